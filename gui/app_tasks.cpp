@@ -0,0 +1,110 @@
+// gui/app_tasks.cpp - Task creation, inter-task queues and the LVGL lock
+
+#include "app_tasks.h"
+
+MsgQueue<ServoMsg, SERVO_QUEUE_LEN> g_servo_queue;
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+static StaticSemaphore_t lvgl_mutex_buf;
+static SemaphoreHandle_t lvgl_mutex = nullptr;
+
+void app_tasks_init() {
+    if (!lvgl_mutex) {
+        lvgl_mutex = xSemaphoreCreateRecursiveMutexStatic(&lvgl_mutex_buf);
+    }
+}
+
+void lvgl_lock() {
+    // Before app_tasks_init() only the boot task exists - nothing to guard
+    if (lvgl_mutex) xSemaphoreTakeRecursive(lvgl_mutex, portMAX_DELAY);
+}
+
+void lvgl_unlock() {
+    if (lvgl_mutex) xSemaphoreGiveRecursive(lvgl_mutex);
+}
+
+bool app_task_create(const char* name, app_task_fn_t fn, void* arg,
+                     uint32_t stack_size, uint32_t priority, int core) {
+    return xTaskCreatePinnedToCore(fn, name, stack_size, arg, priority,
+                                   nullptr, core) == pdPASS;
+}
+
+void app_task_delay_ms(uint32_t ms) {
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+void app_task_yield() {
+    taskYIELD();
+}
+
+bool app_notify_wait(uint32_t bits, uint32_t timeout_ms) {
+    // Already set while a wait for another bit took the pending notification
+    if (ulTaskNotifyValueClear(nullptr, bits) & bits) return true;
+
+    const TickType_t ticks = pdMS_TO_TICKS(timeout_ms);
+    const TickType_t start = xTaskGetTickCount();
+    for (;;) {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= ticks) return false;
+        uint32_t value = 0;
+        if (xTaskNotifyWait(0, bits, &value, ticks - elapsed) == pdTRUE && (value & bits)) return true;
+    }
+}
+
+uint32_t app_time_us() {
+    return static_cast<uint32_t>(esp_timer_get_time());
+}
+
+#else
+// Simulator: std::thread based
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+static std::recursive_mutex lvgl_mutex;
+
+void app_tasks_init() {}
+
+void lvgl_lock() {
+    lvgl_mutex.lock();
+}
+
+void lvgl_unlock() {
+    lvgl_mutex.unlock();
+}
+
+bool app_task_create(const char* name, app_task_fn_t fn, void* arg,
+                     uint32_t stack_size, uint32_t priority, int core) {
+    (void)name; (void)stack_size; (void)priority; (void)core;
+    std::thread(fn, arg).detach();
+    return true;
+}
+
+void app_task_delay_ms(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void app_task_yield() {
+    std::this_thread::yield();
+}
+
+bool app_notify_wait(uint32_t bits, uint32_t timeout_ms) {
+    (void)bits;
+    app_task_delay_ms(timeout_ms);
+    return false;
+}
+
+uint32_t app_time_us() {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return static_cast<uint32_t>(us);
+}
+
+#endif
@@ -0,0 +1,143 @@
+// gui/app_tasks.h - Task layout, inter-task messages and the LVGL lock
+//
+//   Task   Core  Prio  Owns
+//   ----   ----  ----  ----------------------------------------------------
+//   GUI    1     2     LVGL, display, touch, encoder (only task calling lv_*)
+//   IO     0     3     PN532, signal capture, servo test, LiPo taps
+//   RT     0     10    Servo PWM hardware and timing work
+//   SCALE  0     5     HX711 load cells (bit-banged, woken by DOUT ready)
+//   IMU    0     4     IMU FIFO bursts over the shared I2C bus, attitude fusion
+//   I2C    0     6     Owns the I2C bus, runs the drivers' queued transfers
+//   LOG    0     1     Drains the log queue to UART and the serial monitor
+//   STORE  0     1     Writes the settings block to flash (debounced)
+//
+// Tasks talk through the queues below; nothing outside the GUI task touches
+// LVGL objects except inside an LvglLock scope (e.g. serial_log.cpp).
+//
+// ESP32:     FreeRTOS tasks pinned to cores
+// Simulator: std::thread (core and priority are ignored)
+#pragma once
+
+#include <stdint.h>
+#include "msg_queue.h"
+#include "pins.h"
+#include "servo_trajectory.h"
+
+// =============================================================================
+// Task Configuration
+// =============================================================================
+constexpr uint32_t GUI_TASK_STACK    = 16384;
+constexpr uint32_t GUI_TASK_PRIORITY = 2;
+constexpr int      GUI_TASK_CORE     = 1;
+
+constexpr uint32_t IO_TASK_STACK     = 4096;
+constexpr uint32_t IO_TASK_PRIORITY  = 3;
+constexpr int      IO_TASK_CORE      = 0;
+
+constexpr uint32_t RT_TASK_STACK     = 3072;
+constexpr uint32_t RT_TASK_PRIORITY  = 10;
+constexpr int      RT_TASK_CORE      = 0;
+
+constexpr uint32_t SCALE_TASK_STACK    = 3072;
+constexpr uint32_t SCALE_TASK_PRIORITY = 5;
+constexpr int      SCALE_TASK_CORE     = 0;
+
+constexpr uint32_t IMU_TASK_STACK    = 4096;
+constexpr uint32_t IMU_TASK_PRIORITY = 4;
+constexpr int      IMU_TASK_CORE     = 0;
+
+constexpr uint32_t I2C_TASK_STACK    = 4096;
+constexpr uint32_t I2C_TASK_PRIORITY = 6;
+constexpr int      I2C_TASK_CORE     = 0;
+
+constexpr uint32_t LOG_TASK_STACK    = 4096;
+constexpr uint32_t LOG_TASK_PRIORITY = 1;
+constexpr int      LOG_TASK_CORE     = 0;
+
+constexpr uint32_t STORE_TASK_STACK    = 4096;
+constexpr uint32_t STORE_TASK_PRIORITY = 1;
+constexpr int      STORE_TASK_CORE     = 0;
+
+// =============================================================================
+// Messages
+// =============================================================================
+
+// GUI -> RT: servo output commands (posted by the servo_* API in servo_driver.cpp)
+enum ServoCmd : uint8_t {
+    SERVO_CMD_SET_PULSE = 0,    // Set pulse width (value = ns) on all servos in mask
+    SERVO_CMD_ENABLE,           // Enable (value = 1) or disable (value = 0) servos in mask
+    SERVO_CMD_DISABLE_ALL,      // Stop every output
+    SERVO_CMD_SET_FREQUENCY,    // Set frame rate (value = Hz) on all servos in mask
+    SERVO_CMD_SET_HIRES,        // High-resolution RMT output (value = 1) or LEDC (value = 0)
+    SERVO_CMD_COMMIT,           // Latch frame_ns for all servos in mask at the next period
+    SERVO_CMD_TRAJ_START,       // Run traj on all servos in mask
+    SERVO_CMD_TRAJ_SPEED,       // Set trajectory speed (value = µs/s) on servos in mask
+    SERVO_CMD_TRAJ_STOP,        // Stop trajectories, hold position
+    SERVO_CMD_RELEASE_PINS,     // Release pins as inputs (value = 1) or drive them again (value = 0)
+};
+
+struct ServoMsg {
+    ServoCmd cmd;
+    uint8_t mask;       // Bit N = servo N
+    uint32_t value;
+    uint32_t frame_ns[NUM_SERVO_PINS];  // SERVO_CMD_COMMIT only: pulse per servo (ns)
+    ServoTrajectory traj;               // SERVO_CMD_TRAJ_START only
+};
+
+constexpr size_t SERVO_QUEUE_LEN = 32;
+extern MsgQueue<ServoMsg, SERVO_QUEUE_LEN> g_servo_queue;
+
+// =============================================================================
+// Task Creation
+// =============================================================================
+typedef void (*app_task_fn_t)(void* arg);
+
+// Create a task (detached). Returns false if it could not be started.
+bool app_task_create(const char* name, app_task_fn_t fn, void* arg,
+                     uint32_t stack_size, uint32_t priority, int core);
+
+// Sleep the calling task
+void app_task_delay_ms(uint32_t ms);
+
+// Let other ready tasks run (does not sleep)
+void app_task_yield();
+
+// Monotonic microsecond clock shared by driver timestamps (esp_timer on ESP32).
+// Wraps after ~71 minutes - compare timestamps by difference only.
+uint32_t app_time_us();
+
+// =============================================================================
+// Task Notification Bits
+// =============================================================================
+// A task that uses the I2C bus gets two kinds of wakeups on its task
+// notification: its own (IRQ line, start/stop) and I2C completions. Each sets
+// its own bit (xTaskNotify / xTaskNotifyFromISR with eSetBits), so waiting for
+// one never consumes the other. Such tasks must not use xTaskNotifyGive /
+// ulTaskNotifyTake, which count instead of setting bits.
+constexpr uint32_t NOTIFY_WAKE     = 1u << 0;   // Driver's own wakeups
+constexpr uint32_t NOTIFY_I2C_DONE = 1u << 1;   // I2C transfer finished (i2c_bus)
+
+// Sleep until one of the bits is set (clears them) or timeout_ms passed.
+// Returns true if woken by the bits. Simulator: plain sleep, returns false.
+bool app_notify_wait(uint32_t bits, uint32_t timeout_ms);
+
+// =============================================================================
+// LVGL Lock (recursive)
+// =============================================================================
+// LVGL is not thread-safe. The GUI task holds the lock while running
+// lv_timer_handler(); any other task must hold it while touching LVGL objects.
+
+// Create the lock (call once before starting tasks)
+void app_tasks_init();
+
+void lvgl_lock();
+void lvgl_unlock();
+
+// RAII helper: { LvglLock lock; lv_label_set_text(...); }
+class LvglLock {
+public:
+    LvglLock() { lvgl_lock(); }
+    ~LvglLock() { lvgl_unlock(); }
+    LvglLock(const LvglLock&) = delete;
+    LvglLock& operator=(const LvglLock&) = delete;
+};
@@ -1,8 +1,32 @@
 // gui/config/settings.cpp - Settings storage implementation
-// Platform-agnostic JSON file handling
+// The settings are stored as one binary block (gui/config/settings_store.h):
+//
+//   header   magic "RCTS", schema version, payload length, CRC-32 of the payload
+//   payload  the fields of SETTINGS_SCHEMA (gui/config/settings_schema.h) in
+//            table order, little endian, packed to their type size
+//
+// Loading at boot is one block read, then the schema table decodes, validates
+// and migrates it. JSON stays as import/export format only (the file the
+// previous firmware wrote is imported once if no block is stored yet).
+//
+// Migration: fields are never removed or retyped. A field added in
+// SETTINGS_VERSION N is appended with since = N, so the payload of an older
+// block simply lacks it and the field keeps its default.
+//
+// Saving never touches the flash on the caller's task: settings_save() encodes
+// the block, marks the fields that changed and hands it to the settings task,
+// which writes once the changes have settled (SAVE_DEBOUNCE_MS).
 
 #include "gui/config/settings.h"
+#include "gui/config/settings_schema.h"
+#include "gui/config/settings_store.h"
+#include "gui/app_tasks.h"
+#include "gui/serial_log.h"
+#include "seqlock.h"
+#include <atomic>
+#include <cstddef>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 
 // Global settings instance with defaults
@@ -37,137 +61,500 @@ void servo_apply_preset(ServoProtocol protocol) {
     g_settings.servo_frequency = p.frequency;
 }
 
-// Platform-specific path handling
-#if defined(ESP_PLATFORM) || defined(ARDUINO)
-    // ESP32: Use SPIFFS/LittleFS root
-    #include <FS.h>
-    #include <SPIFFS.h>
-    static const char* SETTINGS_PATH = "/settings.json";
+// =============================================================================
+// Schema
+// =============================================================================
 
-    static FILE* settings_fopen(const char* mode) {
-        // For ESP32, we need to use SPIFFS file API
-        // This is a simplified wrapper - actual implementation may vary
-        return fopen(SETTINGS_PATH, mode);
+// Dropdown options (must match the enum order) - language names stay in their
+// own language, protocol and profile names are technical terms: not translated
+static const char LANGUAGE_OPTIONS[] =
+    "English\n"
+    "Deutsch\n"
+    "Français\n"
+    "Español\n"
+    "Italiano\n"
+    "Nederlands\n"
+    "Čeština";
+
+static const char SERVO_PROTOCOL_OPTIONS[] =
+    "Standard\n"
+    "Extended\n"
+    "Sanwa\n"
+    "Futaba\n"
+    "Digital Fast\n"
+    "Custom";
+
+static const char SWEEP_PROFILE_OPTIONS[] =
+    "Linear\n"
+    "Sine\n"
+    "Triangle\n"
+    "Step\n"
+    "S-Curve";
+
+// Settings page row of a field
+#define UI_NONE                         WIDGET_NONE, STR_COUNT, 1, "", nullptr, STR_COUNT, 0, nullptr
+#define UI_SLIDER(label, step, unit)    WIDGET_SLIDER, label, step, unit, nullptr, STR_COUNT, 0, nullptr
+#define UI_DROPDOWN(label, options, n)  WIDGET_DROPDOWN, label, 1, "", options, STR_COUNT, n, nullptr
+#define UI_DROPDOWN_TR(label, first, n) WIDGET_DROPDOWN, label, 1, "", nullptr, first, n, nullptr
+#define UI_CHOICE_TR(label, first, values, n) \
+    WIDGET_DROPDOWN, label, 1, "", nullptr, first, n, values
+
+#define SETTING(id, field, type, since, min, max, def, ui) \
+    { id, #field, offsetof(Settings, field), type, 1, since, min, max, def, ui }
+#define SETTING_ARRAY(id, field, type, since, min, max, def, ui) \
+    { id, #field, offsetof(Settings, field), type, \
+      sizeof(Settings::field) / sizeof(Settings::field[0]), since, min, max, def, ui }
+
+constexpr SettingField SETTINGS_SCHEMA[SETTING_COUNT] = {
+    SETTING(SET_LANGUAGE, language, SETTING_U8, 3, 0, LANG_COUNT - 1, LANG_EN,
+            UI_DROPDOWN(STR_SETTINGS_LANGUAGE, LANGUAGE_OPTIONS, LANG_COUNT)),
+    SETTING(SET_BG_COLOR, bg_color, SETTING_U8, 3, 0, BG_COLOR_COUNT - 1, BG_COLOR_WHITE,
+            UI_DROPDOWN_TR(STR_SETTINGS_BACKGROUND, STR_BG_LIGHT_GRAY, BG_COLOR_COUNT)),
+    SETTING(SET_BRIGHTNESS, brightness, SETTING_U8, 3, 10, 100, 80,
+            UI_SLIDER(STR_SETTINGS_BRIGHTNESS, 1, "%")),
+    SETTING(SET_SERVO_PROTOCOL, servo_protocol, SETTING_U8, 3, 0, SERVO_PROTOCOL_COUNT - 1, SERVO_STANDARD,
+            UI_DROPDOWN(STR_SETTINGS_PROTOCOL, SERVO_PROTOCOL_OPTIONS, SERVO_PROTOCOL_COUNT)),
+    SETTING(SET_SERVO_PWM_MIN, servo_pwm_min, SETTING_U16, 3, 500, 1500, 1000,
+            UI_SLIDER(STR_SETTINGS_PWM_MIN, 1, "µs")),
+    SETTING(SET_SERVO_PWM_CENTER, servo_pwm_center, SETTING_U16, 3, 1000, 2000, 1500,
+            UI_SLIDER(STR_SETTINGS_PWM_CENTER, 1, "µs")),
+    SETTING(SET_SERVO_PWM_MAX, servo_pwm_max, SETTING_U16, 3, 1500, 2500, 2000,
+            UI_SLIDER(STR_SETTINGS_PWM_MAX, 1, "µs")),
+    SETTING(SET_SERVO_FREQUENCY, servo_frequency, SETTING_U16, 3, 50, 400, 50,
+            UI_CHOICE_TR(STR_SETTINGS_FREQUENCY, STR_FREQ_50HZ, SERVO_FREQ_VALUES, SERVO_FREQ_COUNT)),
+    SETTING_ARRAY(SET_SERVO_PWM_STEP, servo_pwm_step, SETTING_U8, 3, 1, 100, DEFAULT_PWM_STEP,
+                  UI_SLIDER(STR_SETTINGS_SERVO_STEP, 1, "µs")),
+    SETTING(SET_SERVO_SWEEP_STEP, servo_sweep_step, SETTING_U8, 3, 1, 100, DEFAULT_SWEEP_STEP,
+            UI_NONE),
+    SETTING(SET_SERVO_SWEEP_STEP_INCREMENT, servo_sweep_step_increment, SETTING_U8, 3, 1, 20,
+            DEFAULT_SWEEP_STEP_INCREMENT, UI_NONE),
+    SETTING(SET_SERVO_SWEEP_PROFILE, servo_sweep_profile, SETTING_U8, 4, 0, SERVO_PROFILE_COUNT - 1,
+            SERVO_PROFILE_TRIANGLE,
+            UI_DROPDOWN(STR_SETTINGS_SWEEP_PROFILE, SWEEP_PROFILE_OPTIONS, SERVO_PROFILE_COUNT)),
+    SETTING(SET_SERVO_SWEEP_DWELL_MS, servo_sweep_dwell_ms, SETTING_U16, 4, 0, MAX_SWEEP_DWELL_MS, 0,
+            UI_SLIDER(STR_SETTINGS_SWEEP_DWELL, 100, "ms")),
+    SETTING_ARRAY(SET_CG_ZERO, cg_zero, SETTING_I32, 5, INT32_MIN, INT32_MAX, 0,
+                  UI_NONE),
+    SETTING_ARRAY(SET_CG_COUNTS_PER_KG, cg_counts_per_kg, SETTING_I32, 5, INT32_MIN, INT32_MAX, 0,
+                  UI_NONE),
+    SETTING(SET_CG_CAL_MASS_G, cg_cal_mass_g, SETTING_U16, 5, 10, 10000, DEFAULT_CG_CAL_MASS_G,
+            UI_SLIDER(STR_SETTINGS_CG_REF_MASS, 10, "g")),
+    SETTING(SET_CG_LE_OFFSET_MM, cg_le_offset_mm, SETTING_U16, 5, 0, MAX_CG_LE_OFFSET_MM,
+            DEFAULT_CG_LE_OFFSET_MM, UI_SLIDER(STR_SETTINGS_CG_LE_OFFSET, 1, "mm")),
+    SETTING(SET_CG_SUPPORT_DIST_MM, cg_support_dist_mm, SETTING_U16, 5, MIN_CG_SUPPORT_DIST_MM,
+            MAX_CG_SUPPORT_DIST_MM, DEFAULT_CG_SUPPORT_DIST_MM,
+            UI_SLIDER(STR_SETTINGS_CG_DISTANCE, 1, "mm")),
+    SETTING(SET_DEFL_CHORD_MM, defl_chord_mm, SETTING_U16, 6, MIN_DEFL_CHORD_MM, MAX_DEFL_CHORD_MM,
+            DEFAULT_DEFL_CHORD_MM, UI_SLIDER(STR_SETTINGS_DEFL_CHORD, 1, "mm")),
+    SETTING(SET_DEFL_ZEROED, defl_zeroed, SETTING_U8, 6, 0, 1, 0,
+            UI_NONE),
+    SETTING(SET_DEFL_ZERO_CDEG, defl_zero_cdeg, SETTING_I16, 6, -MAX_DEFL_ZERO_CDEG, MAX_DEFL_ZERO_CDEG, 0,
+            UI_NONE),
+};
+constexpr size_t SETTINGS_FIELD_COUNT = SETTING_COUNT;
+static_assert(SETTINGS_FIELD_COUNT <= 32, "Dirty field mask holds 32 fields");
+
+#undef SETTING
+#undef SETTING_ARRAY
+#undef UI_NONE
+#undef UI_SLIDER
+#undef UI_DROPDOWN
+#undef UI_DROPDOWN_TR
+#undef UI_CHOICE_TR
+
+// Compile-time checks of the table: ids in table order, defaults in range,
+// slider steps that divide the range, one dropdown option per value
+static constexpr bool schema_valid(size_t n) {
+    return n == SETTING_COUNT ||
+           (SETTINGS_SCHEMA[n].id == n &&
+            SETTINGS_SCHEMA[n].def >= SETTINGS_SCHEMA[n].min &&
+            SETTINGS_SCHEMA[n].def <= SETTINGS_SCHEMA[n].max &&
+            (SETTINGS_SCHEMA[n].widget != WIDGET_SLIDER ||
+             (SETTINGS_SCHEMA[n].min % SETTINGS_SCHEMA[n].step == 0 &&
+              SETTINGS_SCHEMA[n].max % SETTINGS_SCHEMA[n].step == 0)) &&
+            (SETTINGS_SCHEMA[n].widget != WIDGET_DROPDOWN || SETTINGS_SCHEMA[n].values ||
+             SETTINGS_SCHEMA[n].option_count == SETTINGS_SCHEMA[n].max - SETTINGS_SCHEMA[n].min + 1) &&
+            schema_valid(n + 1));
+}
+static_assert(schema_valid(0), "SETTINGS_SCHEMA: row out of order or inconsistent");
+
+static size_t type_size(SettingType type) {
+    switch (type) {
+        case SETTING_U8:  return 1;
+        case SETTING_U16:
+        case SETTING_I16: return 2;
+        default:          return 4;
     }
-#else
-    // Simulator: Use gui/config/ folder relative to executable
-    static const char* SETTINGS_PATH = "gui/config/settings.json";
+}
 
-    static FILE* settings_fopen(const char* mode) {
-        return fopen(SETTINGS_PATH, mode);
+static int32_t field_get(const Settings& s, const SettingField& f, uint8_t i) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&s) + f.offset + i * type_size(f.type);
+    switch (f.type) {
+        case SETTING_U8:  return *p;
+        case SETTING_U16: { uint16_t v; memcpy(&v, p, sizeof(v)); return v; }
+        case SETTING_I16: { int16_t v; memcpy(&v, p, sizeof(v)); return v; }
+        default:          { int32_t v; memcpy(&v, p, sizeof(v)); return v; }
     }
-#endif
+}
 
-void settings_init() {
-    // Initialize with defaults (struct already has default values)
-    g_settings = Settings();
+// Out of range values are replaced by the field's default
+static void field_set(Settings& s, const SettingField& f, uint8_t i, int32_t value) {
+    if (value < f.min || value > f.max) value = f.def;
+    uint8_t* p = reinterpret_cast<uint8_t*>(&s) + f.offset + i * type_size(f.type);
+    switch (f.type) {
+        case SETTING_U8:  *p = static_cast<uint8_t>(value); break;
+        case SETTING_U16: { uint16_t v = static_cast<uint16_t>(value); memcpy(p, &v, sizeof(v)); break; }
+        case SETTING_I16: { int16_t v = static_cast<int16_t>(value); memcpy(p, &v, sizeof(v)); break; }
+        default:          memcpy(p, &value, sizeof(value)); break;
+    }
+}
+
+int32_t settings_get(SettingId id, uint8_t index) {
+    const SettingField& f = SETTINGS_SCHEMA[id];
+    return index < f.count ? field_get(g_settings, f, index) : f.def;
+}
+
+void settings_set(SettingId id, uint8_t index, int32_t value) {
+    const SettingField& f = SETTINGS_SCHEMA[id];
+    if (index < f.count) field_set(g_settings, f, index, value);
+}
 
-#if defined(ESP_PLATFORM) || defined(ARDUINO)
-    // Initialize SPIFFS for ESP32
-    if (!SPIFFS.begin(true)) {
-        // Format SPIFFS if mount failed
-        SPIFFS.format();
-        SPIFFS.begin(true);
+int settings_option_index(const SettingField& f, int32_t value) {
+    if (!f.values) return value - f.min;
+    int idx = 0;
+    for (int i = 0; i < f.option_count; i++) {
+        if (f.values[i] <= value) idx = i;
     }
-#endif
+    return idx;
 }
 
-void settings_load() {
-    FILE* f = settings_fopen("r");
+int32_t settings_option_value(const SettingField& f, int option) {
+    if (option < 0 || option >= f.option_count) return f.def;
+    return f.values ? f.values[option] : f.min + option;
+}
+
+// =============================================================================
+// Binary block
+// =============================================================================
+
+static constexpr uint32_t BLOCK_MAGIC = 0x53544352;     // "RCTS"
+static constexpr size_t BLOCK_MAX = 256;
+
+struct BlockHeader {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t length;        // Payload bytes
+    uint32_t crc;           // CRC-32 of the payload
+};
+
+static uint32_t crc32(const uint8_t* data, size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+// Payload of the current version; returns its length
+static size_t encode(const Settings& s, uint8_t* out) {
+    size_t pos = 0;
+    for (const SettingField& f : SETTINGS_SCHEMA) {
+        size_t size = type_size(f.type);
+        for (uint8_t i = 0; i < f.count; i++) {
+            uint32_t v = static_cast<uint32_t>(field_get(s, f, i));
+            for (size_t b = 0; b < size; b++) out[pos++] = static_cast<uint8_t>(v >> (8 * b));
+        }
+    }
+    return pos;
+}
+
+// Payload written by schema version `version`; false if the length does not match
+static bool decode(Settings& s, const uint8_t* in, size_t len, uint8_t version) {
+    size_t pos = 0;
+    for (const SettingField& f : SETTINGS_SCHEMA) {
+        if (f.since > version) continue;        // Added later: keeps its default
+        size_t size = type_size(f.type);
+        if (pos + f.count * size > len) return false;
+        for (uint8_t i = 0; i < f.count; i++) {
+            uint32_t v = 0;
+            for (size_t b = 0; b < size; b++) v |= static_cast<uint32_t>(in[pos++]) << (8 * b);
+            // Sign-extend the 16-bit type
+            int32_t value = (f.type == SETTING_I16) ? static_cast<int16_t>(v) : static_cast<int32_t>(v);
+            field_set(s, f, i, value);
+        }
+    }
+    return pos == len;
+}
+
+static bool read_block(Settings& s, uint8_t& version, uint32_t& crc) {
+    uint8_t block[BLOCK_MAX];
+    size_t len = 0;
+    if (!settings_store_read(block, sizeof(block), len) || len < sizeof(BlockHeader)) return false;
+
+    BlockHeader h;
+    memcpy(&h, block, sizeof(h));
+    const uint8_t* payload = block + sizeof(h);
+    if (h.magic != BLOCK_MAGIC || h.version == 0 || h.version > SETTINGS_VERSION ||
+        h.length != len - sizeof(h) || crc32(payload, h.length) != h.crc) {
+        return false;
+    }
+
+    Settings loaded;
+    if (!decode(loaded, payload, h.length, h.version)) return false;
+    s = loaded;
+    version = h.version;
+    crc = h.crc;
+    return true;
+}
+
+// Whole block (header + payload) of the current version; returns its length
+static size_t build_block(const Settings& s, uint8_t* block) {
+    BlockHeader h;
+    h.magic = BLOCK_MAGIC;
+    h.version = SETTINGS_VERSION;
+    h.reserved = 0;
+    h.length = static_cast<uint16_t>(encode(s, block + sizeof(h)));
+    h.crc = crc32(block + sizeof(h), h.length);
+    memcpy(block, &h, sizeof(h));
+    return sizeof(h) + h.length;
+}
+
+// Fields of a and b that differ (bit N = SETTINGS_SCHEMA[N])
+static uint32_t changed_fields(const Settings& a, const Settings& b) {
+    uint32_t mask = 0;
+    for (size_t n = 0; n < SETTINGS_FIELD_COUNT; n++) {
+        const SettingField& f = SETTINGS_SCHEMA[n];
+        for (uint8_t i = 0; i < f.count; i++) {
+            if (field_get(a, f, i) != field_get(b, f, i)) mask |= 1u << n;
+        }
+    }
+    return mask;
+}
+
+static uint8_t count_bits(uint32_t v) {
+    uint8_t n = 0;
+    for (; v; v &= v - 1) n++;
+    return n;
+}
+
+// =============================================================================
+// JSON import / export
+// =============================================================================
+
+// Schema field for a JSON key ("brightness", "servo_pwm_step_3")
+static const SettingField* find_field(const char* key, uint8_t& index) {
+    for (const SettingField& f : SETTINGS_SCHEMA) {
+        size_t n = strlen(f.key);
+        if (strncmp(key, f.key, n) != 0) continue;
+        if (f.count == 1 && key[n] == '\0') {
+            index = 0;
+            return &f;
+        }
+        if (f.count > 1 && key[n] == '_') {
+            char* end;
+            long i = strtol(key + n + 1, &end, 10);
+            if (end != key + n + 1 && *end == '\0' && i >= 0 && i < f.count) {
+                index = static_cast<uint8_t>(i);
+                return &f;
+            }
+        }
+    }
+    return nullptr;
+}
+
+bool settings_import_json(const char* path) {
+    FILE* f = fopen(path, "r");
     if (!f) {
-        // File doesn't exist, keep defaults
-        return;
+        return false;
     }
 
+    // Keys missing from the file (older firmware) keep their defaults
+    Settings imported;
     char line[256];
     while (fgets(line, sizeof(line), f)) {
-        int value;
-        int idx;
-        if (sscanf(line, " \"version\" : %d", &value) == 1) {
-            g_settings.version = (uint8_t)value;
-        } else if (sscanf(line, " \"language\" : %d", &value) == 1) {
-            g_settings.language = (uint8_t)value;
-        } else if (sscanf(line, " \"bg_color\" : %d", &value) == 1) {
-            g_settings.bg_color = (uint8_t)value;
-        } else if (sscanf(line, " \"brightness\" : %d", &value) == 1) {
-            g_settings.brightness = (uint8_t)value;
-        } else if (sscanf(line, " \"servo_protocol\" : %d", &value) == 1) {
-            g_settings.servo_protocol = (uint8_t)value;
-        } else if (sscanf(line, " \"servo_pwm_min\" : %d", &value) == 1) {
-            g_settings.servo_pwm_min = (uint16_t)value;
-        } else if (sscanf(line, " \"servo_pwm_center\" : %d", &value) == 1) {
-            g_settings.servo_pwm_center = (uint16_t)value;
-        } else if (sscanf(line, " \"servo_pwm_max\" : %d", &value) == 1) {
-            g_settings.servo_pwm_max = (uint16_t)value;
-        } else if (sscanf(line, " \"servo_frequency\" : %d", &value) == 1) {
-            g_settings.servo_frequency = (uint16_t)value;
-        } else if (sscanf(line, " \"servo_pwm_step_%d\" : %d", &idx, &value) == 2) {
-            if (idx >= 0 && idx < NUM_SERVOS) {
-                g_settings.servo_pwm_step[idx] = (uint8_t)value;
+        char key[48];
+        long value;
+        if (sscanf(line, " \"%47[^\"]\" : %ld", key, &value) != 2) continue;
+        uint8_t index;
+        const SettingField* field = find_field(key, index);
+        if (field) field_set(imported, *field, index, static_cast<int32_t>(value));
+    }
+    fclose(f);
+
+    g_settings = imported;
+    return true;
+}
+
+static bool export_json(const Settings& s, const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        return false;
+    }
+
+    fprintf(f, "{\n");
+    fprintf(f, "    \"version\": %d", SETTINGS_VERSION);
+    for (const SettingField& field : SETTINGS_SCHEMA) {
+        for (uint8_t i = 0; i < field.count; i++) {
+            if (field.count > 1) {
+                fprintf(f, ",\n    \"%s_%d\": %ld", field.key, i, (long)field_get(s, field, i));
+            } else {
+                fprintf(f, ",\n    \"%s\": %ld", field.key, (long)field_get(s, field, i));
             }
-        } else if (sscanf(line, " \"servo_sweep_step\" : %d", &value) == 1) {
-            g_settings.servo_sweep_step = (uint8_t)value;
-        } else if (sscanf(line, " \"servo_sweep_step_increment\" : %d", &value) == 1) {
-            g_settings.servo_sweep_step_increment = (uint8_t)value;
         }
     }
+    fprintf(f, "\n}\n");
 
-    fclose(f);
+    return fclose(f) == 0;
+}
 
-    // Validate loaded values are within range
-    if (g_settings.language >= LANG_COUNT) g_settings.language = LANG_EN;
-    if (g_settings.bg_color >= BG_COLOR_COUNT) g_settings.bg_color = BG_COLOR_WHITE;
-    if (g_settings.brightness < 10 || g_settings.brightness > 100) g_settings.brightness = 80;
-    if (g_settings.servo_protocol >= SERVO_PROTOCOL_COUNT) g_settings.servo_protocol = SERVO_STANDARD;
-    if (g_settings.servo_pwm_min < 500 || g_settings.servo_pwm_min > 1500) g_settings.servo_pwm_min = 1000;
-    if (g_settings.servo_pwm_center < 1000 || g_settings.servo_pwm_center > 2000) g_settings.servo_pwm_center = 1500;
-    if (g_settings.servo_pwm_max < 1500 || g_settings.servo_pwm_max > 2500) g_settings.servo_pwm_max = 2000;
-    if (g_settings.servo_frequency < 50 || g_settings.servo_frequency > 400) g_settings.servo_frequency = 50;
-
-    // Validate per-servo PWM step values (1-100 µs range)
-    for (int i = 0; i < NUM_SERVOS; i++) {
-        if (g_settings.servo_pwm_step[i] < 1 || g_settings.servo_pwm_step[i] > 100) {
-            g_settings.servo_pwm_step[i] = DEFAULT_PWM_STEP;
-        }
+bool settings_export_json(const char* path) {
+    return export_json(g_settings, path);
+}
+
+// =============================================================================
+// Persistence Task
+// =============================================================================
+
+static constexpr uint32_t SAVE_DEBOUNCE_MS = 1000;      // Quiet time before a write
+static constexpr uint32_t SAVE_MAX_DELAY_MS = 5000;     // Write anyway if changes keep coming
+static constexpr uint32_t SAVE_POLL_MS = 100;
+
+struct PendingBlock {
+    uint16_t len;
+    uint8_t data[BLOCK_MAX];
+};
+
+static SeqLock<PendingBlock> pending;                   // GUI -> settings task
+static std::atomic<uint32_t> posted_count{0};
+static std::atomic<uint32_t> last_post_us{0};
+static std::atomic<uint32_t> dirty_fields{0};           // Changed since the last write
+static std::atomic<uint32_t> stored_crc{0};             // Block on flash (0: none)
+static std::atomic<uint32_t> write_count{0};
+static std::atomic<uint32_t> skip_count{0};
+static std::atomic<uint32_t> fail_count{0};
+static std::atomic<uint32_t> last_write_us{0};
+static std::atomic<uint32_t> max_write_us{0};
+
+// GUI side: the settings last handed to the task
+static Settings posted;
+
+static void post(const Settings& s, uint32_t fields) {
+    PendingBlock b;
+    b.len = static_cast<uint16_t>(build_block(s, b.data));
+    pending.write(b);
+    posted = s;
+    dirty_fields.fetch_or(fields);
+    last_post_us.store(app_time_us());
+    posted_count++;
+}
+
+static bool write_pending(const PendingBlock& b) {
+    BlockHeader h;
+    memcpy(&h, b.data, sizeof(h));
+    if (h.crc == stored_crc.load()) {
+        skip_count++;                                   // Changed and changed back
+        return true;
     }
 
-    // Validate sweep step (1-100 µs range)
-    if (g_settings.servo_sweep_step < 1 || g_settings.servo_sweep_step > 100) {
-        g_settings.servo_sweep_step = DEFAULT_SWEEP_STEP;
+    uint32_t start_us = app_time_us();
+    if (!settings_store_write(b.data, b.len)) {
+        fail_count++;
+        return false;
     }
-    // Validate sweep step increment (1-20 range)
-    if (g_settings.servo_sweep_step_increment < 1 || g_settings.servo_sweep_step_increment > 20) {
-        g_settings.servo_sweep_step_increment = DEFAULT_SWEEP_STEP_INCREMENT;
+    uint32_t took_us = app_time_us() - start_us;
+    stored_crc.store(h.crc);
+    write_count++;
+    last_write_us.store(took_us);
+    if (took_us > max_write_us.load()) max_write_us.store(took_us);
+
+#if !defined(ESP_PLATFORM) && !defined(ARDUINO)
+    // Simulator: keep a readable copy next to the block
+    Settings s;
+    decode(s, b.data + sizeof(h), h.length, h.version);
+    export_json(s, settings_store_json_path());
+#endif
+    return true;
+}
+
+void settings_task_main(void* arg) {
+    (void)arg;
+    uint32_t written = 0;           // posted_count covered by the last write
+    uint32_t pending_since_us = 0;
+    bool waiting = false;
+
+    for (;;) {
+        app_task_delay_ms(SAVE_POLL_MS);
+
+        uint32_t count = posted_count.load();
+        if (count == written) continue;
+
+        uint32_t now = app_time_us();
+        if (!waiting) {
+            waiting = true;
+            pending_since_us = now;
+        }
+        bool settled = now - last_post_us.load() >= SAVE_DEBOUNCE_MS * 1000;
+        bool overdue = now - pending_since_us >= SAVE_MAX_DELAY_MS * 1000;
+        if (!settled && !overdue) continue;
+
+        PendingBlock b;
+        if (!pending.read(b)) continue;
+        uint32_t fields = dirty_fields.exchange(0);
+        if (!write_pending(b)) {
+            dirty_fields.fetch_or(fields);              // Retry after the next delay
+            pending_since_us = now;
+            continue;
+        }
+        LOG_D("SETTINGS", "Saved (%u fields changed)", count_bits(fields));
+        // A post between reading the count and the block: written again (or skipped) next round
+        written = count;
+        waiting = false;
     }
 }
 
-void settings_save() {
-    FILE* f = settings_fopen("w");
-    if (!f) {
+// =============================================================================
+// Public API
+// =============================================================================
+
+void settings_init() {
+    // Initialize with defaults (struct already has default values)
+    g_settings = Settings();
+    settings_store_init();
+}
+
+void settings_load() {
+    uint8_t version = 0;
+    uint32_t crc = 0;
+    if (read_block(g_settings, version, crc)) {
+        stored_crc.store(crc);
+        posted = g_settings;
+        // An older block is rewritten in the current layout
+        if (version < SETTINGS_VERSION) post(g_settings, 0);
         return;
     }
 
-    fprintf(f, "{\n");
-    fprintf(f, "    \"version\": %d,\n", g_settings.version);
-    fprintf(f, "    \"language\": %d,\n", g_settings.language);
-    fprintf(f, "    \"bg_color\": %d,\n", g_settings.bg_color);
-    fprintf(f, "    \"brightness\": %d,\n", g_settings.brightness);
-    fprintf(f, "    \"servo_protocol\": %d,\n", g_settings.servo_protocol);
-    fprintf(f, "    \"servo_pwm_min\": %d,\n", g_settings.servo_pwm_min);
-    fprintf(f, "    \"servo_pwm_center\": %d,\n", g_settings.servo_pwm_center);
-    fprintf(f, "    \"servo_pwm_max\": %d,\n", g_settings.servo_pwm_max);
-    fprintf(f, "    \"servo_frequency\": %d,\n", g_settings.servo_frequency);
-    // Per-servo PWM step values
-    for (int i = 0; i < NUM_SERVOS; i++) {
-        fprintf(f, "    \"servo_pwm_step_%d\": %d,\n",
-                i, g_settings.servo_pwm_step[i]);
+    // No block yet (first boot of this firmware): take over the JSON settings
+    posted = g_settings;
+    if (settings_import_json(settings_store_json_path())) {
+        post(g_settings, changed_fields(g_settings, Settings()));
     }
-    // Auto sweep settings
-    fprintf(f, "    \"servo_sweep_step\": %d,\n", g_settings.servo_sweep_step);
-    fprintf(f, "    \"servo_sweep_step_increment\": %d\n", g_settings.servo_sweep_step_increment);
-    fprintf(f, "}\n");
+}
 
-    fclose(f);
+void settings_save() {
+    g_settings.version = SETTINGS_VERSION;
+    uint32_t fields = changed_fields(g_settings, posted);
+    if (fields) post(g_settings, fields);
+}
+
+void settings_get_store_stats(SettingsStoreStats& out) {
+    out.writes = write_count.load();
+    out.skipped = skip_count.load();
+    out.failures = fail_count.load();
+    out.last_write_us = last_write_us.load();
+    out.max_write_us = max_write_us.load();
+    out.pending_fields = count_bits(dirty_fields.load());
 }
 
 void settings_reset() {
@@ -176,7 +563,7 @@ void settings_reset() {
 }
 
 const char* settings_get_path() {
-    return SETTINGS_PATH;
+    return settings_store_location();
 }
 
 void servo_reset_pwm_steps() {
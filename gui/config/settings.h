@@ -1,13 +1,16 @@
 // gui/config/settings.h - Settings storage interface
-// Stores settings in a JSON file (gui/config/settings.json on simulator, /settings.json on SPIFFS for ESP32)
+// Stores settings as a binary block (NVS on ESP32, gui/config/settings.bin on simulator,
+// see gui/config/settings.cpp); JSON (settings.json) is the import/export format
 #pragma once
 
 #include <stdint.h>
 #include "gui/gui.h"
 #include "gui/lang.h"
+#include "servo_trajectory.h"
+#include "pins.h"
 
-// Settings version - increment when adding/changing settings structure
-#define SETTINGS_VERSION 3
+// Settings version - increment when adding settings (new schema fields get since = version)
+#define SETTINGS_VERSION 6
 
 // Number of servos supported
 #define NUM_SERVOS 6
@@ -21,6 +24,25 @@
 // Default sweep step increment (change per encoder detent)
 #define DEFAULT_SWEEP_STEP_INCREMENT 5
 
+// Longest sweep dwell at each end (ms)
+#define MAX_SWEEP_DWELL_MS 2000
+
+// CG scale calibration reference mass (g)
+#define DEFAULT_CG_CAL_MASS_G 500
+
+// CG scale geometry (mm): leading edge stop -> front supports, front -> rear support
+#define DEFAULT_CG_LE_OFFSET_MM 30
+#define DEFAULT_CG_SUPPORT_DIST_MM 200
+#define MAX_CG_LE_OFFSET_MM 200
+#define MIN_CG_SUPPORT_DIST_MM 50
+#define MAX_CG_SUPPORT_DIST_MM 800
+
+// Flap deflection: surface chord behind the hinge line (mm), stored zero (0.01 deg)
+#define DEFAULT_DEFL_CHORD_MM 50
+#define MIN_DEFL_CHORD_MM 10
+#define MAX_DEFL_CHORD_MM 300
+#define MAX_DEFL_ZERO_CDEG 9000
+
 // Servo protocol presets
 enum ServoProtocol {
     SERVO_STANDARD = 0,   // 1000-1500-2000 @ 50Hz
@@ -53,6 +75,20 @@ struct Settings {
     // Auto sweep settings
     uint8_t servo_sweep_step = DEFAULT_SWEEP_STEP;            // Current sweep step (µs per tick)
     uint8_t servo_sweep_step_increment = DEFAULT_SWEEP_STEP_INCREMENT;  // Encoder increment
+    uint8_t servo_sweep_profile = SERVO_PROFILE_TRIANGLE;     // ServoProfile
+    uint16_t servo_sweep_dwell_ms = 0;                        // Hold time at each end
+
+    // CG scale load cells (LoadCellCal per cell, include/load_cell_filter.h)
+    int32_t cg_zero[NUM_LOAD_CELLS] = {0, 0, 0};              // Raw counts without load (tare)
+    int32_t cg_counts_per_kg[NUM_LOAD_CELLS] = {0, 0, 0};     // 0 = not calibrated
+    uint16_t cg_cal_mass_g = DEFAULT_CG_CAL_MASS_G;           // Reference mass for the calibration
+    uint16_t cg_le_offset_mm = DEFAULT_CG_LE_OFFSET_MM;       // Supports 1, 2 behind the LE stop
+    uint16_t cg_support_dist_mm = DEFAULT_CG_SUPPORT_DIST_MM; // Support 3 behind supports 1, 2
+
+    // Flap deflection page
+    uint16_t defl_chord_mm = DEFAULT_DEFL_CHORD_MM;           // Hinge line -> trailing edge
+    uint8_t defl_zeroed = 0;                                  // defl_zero_cdeg is set
+    int16_t defl_zero_cdeg = 0;                               // Surface - reference in neutral (mounting offset)
 };
 
 // Reset all servo PWM steps to default
@@ -67,14 +103,34 @@ extern Settings g_settings;
 // Initialize settings (call once at startup, before gui_init)
 void settings_init();
 
-// Load settings from JSON file (uses defaults if file not found)
+// Load settings from the stored block (imports settings.json if none, else uses defaults)
 void settings_load();
 
-// Save current settings to JSON file
+// Save current settings: returns at once, the settings task writes them once the
+// changes have settled (nothing is written if nothing changed)
 void settings_save();
 
+// JSON import/export (values outside their range are replaced by the default)
+bool settings_import_json(const char* path);
+bool settings_export_json(const char* path);
+
 // Reset settings to defaults and save
 void settings_reset();
 
-// Get path to settings file (for user info)
+// Where the settings are stored (for user info)
 const char* settings_get_path();
+
+// Flash wear monitoring
+struct SettingsStoreStats {
+    uint32_t writes;            // Blocks written since boot
+    uint32_t skipped;           // Saves that ended up unchanged (no flash write)
+    uint32_t failures;
+    uint32_t last_write_us;     // Duration of the last write
+    uint32_t max_write_us;
+    uint8_t pending_fields;     // Changed fields waiting to be written
+};
+
+void settings_get_store_stats(SettingsStoreStats& out);
+
+// Settings task body: debounced block writes (never returns)
+void settings_task_main(void* arg);
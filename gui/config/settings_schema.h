@@ -0,0 +1,93 @@
+// gui/config/settings_schema.h - Settings schema: one table row per stored field
+// SETTINGS_SCHEMA (gui/config/settings.cpp) drives the binary block, the JSON
+// import/export, the range check and the rows of the settings page. A new
+// setting is a Settings member plus one table row; the page lists it by id.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "gui/lang.h"
+
+// Table order = binary block order: append only (see gui/config/settings.cpp)
+enum SettingId : uint8_t {
+    SET_LANGUAGE = 0,
+    SET_BG_COLOR,
+    SET_BRIGHTNESS,
+    SET_SERVO_PROTOCOL,
+    SET_SERVO_PWM_MIN,
+    SET_SERVO_PWM_CENTER,
+    SET_SERVO_PWM_MAX,
+    SET_SERVO_FREQUENCY,
+    SET_SERVO_PWM_STEP,
+    SET_SERVO_SWEEP_STEP,
+    SET_SERVO_SWEEP_STEP_INCREMENT,
+    SET_SERVO_SWEEP_PROFILE,
+    SET_SERVO_SWEEP_DWELL_MS,
+    SET_CG_ZERO,
+    SET_CG_COUNTS_PER_KG,
+    SET_CG_CAL_MASS_G,
+    SET_CG_LE_OFFSET_MM,
+    SET_CG_SUPPORT_DIST_MM,
+    SET_DEFL_CHORD_MM,
+    SET_DEFL_ZEROED,
+    SET_DEFL_ZERO_CDEG,
+    SETTING_COUNT
+};
+
+enum SettingType : uint8_t {
+    SETTING_U8,
+    SETTING_U16,
+    SETTING_I16,
+    SETTING_I32,
+};
+
+// Settings page control for a field
+enum SettingWidget : uint8_t {
+    WIDGET_NONE,            // Not on the settings page (set by other pages)
+    WIDGET_SLIDER,          // Slider + "value unit" label
+    WIDGET_DROPDOWN,        // One option per value (min..max, or per entry of values)
+};
+
+struct SettingField {
+    SettingId id;
+    const char* key;        // JSON key, "<key>_<index>" for arrays
+    uint16_t offset;        // In Settings
+    SettingType type;
+    uint8_t count;          // Array length (1 = scalar)
+    uint8_t since;          // SETTINGS_VERSION that added the field
+    int32_t min;
+    int32_t max;
+    int32_t def;            // Replaces values outside min..max
+
+    // Settings page row
+    SettingWidget widget;
+    StringId label;
+    uint16_t step;          // Slider: value per slider position
+    const char* unit;       // Slider: shown after the value
+    const char* options;    // Dropdown: fixed option text ("\n" separated), or nullptr for
+    StringId first_option;  //   translated options (consecutive string ids)
+    uint8_t option_count;
+    const uint16_t* values; // Dropdown: value of each option (nullptr: min + option index)
+};
+
+// Servo frame rates offered on the settings page
+constexpr uint16_t SERVO_FREQ_VALUES[] = { 50, 100, 200, 333, 400 };
+constexpr uint8_t SERVO_FREQ_COUNT = sizeof(SERVO_FREQ_VALUES) / sizeof(SERVO_FREQ_VALUES[0]);
+
+extern const SettingField SETTINGS_SCHEMA[SETTING_COUNT];
+
+inline const SettingField& settings_field(SettingId id) {
+    return SETTINGS_SCHEMA[id];
+}
+
+// Field value in g_settings (index: array element)
+int32_t settings_get(SettingId id, uint8_t index = 0);
+
+// Set a field in g_settings (values outside min..max are replaced by the default)
+void settings_set(SettingId id, uint8_t index, int32_t value);
+
+// Dropdown option of a field's value (nearest lower option for values not listed)
+int settings_option_index(const SettingField& f, int32_t value);
+
+// Value of a dropdown option
+int32_t settings_option_value(const SettingField& f, int option);
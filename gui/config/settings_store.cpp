@@ -0,0 +1,81 @@
+// gui/config/settings_store.cpp - Binary settings block storage
+// Writes replace the block atomically, a power cut mid-write leaves the old one:
+// ESP32:     one NVS blob. NVS writes the new entry before it erases the old
+//            one and spreads its writes over the partition (wear levelling).
+// Simulator: a file next to settings.json, written to a temp file and renamed.
+
+#include "gui/config/settings_store.h"
+#include <cstdio>
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+
+#include <Preferences.h>
+#include <SPIFFS.h>
+
+static const char* NVS_NAMESPACE = "rctoolbox";
+static const char* NVS_KEY = "settings";
+
+// SPIFFS is mounted at /spiffs in the VFS: stdio paths need the prefix
+static const char* JSON_PATH = "/spiffs/settings.json";
+
+static Preferences prefs;
+
+void settings_store_init() {
+    prefs.begin(NVS_NAMESPACE, false);
+
+    // SPIFFS only carries the JSON import/export file
+    if (!SPIFFS.begin(true)) {
+        // Format SPIFFS if mount failed
+        SPIFFS.format();
+        SPIFFS.begin(true);
+    }
+}
+
+bool settings_store_read(uint8_t* buf, size_t cap, size_t& len) {
+    len = prefs.getBytesLength(NVS_KEY);
+    if (len == 0 || len > cap) return false;
+    return prefs.getBytes(NVS_KEY, buf, len) == len;
+}
+
+bool settings_store_write(const uint8_t* buf, size_t len) {
+    return prefs.putBytes(NVS_KEY, buf, len) == len;
+}
+
+const char* settings_store_location() {
+    return "NVS";
+}
+
+#else
+
+static const char* BLOB_PATH = "gui/config/settings.bin";
+static const char* BLOB_TMP_PATH = "gui/config/settings.bin.tmp";
+static const char* JSON_PATH = "gui/config/settings.json";
+
+void settings_store_init() {}
+
+bool settings_store_read(uint8_t* buf, size_t cap, size_t& len) {
+    FILE* f = fopen(BLOB_PATH, "rb");
+    if (!f) return false;
+    len = fread(buf, 1, cap, f);
+    bool fits = (fgetc(f) == EOF);
+    fclose(f);
+    return len > 0 && fits;
+}
+
+bool settings_store_write(const uint8_t* buf, size_t len) {
+    FILE* f = fopen(BLOB_TMP_PATH, "wb");
+    if (!f) return false;
+    bool ok = (fwrite(buf, 1, len, f) == len);
+    ok &= (fclose(f) == 0);
+    return ok && rename(BLOB_TMP_PATH, BLOB_PATH) == 0;
+}
+
+const char* settings_store_location() {
+    return BLOB_PATH;
+}
+
+#endif
+
+const char* settings_store_json_path() {
+    return JSON_PATH;
+}
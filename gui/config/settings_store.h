@@ -0,0 +1,27 @@
+// gui/config/settings_store.h - Binary settings block storage
+// The settings are kept as one binary block (see gui/config/settings.cpp for
+// the layout): in NVS on ESP32, in gui/config/settings.bin on the simulator.
+// The store only moves bytes; layout, CRC and validation are the caller's.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Mount the storage (call once, before the first read)
+void settings_store_init();
+
+/**
+ * Read the whole block
+ * @param len Bytes read
+ * @return false if no block is stored or it does not fit into buf
+ */
+bool settings_store_read(uint8_t* buf, size_t cap, size_t& len);
+
+// Replace the stored block (atomic; slow - settings task only)
+bool settings_store_write(const uint8_t* buf, size_t len);
+
+// Where the block lives (for user info)
+const char* settings_store_location();
+
+// Path of the JSON import/export file (on the SPIFFS mount on ESP32)
+const char* settings_store_json_path();
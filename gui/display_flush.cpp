@@ -0,0 +1,101 @@
+// gui/display_flush.cpp - Asynchronous LVGL flush handshake
+// Platform-agnostic: the transport decides how pixels reach the panel
+
+#include "gui/display_flush.h"
+#include "gui/app_tasks.h"
+
+namespace {
+    // Waits shorter than this spin (with yields), longer ones sleep between polls
+    // so a long DMA band does not keep the GUI core busy
+    constexpr uint32_t FLUSH_SPIN_US = 200;
+
+    lv_display_t* flush_disp = nullptr;
+    const DisplayTransport* flush_transport = nullptr;
+
+    volatile bool in_flight = false;   // Transfer started, completion not yet signalled
+    bool bus_held = false;             // finish() still owed to the transport
+
+    DisplayFlushStats stats = {};
+
+    // Release the bus once the transfer is known to be complete (task context only)
+    void release_bus() {
+        if (bus_held) {
+            bus_held = false;
+            if (flush_transport->finish) flush_transport->finish();
+        }
+    }
+
+    // Wait until the transfer is done, polling the transport if it has no callback
+    void wait_in_flight() {
+        if (!in_flight) return;
+
+        uint32_t start = lv_tick_get();
+        uint32_t spin_start_us = app_time_us();
+        stats.waits++;
+        while (in_flight) {
+            if (flush_transport->is_done && flush_transport->is_done()) {
+                display_flush_complete();
+                break;
+            }
+            if (app_time_us() - spin_start_us < FLUSH_SPIN_US) {
+                app_task_yield();
+            } else {
+                app_task_delay_ms(1);
+            }
+        }
+        uint32_t waited = lv_tick_elaps(start);
+        if (waited > stats.max_wait_ms) stats.max_wait_ms = waited;
+    }
+
+    // LVGL flush callback: start the transfer and return immediately
+    void flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map) {
+        // Previous transfer may have completed from a callback without a wait
+        release_bus();
+
+        in_flight = true;
+        bus_held = true;
+        stats.flushes++;
+
+        uint32_t px_count = lv_area_get_width(area) * lv_area_get_height(area);
+        flush_transport->start(disp, area, px_map, px_count);
+    }
+
+    // LVGL flush-wait callback: only called when LVGL needs the buffer back
+    void flush_wait_cb(lv_display_t* disp) {
+        LV_UNUSED(disp);
+        wait_in_flight();
+        release_bus();
+    }
+}
+
+void display_flush_init(lv_display_t* disp, const DisplayTransport* transport) {
+    flush_disp = disp;
+    flush_transport = transport;
+    in_flight = false;
+    bus_held = false;
+    stats = {};
+
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_display_set_flush_wait_cb(disp, flush_wait_cb);
+}
+
+void display_flush_complete() {
+    if (!in_flight) return;
+    in_flight = false;
+    // Only clears LVGL's flushing flags - safe from the transfer-complete callback
+    lv_display_flush_ready(flush_disp);
+}
+
+bool display_flush_busy() {
+    return in_flight;
+}
+
+void display_flush_wait() {
+    if (!flush_transport) return;
+    wait_in_flight();
+    release_bus();
+}
+
+DisplayFlushStats display_flush_get_stats() {
+    return stats;
+}
@@ -0,0 +1,53 @@
+// gui/display_flush.h - Asynchronous LVGL flush handshake
+// Decouples LVGL's flush callback from the transport that moves pixels to the panel.
+//
+// LVGL renders into two draw buffers. The flush callback only *starts* a transfer
+// and returns, so LVGL can render the next band into the other buffer while the
+// previous one is still on the wire. The transport reports completion with
+// display_flush_complete() (transfer-complete callback or polled status);
+// LVGL only blocks in its flush-wait hook when it needs the buffer back.
+//
+// ESP32:     TFT_eSPI DMA transport (src/main.cpp)
+// Simulator: fake SDL transport with deferred completion (simulator/main.cpp)
+#pragma once
+
+#include "lvgl.h"
+#include <stdint.h>
+
+// Transport interface - implemented per platform
+struct DisplayTransport {
+    // Start transferring px_count RGB565 pixels for the area (must not block on completion)
+    void (*start)(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map, uint32_t px_count);
+
+    // Return true once the transfer started by start() has finished.
+    // Optional: transports that signal completion from a callback leave this nullptr.
+    bool (*is_done)();
+
+    // Optional: release the bus after a transfer (e.g. end SPI transaction).
+    // Always called from task context, never from the completion callback.
+    void (*finish)();
+};
+
+// Flush statistics (for profiling rendering throughput)
+struct DisplayFlushStats {
+    uint32_t flushes;       // Transfers started
+    uint32_t waits;         // Times LVGL had to wait for the previous transfer
+    uint32_t max_wait_ms;   // Longest single wait
+};
+
+// Install the flush + flush-wait callbacks on a display
+void display_flush_init(lv_display_t* disp, const DisplayTransport* transport);
+
+// Signal that the in-flight transfer has finished.
+// Safe to call from the transfer-complete ISR/callback; idempotent.
+void display_flush_complete();
+
+// True while a transfer is in flight
+bool display_flush_busy();
+
+// Block until the in-flight transfer (if any) has finished.
+// Call before sharing the bus with another device (e.g. touch controller on the same SPI).
+void display_flush_wait();
+
+// Read flush statistics
+DisplayFlushStats display_flush_get_stats();
@@ -18,6 +18,8 @@
 #include "gui/pages/page_settings.h"
 #include "gui/pages/page_about.h"
 #include "gui/pages/page_serial.h"
+#include "gui/pages/page_analyzer.h"
+#include "gui/pages/page_servo_test.h"
 
 // ============================================================================
 // Page Registry - Uniform lifecycle for all pages
@@ -33,6 +35,9 @@ struct PageEntry {
     const char*  (*subtitle)();                 // Optional: header subtitle (e.g., protocol)
     void         (*on_prev)();                  // Optional: custom prev button behavior
     void         (*on_next)();                  // Optional: custom next button behavior
+    bool           cacheable;                   // Keep widgets when left (see Page Cache)
+    void         (*on_show)();                  // Optional: cached page shown again
+    void         (*on_hide)();                  // Optional: cacheable page left (instead of stop)
 };
 
 // Get servo protocol name for header display
@@ -65,32 +70,41 @@ static void home_page_next() {
     }
 }
 
+// Servo tester <-> servo test sub-page
+static void servo_page_switch() {
+    gui_set_page(gui_get_current_page() == PAGE_SERVO ? PAGE_SERVO_TEST : PAGE_SERVO);
+}
+
 // Forward declarations for home page navigation
 static void home_page_prev();
 static void home_page_next();
 
 // Page registry - must match GuiPage enum order
 static const PageEntry PAGE_REGISTRY[PAGE_COUNT] = {
-    // PAGE_HOME - navigate between home pages
-    { STR_PAGE_HOME,       page_home_create,       page_home_destroy,       nullptr,                 nullptr,           nullptr,                    home_page_prev,  home_page_next },
-    // PAGE_HOME_2 - navigate between home pages
-    { STR_PAGE_HOME,       page_home2_create,      page_home2_destroy,      nullptr,                 nullptr,           nullptr,                    home_page_prev,  home_page_next },
-    // PAGE_SERVO - no prev/next navigation
-    { STR_PAGE_SERVO,      page_servo_create,      page_servo_destroy,      page_servo_is_running,   page_servo_stop,   get_servo_protocol_name,    nullptr,         nullptr },
+    // PAGE_HOME - navigate between home pages, cached
+    { STR_PAGE_HOME,       page_home_create,       page_home_destroy,       nullptr,                 nullptr,           nullptr,                    home_page_prev,  home_page_next, true,  nullptr, nullptr },
+    // PAGE_HOME_2 - navigate between home pages, cached
+    { STR_PAGE_HOME,       page_home2_create,      page_home2_destroy,      nullptr,                 nullptr,           nullptr,                    home_page_prev,  home_page_next, true,  nullptr, nullptr },
+    // PAGE_SERVO - prev/next switch to the servo test sub-page, cached (sweep stops on hide)
+    { STR_PAGE_SERVO,      page_servo_create,      page_servo_destroy,      page_servo_is_running,   page_servo_stop,   get_servo_protocol_name,    servo_page_switch, servo_page_switch, true,  page_servo_on_show, page_servo_on_hide },
     // PAGE_LIPO - no prev/next navigation
-    { STR_PAGE_LIPO,       page_lipo_create,       page_lipo_destroy,       nullptr,                 nullptr,           nullptr,                    nullptr,         nullptr },
+    { STR_PAGE_LIPO,       page_lipo_create,       page_lipo_destroy,       nullptr,                 nullptr,           nullptr,                    nullptr,         nullptr, false, nullptr, nullptr },
     // PAGE_CG_SCALE - no prev/next navigation
-    { STR_PAGE_CG_SCALE,   page_cg_scale_create,   page_cg_scale_destroy,   nullptr,                 nullptr,           nullptr,                    nullptr,         nullptr },
+    { STR_PAGE_CG_SCALE,   page_cg_scale_create,   page_cg_scale_destroy,   nullptr,                 nullptr,           nullptr,                    nullptr,         nullptr, false, nullptr, nullptr },
     // PAGE_DEFLECTION - no prev/next navigation
-    { STR_PAGE_DEFLECTION, page_deflection_create, page_deflection_destroy, nullptr,                 nullptr,           nullptr,                    nullptr,         nullptr },
+    { STR_PAGE_DEFLECTION, page_deflection_create, page_deflection_destroy, nullptr,                 nullptr,           nullptr,                    nullptr,         nullptr, false, nullptr, nullptr },
     // PAGE_ANGLE - no prev/next navigation
-    { STR_PAGE_ANGLE,      page_angle_create,      page_angle_destroy,      nullptr,                 nullptr,           nullptr,                    nullptr,         nullptr },
+    { STR_PAGE_ANGLE,      page_angle_create,      page_angle_destroy,      nullptr,                 nullptr,           nullptr,                    nullptr,         nullptr, false, nullptr, nullptr },
     // PAGE_SETTINGS - no prev/next navigation
-    { STR_PAGE_SETTINGS,   page_settings_create,   page_settings_destroy,   nullptr,                nullptr,           nullptr,                    nullptr,         nullptr },
+    { STR_PAGE_SETTINGS,   page_settings_create,   page_settings_destroy,   nullptr,                nullptr,           nullptr,                    nullptr,         nullptr, false, nullptr, nullptr },
     // PAGE_ABOUT - no prev/next navigation
-    { STR_PAGE_ABOUT,      page_about_create,      page_about_destroy,      nullptr,                 nullptr,           nullptr,                    nullptr,         nullptr },
+    { STR_PAGE_ABOUT,      page_about_create,      page_about_destroy,      nullptr,                 nullptr,           nullptr,                    nullptr,         nullptr, false, nullptr, nullptr },
     // PAGE_SERIAL - no prev/next navigation
-    { STR_PAGE_SERIAL,     page_serial_create,     page_serial_destroy,     nullptr,                 nullptr,           nullptr,                    nullptr,         nullptr },
+    { STR_PAGE_SERIAL,     page_serial_create,     page_serial_destroy,     nullptr,                 nullptr,           nullptr,                    nullptr,         nullptr, false, nullptr, nullptr },
+    // PAGE_ANALYZER - no prev/next navigation
+    { STR_PAGE_ANALYZER,   page_analyzer_create,   page_analyzer_destroy,   nullptr,                 nullptr,           nullptr,                    nullptr,         nullptr, false, nullptr, nullptr },
+    // PAGE_SERVO_TEST - prev/next back to the servo tester
+    { STR_PAGE_SERVO_TEST, page_servo_test_create, page_servo_test_destroy, page_servo_test_is_running, page_servo_test_stop, get_servo_protocol_name, servo_page_switch, servo_page_switch, false, nullptr, nullptr },
 };
 
 // ============================================================================
@@ -113,6 +127,81 @@ static GuiPage active_page = PAGE_COUNT; // sentinel so first gui_set_page runs
 static bool splash_shown = false;
 static BgColorPreset active_bg_color = BG_COLOR_WHITE;
 
+// ============================================================================
+// Page Cache
+// ============================================================================
+// Cacheable pages are hidden instead of destroyed when left (on_hide instead
+// of stop + destroy) and shown again on return (on_show instead of create).
+// Hidden pages are destroyed least recently used first while more than
+// PAGE_CACHE_MAX are kept or the LVGL heap is above PAGE_CACHE_HEAP_PCT.
+
+// Below the number of cacheable pages (Home, Home2, Servo), so leaving all three
+// for a tool page drops the least recently used one
+constexpr int PAGE_CACHE_MAX = 2;
+constexpr uint8_t PAGE_CACHE_HEAP_PCT = 60;
+
+struct PageSlot {
+    lv_obj_t* root;                 // Page container in content (nullptr: not created)
+    FocusOrderBuilder* focus;       // Page focus builder while hidden
+    uint32_t last_used;             // LRU stamp
+};
+
+static PageSlot page_slots[PAGE_COUNT] = {};
+static uint32_t page_use_count = 0;
+
+static bool lvgl_heap_high() {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size > 0 && mon.used_pct >= PAGE_CACHE_HEAP_PCT;
+}
+
+// Container a page is built into (one per page, so it can be kept hidden)
+static lv_obj_t* create_page_root() {
+    lv_obj_t* root = lv_obj_create(content);
+    lv_obj_set_size(root, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_style_bg_opa(root, LV_OPA_TRANSP, 0);  // Background color stays on content
+    lv_obj_set_style_border_width(root, 0, 0);
+    lv_obj_set_style_radius(root, 0, 0);
+    lv_obj_set_style_pad_all(root, 0, 0);
+    lv_obj_set_style_pad_row(root, 0, 0);
+    lv_obj_set_style_pad_column(root, 0, 0);
+    lv_obj_set_flex_flow(root, LV_FLEX_FLOW_COLUMN);  // Default, pages can override
+    lv_obj_set_flex_align(root, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
+    lv_obj_set_scrollbar_mode(root, LV_SCROLLBAR_MODE_OFF);
+    lv_obj_clear_flag(root, LV_OBJ_FLAG_SCROLLABLE);
+    return root;
+}
+
+// Stop and destroy a page, delete its widgets
+static void page_close(GuiPage p) {
+    const PageEntry& entry = PAGE_REGISTRY[p];
+    if (entry.stop) entry.stop();       // Graceful stop first
+    if (entry.destroy) entry.destroy(); // Then cleanup
+    if (page_slots[p].root) lv_obj_delete(page_slots[p].root);
+    page_slots[p] = PageSlot{};
+}
+
+// Destroy hidden pages (least recently used first) until the cache fits
+static void page_cache_trim() {
+    for (;;) {
+        int lru = -1;
+        int cached = 0;
+        for (int p = 0; p < PAGE_COUNT; p++) {
+            if (p == active_page || !page_slots[p].root) continue;
+            cached++;
+            if (lru < 0 || page_slots[p].last_used < page_slots[lru].last_used) lru = p;
+        }
+        if (lru < 0 || (cached <= PAGE_CACHE_MAX && !lvgl_heap_high())) return;
+        page_close((GuiPage)lru);
+    }
+}
+
+void gui_page_cache_clear() {
+    for (int p = 0; p < PAGE_COUNT; p++) {
+        if (p != active_page && page_slots[p].root) page_close((GuiPage)p);
+    }
+}
+
 // Check if current page is busy (blocks navigation)
 static bool gui_page_is_busy() {
     if (active_page < PAGE_COUNT && PAGE_REGISTRY[active_page].is_busy) {
@@ -303,11 +392,21 @@ void gui_set_page(GuiPage p)
 {
     if (p >= PAGE_COUNT) return;
 
-    // Clean up previous page using registry
+    // Leave the previous page: keep it hidden if cacheable, else destroy it
     if (active_page < PAGE_COUNT) {
         const PageEntry& prev = PAGE_REGISTRY[active_page];
-        if (prev.stop) prev.stop();       // Graceful stop first
-        if (prev.destroy) prev.destroy(); // Then cleanup
+        PageSlot& slot = page_slots[active_page];
+        if (prev.cacheable && p != active_page) {
+            if (prev.on_hide) prev.on_hide();
+            slot.focus = input_get_active_focus_builder();
+            if (slot.focus) slot.focus->suspend();
+            lv_obj_add_flag(slot.root, LV_OBJ_FLAG_HIDDEN);
+            slot.last_used = ++page_use_count;
+        } else {
+            page_close(active_page);    // Also when re-entering the same page (refresh)
+        }
+    } else {
+        lv_obj_clean(content);          // Splash
     }
 
     active_page = p;
@@ -321,19 +420,23 @@ void gui_set_page(GuiPage p)
         lv_label_set_text(header_subtitle, "");
     }
 
-    // Clean content and reset its layout state
-    lv_obj_clean(content);
-    lv_obj_set_style_pad_all(content, 0, 0);
-    lv_obj_set_style_pad_row(content, 0, 0);
-    lv_obj_set_style_pad_column(content, 0, 0);
-    lv_obj_set_flex_flow(content, LV_FLEX_FLOW_COLUMN);  // Default, pages can override
-    lv_obj_set_flex_align(content, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
-    lv_obj_set_scrollbar_mode(content, LV_SCROLLBAR_MODE_OFF);
-    lv_obj_clear_flag(content, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_scroll_to(content, 0, 0, LV_ANIM_OFF);  // Reset scroll position
+    // Make room before showing or building the page
+    page_cache_trim();
+
+    PageSlot& slot = page_slots[p];
+    if (slot.root) {
+        // Cached: show it again as it was left
+        lv_obj_clear_flag(slot.root, LV_OBJ_FLAG_HIDDEN);
+        input_push_page(p);
+        if (slot.focus) slot.focus->finalize();
+        slot.focus = nullptr;
+        if (curr.on_show) curr.on_show();
+        return;
+    }
 
     // Create new page
-    curr.create(content);
+    slot.root = create_page_root();
+    curr.create(slot.root);
 }
 
 static void btn_home_event_cb(lv_event_t *e)
@@ -13,6 +13,8 @@ enum GuiPage {
     PAGE_SETTINGS,
     PAGE_ABOUT,
     PAGE_SERIAL,
+    PAGE_ANALYZER,
+    PAGE_SERVO_TEST,
     PAGE_COUNT
 };
 
@@ -40,3 +42,6 @@ lv_obj_t* gui_get_btn_settings();
 
 // Navigation
 void gui_go_back();  // Go to previous page in history
+
+// Destroy the pages kept hidden by the page cache (e.g. after a language change)
+void gui_page_cache_clear();
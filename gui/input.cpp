@@ -604,16 +604,24 @@ void FocusOrderBuilder::apply_focus_style(lv_obj_t* widget) {
     #endif
 }
 
-void FocusOrderBuilder::destroy() {
-    // Clear focus from current widget before destroying
+void FocusOrderBuilder::suspend() {
+    // Clear focus from current widget (footer buttons are shared with the next page)
     if (current_focus >= 0 && current_focus < count && widgets[current_focus] != nullptr) {
         lv_obj_clear_state(widgets[current_focus], LV_STATE_FOCUSED);
+        lv_obj_clear_state(widgets[current_focus], LV_STATE_EDITED);
     }
+    edit_mode = false;
 
     // Clear active builder if it's us
     if (active_focus_builder == this) {
         active_focus_builder = nullptr;
     }
+}
+
+void FocusOrderBuilder::destroy() {
+    // Clear focus and deactivate before destroying (a suspended builder already
+    // did: its last widget may be a footer button focused by the current page)
+    if (active_focus_builder == this) suspend();
     if (group) {
         lv_group_delete(group);
         group = nullptr;
@@ -28,7 +28,7 @@ enum InputEvent {
 // Focus Order Helper
 // =============================================================================
 // Maximum widgets per page that can be in focus order
-constexpr int MAX_FOCUS_WIDGETS = 30;
+constexpr int MAX_FOCUS_WIDGETS = 32;
 
 // Focus color (green) - use this in pages for consistent styling
 constexpr uint32_t FOCUS_COLOR_HEX = 0x00AA00;
@@ -100,6 +100,10 @@ struct FocusOrderBuilder {
     // Apply focus style to a widget (green outline)
     static void apply_focus_style(lv_obj_t* widget);
 
+    // Page hidden but kept (page cache): clear focus, stop receiving input.
+    // finalize() makes it active again when the page is shown
+    void suspend();
+
     // Cleanup
     void destroy();
 };
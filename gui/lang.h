@@ -35,6 +35,8 @@ enum StringId {
     STR_PAGE_SETTINGS,
     STR_PAGE_ABOUT,
     STR_PAGE_SERIAL,
+    STR_PAGE_ANALYZER,
+    STR_PAGE_SERVO_TEST,
 
     // Home buttons
     STR_BTN_SERVO,
@@ -43,6 +45,7 @@ enum StringId {
     STR_BTN_DEFLECTION,
     STR_BTN_ANGLE,
     STR_BTN_ABOUT,
+    STR_BTN_ANALYZER,
     STR_BTN_HOME,
 
     // About page
@@ -67,6 +70,14 @@ enum StringId {
     STR_SETTINGS_SERVO_STEP,      // "Step Servo X"
     STR_SETTINGS_SERVO_RESET,     // "Reset Servos"
     STR_SETTINGS_SERVO_STEP_US,   // "X µs" format
+    STR_SETTINGS_SWEEP_PROFILE,
+    STR_SETTINGS_SWEEP_DWELL,
+    STR_SETTINGS_CG_SCALE,
+    STR_SETTINGS_CG_LE_OFFSET,  // "LE stop -> front supports"
+    STR_SETTINGS_CG_DISTANCE,  // "Front -> rear support"
+    STR_SETTINGS_CG_REF_MASS,
+    STR_SETTINGS_DEFLECTION,
+    STR_SETTINGS_DEFL_CHORD,  // "Hinge line -> trailing edge"
 
     // Page content placeholders
     STR_SERVO_CONTENT,
@@ -85,6 +96,61 @@ enum StringId {
     STR_SERVO_SPEED,
     STR_SERVO_US,
 
+    // Signal analyzer page
+    STR_ANALYZER_JITTER,
+    STR_ANALYZER_NO_SIGNAL,
+    STR_ANALYZER_RESET,  // "Reset min/max"
+    STR_ANALYZER_LOST,
+    STR_ANALYZER_FAILSAFE,
+    STR_ANALYZER_ERRORS,
+
+    // Servo test page
+    STR_SERVO_TEST_DEAD_TIME,
+    STR_SERVO_TEST_RISE,
+    STR_SERVO_TEST_SLEW,
+    STR_SERVO_TEST_OVERSHOOT,
+    STR_SERVO_TEST_DEADBAND,
+    STR_SERVO_TEST_MEASURING,
+    STR_SERVO_TEST_NO_RESPONSE,
+    STR_SERVO_TEST_ADC_FAILED,
+    STR_SERVO_TEST_EXPORT,  // "Export CSV"
+
+    // LiPo checker page
+    STR_LIPO_CELL,
+    STR_LIPO_TOTAL,
+    STR_LIPO_NO_BATTERY,
+    STR_LIPO_UNCALIBRATED,
+    STR_LIPO_IMPLAUSIBLE,
+    STR_LIPO_MEASURE_IR,
+    STR_LIPO_CONFIDENCE,
+    STR_LIPO_IR_FAILED,
+
+    // CG scale page
+    STR_CG_SUPPORT,
+    STR_CG_TOTAL,
+    STR_CG_TARE,
+    STR_CG_CALIBRATE,
+    STR_CG_NEXT,
+    STR_CG_CAL_EMPTY,
+    STR_CG_CAL_PLACE,  // "Place reference on" + support and mass
+    STR_CG_HOLD_STILL,
+    STR_CG_NO_SENSOR,
+    STR_CG_UNCALIBRATED,
+    STR_CG_POSITION,  // "CG" position row
+
+    // Angle / deflection pages
+    STR_ANGLE_PITCH,
+    STR_ANGLE_ROLL,
+    STR_DEFLECTION_ANGLE,
+    STR_IMU_ZERO,
+    STR_IMU_ABSOLUTE,
+    STR_IMU_RELATIVE,
+    STR_IMU_NO_SENSOR,
+    STR_DEFL_TRAVEL,  // "Travel" at the trailing edge (mm)
+    STR_DEFL_TWO_SENSORS,
+    STR_DEFL_ONE_SENSOR,
+    STR_DEFL_ZERO_RANGE,  // Zero offset beyond +-90 deg (not stored)
+
     // Background color options
     STR_BG_LIGHT_GRAY,
     STR_BG_WHITE,
@@ -94,7 +160,10 @@ enum StringId {
 
     // Frequency options
     STR_FREQ_50HZ,
+    STR_FREQ_100HZ,
+    STR_FREQ_200HZ,
     STR_FREQ_333HZ,
+    STR_FREQ_400HZ,
 
     STR_COUNT
 };
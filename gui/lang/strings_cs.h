@@ -22,6 +22,8 @@ static const char* strings_cs[STR_COUNT] = {
     "Úhel Náběhu",
     "Nastavení",
     "O aplikaci",    "Sériový Monitor",
+    "Analyzátor signálu",
+    "Test serva",
     // Home buttons
     "Tester Serv",
     "Kontrola Lipo",
@@ -29,6 +31,7 @@ static const char* strings_cs[STR_COUNT] = {
     "Výchylka",
     "Úhel\nNáběhu",
     "O aplikaci",
+    "Analyzátor\nsignálu",
     "DOMŮ",
 
     // About page
@@ -53,6 +56,14 @@ static const char* strings_cs[STR_COUNT] = {
     "Krok servo",
     "Reset serv",
     "µs",
+    "Profil pohybu",
+    "Prodleva",
+    "Váha těžiště",
+    "Odsazení NH",
+    "Rozteč podpěr",
+    "Ref. hmotnost",
+    "Výchylka",
+    "Hloubka kormidla",
 
     // Page content placeholders
     "Tester Serv",
@@ -71,6 +82,61 @@ static const char* strings_cs[STR_COUNT] = {
     "Rychlost",
     "µs",
 
+    // Signal analyzer page
+    "Jitter",
+    "Žádný signál",
+    "Vynulovat",
+    "Ztraceno",
+    "Failsafe",
+    "Chyby",
+
+    // Servo test page
+    "Mrtvá doba",
+    "Doba náběhu",
+    "Rychlost",
+    "Překmit",
+    "Pásmo necitlivosti",
+    "Měření",
+    "Bez odezvy",
+    "Chyba ADC",
+    "Export CSV",
+
+    // LiPo checker page
+    "Článek",
+    "Celkem",
+    "Bez baterie",
+    "ADC nekalibrován",
+    "Zkontrolujte balanční konektor",
+    "Měřit IR",
+    "Spolehlivost",
+    "Měření IR selhalo",
+
+    // CG scale page
+    "Podpěra",
+    "Celkem",
+    "Tára",
+    "Kalibrovat",
+    "Další",
+    "Odstraňte veškerou zátěž",
+    "Položte referenci na",
+    "Držte v klidu...",
+    "Žádný tenzometr",
+    "Nekalibrováno",
+    "Těžiště",
+
+    // Angle / deflection pages
+    "Klopení",
+    "Klonění",
+    "Výchylka",
+    "Nulovat",
+    "Absolutní",
+    "Relativně k nule",
+    "Žádná IMU - zkontrolujte I2C",
+    "Zdvih",
+    "2 senzory",
+    "1 senzor",
+    "Nula > 90 deg",
+
     // Background color options
     "Světle šedá",
     "Bílá",
@@ -80,5 +146,8 @@ static const char* strings_cs[STR_COUNT] = {
 
     // Frequency options
     "50 Hz",
-    "333 Hz"
+    "100 Hz",
+    "200 Hz",
+    "333 Hz",
+    "400 Hz"
 };
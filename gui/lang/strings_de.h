@@ -23,6 +23,8 @@ static const char* strings_de[STR_COUNT] = {
     "Einstellungen",
     "Über",
     "Serieller Monitor",
+    "Signal-Analyse",
+    "Servo-Test",
 
     // Home buttons
     "Servo Tester",
@@ -31,6 +33,7 @@ static const char* strings_de[STR_COUNT] = {
     "Ruderweg Messung",
     "EDW Messung",
     "Über",
+    "Signal-\nAnalyse",
     "HOME",
 
     // About page
@@ -55,6 +58,14 @@ static const char* strings_de[STR_COUNT] = {
     "Schritt Servo",
     "Servos zurücksetzen",
     "µs",
+    "Sweep-Profil",
+    "Haltezeit",
+    "Schwerpunktwaage",
+    "Nasenleiste",
+    "Auflagenabst.",
+    "Referenzmasse",
+    "Ruderausschlag",
+    "Rudertiefe",
 
     // Page content placeholders
     "Servo-Tester",
@@ -73,6 +84,61 @@ static const char* strings_de[STR_COUNT] = {
     "Tempo",
     "µs",
 
+    // Signal analyzer page
+    "Jitter",
+    "Kein Signal",
+    "Zurücksetzen",
+    "Verloren",
+    "Failsafe",
+    "Fehler",
+
+    // Servo test page
+    "Totzeit",
+    "Anstiegszeit",
+    "Stellrate",
+    "Überschwingen",
+    "Totband",
+    "Messung läuft",
+    "Keine Reaktion",
+    "ADC-Fehler",
+    "CSV-Export",
+
+    // LiPo checker page
+    "Zelle",
+    "Gesamt",
+    "Kein Akku",
+    "ADC nicht kalibriert",
+    "Balancerstecker prüfen",
+    "IR messen",
+    "Vertrauen",
+    "IR-Messung fehlgeschlagen",
+
+    // CG scale page
+    "Auflage",
+    "Gesamt",
+    "Tara",
+    "Kalibrieren",
+    "Weiter",
+    "Alle Lasten entfernen",
+    "Referenz auflegen:",
+    "Ruhig halten...",
+    "Keine Wägezelle gefunden",
+    "Nicht kalibriert",
+    "SP",
+
+    // Angle / deflection pages
+    "Nick",
+    "Roll",
+    "Ausschlag",
+    "Nullen",
+    "Absolut",
+    "Relativ zur Nullung",
+    "Kein IMU - I2C prüfen",
+    "Weg",
+    "2 Sensoren",
+    "1 Sensor",
+    "Nullpunkt > 90 deg",
+
     // Background color options
     "Hellgrau",
     "Weiß",
@@ -82,5 +148,8 @@ static const char* strings_de[STR_COUNT] = {
 
     // Frequency options
     "50 Hz",
-    "333 Hz"
+    "100 Hz",
+    "200 Hz",
+    "333 Hz",
+    "400 Hz"
 };
@@ -23,6 +23,8 @@ static const char* strings_en[STR_COUNT] = {
     "Settings",
     "About",
     "Serial Monitor",
+    "Signal Analyzer",
+    "Servo Test",
 
     // Home buttons
     "Servo Tester",
@@ -31,6 +33,7 @@ static const char* strings_en[STR_COUNT] = {
     "Flap\nDeflection",
     "Angle of\nIncidence",
     "About",
+    "Signal\nAnalyzer",
     "HOME",
 
     // About page
@@ -55,6 +58,14 @@ static const char* strings_en[STR_COUNT] = {
     "Step Servo",
     "Reset Servos",
     "µs",
+    "Sweep Profile",
+    "Sweep Dwell",
+    "CG Scale",
+    "LE Offset",
+    "Support Dist.",
+    "Ref. Mass",
+    "Deflection",
+    "Surface chord",
 
     // Page content placeholders
     "Servo Tester",
@@ -73,6 +84,61 @@ static const char* strings_en[STR_COUNT] = {
     "Speed",
     "µs",
 
+    // Signal analyzer page
+    "Jitter",
+    "No signal",
+    "Reset",
+    "Lost",
+    "Failsafe",
+    "Errors",
+
+    // Servo test page
+    "Dead time",
+    "Rise time",
+    "Slew rate",
+    "Overshoot",
+    "Deadband",
+    "Measuring",
+    "No response",
+    "ADC error",
+    "Export CSV",
+
+    // LiPo checker page
+    "Cell",
+    "Total",
+    "No battery",
+    "ADC not calibrated",
+    "Check balancer plug",
+    "Measure IR",
+    "Confidence",
+    "IR measurement failed",
+
+    // CG scale page
+    "Support",
+    "Total",
+    "Tare",
+    "Calibrate",
+    "Next",
+    "Remove all weight",
+    "Place reference on",
+    "Hold still...",
+    "No load cell found",
+    "Not calibrated",
+    "CG",
+
+    // Angle / deflection pages
+    "Pitch",
+    "Roll",
+    "Deflection",
+    "Zero",
+    "Absolute",
+    "Relative to zero",
+    "No IMU - check I2C",
+    "Travel",
+    "2 sensors",
+    "1 sensor",
+    "Zero > 90 deg",
+
     // Background color options
     "Light Gray",
     "White",
@@ -82,5 +148,8 @@ static const char* strings_en[STR_COUNT] = {
 
     // Frequency options
     "50 Hz",
-    "333 Hz"
+    "100 Hz",
+    "200 Hz",
+    "333 Hz",
+    "400 Hz"
 };
@@ -23,6 +23,8 @@ static const char* strings_es[STR_COUNT] = {
     "Ajustes",
     "Acerca de",
     "Monitor Serie",
+    "Analizador señal",
+    "Prueba servo",
 
     // Home buttons
     "Probador de Servo",
@@ -31,6 +33,7 @@ static const char* strings_es[STR_COUNT] = {
     "Deflexión",
     "Ángulo de\nIncidencia",
     "Acerca de",
+    "Analizador\nseñal",
     "INICIO",
 
     // About page
@@ -55,6 +58,14 @@ static const char* strings_es[STR_COUNT] = {
     "Paso Servo",
     "Resetear servos",
     "µs",
+    "Perfil barrido",
+    "Pausa extremos",
+    "Balanza CG",
+    "Desfase BA",
+    "Dist. apoyos",
+    "Masa ref.",
+    "Deflexión",
+    "Cuerda superficie",
 
     // Page content placeholders
     "Probador de Servo",
@@ -73,6 +84,61 @@ static const char* strings_es[STR_COUNT] = {
     "Velocidad",
     "µs",
 
+    // Signal analyzer page
+    "Jitter",
+    "Sin señal",
+    "Reiniciar",
+    "Perdidas",
+    "Failsafe",
+    "Errores",
+
+    // Servo test page
+    "Tiempo muerto",
+    "Tiempo subida",
+    "Velocidad",
+    "Sobreimpulso",
+    "Banda muerta",
+    "Midiendo",
+    "Sin respuesta",
+    "Error ADC",
+    "Exportar CSV",
+
+    // LiPo checker page
+    "Celda",
+    "Total",
+    "Sin batería",
+    "ADC sin calibrar",
+    "Revisar conector balanceador",
+    "Medir RI",
+    "Confianza",
+    "Fallo al medir RI",
+
+    // CG scale page
+    "Apoyo",
+    "Total",
+    "Tara",
+    "Calibrar",
+    "Siguiente",
+    "Retirar todo el peso",
+    "Colocar referencia en",
+    "Mantener quieto...",
+    "Sin célula de carga",
+    "Sin calibrar",
+    "CG",
+
+    // Angle / deflection pages
+    "Cabeceo",
+    "Alabeo",
+    "Deflexión",
+    "Cero",
+    "Absoluto",
+    "Relativo al cero",
+    "Sin IMU - revisar I2C",
+    "Recorrido",
+    "2 sensores",
+    "1 sensor",
+    "Cero > 90 deg",
+
     // Background color options
     "Gris claro",
     "Blanco",
@@ -82,5 +148,8 @@ static const char* strings_es[STR_COUNT] = {
 
     // Frequency options
     "50 Hz",
-    "333 Hz"
+    "100 Hz",
+    "200 Hz",
+    "333 Hz",
+    "400 Hz"
 };
@@ -23,6 +23,8 @@ static const char* strings_fr[STR_COUNT] = {
     "Paramètres",
     "À propos",
     "Moniteur Série",
+    "Analyseur signal",
+    "Test servo",
 
     // Home buttons
     "Testeur de Servo",
@@ -31,6 +33,7 @@ static const char* strings_fr[STR_COUNT] = {
     "Débatte-\nment",
     "Angle\nd'Incidence",
     "À propos",
+    "Analyseur\nsignal",
     "ACCUEIL",
 
     // About page
@@ -55,6 +58,14 @@ static const char* strings_fr[STR_COUNT] = {
     "Pas Servo",
     "Réinit. servos",
     "µs",
+    "Profil balayage",
+    "Temps d'arrêt",
+    "Balance CG",
+    "Décalage BA",
+    "Dist. appuis",
+    "Masse réf.",
+    "Débattement",
+    "Profondeur gouverne",
 
     // Page content placeholders
     "Testeur de Servo",
@@ -73,6 +84,61 @@ static const char* strings_fr[STR_COUNT] = {
     "Vitesse",
     "µs",
 
+    // Signal analyzer page
+    "Gigue",
+    "Pas de signal",
+    "Réinit.",
+    "Perdues",
+    "Failsafe",
+    "Erreurs",
+
+    // Servo test page
+    "Temps mort",
+    "Temps de montée",
+    "Vitesse",
+    "Dépassement",
+    "Zone morte",
+    "Mesure",
+    "Pas de réponse",
+    "Erreur ADC",
+    "Export CSV",
+
+    // LiPo checker page
+    "Cellule",
+    "Total",
+    "Pas de batterie",
+    "ADC non calibré",
+    "Vérifier la prise d'équilibrage",
+    "Mesurer RI",
+    "Confiance",
+    "Échec mesure RI",
+
+    // CG scale page
+    "Appui",
+    "Total",
+    "Tare",
+    "Calibrer",
+    "Suivant",
+    "Retirer toute charge",
+    "Poser la référence sur",
+    "Ne pas bouger...",
+    "Aucun capteur de force",
+    "Non calibré",
+    "CG",
+
+    // Angle / deflection pages
+    "Tangage",
+    "Roulis",
+    "Débattement",
+    "Zéro",
+    "Absolu",
+    "Relatif au zéro",
+    "Pas d'IMU - vérifier I2C",
+    "Course",
+    "2 capteurs",
+    "1 capteur",
+    "Zéro > 90 deg",
+
     // Background color options
     "Gris clair",
     "Blanc",
@@ -82,5 +148,8 @@ static const char* strings_fr[STR_COUNT] = {
 
     // Frequency options
     "50 Hz",
-    "333 Hz"
+    "100 Hz",
+    "200 Hz",
+    "333 Hz",
+    "400 Hz"
 };
@@ -23,6 +23,8 @@ static const char* strings_it[STR_COUNT] = {
     "Impostazioni",
     "Info",
     "Monitor Seriale",
+    "Analizzatore segnale",
+    "Test servo",
 
     // Home buttons
     "Tester Servo",
@@ -31,6 +33,7 @@ static const char* strings_it[STR_COUNT] = {
     "Defles-\nsione",
     "Angolo di\nIncidenza",
     "Info",
+    "Analizzatore\nsegnale",
     "HOME",
 
     // About page
@@ -55,6 +58,14 @@ static const char* strings_it[STR_COUNT] = {
     "Passo Servo",
     "Reset servos",
     "µs",
+    "Profilo sweep",
+    "Pausa estremi",
+    "Bilancia CG",
+    "Offset BA",
+    "Dist. appoggi",
+    "Massa rif.",
+    "Escursione",
+    "Corda superficie",
 
     // Page content placeholders
     "Tester Servo",
@@ -73,6 +84,61 @@ static const char* strings_it[STR_COUNT] = {
     "Velocità",
     "µs",
 
+    // Signal analyzer page
+    "Jitter",
+    "Nessun segnale",
+    "Azzera",
+    "Persi",
+    "Failsafe",
+    "Errori",
+
+    // Servo test page
+    "Tempo morto",
+    "Tempo salita",
+    "Velocità",
+    "Sovraelongazione",
+    "Banda morta",
+    "Misura",
+    "Nessuna risposta",
+    "Errore ADC",
+    "Esporta CSV",
+
+    // LiPo checker page
+    "Cella",
+    "Totale",
+    "Nessuna batteria",
+    "ADC non calibrato",
+    "Controllare connettore bilanciatore",
+    "Misura RI",
+    "Affidabilità",
+    "Misura RI fallita",
+
+    // CG scale page
+    "Appoggio",
+    "Totale",
+    "Tara",
+    "Calibra",
+    "Avanti",
+    "Rimuovere ogni peso",
+    "Posare riferimento su",
+    "Tenere fermo...",
+    "Nessuna cella di carico",
+    "Non calibrato",
+    "CG",
+
+    // Angle / deflection pages
+    "Beccheggio",
+    "Rollio",
+    "Escursione",
+    "Zero",
+    "Assoluto",
+    "Relativo allo zero",
+    "Nessuna IMU - controllare I2C",
+    "Corsa",
+    "2 sensori",
+    "1 sensore",
+    "Zero > 90 deg",
+
     // Background color options
     "Grigio chiaro",
     "Bianco",
@@ -82,5 +148,8 @@ static const char* strings_it[STR_COUNT] = {
 
     // Frequency options
     "50 Hz",
-    "333 Hz"
+    "100 Hz",
+    "200 Hz",
+    "333 Hz",
+    "400 Hz"
 };
@@ -22,6 +22,8 @@ static const char* strings_nl[STR_COUNT] = {
     "Invalshoek",
     "Instellingen",
     "Over",    "Seriële Monitor",
+    "Signaalanalyse",
+    "Servotest",
     // Home buttons
     "Servo Tester",
     "Lipo Checker",
@@ -29,6 +31,7 @@ static const char* strings_nl[STR_COUNT] = {
     "Klep-\nuitslag",
     "Invals-\nhoek",
     "Over",
+    "Signaal-\nanalyse",
     "HOME",
 
     // About page
@@ -53,6 +56,14 @@ static const char* strings_nl[STR_COUNT] = {
     "Stap Servo",
     "Reset servo's",
     "µs",
+    "Sweep-profiel",
+    "Wachttijd",
+    "Zwaartepuntweegschaal",
+    "Neuslijst",
+    "Steunafstand",
+    "Ref. massa",
+    "Uitslag",
+    "Roerdiepte",
 
     // Page content placeholders
     "Servo Tester",
@@ -71,6 +82,61 @@ static const char* strings_nl[STR_COUNT] = {
     "Snelheid",
     "µs",
 
+    // Signal analyzer page
+    "Jitter",
+    "Geen signaal",
+    "Reset",
+    "Verloren",
+    "Failsafe",
+    "Fouten",
+
+    // Servo test page
+    "Dode tijd",
+    "Stijgtijd",
+    "Snelheid",
+    "Doorschot",
+    "Dode band",
+    "Meten",
+    "Geen reactie",
+    "ADC-fout",
+    "CSV export",
+
+    // LiPo checker page
+    "Cel",
+    "Totaal",
+    "Geen accu",
+    "ADC niet gekalibreerd",
+    "Balancerstekker controleren",
+    "IR meten",
+    "Betrouwbaarheid",
+    "IR-meting mislukt",
+
+    // CG scale page
+    "Steunpunt",
+    "Totaal",
+    "Tarra",
+    "Kalibreren",
+    "Volgende",
+    "Alle gewicht verwijderen",
+    "Referentie plaatsen op",
+    "Stil houden...",
+    "Geen weegcel gevonden",
+    "Niet gekalibreerd",
+    "ZP",
+
+    // Angle / deflection pages
+    "Stampen",
+    "Rollen",
+    "Uitslag",
+    "Nul",
+    "Absoluut",
+    "Relatief t.o.v. nul",
+    "Geen IMU - I2C controleren",
+    "Slag",
+    "2 sensoren",
+    "1 sensor",
+    "Nulpunt > 90 deg",
+
     // Background color options
     "Lichtgrijs",
     "Wit",
@@ -80,5 +146,8 @@ static const char* strings_nl[STR_COUNT] = {
 
     // Frequency options
     "50 Hz",
-    "333 Hz"
+    "100 Hz",
+    "200 Hz",
+    "333 Hz",
+    "400 Hz"
 };
@@ -0,0 +1,82 @@
+// gui/log_ring.h - Byte-packed ring buffer of text lines
+// Each line is stored as [length byte][characters] with no padding, so short
+// messages don't waste a fixed-size slot. When full, the oldest lines are dropped.
+// Lines are numbered with a running sequence number so a view can ask for
+// "everything after the last line I showed".
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+template <size_t CAPACITY>
+class LogRing {
+    static_assert(CAPACITY > 256, "LogRing capacity must hold at least one full line");
+
+public:
+    static constexpr size_t MAX_LINE_LEN = 255;   // Longer lines are truncated
+
+    // Append a line (no trailing newline expected)
+    void push(const char* msg) {
+        size_t len = strnlen(msg, MAX_LINE_LEN);
+        while (CAPACITY - used_ < len + 1) drop_oldest();
+
+        put(static_cast<uint8_t>(len));
+        for (size_t i = 0; i < len; i++) put(static_cast<uint8_t>(msg[i]));
+        next_seq_++;
+    }
+
+    void clear() {
+        head_ = tail_ = used_ = 0;
+        first_seq_ = next_seq_;
+    }
+
+    // Sequence number of the oldest stored line / the next line to be pushed
+    uint32_t first_seq() const { return first_seq_; }
+    uint32_t next_seq() const { return next_seq_; }
+    size_t line_count() const { return next_seq_ - first_seq_; }
+
+    // Call fn(text, len) for every stored line with sequence >= seq (oldest first).
+    // text is NUL-terminated and only valid during the call.
+    template <typename Fn>
+    void for_each_since(uint32_t seq, Fn fn) const {
+        char line[MAX_LINE_LEN + 1];
+        size_t pos = tail_;
+        for (uint32_t s = first_seq_; s != next_seq_; s++) {
+            size_t len = buf_[pos];
+            pos = (pos + 1) % CAPACITY;
+            if (static_cast<int32_t>(s - seq) < 0) {
+                pos = (pos + len) % CAPACITY;   // Skip already-seen line
+                continue;
+            }
+            for (size_t i = 0; i < len; i++) {
+                line[i] = static_cast<char>(buf_[pos]);
+                pos = (pos + 1) % CAPACITY;
+            }
+            line[len] = '\0';
+            fn(line, len);
+        }
+    }
+
+private:
+    void put(uint8_t b) {
+        buf_[head_] = b;
+        head_ = (head_ + 1) % CAPACITY;
+        used_++;
+    }
+
+    void drop_oldest() {
+        size_t len = buf_[tail_];
+        tail_ = (tail_ + len + 1) % CAPACITY;
+        used_ -= len + 1;
+        first_seq_++;
+    }
+
+    uint8_t buf_[CAPACITY];
+    size_t head_ = 0;       // Next write position
+    size_t tail_ = 0;       // Start of oldest line
+    size_t used_ = 0;       // Bytes in use
+    uint32_t first_seq_ = 0;
+    uint32_t next_seq_ = 0;
+};
@@ -0,0 +1,333 @@
+// gui/pages/page_analyzer.cpp - Servo signal analyzer
+// Measures receiver / servo tester signals on the servo header (src/servo_capture.cpp):
+// pulse width, frame rate, min/max since reset and pulse width jitter per channel.
+// Bus modes decode a PPM/SBUS/iBUS receiver on servo header 1 and show all
+// channels plus link statistics. The servo outputs are released while this page is open.
+
+#include "lvgl.h"
+#include "gui/fonts.h"
+#include "gui/color_palette.h"
+#include "gui/lang.h"
+#include "gui/input.h"
+#include "gui/gui.h"
+#include "servo_capture.h"
+#include <cstdio>
+#include <cstring>
+
+// =============================================================================
+// Focus Order Configuration
+// =============================================================================
+enum FocusOrder {
+    FO_BTN_MODE     = 0,
+    FO_BTN_RESET    = 1,
+    FO_BTN_HOME     = 2,
+    FO_BTN_PREV     = 3,
+    FO_BTN_NEXT     = 4,
+    FO_BTN_SETTINGS = 5,
+};
+
+// Focus group builder for this page
+static FocusOrderBuilder focus_builder;
+
+// =============================================================================
+// Layout
+// =============================================================================
+static constexpr uint32_t REFRESH_MS = CAPTURE_REPORT_MS;
+static constexpr lv_coord_t ROW_H = 17;
+
+// Column widths: Ch | µs | Hz | Min | Max | Jitter (ns)
+enum Column { COL_CH = 0, COL_WIDTH, COL_FREQ, COL_MIN, COL_MAX, COL_JITTER, COL_COUNT };
+static const lv_coord_t COL_W[COL_COUNT] = { 28, 56, 56, 52, 52, 56 };
+
+struct ChannelRow {
+    lv_obj_t* col[COL_COUNT];
+    lv_obj_t* lbl_none;         // "No signal", replaces the value columns
+};
+
+static ChannelRow rows[NUM_SERVO_PINS];
+static lv_timer_t* refresh_timer = nullptr;
+
+// Bus view: RC_MAX_CHANNELS values in a grid
+static constexpr int BUS_GRID_COLS = 4;
+static constexpr lv_coord_t BUS_CELL_W = 76;
+
+static const char* const MODE_NAMES[CAPTURE_MODE_COUNT] = { "PWM", "PPM", "SBUS", "iBUS" };
+
+static CaptureMode mode = CAPTURE_MODE_PWM;     // Kept across page visits
+static lv_obj_t* pwm_panel = nullptr;
+static lv_obj_t* bus_panel = nullptr;
+static lv_obj_t* bus_cells[RC_MAX_CHANNELS];
+static lv_obj_t* lbl_bus_stats = nullptr;
+static lv_obj_t* lbl_mode = nullptr;
+
+// Set label text only if it changed (avoids invalidating unchanged cells)
+static void set_text_if_changed(lv_obj_t* lbl, const char* text) {
+    if (strcmp(lv_label_get_text(lbl), text) != 0) {
+        lv_label_set_text(lbl, text);
+    }
+}
+
+// ns -> "1500.0" (µs, one decimal)
+static void format_us(char* buf, size_t len, uint32_t ns) {
+    uint32_t tenths = (ns + 50) / 100;
+    snprintf(buf, len, "%lu.%lu", (unsigned long)(tenths / 10), (unsigned long)(tenths % 10));
+}
+
+static void show_signal(ChannelRow& row, bool signal) {
+    for (int c = COL_WIDTH; c < COL_COUNT; c++) {
+        if (signal) lv_obj_clear_flag(row.col[c], LV_OBJ_FLAG_HIDDEN);
+        else lv_obj_add_flag(row.col[c], LV_OBJ_FLAG_HIDDEN);
+    }
+    if (signal) lv_obj_add_flag(row.lbl_none, LV_OBJ_FLAG_HIDDEN);
+    else lv_obj_clear_flag(row.lbl_none, LV_OBJ_FLAG_HIDDEN);
+}
+
+static void update_row(const CaptureReport& report) {
+    if (report.channel >= NUM_SERVO_PINS) return;
+    ChannelRow& row = rows[report.channel];
+    const PulseReport& s = report.stats;
+
+    show_signal(row, s.signal);
+
+    // Lost frames or broken edges since the last reset: highlight the channel number
+    bool errors = s.lost_frames || s.glitches;
+    lv_obj_set_style_text_color(row.col[COL_CH],
+        lv_color_hex(errors ? GUI_COLOR_TRIAD[0] : GUI_COLOR_MONO[0]), 0);
+
+    if (!s.signal) return;
+
+    char buf[16];
+    format_us(buf, sizeof(buf), s.width_mean_ns);
+    set_text_if_changed(row.col[COL_WIDTH], buf);
+
+    uint32_t freq_tenths = (s.freq_mhz + 50) / 100;
+    snprintf(buf, sizeof(buf), "%lu.%lu", (unsigned long)(freq_tenths / 10), (unsigned long)(freq_tenths % 10));
+    set_text_if_changed(row.col[COL_FREQ], buf);
+
+    format_us(buf, sizeof(buf), s.width_min_ns);
+    set_text_if_changed(row.col[COL_MIN], buf);
+
+    format_us(buf, sizeof(buf), s.width_max_ns);
+    set_text_if_changed(row.col[COL_MAX], buf);
+
+    snprintf(buf, sizeof(buf), "%lu", (unsigned long)s.width_jitter_ns);
+    set_text_if_changed(row.col[COL_JITTER], buf);
+}
+
+static void update_bus(const BusReport& report) {
+    char buf[48];
+    const RcFrame& f = report.frame;
+
+    for (uint8_t i = 0; i < RC_MAX_CHANNELS; i++) {
+        if (i < f.num_channels) {
+            snprintf(buf, sizeof(buf), "%2u:%4u", (unsigned)(i + 1), (unsigned)f.ch_us[i]);
+        } else {
+            snprintf(buf, sizeof(buf), "%2u:  --", (unsigned)(i + 1));
+        }
+        set_text_if_changed(bus_cells[i], buf);
+        lv_obj_set_style_text_color(bus_cells[i],
+            lv_color_hex(report.signal ? GUI_COLOR_MONO[0] : GUI_COLOR_GRAYS[0]), 0);
+    }
+
+    const RcLinkStats& st = report.stats;
+    if (report.signal) {
+        uint32_t rate_tenths = (report.frame_rate_mhz + 50) / 100;
+        snprintf(buf, sizeof(buf), "%lu.%lu Hz", (unsigned long)(rate_tenths / 10), (unsigned long)(rate_tenths % 10));
+    } else {
+        snprintf(buf, sizeof(buf), "%s", tr(STR_ANALYZER_NO_SIGNAL));
+    }
+
+    char text[128];
+    snprintf(text, sizeof(text), "%s\n%s: %lu  %s: %lu  %s: %lu", buf,
+             tr(STR_ANALYZER_LOST), (unsigned long)st.lost_frames,
+             tr(STR_ANALYZER_FAILSAFE), (unsigned long)st.failsafe_frames,
+             tr(STR_ANALYZER_ERRORS), (unsigned long)st.bad_frames);
+    set_text_if_changed(lbl_bus_stats, text);
+}
+
+static void refresh_timer_cb(lv_timer_t* t) {
+    LV_UNUSED(t);
+    CaptureReport report;
+    while (capture_poll(report)) {
+        update_row(report);
+    }
+    BusReport bus;
+    while (capture_poll_bus(bus)) {
+        if (bus.mode == mode) update_bus(bus);
+    }
+}
+
+// Start capturing in the current mode and show the matching panel
+static void apply_mode() {
+    capture_stop();
+    if (mode == CAPTURE_MODE_PWM) {
+        capture_start((1 << NUM_SERVO_PINS) - 1);
+        lv_obj_clear_flag(pwm_panel, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_flag(bus_panel, LV_OBJ_FLAG_HIDDEN);
+        for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) show_signal(rows[i], false);
+    } else {
+        capture_start_bus(mode);
+        lv_obj_add_flag(pwm_panel, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_clear_flag(bus_panel, LV_OBJ_FLAG_HIDDEN);
+        BusReport empty = {};
+        empty.mode = mode;
+        update_bus(empty);
+    }
+    lv_label_set_text(lbl_mode, MODE_NAMES[mode]);
+}
+
+static void btn_mode_event_cb(lv_event_t* e) {
+    if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
+        mode = static_cast<CaptureMode>((mode + 1) % CAPTURE_MODE_COUNT);
+        apply_mode();
+    }
+}
+
+static void btn_reset_event_cb(lv_event_t* e) {
+    if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
+        capture_reset_minmax();
+    }
+}
+
+// Row container: cells laid out left to right, no scrolling
+static lv_obj_t* make_row(lv_obj_t* parent) {
+    lv_obj_t* row = lv_obj_create(parent);
+    lv_obj_remove_style_all(row);
+    lv_obj_set_size(row, LV_PCT(100), ROW_H);
+    lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(row, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_clear_flag(row, LV_OBJ_FLAG_SCROLLABLE);
+    return row;
+}
+
+// Plain column container (no style, no scrolling)
+static lv_obj_t* make_panel(lv_obj_t* parent) {
+    lv_obj_t* panel = lv_obj_create(parent);
+    lv_obj_remove_style_all(panel);
+    lv_obj_set_size(panel, LV_PCT(100), LV_SIZE_CONTENT);
+    lv_obj_set_flex_flow(panel, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_row(panel, 2, 0);
+    lv_obj_clear_flag(panel, LV_OBJ_FLAG_SCROLLABLE);
+    return panel;
+}
+
+static lv_obj_t* make_button(lv_obj_t* parent, const char* text, lv_event_cb_t cb, lv_obj_t** label_out) {
+    lv_obj_t* btn = lv_button_create(parent);
+    lv_obj_set_size(btn, 120, 24);
+    lv_obj_add_event_cb(btn, cb, LV_EVENT_CLICKED, nullptr);
+    lv_obj_set_style_bg_color(btn, lv_color_hex(GUI_COLOR_MONO[1]), 0);
+    lv_obj_set_style_text_color(btn, lv_color_white(), 0);
+
+    lv_obj_t* lbl = lv_label_create(btn);
+    lv_label_set_text(lbl, text);
+    lv_obj_set_style_text_font(lbl, FONT_DEFAULT, 0);
+    lv_obj_center(lbl);
+    if (label_out) *label_out = lbl;
+    return btn;
+}
+
+static lv_obj_t* make_cell(lv_obj_t* row, lv_coord_t width, const lv_font_t* font, const char* text) {
+    lv_obj_t* lbl = lv_label_create(row);
+    lv_obj_set_width(lbl, width);
+    lv_obj_set_style_text_font(lbl, font, 0);
+    lv_obj_set_style_text_align(lbl, LV_TEXT_ALIGN_RIGHT, 0);
+    lv_label_set_long_mode(lbl, LV_LABEL_LONG_CLIP);
+    lv_label_set_text(lbl, text);
+    return lbl;
+}
+
+void page_analyzer_create(lv_obj_t* parent) {
+    // Initialize focus builder
+    focus_builder.init();
+
+    // Record this page in navigation history
+    input_push_page(PAGE_ANALYZER);
+
+    lv_obj_set_flex_flow(parent, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(parent, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_all(parent, 6, 0);
+    lv_obj_set_style_pad_row(parent, 2, 0);
+    lv_obj_clear_flag(parent, LV_OBJ_FLAG_SCROLLABLE);
+
+    // === PWM view: one row per servo header channel ===
+    pwm_panel = make_panel(parent);
+
+    const char* headers[COL_COUNT] = { "Ch", tr(STR_SERVO_US), "Hz", "Min", "Max", tr(STR_ANALYZER_JITTER) };
+    lv_obj_t* header = make_row(pwm_panel);
+    for (int c = 0; c < COL_COUNT; c++) {
+        lv_obj_t* lbl = make_cell(header, COL_W[c], FONT_BOLD_SM, headers[c]);
+        lv_obj_set_style_text_color(lbl, lv_color_hex(GUI_COLOR_GRAYS[0]), 0);
+    }
+
+    for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+        lv_obj_t* row = make_row(pwm_panel);
+        rows[i].col[COL_CH] = make_cell(row, COL_W[COL_CH], FONT_BOLD_SM, "");
+        lv_label_set_text_fmt(rows[i].col[COL_CH], "%d", i + 1);
+        for (int c = COL_WIDTH; c < COL_COUNT; c++) {
+            rows[i].col[c] = make_cell(row, COL_W[c], FONT_MONO_SM, "");
+        }
+
+        lv_coord_t none_w = 0;
+        for (int c = COL_WIDTH; c < COL_COUNT; c++) none_w += COL_W[c];
+        rows[i].lbl_none = make_cell(row, none_w, FONT_DEFAULT, tr(STR_ANALYZER_NO_SIGNAL));
+        lv_obj_set_style_text_align(rows[i].lbl_none, LV_TEXT_ALIGN_CENTER, 0);
+        lv_obj_set_style_text_color(rows[i].lbl_none, lv_color_hex(GUI_COLOR_GRAYS[0]), 0);
+    }
+
+    // === Bus view: channel grid + link statistics ===
+    bus_panel = make_panel(parent);
+
+    for (int r = 0; r < RC_MAX_CHANNELS / BUS_GRID_COLS; r++) {
+        lv_obj_t* row = make_row(bus_panel);
+        for (int c = 0; c < BUS_GRID_COLS; c++) {
+            bus_cells[r * BUS_GRID_COLS + c] = make_cell(row, BUS_CELL_W, FONT_MONO_SM, "");
+        }
+    }
+
+    lbl_bus_stats = lv_label_create(bus_panel);
+    lv_obj_set_width(lbl_bus_stats, LV_PCT(100));
+    lv_obj_set_style_text_font(lbl_bus_stats, FONT_DEFAULT, 0);
+    lv_obj_set_style_text_align(lbl_bus_stats, LV_TEXT_ALIGN_CENTER, 0);
+    lv_label_set_text(lbl_bus_stats, "");
+
+    // === Buttons: input mode, reset min/max ===
+    lv_obj_t* row_buttons = make_row(parent);
+    lv_obj_set_height(row_buttons, LV_SIZE_CONTENT);
+    lv_obj_set_flex_align(row_buttons, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_t* btn_mode = make_button(row_buttons, MODE_NAMES[mode], btn_mode_event_cb, &lbl_mode);
+    lv_obj_t* btn_reset = make_button(row_buttons, tr(STR_ANALYZER_RESET), btn_reset_event_cb, nullptr);
+
+    // Take over the servo pins as inputs
+    apply_mode();
+    refresh_timer = lv_timer_create(refresh_timer_cb, REFRESH_MS, nullptr);
+
+    // Add buttons to focus order
+    focus_builder.add(btn_mode, FO_BTN_MODE);
+    focus_builder.add(btn_reset, FO_BTN_RESET);
+    focus_builder.add(gui_get_btn_home(), FO_BTN_HOME);
+    focus_builder.add(gui_get_btn_prev(), FO_BTN_PREV);
+    focus_builder.add(gui_get_btn_next(), FO_BTN_NEXT);
+    focus_builder.add(gui_get_btn_settings(), FO_BTN_SETTINGS);
+    focus_builder.finalize();
+}
+
+void page_analyzer_destroy() {
+    if (refresh_timer) {
+        lv_timer_delete(refresh_timer);
+        refresh_timer = nullptr;
+    }
+    capture_stop();
+
+    // Drop reports still queued for the deleted labels
+    CaptureReport stale;
+    while (capture_poll(stale)) {}
+    BusReport stale_bus;
+    while (capture_poll_bus(stale_bus)) {}
+
+    memset(rows, 0, sizeof(rows));
+    memset(bus_cells, 0, sizeof(bus_cells));
+    pwm_panel = nullptr;
+    bus_panel = nullptr;
+    lbl_bus_stats = nullptr;
+    lbl_mode = nullptr;
+}
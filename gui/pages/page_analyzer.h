@@ -0,0 +1,5 @@
+#pragma once
+#include "lvgl.h"
+
+void page_analyzer_create(lv_obj_t* parent);
+void page_analyzer_destroy();
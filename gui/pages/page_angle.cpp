@@ -1,23 +1,172 @@
+// gui/pages/page_angle.cpp - Angle of incidence
+// Shows pitch and roll from the IMU service (src/imu.cpp). The sensor lies on
+// the wing with its x axis towards the leading edge: pitch is the incidence,
+// leading edge up positive. "Zero" takes the current attitude as reference
+// (e.g. on the stabilizer), "Absolute" goes back to the sensor's level.
+
 #include "lvgl.h"
 #include "gui/fonts.h"
 #include "gui/color_palette.h"
 #include "gui/lang.h"
 #include "gui/input.h"
 #include "gui/gui.h"
+#include "imu.h"
+#include <cstdio>
+#include <cstring>
+#include <math.h>
 
 // =============================================================================
 // Focus Order Configuration
 // =============================================================================
 enum FocusOrder {
-    FO_BTN_HOME     = 0,
-    FO_BTN_PREV     = 1,
-    FO_BTN_NEXT     = 2,
-    FO_BTN_SETTINGS = 3,
+    FO_BTN_ZERO     = 0,
+    FO_BTN_ABSOLUTE = 1,
+    FO_BTN_HOME     = 2,
+    FO_BTN_PREV     = 3,
+    FO_BTN_NEXT     = 4,
+    FO_BTN_SETTINGS = 5,
 };
 
 // Focus group builder for this page
 static FocusOrderBuilder focus_builder;
 
+// =============================================================================
+// Layout
+// =============================================================================
+static constexpr uint32_t REFRESH_MS = 50;
+static constexpr lv_coord_t ROW_H = 40;
+static constexpr lv_coord_t BUTTON_ROW_H = 28;
+static constexpr lv_coord_t NAME_W = 110;
+static constexpr lv_coord_t VALUE_W = 180;
+
+struct AngleRow {
+    lv_obj_t* row;
+    lv_obj_t* value;
+};
+
+static AngleRow pitch_row;
+static AngleRow roll_row;
+static lv_obj_t* lbl_status = nullptr;
+static lv_obj_t* btn_absolute = nullptr;
+static lv_timer_t* refresh_timer = nullptr;
+
+// Reference attitude (page-local, "Zero")
+static bool zeroed = false;
+static float zero_pitch = 0.0f;
+static float zero_roll = 0.0f;
+static ImuAttitude last = {};
+static bool have_reading = false;
+
+// Set label text only if it changed
+static void set_text_if_changed(lv_obj_t* lbl, const char* text) {
+    if (strcmp(lv_label_get_text(lbl), text) != 0) {
+        lv_label_set_text(lbl, text);
+    }
+}
+
+// Degrees -> "+1.25 deg" (0.01 deg steps; the font has no degree sign)
+static void format_degrees(char* buf, size_t len, float deg) {
+    long hundredths = lroundf(deg * 100.0f);
+    const char* sign = (hundredths < 0) ? "-" : "+";
+    if (hundredths < 0) hundredths = -hundredths;
+    snprintf(buf, len, "%s%ld.%02ld deg", sign, hundredths / 100, hundredths % 100);
+}
+
+// Incidence is leading edge up positive: the filter's pitch is nose down positive
+static float incidence_deg(const ImuAttitude& a) {
+    return -a.pitch_deg;
+}
+
+static void update_status() {
+    const char* text;
+    if (!imu_present()) text = tr(STR_IMU_NO_SENSOR);
+    else text = tr(zeroed ? STR_IMU_RELATIVE : STR_IMU_ABSOLUTE);
+    set_text_if_changed(lbl_status, text);
+
+    if (zeroed) lv_obj_clear_state(btn_absolute, LV_STATE_DISABLED);
+    else lv_obj_add_state(btn_absolute, LV_STATE_DISABLED);
+}
+
+static void refresh_timer_cb(lv_timer_t* t) {
+    LV_UNUSED(t);
+    update_status();
+
+    char buf[24];
+    if (!imu_read(last)) {
+        have_reading = false;
+        set_text_if_changed(pitch_row.value, "--");
+        set_text_if_changed(roll_row.value, "--");
+        return;
+    }
+    have_reading = true;
+    format_degrees(buf, sizeof(buf), incidence_deg(last) - zero_pitch);
+    set_text_if_changed(pitch_row.value, buf);
+    format_degrees(buf, sizeof(buf), last.roll_deg - zero_roll);
+    set_text_if_changed(roll_row.value, buf);
+}
+
+// =============================================================================
+// Event Handlers
+// =============================================================================
+
+static void btn_zero_event_cb(lv_event_t* e) {
+    LV_UNUSED(e);
+    if (!have_reading) return;
+    zero_pitch = incidence_deg(last);
+    zero_roll = last.roll_deg;
+    zeroed = true;
+    update_status();
+}
+
+static void btn_absolute_event_cb(lv_event_t* e) {
+    LV_UNUSED(e);
+    zero_pitch = zero_roll = 0.0f;
+    zeroed = false;
+    update_status();
+}
+
+// =============================================================================
+// Page
+// =============================================================================
+
+static AngleRow make_row(lv_obj_t* parent, const char* name) {
+    AngleRow ar;
+    ar.row = lv_obj_create(parent);
+    lv_obj_remove_style_all(ar.row);
+    lv_obj_set_size(ar.row, LV_PCT(100), ROW_H);
+    lv_obj_set_flex_flow(ar.row, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(ar.row, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_clear_flag(ar.row, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t* lbl = lv_label_create(ar.row);
+    lv_obj_set_width(lbl, NAME_W);
+    lv_obj_set_style_text_font(lbl, FONT_BOLD_MD, 0);
+    lv_obj_set_style_text_color(lbl, lv_color_hex(GUI_COLOR_GRAYS[0]), 0);
+    lv_label_set_text(lbl, name);
+
+    ar.value = lv_label_create(ar.row);
+    lv_obj_set_width(ar.value, VALUE_W);
+    lv_obj_set_style_text_font(ar.value, FONT_MONO_BOLD_XL, 0);
+    lv_obj_set_style_text_align(ar.value, LV_TEXT_ALIGN_RIGHT, 0);
+    lv_label_set_text(ar.value, "--");
+    return ar;
+}
+
+static lv_obj_t* make_button(lv_obj_t* parent, lv_coord_t width, const char* text, lv_event_cb_t cb) {
+    lv_obj_t* btn = lv_button_create(parent);
+    lv_obj_set_size(btn, width, 24);
+    lv_obj_add_event_cb(btn, cb, LV_EVENT_CLICKED, nullptr);
+    lv_obj_set_style_bg_color(btn, lv_color_hex(GUI_COLOR_MONO[1]), 0);
+    lv_obj_set_style_bg_color(btn, lv_color_hex(GUI_COLOR_GRAYS[0]), LV_STATE_DISABLED);
+    lv_obj_set_style_text_color(btn, lv_color_white(), 0);
+
+    lv_obj_t* lbl = lv_label_create(btn);
+    lv_label_set_text(lbl, text);
+    lv_obj_set_style_text_font(lbl, FONT_DEFAULT, 0);
+    lv_obj_center(lbl);
+    return btn;
+}
+
 void page_angle_create(lv_obj_t* parent) {
     // Initialize focus builder
     focus_builder.init();
@@ -25,14 +174,41 @@ void page_angle_create(lv_obj_t* parent) {
     // Record this page in navigation history
     input_push_page(PAGE_ANGLE);
 
-    lv_obj_t* label = lv_label_create(parent);
-    lv_label_set_text(label, tr(STR_ANGLE_CONTENT));
-    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_style_text_font(label, FONT_DEFAULT, 0);
-    lv_obj_set_style_text_color(label, lv_color_hex(GUI_COLOR_SHADES[7]), 0);
-    lv_obj_center(label);
+    lv_obj_set_flex_flow(parent, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(parent, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_all(parent, 6, 0);
+    lv_obj_set_style_pad_row(parent, 4, 0);
+    lv_obj_clear_flag(parent, LV_OBJ_FLAG_SCROLLABLE);
 
-    // Add footer buttons to focus order
+    pitch_row = make_row(parent, tr(STR_ANGLE_PITCH));
+    roll_row = make_row(parent, tr(STR_ANGLE_ROLL));
+
+    lbl_status = lv_label_create(parent);
+    lv_obj_set_width(lbl_status, LV_PCT(100));
+    lv_obj_set_style_text_font(lbl_status, FONT_DEFAULT, 0);
+    lv_obj_set_style_text_align(lbl_status, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_set_style_text_color(lbl_status, lv_color_hex(GUI_COLOR_SHADES[7]), 0);
+    lv_label_set_long_mode(lbl_status, LV_LABEL_LONG_CLIP);
+    lv_label_set_text(lbl_status, "");
+
+    // === Zero, absolute ===
+    lv_obj_t* row_buttons = lv_obj_create(parent);
+    lv_obj_remove_style_all(row_buttons);
+    lv_obj_set_size(row_buttons, LV_PCT(100), BUTTON_ROW_H);
+    lv_obj_set_flex_flow(row_buttons, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(row_buttons, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_clear_flag(row_buttons, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_t* btn_zero = make_button(row_buttons, 120, tr(STR_IMU_ZERO), btn_zero_event_cb);
+    btn_absolute = make_button(row_buttons, 120, tr(STR_IMU_ABSOLUTE), btn_absolute_event_cb);
+
+    have_reading = false;
+    imu_start();
+    update_status();
+    refresh_timer = lv_timer_create(refresh_timer_cb, REFRESH_MS, nullptr);
+
+    // Add buttons to focus order
+    focus_builder.add(btn_zero, FO_BTN_ZERO);
+    focus_builder.add(btn_absolute, FO_BTN_ABSOLUTE);
     focus_builder.add(gui_get_btn_home(), FO_BTN_HOME);
     focus_builder.add(gui_get_btn_prev(), FO_BTN_PREV);
     focus_builder.add(gui_get_btn_next(), FO_BTN_NEXT);
@@ -43,5 +219,15 @@ void page_angle_create(lv_obj_t* parent) {
 }
 
 void page_angle_destroy() {
+    if (refresh_timer) {
+        lv_timer_delete(refresh_timer);
+        refresh_timer = nullptr;
+    }
+    imu_stop();
+
     focus_builder.destroy();
+    pitch_row = AngleRow{};
+    roll_row = AngleRow{};
+    lbl_status = nullptr;
+    btn_absolute = nullptr;
 }
@@ -1,23 +1,355 @@
+// gui/pages/page_cg_scale.cpp - CG scale
+// Shows the CG position, the total mass and the load on each support
+// (src/hx711.cpp). Tare and the two-point calibration (empty, reference mass
+// per support) are stored in the settings; the scale task only delivers
+// filtered raw counts.
+//
+// Geometry (settings): supports 1 and 2 (wings) sit cg_le_offset_mm behind
+// the leading edge stop, support 3 (fuselage) cg_support_dist_mm behind them.
+// The CG is shown from the leading edge stop; it is gray until the tracked
+// value has settled.
+
 #include "lvgl.h"
 #include "gui/fonts.h"
 #include "gui/color_palette.h"
 #include "gui/lang.h"
 #include "gui/input.h"
 #include "gui/gui.h"
+#include "gui/config/settings.h"
+#include "hx711.h"
+#include "cg_solver.h"
+#include <cstdio>
+#include <cstring>
 
 // =============================================================================
 // Focus Order Configuration
 // =============================================================================
 enum FocusOrder {
-    FO_BTN_HOME     = 0,
-    FO_BTN_PREV     = 1,
-    FO_BTN_NEXT     = 2,
-    FO_BTN_SETTINGS = 3,
+    FO_BTN_TARE      = 0,
+    FO_BTN_CALIBRATE = 1,
+    FO_BTN_HOME      = 2,
+    FO_BTN_PREV      = 3,
+    FO_BTN_NEXT      = 4,
+    FO_BTN_SETTINGS  = 5,
 };
 
 // Focus group builder for this page
 static FocusOrderBuilder focus_builder;
 
+// =============================================================================
+// Layout
+// =============================================================================
+static constexpr uint32_t REFRESH_MS = HX711_PUBLISH_MS;
+static constexpr lv_coord_t ROW_H = 28;
+static constexpr lv_coord_t CELL_ROW_H = 18;
+static constexpr lv_coord_t BUTTON_ROW_H = 28;
+static constexpr lv_coord_t NAME_W = 100;
+static constexpr lv_coord_t VALUE_W = 140;
+static constexpr lv_coord_t BUTTON_W = 90;
+
+// CG tracking: weight 1/8 per reading (50 ms), settled within 0.2 mm (1 sigma)
+static constexpr uint8_t CG_SHIFT = 3;
+static constexpr uint32_t CG_SETTLED_UM = 200;
+
+// A capture waits for a full filter window that started after the request
+static constexpr uint32_t CAPTURE_SAMPLES = HX711_MEDIAN + HX711_AVERAGE + 2;
+
+struct WeightRow {
+    lv_obj_t* row;
+    lv_obj_t* value;
+};
+
+static WeightRow cell_rows[NUM_LOAD_CELLS];
+static WeightRow total_row;
+static WeightRow cg_row;
+static lv_obj_t* lbl_cg_sigma = nullptr;
+static lv_obj_t* lbl_status = nullptr;
+static lv_obj_t* btn_tare = nullptr;
+static lv_obj_t* lbl_calibrate = nullptr;
+static lv_timer_t* refresh_timer = nullptr;
+
+// =============================================================================
+// Calibration State
+// =============================================================================
+enum CalStep : int8_t {
+    CAL_IDLE = -2,
+    CAL_EMPTY = -1,         // 0 .. NUM_LOAD_CELLS - 1: reference on that support
+};
+
+enum Capture : uint8_t {
+    CAPTURE_NONE,
+    CAPTURE_TARE,
+    CAPTURE_CAL,
+};
+
+static int8_t cal_step = CAL_IDLE;
+static int32_t cal_empty_raw[NUM_LOAD_CELLS];
+static LoadCellCal cal_new[NUM_LOAD_CELLS];      // Applied when every support is done
+static Capture capture = CAPTURE_NONE;
+static uint32_t capture_after = 0;      // Reading sample count that completes the capture
+static uint32_t last_samples = 0;
+static uint8_t present_mask = 0;
+static CgTracker<CG_SHIFT> cg_tracker;
+static bool cg_settled = false;
+
+static LoadCellCal cell_cal(uint8_t i) {
+    return LoadCellCal{ g_settings.cg_zero[i], g_settings.cg_counts_per_kg[i] };
+}
+
+// Set label text only if it changed
+static void set_text_if_changed(lv_obj_t* lbl, const char* text) {
+    if (strcmp(lv_label_get_text(lbl), text) != 0) {
+        lv_label_set_text(lbl, text);
+    }
+}
+
+// mg -> "1240.0 g"
+static void format_grams(char* buf, size_t len, int32_t mg) {
+    int32_t dg = (mg >= 0 ? mg + 50 : mg - 50) / 100;
+    const char* sign = (dg < 0) ? "-" : "";
+    if (dg < 0) dg = -dg;
+    snprintf(buf, len, "%s%ld.%ld g", sign, (long)(dg / 10), (long)(dg % 10));
+}
+
+// µm -> "95.0 mm"
+static void format_mm(char* buf, size_t len, int32_t um) {
+    int32_t tenth = (um >= 0 ? um + 50 : um - 50) / 100;
+    const char* sign = (tenth < 0) ? "-" : "";
+    if (tenth < 0) tenth = -tenth;
+    snprintf(buf, len, "%s%ld.%ld mm", sign, (long)(tenth / 10), (long)(tenth % 10));
+}
+
+// Support positions from the leading edge stop
+static void support_positions(int32_t* x_um) {
+    const int32_t front_um = static_cast<int32_t>(g_settings.cg_le_offset_mm) * 1000;
+    const int32_t rear_um = front_um + static_cast<int32_t>(g_settings.cg_support_dist_mm) * 1000;
+    for (uint8_t i = 0; i < NUM_LOAD_CELLS; i++) {
+        x_um[i] = (i < 2) ? front_um : rear_um;
+    }
+}
+
+static void show(lv_obj_t* obj, bool visible) {
+    if (visible) lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    else lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+}
+
+// Next support with a module connected after 'from' (NUM_LOAD_CELLS = none)
+static int8_t next_present(int8_t from) {
+    for (int8_t i = from + 1; i < NUM_LOAD_CELLS; i++) {
+        if (present_mask & (1 << i)) return i;
+    }
+    return NUM_LOAD_CELLS;
+}
+
+static void start_capture(Capture what) {
+    hx711_reset_filters();
+    capture = what;
+    capture_after = last_samples + CAPTURE_SAMPLES;
+}
+
+static void update_cal_ui() {
+    char buf[64];
+    if (capture != CAPTURE_NONE) {
+        set_text_if_changed(lbl_status, tr(STR_CG_HOLD_STILL));
+    } else if (cal_step == CAL_EMPTY) {
+        set_text_if_changed(lbl_status, tr(STR_CG_CAL_EMPTY));
+    } else if (cal_step >= 0) {
+        snprintf(buf, sizeof(buf), "%s %s %d (%u g)", tr(STR_CG_CAL_PLACE), tr(STR_CG_SUPPORT),
+                 cal_step + 1, (unsigned)g_settings.cg_cal_mass_g);
+        set_text_if_changed(lbl_status, buf);
+    }
+    set_text_if_changed(lbl_calibrate, tr(cal_step == CAL_IDLE ? STR_CG_CALIBRATE : STR_CG_NEXT));
+
+    bool busy = cal_step != CAL_IDLE || capture != CAPTURE_NONE;
+    if (busy) lv_obj_add_state(btn_tare, LV_STATE_DISABLED);
+    else lv_obj_clear_state(btn_tare, LV_STATE_DISABLED);
+}
+
+// Filter window complete: apply the tare or the calibration point
+static void finish_capture(const ScaleReading& r) {
+    const Capture what = capture;
+    capture = CAPTURE_NONE;
+
+    if (what == CAPTURE_TARE) {
+        for (uint8_t i = 0; i < NUM_LOAD_CELLS; i++) {
+            if (r.present_mask & (1 << i)) g_settings.cg_zero[i] = r.raw[i];
+        }
+        settings_save();
+    } else if (cal_step == CAL_EMPTY) {
+        memcpy(cal_empty_raw, r.raw, sizeof(cal_empty_raw));
+        cal_step = next_present(CAL_EMPTY);
+    } else if (cal_step >= 0) {
+        // No slope (reference not on this support): keep the old calibration
+        if (!LoadCellCal::from_points(cal_empty_raw[cal_step], 0, r.raw[cal_step],
+                                      static_cast<int32_t>(g_settings.cg_cal_mass_g) * 1000, cal_new[cal_step])) {
+            cal_new[cal_step] = cell_cal(cal_step);
+        }
+        cal_step = next_present(cal_step);
+    }
+
+    if (cal_step >= NUM_LOAD_CELLS) {
+        for (uint8_t i = 0; i < NUM_LOAD_CELLS; i++) {
+            if (!(present_mask & (1 << i))) continue;
+            g_settings.cg_zero[i] = cal_new[i].zero;
+            g_settings.cg_counts_per_kg[i] = cal_new[i].counts_per_kg;
+        }
+        cal_step = CAL_IDLE;
+        settings_save();
+    }
+    update_cal_ui();
+}
+
+// CG row: only redrawn when the rounded value or the settled state changes
+static void update_cg(const int32_t* load_mg, bool usable) {
+    char buf[24];
+    if (usable) {
+        int32_t x_um[NUM_LOAD_CELLS];
+        support_positions(x_um);
+        cg_tracker.update(cg_solve(load_mg, x_um, NUM_LOAD_CELLS, present_mask));
+    } else {
+        cg_tracker.reset();
+    }
+
+    if (!cg_tracker.valid()) {
+        set_text_if_changed(cg_row.value, "--");
+        set_text_if_changed(lbl_cg_sigma, "");
+        return;
+    }
+    format_mm(buf, sizeof(buf), cg_tracker.x_um());
+    set_text_if_changed(cg_row.value, buf);
+    uint32_t sigma = (cg_tracker.stddev_um() + 50) / 100;
+    snprintf(buf, sizeof(buf), "+-%lu.%lu", (unsigned long)(sigma / 10), (unsigned long)(sigma % 10));
+    set_text_if_changed(lbl_cg_sigma, buf);
+
+    bool settled = cg_tracker.settled(CG_SETTLED_UM);
+    if (settled != cg_settled) {
+        cg_settled = settled;
+        lv_obj_set_style_text_color(cg_row.value,
+            lv_color_hex(settled ? GUI_COLOR_MONO[0] : GUI_COLOR_GRAYS[0]), 0);
+        lv_obj_set_style_text_color(lbl_cg_sigma,
+            lv_color_hex(settled ? GUI_COLOR_TRIAD[1] : GUI_COLOR_GRAYS[0]), 0);
+    }
+}
+
+static void update(const ScaleReading& r) {
+    char buf[24];
+    last_samples = r.samples;
+    present_mask = r.present_mask;
+
+    int32_t load_mg[NUM_LOAD_CELLS] = {};
+    int32_t total_mg = 0;
+    bool all_calibrated = true;
+    for (uint8_t i = 0; i < NUM_LOAD_CELLS; i++) {
+        bool present = r.present_mask & (1 << i);
+        show(cell_rows[i].row, present);
+        if (!present) continue;
+
+        LoadCellCal cal = cell_cal(i);
+        if (!cal.calibrated()) all_calibrated = false;
+        int32_t mg = cal.to_mg(r.raw[i]);
+        load_mg[i] = mg;
+        total_mg += mg;
+
+        if (cal.calibrated()) format_grams(buf, sizeof(buf), mg);
+        else snprintf(buf, sizeof(buf), "%ld", (long)(r.raw[i] - cal.zero));
+        set_text_if_changed(cell_rows[i].value, buf);
+        // Still filling the window: gray
+        lv_obj_set_style_text_color(cell_rows[i].value,
+            lv_color_hex((r.full_mask & (1 << i)) ? GUI_COLOR_MONO[0] : GUI_COLOR_GRAYS[0]), 0);
+    }
+
+    const bool weighing = r.present_mask != 0 && all_calibrated;
+    show(total_row.row, weighing);
+    show(cg_row.row, weighing);
+    format_grams(buf, sizeof(buf), total_mg);
+    set_text_if_changed(total_row.value, buf);
+
+    // Only complete filter windows: a half-filled one drags the CG around
+    update_cg(load_mg, weighing && capture == CAPTURE_NONE &&
+                       (r.full_mask & r.present_mask) == r.present_mask);
+
+    if (capture != CAPTURE_NONE && r.samples >= capture_after &&
+        (r.full_mask & r.present_mask) == r.present_mask) {
+        finish_capture(r);
+    }
+
+    if (cal_step != CAL_IDLE || capture != CAPTURE_NONE) return;    // Status shows the calibration
+    if (!r.present_mask) set_text_if_changed(lbl_status, tr(STR_CG_NO_SENSOR));
+    else if (!all_calibrated) set_text_if_changed(lbl_status, tr(STR_CG_UNCALIBRATED));
+    else set_text_if_changed(lbl_status, "");
+}
+
+static void refresh_timer_cb(lv_timer_t* t) {
+    LV_UNUSED(t);
+    ScaleReading r;
+    if (hx711_poll(r)) update(r);
+}
+
+// =============================================================================
+// Event Handlers
+// =============================================================================
+
+static void btn_tare_event_cb(lv_event_t* e) {
+    LV_UNUSED(e);
+    if (!present_mask || cal_step != CAL_IDLE || capture != CAPTURE_NONE) return;
+    start_capture(CAPTURE_TARE);
+    update_cal_ui();
+}
+
+static void btn_calibrate_event_cb(lv_event_t* e) {
+    LV_UNUSED(e);
+    if (!present_mask || capture != CAPTURE_NONE) return;
+    if (cal_step == CAL_IDLE) cal_step = CAL_EMPTY;     // First press: instructions only
+    else start_capture(CAPTURE_CAL);
+    update_cal_ui();
+}
+
+// =============================================================================
+// Page
+// =============================================================================
+
+// Big rows for the CG and the total, compact ones for the supports
+static WeightRow make_row(lv_obj_t* parent, const char* name, bool big) {
+    WeightRow wr;
+    wr.row = lv_obj_create(parent);
+    lv_obj_remove_style_all(wr.row);
+    lv_obj_set_size(wr.row, LV_PCT(100), big ? ROW_H : CELL_ROW_H);
+    lv_obj_set_flex_flow(wr.row, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(wr.row, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_clear_flag(wr.row, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t* lbl = lv_label_create(wr.row);
+    lv_obj_set_width(lbl, NAME_W);
+    lv_obj_set_style_text_font(lbl, big ? FONT_BOLD_MD : FONT_DEFAULT, 0);
+    lv_obj_set_style_text_color(lbl, lv_color_hex(GUI_COLOR_GRAYS[0]), 0);
+    lv_label_set_text(lbl, name);
+
+    wr.value = lv_label_create(wr.row);
+    lv_obj_set_width(wr.value, VALUE_W);
+    lv_obj_set_style_text_font(wr.value, big ? FONT_MONO_BOLD_LG : FONT_MONO_SM, 0);
+    lv_obj_set_style_text_align(wr.value, LV_TEXT_ALIGN_RIGHT, 0);
+    lv_label_set_text(wr.value, "");
+    show(wr.row, false);
+    return wr;
+}
+
+static lv_obj_t* make_button(lv_obj_t* parent, lv_coord_t width, const char* text,
+                             lv_event_cb_t cb, lv_obj_t** label_out) {
+    lv_obj_t* btn = lv_button_create(parent);
+    lv_obj_set_size(btn, width, 24);
+    lv_obj_add_event_cb(btn, cb, LV_EVENT_CLICKED, nullptr);
+    lv_obj_set_style_bg_color(btn, lv_color_hex(GUI_COLOR_MONO[1]), 0);
+    lv_obj_set_style_bg_color(btn, lv_color_hex(GUI_COLOR_GRAYS[0]), LV_STATE_DISABLED);
+    lv_obj_set_style_text_color(btn, lv_color_white(), 0);
+
+    lv_obj_t* lbl = lv_label_create(btn);
+    lv_label_set_text(lbl, text);
+    lv_obj_set_style_text_font(lbl, FONT_DEFAULT, 0);
+    lv_obj_center(lbl);
+    if (label_out) *label_out = lbl;
+    return btn;
+}
+
 void page_cg_scale_create(lv_obj_t* parent) {
     // Initialize focus builder
     focus_builder.init();
@@ -25,14 +357,62 @@ void page_cg_scale_create(lv_obj_t* parent) {
     // Record this page in navigation history
     input_push_page(PAGE_CG_SCALE);
 
-    lv_obj_t* label = lv_label_create(parent);
-    lv_label_set_text(label, tr(STR_CG_SCALE_CONTENT));
-    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_style_text_font(label, FONT_DEFAULT, 0);
-    lv_obj_set_style_text_color(label, lv_color_hex(GUI_COLOR_SHADES[7]), 0);
-    lv_obj_center(label);
+    lv_obj_set_flex_flow(parent, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(parent, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_all(parent, 6, 0);
+    lv_obj_set_style_pad_row(parent, 2, 0);
+    lv_obj_clear_flag(parent, LV_OBJ_FLAG_SCROLLABLE);
 
-    // Add footer buttons to focus order
+    // === CG with its standard deviation, total mass ===
+    cg_row = make_row(parent, tr(STR_CG_POSITION), true);
+    lbl_cg_sigma = lv_label_create(cg_row.row);
+    lv_obj_set_flex_grow(lbl_cg_sigma, 1);
+    lv_obj_set_style_text_font(lbl_cg_sigma, FONT_MONO_SM, 0);
+    lv_obj_set_style_text_color(lbl_cg_sigma, lv_color_hex(GUI_COLOR_GRAYS[0]), 0);
+    lv_obj_set_style_text_align(lbl_cg_sigma, LV_TEXT_ALIGN_RIGHT, 0);
+    lv_label_set_text(lbl_cg_sigma, "");
+    lv_obj_set_style_text_color(cg_row.value, lv_color_hex(GUI_COLOR_GRAYS[0]), 0);
+    total_row = make_row(parent, tr(STR_CG_TOTAL), true);
+
+    // === Supports ===
+    char name[24];
+    for (uint8_t i = 0; i < NUM_LOAD_CELLS; i++) {
+        snprintf(name, sizeof(name), "%s %u", tr(STR_CG_SUPPORT), (unsigned)(i + 1));
+        cell_rows[i] = make_row(parent, name, false);
+    }
+
+    // === Status, tare, calibration ===
+    lv_obj_t* row_buttons = lv_obj_create(parent);
+    lv_obj_remove_style_all(row_buttons);
+    lv_obj_set_size(row_buttons, LV_PCT(100), BUTTON_ROW_H);
+    lv_obj_set_flex_flow(row_buttons, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(row_buttons, LV_FLEX_ALIGN_SPACE_BETWEEN, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_column(row_buttons, 4, 0);
+    lv_obj_clear_flag(row_buttons, LV_OBJ_FLAG_SCROLLABLE);
+
+    lbl_status = lv_label_create(row_buttons);
+    lv_obj_set_flex_grow(lbl_status, 1);
+    lv_obj_set_style_text_font(lbl_status, FONT_DEFAULT, 0);
+    lv_obj_set_style_text_color(lbl_status, lv_color_hex(GUI_COLOR_SHADES[7]), 0);
+    lv_label_set_long_mode(lbl_status, LV_LABEL_LONG_CLIP);
+    lv_label_set_text(lbl_status, "");
+
+    btn_tare = make_button(row_buttons, BUTTON_W, tr(STR_CG_TARE), btn_tare_event_cb, nullptr);
+    lv_obj_t* btn_calibrate = make_button(row_buttons, BUTTON_W, tr(STR_CG_CALIBRATE), btn_calibrate_event_cb, &lbl_calibrate);
+
+    cal_step = CAL_IDLE;
+    capture = CAPTURE_NONE;
+    present_mask = 0;
+    last_samples = 0;
+    cg_tracker.reset();
+    cg_settled = false;
+
+    hx711_start();
+    refresh_timer = lv_timer_create(refresh_timer_cb, REFRESH_MS, nullptr);
+
+    // Add buttons to focus order
+    focus_builder.add(btn_tare, FO_BTN_TARE);
+    focus_builder.add(btn_calibrate, FO_BTN_CALIBRATE);
     focus_builder.add(gui_get_btn_home(), FO_BTN_HOME);
     focus_builder.add(gui_get_btn_prev(), FO_BTN_PREV);
     focus_builder.add(gui_get_btn_next(), FO_BTN_NEXT);
@@ -43,5 +423,26 @@ void page_cg_scale_create(lv_obj_t* parent) {
 }
 
 void page_cg_scale_destroy() {
+    if (refresh_timer) {
+        lv_timer_delete(refresh_timer);
+        refresh_timer = nullptr;
+    }
+    hx711_stop();
+
+    // Drop a reading still queued for the deleted labels
+    ScaleReading stale;
+    hx711_poll(stale);
+
+    // An unfinished calibration keeps the previous values (nothing was saved)
+    cal_step = CAL_IDLE;
+    capture = CAPTURE_NONE;
+
     focus_builder.destroy();
+    memset(cell_rows, 0, sizeof(cell_rows));
+    total_row = WeightRow{};
+    cg_row = WeightRow{};
+    lbl_cg_sigma = nullptr;
+    lbl_status = nullptr;
+    btn_tare = nullptr;
+    lbl_calibrate = nullptr;
 }
@@ -1,23 +1,239 @@
+// gui/pages/page_deflection.cpp - Flap deflection
+// Shows the control surface angle from the IMU service (src/imu.cpp). The
+// sensor sits on the surface with its x axis towards the hinge line: trailing
+// edge down is positive. "Zero" with the surface in neutral, then the
+// deflection is read relative to it.
+//
+// With a second sensor on the wing (or fuselage) the page switches to the
+// differential mode: surface minus reference, both taken at the same instant,
+// so the model may be moved while measuring. The neutral difference is the
+// mounting offset of the two sensors and is stored in the settings; the
+// single-sensor zero depends on how the model rests and stays on the page.
+// The travel is the vertical movement of the trailing edge for the surface
+// chord set in the settings.
+
 #include "lvgl.h"
 #include "gui/fonts.h"
 #include "gui/color_palette.h"
 #include "gui/lang.h"
 #include "gui/input.h"
 #include "gui/gui.h"
+#include "gui/config/settings.h"
+#include "imu.h"
+#include <cstdio>
+#include <cstring>
+#include <math.h>
 
 // =============================================================================
 // Focus Order Configuration
 // =============================================================================
 enum FocusOrder {
-    FO_BTN_HOME     = 0,
-    FO_BTN_PREV     = 1,
-    FO_BTN_NEXT     = 2,
-    FO_BTN_SETTINGS = 3,
+    FO_BTN_ZERO     = 0,
+    FO_BTN_ABSOLUTE = 1,
+    FO_BTN_HOME     = 2,
+    FO_BTN_PREV     = 3,
+    FO_BTN_NEXT     = 4,
+    FO_BTN_SETTINGS = 5,
 };
 
 // Focus group builder for this page
 static FocusOrderBuilder focus_builder;
 
+// =============================================================================
+// Layout
+// =============================================================================
+static constexpr uint32_t REFRESH_MS = 50;
+static constexpr lv_coord_t ROW_H = 40;
+static constexpr lv_coord_t BUTTON_ROW_H = 28;
+static constexpr lv_coord_t NAME_W = 110;
+static constexpr lv_coord_t VALUE_W = 180;
+
+static constexpr float RAD_PER_DEG = static_cast<float>(M_PI) / 180.0f;
+
+struct DeflectionRow {
+    lv_obj_t* row;
+    lv_obj_t* value;
+};
+
+static DeflectionRow angle_row;
+static DeflectionRow travel_row;
+static lv_obj_t* lbl_status = nullptr;
+static lv_obj_t* btn_absolute = nullptr;
+static lv_timer_t* refresh_timer = nullptr;
+
+// Neutral position with one sensor (page-local, "Zero"); two sensors: g_settings
+static bool zeroed = false;
+static float zero_deg = 0.0f;
+static float last_deg = 0.0f;
+static bool have_reading = false;
+static bool differential = false;
+static bool zero_rejected = false;      // Last zero beyond the stored range
+
+// Set label text only if it changed
+static void set_text_if_changed(lv_obj_t* lbl, const char* text) {
+    if (strcmp(lv_label_get_text(lbl), text) != 0) {
+        lv_label_set_text(lbl, text);
+    }
+}
+
+// Degrees -> "+1.25 deg" (0.01 deg steps; the font has no degree sign)
+static void format_degrees(char* buf, size_t len, float deg) {
+    long hundredths = lroundf(deg * 100.0f);
+    const char* sign = (hundredths < 0) ? "-" : "+";
+    if (hundredths < 0) hundredths = -hundredths;
+    snprintf(buf, len, "%s%ld.%02ld deg", sign, hundredths / 100, hundredths % 100);
+}
+
+// Millimetres -> "+12.3 mm"
+static void format_travel(char* buf, size_t len, float mm) {
+    long tenths = lroundf(mm * 10.0f);
+    const char* sign = (tenths < 0) ? "-" : "+";
+    if (tenths < 0) tenths = -tenths;
+    snprintf(buf, len, "%s%ld.%ld mm", sign, tenths / 10, tenths % 10);
+}
+
+static bool is_zeroed() {
+    return differential ? g_settings.defl_zeroed != 0 : zeroed;
+}
+
+static float current_zero_deg() {
+    if (differential) return g_settings.defl_zeroed ? g_settings.defl_zero_cdeg / 100.0f : 0.0f;
+    return zeroed ? zero_deg : 0.0f;
+}
+
+static void update_status() {
+    bool ref = imu_present(IMU_REFERENCE);
+    bool surf = imu_present(IMU_SURFACE);
+    differential = ref && surf;
+
+    char text[64];
+    if (!ref && !surf) {
+        snprintf(text, sizeof(text), "%s", tr(STR_IMU_NO_SENSOR));
+    } else {
+        snprintf(text, sizeof(text), "%s - %s", tr(differential ? STR_DEFL_TWO_SENSORS : STR_DEFL_ONE_SENSOR),
+                 tr(zero_rejected ? STR_DEFL_ZERO_RANGE : is_zeroed() ? STR_IMU_RELATIVE : STR_IMU_ABSOLUTE));
+    }
+    set_text_if_changed(lbl_status, text);
+
+    if (is_zeroed()) lv_obj_clear_state(btn_absolute, LV_STATE_DISABLED);
+    else lv_obj_add_state(btn_absolute, LV_STATE_DISABLED);
+}
+
+// Surface angle, trailing edge down positive (filter pitch is nose = hinge side down positive)
+static bool read_surface_deg(float& deg) {
+    if (differential) {
+        ImuPair p;
+        if (!imu_read_pair(p)) return false;
+        deg = p.pitch_deg[IMU_REFERENCE] - p.pitch_deg[IMU_SURFACE];
+        return true;
+    }
+    ImuAttitude a;
+    ImuSensor sensor = imu_present(IMU_SURFACE) ? IMU_SURFACE : IMU_REFERENCE;
+    if (!imu_read(a, sensor)) return false;
+    deg = -a.pitch_deg;
+    return true;
+}
+
+static void refresh_timer_cb(lv_timer_t* t) {
+    LV_UNUSED(t);
+    update_status();
+
+    if (!read_surface_deg(last_deg)) {
+        have_reading = false;
+        set_text_if_changed(angle_row.value, "--");
+        set_text_if_changed(travel_row.value, "--");
+        return;
+    }
+    have_reading = true;
+
+    char buf[24];
+    float deg = last_deg - current_zero_deg();
+    format_degrees(buf, sizeof(buf), deg);
+    set_text_if_changed(angle_row.value, buf);
+    format_travel(buf, sizeof(buf), g_settings.defl_chord_mm * sinf(deg * RAD_PER_DEG));
+    set_text_if_changed(travel_row.value, buf);
+}
+
+// =============================================================================
+// Event Handlers
+// =============================================================================
+
+static void btn_zero_event_cb(lv_event_t* e) {
+    LV_UNUSED(e);
+    if (!have_reading) return;
+    if (differential) {
+        // Stored offset is limited to +-MAX_DEFL_ZERO_CDEG: a larger one would
+        // be dropped on the next load, so it is not applied at all
+        long cdeg = lroundf(last_deg * 100.0f);
+        zero_rejected = cdeg < -MAX_DEFL_ZERO_CDEG || cdeg > MAX_DEFL_ZERO_CDEG;
+        if (!zero_rejected) {
+            g_settings.defl_zero_cdeg = static_cast<int16_t>(cdeg);
+            g_settings.defl_zeroed = 1;
+            settings_save();
+        }
+    } else {
+        zero_deg = last_deg;
+        zeroed = true;
+    }
+    update_status();
+}
+
+static void btn_absolute_event_cb(lv_event_t* e) {
+    LV_UNUSED(e);
+    zero_rejected = false;
+    if (differential) {
+        g_settings.defl_zero_cdeg = 0;
+        g_settings.defl_zeroed = 0;
+        settings_save();
+    } else {
+        zero_deg = 0.0f;
+        zeroed = false;
+    }
+    update_status();
+}
+
+// =============================================================================
+// Page
+// =============================================================================
+
+static DeflectionRow make_row(lv_obj_t* parent, const char* name) {
+    DeflectionRow dr;
+    dr.row = lv_obj_create(parent);
+    lv_obj_remove_style_all(dr.row);
+    lv_obj_set_size(dr.row, LV_PCT(100), ROW_H);
+    lv_obj_set_flex_flow(dr.row, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(dr.row, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_clear_flag(dr.row, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t* lbl = lv_label_create(dr.row);
+    lv_obj_set_width(lbl, NAME_W);
+    lv_obj_set_style_text_font(lbl, FONT_BOLD_MD, 0);
+    lv_obj_set_style_text_color(lbl, lv_color_hex(GUI_COLOR_GRAYS[0]), 0);
+    lv_label_set_text(lbl, name);
+
+    dr.value = lv_label_create(dr.row);
+    lv_obj_set_width(dr.value, VALUE_W);
+    lv_obj_set_style_text_font(dr.value, FONT_MONO_BOLD_XL, 0);
+    lv_obj_set_style_text_align(dr.value, LV_TEXT_ALIGN_RIGHT, 0);
+    lv_label_set_text(dr.value, "--");
+    return dr;
+}
+
+static lv_obj_t* make_button(lv_obj_t* parent, lv_coord_t width, const char* text, lv_event_cb_t cb) {
+    lv_obj_t* btn = lv_button_create(parent);
+    lv_obj_set_size(btn, width, 24);
+    lv_obj_add_event_cb(btn, cb, LV_EVENT_CLICKED, nullptr);
+    lv_obj_set_style_bg_color(btn, lv_color_hex(GUI_COLOR_MONO[1]), 0);
+    lv_obj_set_style_bg_color(btn, lv_color_hex(GUI_COLOR_GRAYS[0]), LV_STATE_DISABLED);
+    lv_obj_set_style_text_color(btn, lv_color_white(), 0);
+
+    lv_obj_t* lbl = lv_label_create(btn);
+    lv_label_set_text(lbl, text);
+    lv_obj_set_style_text_font(lbl, FONT_DEFAULT, 0);
+    lv_obj_center(lbl);
+    return btn;
+}
+
 void page_deflection_create(lv_obj_t* parent) {
     // Initialize focus builder
     focus_builder.init();
@@ -25,14 +241,42 @@ void page_deflection_create(lv_obj_t* parent) {
     // Record this page in navigation history
     input_push_page(PAGE_DEFLECTION);
 
-    lv_obj_t* label = lv_label_create(parent);
-    lv_label_set_text(label, tr(STR_DEFLECTION_CONTENT));
-    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_style_text_font(label, FONT_DEFAULT, 0);
-    lv_obj_set_style_text_color(label, lv_color_hex(GUI_COLOR_SHADES[7]), 0);
-    lv_obj_center(label);
+    lv_obj_set_flex_flow(parent, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(parent, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_all(parent, 6, 0);
+    lv_obj_set_style_pad_row(parent, 4, 0);
+    lv_obj_clear_flag(parent, LV_OBJ_FLAG_SCROLLABLE);
+
+    angle_row = make_row(parent, tr(STR_DEFLECTION_ANGLE));
+    travel_row = make_row(parent, tr(STR_DEFL_TRAVEL));
+
+    lbl_status = lv_label_create(parent);
+    lv_obj_set_width(lbl_status, LV_PCT(100));
+    lv_obj_set_style_text_font(lbl_status, FONT_DEFAULT, 0);
+    lv_obj_set_style_text_align(lbl_status, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_set_style_text_color(lbl_status, lv_color_hex(GUI_COLOR_SHADES[7]), 0);
+    lv_label_set_long_mode(lbl_status, LV_LABEL_LONG_CLIP);
+    lv_label_set_text(lbl_status, "");
 
-    // Add footer buttons to focus order
+    // === Zero, absolute ===
+    lv_obj_t* row_buttons = lv_obj_create(parent);
+    lv_obj_remove_style_all(row_buttons);
+    lv_obj_set_size(row_buttons, LV_PCT(100), BUTTON_ROW_H);
+    lv_obj_set_flex_flow(row_buttons, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(row_buttons, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_clear_flag(row_buttons, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_t* btn_zero = make_button(row_buttons, 120, tr(STR_IMU_ZERO), btn_zero_event_cb);
+    btn_absolute = make_button(row_buttons, 120, tr(STR_IMU_ABSOLUTE), btn_absolute_event_cb);
+
+    have_reading = false;
+    zero_rejected = false;
+    imu_start();
+    update_status();
+    refresh_timer = lv_timer_create(refresh_timer_cb, REFRESH_MS, nullptr);
+
+    // Add buttons to focus order
+    focus_builder.add(btn_zero, FO_BTN_ZERO);
+    focus_builder.add(btn_absolute, FO_BTN_ABSOLUTE);
     focus_builder.add(gui_get_btn_home(), FO_BTN_HOME);
     focus_builder.add(gui_get_btn_prev(), FO_BTN_PREV);
     focus_builder.add(gui_get_btn_next(), FO_BTN_NEXT);
@@ -43,5 +287,15 @@ void page_deflection_create(lv_obj_t* parent) {
 }
 
 void page_deflection_destroy() {
+    if (refresh_timer) {
+        lv_timer_delete(refresh_timer);
+        refresh_timer = nullptr;
+    }
+    imu_stop();
+
     focus_builder.destroy();
+    angle_row = DeflectionRow{};
+    travel_row = DeflectionRow{};
+    lbl_status = nullptr;
+    btn_absolute = nullptr;
 }
@@ -10,13 +10,13 @@
 // =============================================================================
 // Define focus order here - change these numbers to reorder navigation
 // Layout (2 columns x 3 rows), then footer buttons:
-//   [0: About]     [1: Reserved]
+//   [0: About]     [1: Analyzer]
 //   [2: Reserved]  [3: Reserved]
 //   [4: Reserved]  [5: Reserved]
 //   Footer: [6: Home] [7: Prev] [8: Next] [9: Settings]
 enum FocusOrder {
     FO_ABOUT      = 0,
-    FO_RESERVED_1 = 1,
+    FO_ANALYZER   = 1,
     FO_RESERVED_2 = 2,
     FO_RESERVED_3 = 3,
     FO_RESERVED_4 = 4,
@@ -34,6 +34,7 @@ static FocusOrderBuilder focus_builder;
 // Callbacks
 // =============================================================================
 static void btn_about_cb(lv_event_t* e) { LV_UNUSED(e); gui_set_page(PAGE_ABOUT); }
+static void btn_analyzer_cb(lv_event_t* e) { LV_UNUSED(e); gui_set_page(PAGE_ANALYZER); }
 
 // =============================================================================
 // Button Factory
@@ -78,9 +79,9 @@ void page_home2_create(lv_obj_t* parent) {
     // Create buttons - visual order (left to right, top to bottom)
     // The focus_order parameter controls encoder navigation order
     create_nav_button(parent, tr(STR_BTN_ABOUT), btn_about_cb, FO_ABOUT);
+    create_nav_button(parent, tr(STR_BTN_ANALYZER), btn_analyzer_cb, FO_ANALYZER);
 
     // Space for future buttons:
-    // create_nav_button(parent, "WiFi\nConfig", btn_wifi_cb, FO_RESERVED_1);
     // create_nav_button(parent, "Calibrate", btn_calibrate_cb, FO_RESERVED_2);
     // create_nav_button(parent, "SD Card", btn_sdcard_cb, FO_RESERVED_3);
     // create_nav_button(parent, "Updates", btn_update_cb, FO_RESERVED_4);
@@ -1,23 +1,185 @@
+// gui/pages/page_lipo.cpp - LiPo checker
+// Shows the cell voltages measured on the balancer taps (src/lipo_monitor.cpp).
+// The monitor samples while this page is open and publishes at display rate.
+// "Measure IR" pulses the test load; the resistance of each cell is shown next
+// to its voltage, the load current in the total row.
+
 #include "lvgl.h"
 #include "gui/fonts.h"
 #include "gui/color_palette.h"
 #include "gui/lang.h"
 #include "gui/input.h"
 #include "gui/gui.h"
+#include "lipo_monitor.h"
+#include <cstdio>
+#include <cstring>
 
 // =============================================================================
 // Focus Order Configuration
 // =============================================================================
 enum FocusOrder {
-    FO_BTN_HOME     = 0,
-    FO_BTN_PREV     = 1,
-    FO_BTN_NEXT     = 2,
-    FO_BTN_SETTINGS = 3,
+    FO_BTN_MEASURE  = 0,
+    FO_BTN_HOME     = 1,
+    FO_BTN_PREV     = 2,
+    FO_BTN_NEXT     = 3,
+    FO_BTN_SETTINGS = 4,
 };
 
 // Focus group builder for this page
 static FocusOrderBuilder focus_builder;
 
+// =============================================================================
+// Layout
+// =============================================================================
+static constexpr uint32_t REFRESH_MS = LIPO_PUBLISH_MS;
+static constexpr lv_coord_t ROW_H = 28;
+static constexpr lv_coord_t NAME_W = 80;
+static constexpr lv_coord_t VALUE_W = 130;
+static constexpr lv_coord_t IR_W = 90;
+
+struct CellRow {
+    lv_obj_t* row;
+    lv_obj_t* value;
+    lv_obj_t* ir;
+};
+
+static CellRow cell_rows[LIPO_MAX_CELLS];
+static CellRow total_row;
+static lv_obj_t* lbl_status = nullptr;
+static lv_obj_t* btn_measure = nullptr;
+static lv_timer_t* refresh_timer = nullptr;
+
+static uint8_t ir_cells = 0;        // Cell count of the IR result shown (0 = none)
+static char ir_status[40] = "";
+
+// Set label text only if it changed
+static void set_text_if_changed(lv_obj_t* lbl, const char* text) {
+    if (strcmp(lv_label_get_text(lbl), text) != 0) {
+        lv_label_set_text(lbl, text);
+    }
+}
+
+// mV -> "3.852 V"
+static void format_volts(char* buf, size_t len, uint32_t mv) {
+    snprintf(buf, len, "%lu.%03lu V", (unsigned long)(mv / 1000), (unsigned long)(mv % 1000));
+}
+
+static void show(lv_obj_t* obj, bool visible) {
+    if (visible) lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    else lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+}
+
+// 0.1 mOhm -> "12.3 mOhm"
+static void format_ir(char* buf, size_t len, uint16_t x10_mohm) {
+    snprintf(buf, len, "%u.%u mOhm", (unsigned)(x10_mohm / 10), (unsigned)(x10_mohm % 10));
+}
+
+static void clear_ir() {
+    for (auto& cr : cell_rows) set_text_if_changed(cr.ir, "");
+    set_text_if_changed(total_row.ir, "");
+    ir_cells = 0;
+    ir_status[0] = '\0';
+}
+
+static void show_ir(const LipoIrResult& ir) {
+    clear_ir();
+    if (!ir.valid) {
+        snprintf(ir_status, sizeof(ir_status), "%s", tr(STR_LIPO_IR_FAILED));
+        return;
+    }
+    char buf[24];
+    for (uint8_t i = 0; i < ir.cells && i < LIPO_MAX_CELLS; i++) {
+        format_ir(buf, sizeof(buf), ir.ir_x10_mohm[i]);
+        set_text_if_changed(cell_rows[i].ir, buf);
+    }
+    snprintf(buf, sizeof(buf), "%u.%02u A", (unsigned)(ir.current_ma / 1000), (unsigned)(ir.current_ma % 1000 / 10));
+    set_text_if_changed(total_row.ir, buf);
+    snprintf(ir_status, sizeof(ir_status), "%s %u%%", tr(STR_LIPO_CONFIDENCE),
+             (unsigned)((ir.confidence_permille + 5) / 10));
+    ir_cells = ir.cells;
+}
+
+static void update(const LipoReading& r) {
+    char buf[24];
+    // Battery changed: the resistances belong to the previous one
+    if (ir_cells && r.cells != ir_cells) clear_ir();
+
+    for (uint8_t i = 0; i < LIPO_MAX_CELLS; i++) {
+        show(cell_rows[i].row, i < r.cells);
+        if (i >= r.cells) continue;
+        format_volts(buf, sizeof(buf), r.cell_mv[i]);
+        set_text_if_changed(cell_rows[i].value, buf);
+        // Still converging: gray
+        lv_obj_set_style_text_color(cell_rows[i].value,
+            lv_color_hex(r.settled ? GUI_COLOR_MONO[0] : GUI_COLOR_GRAYS[0]), 0);
+    }
+
+    show(total_row.row, r.cells > 1);
+    format_volts(buf, sizeof(buf), r.total_mv);
+    set_text_if_changed(total_row.value, buf);
+
+    if (r.cells == 0) {
+        set_text_if_changed(lbl_status, tr(STR_LIPO_NO_BATTERY));
+    } else if (r.implausible) {
+        set_text_if_changed(lbl_status, tr(STR_LIPO_IMPLAUSIBLE));
+    } else if (lipo_monitor_ir_running()) {
+        set_text_if_changed(lbl_status, tr(STR_SERVO_TEST_MEASURING));
+    } else if (ir_status[0]) {
+        set_text_if_changed(lbl_status, ir_status);
+    } else if (!r.calibrated) {
+        set_text_if_changed(lbl_status, tr(STR_LIPO_UNCALIBRATED));
+    } else {
+        set_text_if_changed(lbl_status, "");
+    }
+
+    if (r.cells == 0 || lipo_monitor_ir_running()) lv_obj_add_state(btn_measure, LV_STATE_DISABLED);
+    else lv_obj_clear_state(btn_measure, LV_STATE_DISABLED);
+}
+
+static void refresh_timer_cb(lv_timer_t* t) {
+    LV_UNUSED(t);
+    LipoIrResult ir;
+    if (lipo_monitor_poll_ir(ir)) show_ir(ir);
+    LipoReading r;
+    if (lipo_monitor_poll(r)) update(r);
+}
+
+static void btn_measure_event_cb(lv_event_t* e) {
+    LV_UNUSED(e);
+    lipo_monitor_measure_ir();
+    lv_obj_add_state(btn_measure, LV_STATE_DISABLED);
+}
+
+static CellRow make_row(lv_obj_t* parent, const char* name) {
+    CellRow cr;
+    cr.row = lv_obj_create(parent);
+    lv_obj_remove_style_all(cr.row);
+    lv_obj_set_size(cr.row, LV_PCT(100), ROW_H);
+    lv_obj_set_flex_flow(cr.row, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(cr.row, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_clear_flag(cr.row, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t* lbl = lv_label_create(cr.row);
+    lv_obj_set_width(lbl, NAME_W);
+    lv_obj_set_style_text_font(lbl, FONT_BOLD_MD, 0);
+    lv_obj_set_style_text_color(lbl, lv_color_hex(GUI_COLOR_GRAYS[0]), 0);
+    lv_label_set_text(lbl, name);
+
+    cr.value = lv_label_create(cr.row);
+    lv_obj_set_width(cr.value, VALUE_W);
+    lv_obj_set_style_text_font(cr.value, FONT_MONO_BOLD_LG, 0);
+    lv_obj_set_style_text_align(cr.value, LV_TEXT_ALIGN_RIGHT, 0);
+    lv_label_set_text(cr.value, "");
+
+    cr.ir = lv_label_create(cr.row);
+    lv_obj_set_width(cr.ir, IR_W);
+    lv_obj_set_style_text_font(cr.ir, FONT_MONO_SM, 0);
+    lv_obj_set_style_text_align(cr.ir, LV_TEXT_ALIGN_RIGHT, 0);
+    lv_label_set_text(cr.ir, "");
+    show(cr.row, false);
+    return cr;
+}
+
 void page_lipo_create(lv_obj_t* parent) {
     // Initialize focus builder
     focus_builder.init();
@@ -25,14 +187,54 @@ void page_lipo_create(lv_obj_t* parent) {
     // Record this page in navigation history
     input_push_page(PAGE_LIPO);
 
-    lv_obj_t* label = lv_label_create(parent);
-    lv_label_set_text(label, tr(STR_LIPO_CONTENT));
-    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_style_text_font(label, FONT_DEFAULT, 0);
-    lv_obj_set_style_text_color(label, lv_color_hex(GUI_COLOR_SHADES[7]), 0);
-    lv_obj_center(label);
+    lv_obj_set_flex_flow(parent, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(parent, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_all(parent, 6, 0);
+    lv_obj_set_style_pad_row(parent, 2, 0);
+    lv_obj_clear_flag(parent, LV_OBJ_FLAG_SCROLLABLE);
+
+    char name[24];
+    for (uint8_t i = 0; i < LIPO_MAX_CELLS; i++) {
+        snprintf(name, sizeof(name), "%s %u", tr(STR_LIPO_CELL), (unsigned)(i + 1));
+        cell_rows[i] = make_row(parent, name);
+    }
+    total_row = make_row(parent, tr(STR_LIPO_TOTAL));
+
+    // Status and IR button share the bottom row
+    lv_obj_t* row_bottom = lv_obj_create(parent);
+    lv_obj_remove_style_all(row_bottom);
+    lv_obj_set_size(row_bottom, LV_PCT(100), ROW_H);
+    lv_obj_set_flex_flow(row_bottom, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(row_bottom, LV_FLEX_ALIGN_SPACE_BETWEEN, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_clear_flag(row_bottom, LV_OBJ_FLAG_SCROLLABLE);
+
+    lbl_status = lv_label_create(row_bottom);
+    lv_obj_set_flex_grow(lbl_status, 1);
+    lv_obj_set_style_text_font(lbl_status, FONT_DEFAULT, 0);
+    lv_obj_set_style_text_color(lbl_status, lv_color_hex(GUI_COLOR_SHADES[7]), 0);
+    lv_label_set_long_mode(lbl_status, LV_LABEL_LONG_CLIP);
+    lv_label_set_text(lbl_status, "");
 
-    // Add footer buttons to focus order
+    btn_measure = lv_button_create(row_bottom);
+    lv_obj_set_size(btn_measure, 110, 24);
+    lv_obj_add_event_cb(btn_measure, btn_measure_event_cb, LV_EVENT_CLICKED, nullptr);
+    lv_obj_set_style_bg_color(btn_measure, lv_color_hex(GUI_COLOR_MONO[1]), 0);
+    lv_obj_set_style_bg_color(btn_measure, lv_color_hex(GUI_COLOR_GRAYS[0]), LV_STATE_DISABLED);
+    lv_obj_set_style_text_color(btn_measure, lv_color_white(), 0);
+    lv_obj_add_state(btn_measure, LV_STATE_DISABLED);   // Until a battery is seen
+
+    lv_obj_t* lbl_measure = lv_label_create(btn_measure);
+    lv_label_set_text(lbl_measure, tr(STR_LIPO_MEASURE_IR));
+    lv_obj_set_style_text_font(lbl_measure, FONT_DEFAULT, 0);
+    lv_obj_center(lbl_measure);
+
+    ir_cells = 0;
+    ir_status[0] = '\0';
+    lipo_monitor_start();
+    refresh_timer = lv_timer_create(refresh_timer_cb, REFRESH_MS, nullptr);
+
+    // Add buttons to focus order
+    focus_builder.add(btn_measure, FO_BTN_MEASURE);
     focus_builder.add(gui_get_btn_home(), FO_BTN_HOME);
     focus_builder.add(gui_get_btn_prev(), FO_BTN_PREV);
     focus_builder.add(gui_get_btn_next(), FO_BTN_NEXT);
@@ -43,5 +245,21 @@ void page_lipo_create(lv_obj_t* parent) {
 }
 
 void page_lipo_destroy() {
+    if (refresh_timer) {
+        lv_timer_delete(refresh_timer);
+        refresh_timer = nullptr;
+    }
+    lipo_monitor_stop();
+
+    // Drop a reading/result still queued for the deleted labels
+    LipoReading stale;
+    lipo_monitor_poll(stale);
+    LipoIrResult stale_ir;
+    while (lipo_monitor_poll_ir(stale_ir)) {}
+
     focus_builder.destroy();
+    memset(cell_rows, 0, sizeof(cell_rows));
+    total_row = CellRow{};
+    lbl_status = nullptr;
+    btn_measure = nullptr;
 }
@@ -4,6 +4,7 @@
 #include "gui/lang.h"
 #include "gui/input.h"
 #include "gui/gui.h"
+#include "gui/log_ring.h"
 #include <cstring>
 
 // =============================================================================
@@ -25,55 +26,102 @@ static FocusOrderBuilder focus_builder;
 // =============================================================================
 
 static lv_obj_t* log_textarea = nullptr;
+static lv_timer_t* refresh_timer = nullptr;
+
+// Byte-packed message history (survives page changes)
+#define LOG_RING_BYTES   4096
+#define MAX_MSG_LENGTH   128     // Longer messages are truncated
+static LogRing<LOG_RING_BYTES> log_ring;
+
+// Incremental view: the textarea shows at most MAX_VIEW_LINES lines.
+// New lines are appended, old ones cut from the top in batches of TRIM_BATCH.
+#define MAX_VIEW_LINES   50
+#define TRIM_BATCH       10
+#define REFRESH_MS       20      // One refresh per display frame at most
+static uint32_t shown_seq = 0;   // Next ring line not yet in the textarea
+static int view_lines = 0;       // Lines currently in the textarea
+
+// Append ring lines since `from_seq` to the textarea in one text insert per chunk
+static void append_lines(uint32_t from_seq) {
+    static char chunk[1024];
+    size_t used = 0;
+
+    log_ring.for_each_since(from_seq, [&](const char* line, size_t len) {
+        if (len > MAX_MSG_LENGTH - 1) len = MAX_MSG_LENGTH - 1;
+        if (used + len + 2 > sizeof(chunk)) {
+            lv_textarea_add_text(log_textarea, chunk);
+            used = 0;
+        }
+        if (view_lines > 0) chunk[used++] = '\n';
+        memcpy(chunk + used, line, len);
+        used += len;
+        chunk[used] = '\0';
+        view_lines++;
+    });
+    if (used > 0) lv_textarea_add_text(log_textarea, chunk);
+}
 
-// Circular buffer for messages
-#define MAX_LOG_MESSAGES 50
-#define MAX_MSG_LENGTH 128
-static char log_buffer[MAX_LOG_MESSAGES][MAX_MSG_LENGTH];
-static int log_write_idx = 0;
-static int log_count = 0;
+// Cut the oldest lines so only MAX_VIEW_LINES remain
+static void trim_top() {
+    if (view_lines <= MAX_VIEW_LINES + TRIM_BATCH) return;
 
-// Update the text area with all messages
-static void update_display() {
-    if (!log_textarea) return;
+    lv_obj_t* label = lv_textarea_get_label(log_textarea);
+    const char* text = lv_label_get_text(label);
+    int cut_lines = view_lines - MAX_VIEW_LINES;
 
-    // Build text from circular buffer
-    static char full_text[MAX_LOG_MESSAGES * MAX_MSG_LENGTH];
-    full_text[0] = '\0';
+    // Find the start of the first line we keep
+    const char* p = text;
+    for (int i = 0; i < cut_lines && p; i++) {
+        p = strchr(p, '\n');
+        if (p) p++;
+    }
+    if (!p) return;
 
-    int start = (log_count >= MAX_LOG_MESSAGES) ? log_write_idx : 0;
-    int num_msgs = (log_count < MAX_LOG_MESSAGES) ? log_count : MAX_LOG_MESSAGES;
+    uint32_t cut_chars = lv_text_encoded_get_char_id(text, (uint32_t)(p - text));
+    lv_label_cut_text(label, 0, cut_chars);
+    view_lines -= cut_lines;
+}
 
-    for (int i = 0; i < num_msgs; i++) {
-        int idx = (start + i) % MAX_LOG_MESSAGES;
-        strcat(full_text, log_buffer[idx]);
-        if (i < num_msgs - 1) {
-            strcat(full_text, "\n");
-        }
-    }
+// Bring the textarea up to date with the ring (called from refresh_timer)
+static void update_display() {
+    if (!log_textarea) return;
 
-    lv_textarea_set_text(log_textarea, full_text);
+    if (view_lines == 0 || (int32_t)(log_ring.first_seq() - shown_seq) > 0) {
+        // Lines we never showed were already evicted: rebuild from the newest lines
+        lv_textarea_set_text(log_textarea, "");
+        view_lines = 0;
+        uint32_t newest = log_ring.next_seq();
+        uint32_t from = (log_ring.line_count() > MAX_VIEW_LINES) ? newest - MAX_VIEW_LINES : log_ring.first_seq();
+        append_lines(from);
+    } else {
+        append_lines(shown_seq);
+        trim_top();
+    }
+    shown_seq = log_ring.next_seq();
 
-    // Scroll to bottom
+    // Keep the cursor at the end so the next append goes there, then scroll to bottom
+    lv_textarea_set_cursor_pos(log_textarea, LV_TEXTAREA_CURSOR_LAST);
     lv_obj_scroll_to_y(log_textarea, LV_COORD_MAX, LV_ANIM_OFF);
 }
 
+static void refresh_timer_cb(lv_timer_t* t) {
+    update_display();
+    lv_timer_pause(t);   // Resumed by the next message
+}
+
 void page_serial_add_message(const char* msg) {
     if (!msg) return;
 
-    // Copy message to buffer
-    strncpy(log_buffer[log_write_idx], msg, MAX_MSG_LENGTH - 1);
-    log_buffer[log_write_idx][MAX_MSG_LENGTH - 1] = '\0';
+    log_ring.push(msg);
 
-    log_write_idx = (log_write_idx + 1) % MAX_LOG_MESSAGES;
-    log_count++;
-
-    update_display();
+    // Coalesce: the view catches up once per frame, not once per line
+    if (refresh_timer) lv_timer_resume(refresh_timer);
 }
 
 void page_serial_clear() {
-    log_write_idx = 0;
-    log_count = 0;
+    log_ring.clear();
+    shown_seq = log_ring.next_seq();
+    view_lines = 0;
     if (log_textarea) {
         lv_textarea_set_text(log_textarea, "");
     }
@@ -122,8 +170,13 @@ void page_serial_create(lv_obj_t* parent) {
     lv_textarea_set_cursor_click_pos(log_textarea, false);  // Disable cursor
 
     // Show any buffered messages
+    view_lines = 0;
     update_display();
 
+    // Coalesced refresh for messages arriving while the page is open
+    refresh_timer = lv_timer_create(refresh_timer_cb, REFRESH_MS, nullptr);
+    lv_timer_pause(refresh_timer);
+
     // Add buttons to focus order
     focus_builder.add(btn_clear, FO_BTN_CLEAR);
     focus_builder.add(gui_get_btn_home(), FO_BTN_HOME);
@@ -134,5 +187,9 @@ void page_serial_create(lv_obj_t* parent) {
 }
 
 void page_serial_destroy() {
+    if (refresh_timer) {
+        lv_timer_delete(refresh_timer);
+        refresh_timer = nullptr;
+    }
     log_textarea = nullptr;
 }
@@ -41,8 +41,11 @@ namespace {
     // Number of servos (use from settings.h)
     // constexpr int NUM_SERVOS = 6;  // Now defined in settings.h
 
-    // Timer interval (50Hz update rate)
-    constexpr uint32_t SWEEP_INTERVAL_MS = 20;
+    // Readout refresh while sweeping (the sweep itself runs in the servo driver)
+    constexpr uint32_t READOUT_INTERVAL_MS = 40;
+
+    // servo_sweep_step is µs per 20 ms tick (the original sweep rate)
+    constexpr uint32_t SWEEP_STEP_RATE_HZ = 50;
 
     // UI dimensions
     constexpr lv_coord_t BTN_SM = 65, BTN_MD = 90, BTN_H = 30, ROW_H = 35;
@@ -68,9 +71,6 @@ struct ServoState {
     // Per-servo PWM values (each servo maintains its own position)
     int pwm[NUM_SERVOS] = {1500, 1500, 1500, 1500, 1500, 1500};
 
-    // Per-servo sweep direction (1 = increasing, -1 = decreasing)
-    int direction[NUM_SERVOS] = {1, 1, 1, 1, 1, 1};
-
     bool auto_mode = true;
     bool running = false;
     lv_timer_t* timer = nullptr;
@@ -96,7 +96,6 @@ struct ServoState {
     void reset() {
         for (int i = 0; i < NUM_SERVOS; i++) {
             pwm[i] = PWM_CENTER;
-            direction[i] = 1;
         }
         auto_mode = true; running = false; selected = 0x01;
     }
@@ -183,7 +182,43 @@ struct ServoState {
         }
     }
 
+    bool sweeping() const { return auto_mode && running; }
+
+    // Sweep settings as a driver trajectory
+    static ServoTrajectory sweep_trajectory() {
+        ServoTrajectory traj = {};
+        traj.profile = static_cast<ServoProfile>(g_settings.servo_sweep_profile);
+        traj.min_us = static_cast<uint16_t>(PWM_MIN);
+        traj.max_us = static_cast<uint16_t>(PWM_MAX);
+        traj.dwell_ms = g_settings.servo_sweep_dwell_ms;
+        traj.speed_us_per_s = g_settings.servo_sweep_step * SWEEP_STEP_RATE_HZ;
+        return traj;
+    }
+
+    // Copy positions reported by the driver (trajectory running or just stopped)
+    void read_back_positions() {
+        for (int i = 0; i < NUM_SERVOS; i++) {
+            if (is_servo_selected(i)) pwm[i] = servo_get_pulse(static_cast<uint8_t>(i));
+        }
+    }
+
     void update_display() {
+        update_readout();
+
+        // 5. Output PWM to all selected servos with their individual values,
+        //    latched together at the same PWM period boundary.
+        //    While sweeping the trajectory engine owns the outputs.
+        if (sweeping()) return;
+        ServoFrame frame;
+        for (int i = 0; i < NUM_SERVOS; i++) {
+            if (is_servo_selected(i)) {
+                frame.set_us(static_cast<uint8_t>(i), static_cast<uint16_t>(pwm[i]));
+            }
+        }
+        servo_commit(frame);
+    }
+
+    void update_readout() {
         // === OPTIMIZATION: Only update widgets if value actually changed ===
         // This prevents unnecessary LVGL invalidations and reduces flicker.
         // Key: Use lv_label_set_text_static when possible, and always use LV_ANIM_OFF
@@ -219,13 +254,6 @@ struct ServoState {
         if (current_slider_val != slider_val) {
             lv_slider_set_value(slider, slider_val, LV_ANIM_OFF);
         }
-
-        // 5. Output PWM to each selected servo with its individual value
-        for (int i = 0; i < NUM_SERVOS; i++) {
-            if (is_servo_selected(i)) {
-                servo_set_pulse(static_cast<uint8_t>(i), static_cast<uint16_t>(pwm[i]));
-            }
-        }
     }
 
     void update_ui() {
@@ -316,29 +344,25 @@ static lv_obj_t* make_btn(lv_obj_t* p, const char* txt, int w, lv_color_t col, l
     return b;
 }
 
+// Start/stop the driver trajectory on the selected servos
+static void sweep_start() {
+    if (S.timer) lv_timer_resume(S.timer);
+    servo_trajectory_start(S.selected, ServoState::sweep_trajectory());
+}
+
+static void sweep_stop() {
+    if (S.timer) lv_timer_pause(S.timer);
+    servo_trajectory_stop(SERVO_MASK_ALL);
+    S.read_back_positions();
+}
+
 // Callbacks
 static void on_timer(lv_timer_t* t) {
-    if (!S.running || !S.auto_mode) return;
-
-    // Apply sweep delta to each selected servo individually
-    // All servos use the same sweep step (adjustable via encoder)
-    int step = g_settings.servo_sweep_step;
-    for (int i = 0; i < NUM_SERVOS; i++) {
-        if (S.is_servo_selected(i)) {
-            S.pwm[i] += S.direction[i] * step;
-
-            // Check bounds and reverse direction for THIS servo
-            if (S.pwm[i] >= PWM_MAX) {
-                S.pwm[i] = PWM_MAX;
-                S.direction[i] = -1;
-            } else if (S.pwm[i] <= PWM_MIN) {
-                S.pwm[i] = PWM_MIN;
-                S.direction[i] = 1;
-            }
-        }
-    }
+    if (!S.sweeping()) return;
 
-    S.update_display();
+    // Display only - positions come from the driver's trajectory engine
+    S.read_back_positions();
+    S.update_readout();
 }
 
 // Servo selection callbacks
@@ -352,6 +376,10 @@ static void on_servo_toggle(lv_event_t* e) {
     if (enabled) {
         // Output this servo's individual PWM value
         servo_set_pulse(static_cast<uint8_t>(idx), static_cast<uint16_t>(S.pwm[idx]));
+        // Join a running sweep from the current position
+        if (S.sweeping()) servo_trajectory_start(static_cast<uint8_t>(1 << idx), ServoState::sweep_trajectory());
+    } else {
+        servo_trajectory_stop(static_cast<uint8_t>(1 << idx));
     }
     // Update display to show the new primary servo's value
     S.update_display();
@@ -362,14 +390,20 @@ static void on_long_press_toggle_all() {
     // Toggle all servos - useful shortcut accessible from any focus position
     if (S.all_selected()) {
         S.deselect_all();
+        servo_trajectory_stop(SERVO_MASK_ALL);
         servo_disable_all();
     } else {
+        // Servos already sweeping keep their trajectory
+        uint8_t joining = static_cast<uint8_t>(((1 << NUM_SERVOS) - 1) & ~S.selected);
         S.select_all();
         // Enable all servos and output their individual PWM values
         for (int i = 0; i < NUM_SERVOS; i++) {
             servo_enable(static_cast<uint8_t>(i), true);
-            servo_set_pulse(static_cast<uint8_t>(i), static_cast<uint16_t>(S.pwm[i]));
+            if (joining & (1 << i)) {
+                servo_set_pulse(static_cast<uint8_t>(i), static_cast<uint16_t>(S.pwm[i]));
+            }
         }
+        if (S.sweeping()) servo_trajectory_start(joining, ServoState::sweep_trajectory());
     }
     S.update_servo_buttons();
     S.update_display();
@@ -397,6 +431,7 @@ static bool on_encoder_rotation(int delta) {
         if (new_step < 1) new_step = 1;
         if (new_step > 100) new_step = 100;
         g_settings.servo_sweep_step = (uint8_t)new_step;
+        servo_trajectory_set_speed(S.selected, g_settings.servo_sweep_step * SWEEP_STEP_RATE_HZ);
         // Note: settings_save() is called when STOP is pressed, not on every tick
         return true;  // We handled the rotation
     }
@@ -437,7 +472,7 @@ static void on_manual(lv_event_t*) {
     if (S.running) return;
     S.auto_mode = false;
     S.running = false;
-    if (S.timer) lv_timer_pause(S.timer);
+    sweep_stop();
     S.update_ui();
 }
 
@@ -445,7 +480,12 @@ static void on_start_stop(lv_event_t*) {
     if (!S.auto_mode) return;
     bool was_running = S.running;
     S.running = !S.running;
-    if (S.timer) S.running ? lv_timer_resume(S.timer) : lv_timer_pause(S.timer);
+    if (S.running) {
+        sweep_start();
+    } else {
+        sweep_stop();
+        S.update_display();
+    }
     // Persist sweep step when stopping (may have been adjusted via encoder)
     if (was_running && !S.running) {
         settings_save();
@@ -512,9 +552,9 @@ void page_servo_create(lv_obj_t* parent) {
     // Register double-click callback: in manual mode, switch to auto instead of going back
     focus_builder.set_double_click_cb(on_double_click);
 
-    // Timer
+    // Readout timer (runs only while sweeping)
     if (S.timer) lv_timer_delete(S.timer);
-    S.timer = lv_timer_create(on_timer, SWEEP_INTERVAL_MS, nullptr);
+    S.timer = lv_timer_create(on_timer, READOUT_INTERVAL_MS, nullptr);
     lv_timer_pause(S.timer);
 
     // Main layout: horizontal row with sidebar + content
@@ -648,6 +688,9 @@ void page_servo_create(lv_obj_t* parent) {
     S.update_ui();
     S.update_servo_buttons();
 
+    // Frame rate from settings (e.g. 333 Hz for fast digital servos)
+    servo_set_frequency(SERVO_MASK_ALL, g_settings.servo_frequency);
+
     // Enable initially selected servo(s) and set their individual pulses
     for (int i = 0; i < NUM_SERVOS; i++) {
         if (S.is_servo_selected(i)) {
@@ -668,6 +711,7 @@ void page_servo_create(lv_obj_t* parent) {
 
 void page_servo_destroy() {
     S.running = false;
+    servo_trajectory_stop(SERVO_MASK_ALL);
     servo_disable_all();  // Stop all servo outputs
     if (S.timer) { lv_timer_delete(S.timer); S.timer = nullptr; }
     focus_builder.destroy();
@@ -678,16 +722,29 @@ void page_servo_on_hide() {
     // Stop sweep when leaving page (but don't destroy timer)
     if (S.running) {
         S.running = false;
-        if (S.timer) lv_timer_pause(S.timer);
+        sweep_stop();
         S.update_ui();
     }
     servo_disable_all();  // Stop all servo outputs when hiding
 }
 
+void page_servo_on_show() {
+    // Cached page shown again: settings may have changed while it was hidden
+    servo_set_frequency(SERVO_MASK_ALL, g_settings.servo_frequency);
+    for (int i = 0; i < NUM_SERVOS; i++) {
+        S.clamp(i);
+        if (S.is_servo_selected(i)) servo_enable(static_cast<uint8_t>(i), true);
+    }
+    S.update_servo_buttons();
+    S.update_ui();
+    S.update_display();  // Outputs the selected servos again
+}
+
 bool page_servo_is_running() { return S.running && S.auto_mode; }
 
 void page_servo_stop() {
     S.running = false;
+    servo_trajectory_stop(SERVO_MASK_ALL);
     if (S.timer) { lv_timer_delete(S.timer); S.timer = nullptr; }
 }
 
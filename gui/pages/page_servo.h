@@ -3,6 +3,7 @@
 
 void page_servo_create(lv_obj_t* parent);
 void page_servo_destroy();
+void page_servo_on_show();  // Restore outputs when shown again (page cache)
 void page_servo_on_hide();  // Stop sweep when leaving page
 
 // For encoder/keyboard: adjust PWM value by delta (e.g., +10 or -10)
@@ -0,0 +1,330 @@
+// gui/pages/page_servo_test.cpp - Servo response measurement (sub-page of the servo tester)
+// Steps one servo between two positions and measures its feedback on an ADC
+// input (src/servo_test.cpp): dead time, rise time, slew rate, overshoot and
+// deadband. The step range is center +- half the configured min/max span.
+// Export prints the runs as CSV to the serial log.
+
+#include "lvgl.h"
+#include "gui/fonts.h"
+#include "gui/color_palette.h"
+#include "gui/lang.h"
+#include "gui/config/settings.h"
+#include "gui/input.h"
+#include "gui/gui.h"
+#include "gui/pages/page_servo_test.h"
+#include "servo_driver.h"
+#include "servo_test.h"
+#include <cstdio>
+#include <cstring>
+
+// =============================================================================
+// Focus Order Configuration
+// =============================================================================
+enum FocusOrder {
+    FO_BTN_SERVO    = 0,
+    FO_BTN_ADC      = 1,
+    FO_BTN_RUNS     = 2,
+    FO_BTN_START    = 3,
+    FO_BTN_EXPORT   = 4,
+    FO_BTN_HOME     = 5,
+    FO_BTN_PREV     = 6,
+    FO_BTN_NEXT     = 7,
+    FO_BTN_SETTINGS = 8,
+};
+
+// Focus group builder for this page
+static FocusOrderBuilder focus_builder;
+
+// =============================================================================
+// Layout
+// =============================================================================
+static constexpr uint32_t REFRESH_MS = 100;
+static constexpr lv_coord_t ROW_H = 17;
+static constexpr lv_coord_t NAME_W = 150;
+static constexpr lv_coord_t VALUE_W = 150;
+
+static const uint8_t RUN_CHOICES[] = { 5, 10, 20 };
+static constexpr int NUM_RUN_CHOICES = sizeof(RUN_CHOICES) / sizeof(RUN_CHOICES[0]);
+
+enum Metric { M_DEAD = 0, M_RISE, M_SLEW, M_OVERSHOOT, M_DEADBAND, M_COUNT };
+static const StringId METRIC_NAMES[M_COUNT] = {
+    STR_SERVO_TEST_DEAD_TIME, STR_SERVO_TEST_RISE, STR_SERVO_TEST_SLEW,
+    STR_SERVO_TEST_OVERSHOOT, STR_SERVO_TEST_DEADBAND
+};
+
+// Selection, kept across page visits
+static uint8_t sel_servo = 0;
+static uint8_t sel_adc = 0;
+static uint8_t sel_runs = 1;    // Index into RUN_CHOICES
+
+static lv_obj_t* values[M_COUNT];
+static lv_obj_t* lbl_status = nullptr;
+static lv_obj_t* lbl_servo = nullptr;
+static lv_obj_t* lbl_adc = nullptr;
+static lv_obj_t* lbl_runs = nullptr;
+static lv_obj_t* lbl_start = nullptr;
+static lv_obj_t* btn_export = nullptr;
+static lv_timer_t* refresh_timer = nullptr;
+static ServoTestState shown_state = SERVO_TEST_IDLE;
+static uint8_t shown_progress = 0xFF;
+
+// Set label text only if it changed
+static void set_text_if_changed(lv_obj_t* lbl, const char* text) {
+    if (strcmp(lv_label_get_text(lbl), text) != 0) {
+        lv_label_set_text(lbl, text);
+    }
+}
+
+// µs -> "12.3 ms"
+static void format_ms(char* buf, size_t len, uint32_t us) {
+    uint32_t tenths = (us + 50) / 100;
+    snprintf(buf, len, "%lu.%lu ms", (unsigned long)(tenths / 10), (unsigned long)(tenths % 10));
+}
+
+static void update_selection_labels() {
+    lv_label_set_text_fmt(lbl_servo, "Servo %d", sel_servo + 1);
+    lv_label_set_text_fmt(lbl_adc, "ADC %d", sel_adc + 1);
+    lv_label_set_text_fmt(lbl_runs, "%ux", (unsigned)RUN_CHOICES[sel_runs]);
+}
+
+static void show_result() {
+    ServoTestResult r;
+    if (!servo_test_result(r)) {
+        for (int m = 0; m < M_COUNT; m++) set_text_if_changed(values[m], "--");
+        return;
+    }
+
+    char buf[32];
+    char lo[12], hi[12];
+    format_ms(buf, sizeof(buf), r.dead_mean_us);
+    format_ms(lo, sizeof(lo), r.dead_min_us);
+    format_ms(hi, sizeof(hi), r.dead_max_us);
+    // "9.8 ms (9.6..10.1)": drop the unit from min/max
+    lo[strlen(lo) - 3] = '\0';
+    hi[strlen(hi) - 3] = '\0';
+    char dead[48];
+    snprintf(dead, sizeof(dead), "%s (%s..%s)", buf, lo, hi);
+    set_text_if_changed(values[M_DEAD], dead);
+
+    format_ms(buf, sizeof(buf), r.rise_mean_us);
+    set_text_if_changed(values[M_RISE], buf);
+
+    uint32_t slew_tenths = (r.slew_us_per_s + 50) / 100;   // µs/ms with one decimal
+    snprintf(buf, sizeof(buf), "%lu.%lu us/ms", (unsigned long)(slew_tenths / 10), (unsigned long)(slew_tenths % 10));
+    set_text_if_changed(values[M_SLEW], buf);
+
+    snprintf(buf, sizeof(buf), "%u.%u %%", r.overshoot_permille / 10, r.overshoot_permille % 10);
+    set_text_if_changed(values[M_OVERSHOOT], buf);
+
+    if (r.deadband_us) snprintf(buf, sizeof(buf), "%u us", r.deadband_us);
+    else snprintf(buf, sizeof(buf), "> %u us", SERVO_TEST_DEADBAND_MAX_US);
+    set_text_if_changed(values[M_DEADBAND], buf);
+}
+
+static void update_ui() {
+    ServoTestState st = servo_test_state();
+    uint8_t pct = servo_test_progress();
+    if (st == shown_state && pct == shown_progress) return;
+    bool state_changed = st != shown_state;
+    shown_state = st;
+    shown_progress = pct;
+
+    char buf[48];
+    lv_color_t color = lv_color_hex(GUI_COLOR_GRAYS[0]);
+    switch (st) {
+        case SERVO_TEST_RUNNING:
+            snprintf(buf, sizeof(buf), "%s... %u%%", tr(STR_SERVO_TEST_MEASURING), pct);
+            break;
+        case SERVO_TEST_FAILED:
+            snprintf(buf, sizeof(buf), "%s", tr(servo_test_error() == SERVO_TEST_ERR_ADC
+                                               ? STR_SERVO_TEST_ADC_FAILED : STR_SERVO_TEST_NO_RESPONSE));
+            color = lv_color_hex(GUI_COLOR_TRIAD[0]);
+            break;
+        default:
+            buf[0] = '\0';
+            break;
+    }
+    set_text_if_changed(lbl_status, buf);
+    lv_obj_set_style_text_color(lbl_status, color, 0);
+
+    if (!state_changed) return;
+    lv_label_set_text(lbl_start, tr(st == SERVO_TEST_RUNNING ? STR_SERVO_STOP : STR_SERVO_START));
+    if (st == SERVO_TEST_DONE) lv_obj_clear_state(btn_export, LV_STATE_DISABLED);
+    else lv_obj_add_state(btn_export, LV_STATE_DISABLED);
+    show_result();
+}
+
+static void refresh_timer_cb(lv_timer_t* t) {
+    LV_UNUSED(t);
+    update_ui();
+}
+
+static void btn_servo_event_cb(lv_event_t* e) {
+    if (lv_event_get_code(e) != LV_EVENT_CLICKED || page_servo_test_is_running()) return;
+    sel_servo = (sel_servo + 1) % NUM_SERVO_PINS;
+    update_selection_labels();
+}
+
+static void btn_adc_event_cb(lv_event_t* e) {
+    if (lv_event_get_code(e) != LV_EVENT_CLICKED || page_servo_test_is_running()) return;
+    sel_adc = (sel_adc + 1) % NUM_ADC_PINS;
+    update_selection_labels();
+}
+
+static void btn_runs_event_cb(lv_event_t* e) {
+    if (lv_event_get_code(e) != LV_EVENT_CLICKED || page_servo_test_is_running()) return;
+    sel_runs = (sel_runs + 1) % NUM_RUN_CHOICES;
+    update_selection_labels();
+}
+
+static void btn_start_event_cb(lv_event_t* e) {
+    if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
+    if (page_servo_test_is_running()) {
+        servo_test_abort();
+        return;
+    }
+
+    // Step between the quarter points of the configured range
+    const uint16_t center = g_settings.servo_pwm_center;
+    const uint16_t quarter = (g_settings.servo_pwm_max - g_settings.servo_pwm_min) / 4;
+    ServoTestConfig config;
+    config.servo = sel_servo;
+    config.adc_input = sel_adc;
+    config.low_us = center - quarter;
+    config.high_us = center + quarter;
+    config.center_us = center;
+    config.runs = RUN_CHOICES[sel_runs];
+
+    servo_set_frequency(static_cast<uint8_t>(1 << sel_servo), g_settings.servo_frequency);
+    servo_test_start(config);
+    update_ui();
+}
+
+static void btn_export_event_cb(lv_event_t* e) {
+    if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
+        servo_test_export();
+    }
+}
+
+// Row container: cells laid out left to right, no scrolling
+static lv_obj_t* make_row(lv_obj_t* parent, lv_coord_t height) {
+    lv_obj_t* row = lv_obj_create(parent);
+    lv_obj_remove_style_all(row);
+    lv_obj_set_size(row, LV_PCT(100), height);
+    lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(row, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_clear_flag(row, LV_OBJ_FLAG_SCROLLABLE);
+    return row;
+}
+
+static lv_obj_t* make_button(lv_obj_t* parent, lv_coord_t width, const char* text,
+                             lv_event_cb_t cb, lv_obj_t** label_out) {
+    lv_obj_t* btn = lv_button_create(parent);
+    lv_obj_set_size(btn, width, 24);
+    lv_obj_add_event_cb(btn, cb, LV_EVENT_CLICKED, nullptr);
+    lv_obj_set_style_bg_color(btn, lv_color_hex(GUI_COLOR_MONO[1]), 0);
+    lv_obj_set_style_text_color(btn, lv_color_white(), 0);
+
+    lv_obj_t* lbl = lv_label_create(btn);
+    lv_label_set_text(lbl, text);
+    lv_obj_set_style_text_font(lbl, FONT_DEFAULT, 0);
+    lv_obj_center(lbl);
+    if (label_out) *label_out = lbl;
+    return btn;
+}
+
+static lv_obj_t* make_cell(lv_obj_t* row, lv_coord_t width, const lv_font_t* font, const char* text) {
+    lv_obj_t* lbl = lv_label_create(row);
+    lv_obj_set_width(lbl, width);
+    lv_obj_set_style_text_font(lbl, font, 0);
+    lv_obj_set_style_text_align(lbl, LV_TEXT_ALIGN_RIGHT, 0);
+    lv_label_set_long_mode(lbl, LV_LABEL_LONG_CLIP);
+    lv_label_set_text(lbl, text);
+    return lbl;
+}
+
+void page_servo_test_create(lv_obj_t* parent) {
+    // Initialize focus builder
+    focus_builder.init();
+
+    // Record this page in navigation history
+    input_push_page(PAGE_SERVO_TEST);
+
+    lv_obj_set_flex_flow(parent, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(parent, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_all(parent, 6, 0);
+    lv_obj_set_style_pad_row(parent, 2, 0);
+    lv_obj_clear_flag(parent, LV_OBJ_FLAG_SCROLLABLE);
+
+    // === Setup: servo, feedback input, repetitions ===
+    lv_obj_t* row_setup = make_row(parent, 28);
+    lv_obj_t* btn_servo = make_button(row_setup, 96, "", btn_servo_event_cb, &lbl_servo);
+    lv_obj_t* btn_adc = make_button(row_setup, 96, "", btn_adc_event_cb, &lbl_adc);
+    lv_obj_t* btn_runs = make_button(row_setup, 96, "", btn_runs_event_cb, &lbl_runs);
+    update_selection_labels();
+
+    // === Results ===
+    for (int m = 0; m < M_COUNT; m++) {
+        lv_obj_t* row = make_row(parent, ROW_H);
+        lv_obj_t* name = make_cell(row, NAME_W, FONT_DEFAULT, tr(METRIC_NAMES[m]));
+        lv_obj_set_style_text_align(name, LV_TEXT_ALIGN_LEFT, 0);
+        lv_obj_set_style_text_color(name, lv_color_hex(GUI_COLOR_GRAYS[0]), 0);
+        values[m] = make_cell(row, VALUE_W, FONT_MONO_SM, "--");
+    }
+
+    lbl_status = lv_label_create(parent);
+    lv_obj_set_width(lbl_status, LV_PCT(100));
+    lv_obj_set_style_text_font(lbl_status, FONT_DEFAULT, 0);
+    lv_obj_set_style_text_align(lbl_status, LV_TEXT_ALIGN_CENTER, 0);
+    lv_label_set_text(lbl_status, "");
+
+    // === Start/stop, export ===
+    lv_obj_t* row_buttons = make_row(parent, 28);
+    lv_obj_t* btn_start = make_button(row_buttons, 120, tr(STR_SERVO_START), btn_start_event_cb, &lbl_start);
+    btn_export = make_button(row_buttons, 120, tr(STR_SERVO_TEST_EXPORT), btn_export_event_cb, nullptr);
+    lv_obj_set_style_bg_color(btn_export, lv_color_hex(GUI_COLOR_GRAYS[0]), LV_STATE_DISABLED);
+
+    // Force the first update (result of an earlier visit, export state)
+    shown_state = static_cast<ServoTestState>(0xFF);
+    shown_progress = 0xFF;
+    update_ui();
+    refresh_timer = lv_timer_create(refresh_timer_cb, REFRESH_MS, nullptr);
+
+    // Add buttons to focus order
+    focus_builder.add(btn_servo, FO_BTN_SERVO);
+    focus_builder.add(btn_adc, FO_BTN_ADC);
+    focus_builder.add(btn_runs, FO_BTN_RUNS);
+    focus_builder.add(btn_start, FO_BTN_START);
+    focus_builder.add(btn_export, FO_BTN_EXPORT);
+    focus_builder.add(gui_get_btn_home(), FO_BTN_HOME);
+    focus_builder.add(gui_get_btn_prev(), FO_BTN_PREV);
+    focus_builder.add(gui_get_btn_next(), FO_BTN_NEXT);
+    focus_builder.add(gui_get_btn_settings(), FO_BTN_SETTINGS);
+    focus_builder.finalize();
+}
+
+void page_servo_test_destroy() {
+    if (refresh_timer) {
+        lv_timer_delete(refresh_timer);
+        refresh_timer = nullptr;
+    }
+    servo_test_abort();
+    servo_disable_all();
+    focus_builder.destroy();
+
+    memset(values, 0, sizeof(values));
+    lbl_status = nullptr;
+    lbl_servo = nullptr;
+    lbl_adc = nullptr;
+    lbl_runs = nullptr;
+    lbl_start = nullptr;
+    btn_export = nullptr;
+}
+
+bool page_servo_test_is_running() {
+    return servo_test_state() == SERVO_TEST_RUNNING;
+}
+
+void page_servo_test_stop() {
+    servo_test_abort();
+}
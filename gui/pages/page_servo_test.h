@@ -0,0 +1,7 @@
+#pragma once
+#include "lvgl.h"
+
+void page_servo_test_create(lv_obj_t* parent);
+void page_servo_test_destroy();
+bool page_servo_test_is_running();
+void page_servo_test_stop();
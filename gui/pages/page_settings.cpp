@@ -4,6 +4,7 @@
 #include "gui/gui.h"
 #include "gui/settings_builder.h"
 #include "gui/config/settings.h"
+#include "gui/config/settings_schema.h"
 #include "gui/lang.h"
 #include "gui/version.h"
 #include "gui/input.h"
@@ -27,205 +28,256 @@ enum FocusOrder {
     FO_PWM_MIN      = 8,
     FO_PWM_CENTER   = 9,
     FO_PWM_MAX      = 10,
-    FO_SERVO_STEP_1 = 11,
-    FO_SERVO_STEP_2 = 12,
-    FO_SERVO_STEP_3 = 13,
-    FO_SERVO_STEP_4 = 14,
-    FO_SERVO_STEP_5 = 15,
-    FO_SERVO_STEP_6 = 16,
-    FO_SERVO_RESET  = 17,
-    FO_SEC_SYSTEM   = 18,
-    FO_BTN_HOME     = 19,
-    FO_BTN_PREV     = 20,
-    FO_BTN_NEXT     = 21,
-    FO_BTN_SETTINGS = 22,
+    FO_SWEEP_PROFILE = 11,
+    FO_SWEEP_DWELL  = 12,
+    FO_SERVO_STEP_1 = 13,
+    FO_SERVO_STEP_2 = 14,
+    FO_SERVO_STEP_3 = 15,
+    FO_SERVO_STEP_4 = 16,
+    FO_SERVO_STEP_5 = 17,
+    FO_SERVO_STEP_6 = 18,
+    FO_SERVO_RESET  = 19,
+    FO_SEC_CG       = 20,
+    FO_CG_LE_OFFSET = 21,
+    FO_CG_DISTANCE  = 22,
+    FO_CG_REF_MASS  = 23,
+    FO_SEC_DEFL     = 24,
+    FO_DEFL_CHORD   = 25,
+    FO_SEC_SYSTEM   = 26,
+    FO_BTN_HOME     = 27,
+    FO_BTN_PREV     = 28,
+    FO_BTN_NEXT     = 29,
+    FO_BTN_SETTINGS = 30,
+    FO_COUNT
 };
+static_assert(FO_COUNT <= MAX_FOCUS_WIDGETS, "Settings focus order exceeds MAX_FOCUS_WIDGETS");
 
 // Focus group builder for this page
 static FocusOrderBuilder focus_builder;
 
-// Language options (must match Language enum order) - kept in native language
-static const char* LANGUAGE_OPTIONS =
-    "English\n"
-    "Deutsch\n"
-    "Français\n"
-    "Español\n"
-    "Italiano\n"
-    "Nederlands\n"
-    "Čeština";
-
-// Servo protocol options (must match ServoProtocol enum order) - industry terms, not translated
-static const char* SERVO_PROTOCOL_OPTIONS =
-    "Standard\n"
-    "Extended\n"
-    "Sanwa\n"
-    "Futaba\n"
-    "Digital Fast\n"
-    "Custom";
-
-// Helper to build translated dropdown options at runtime
-static char bg_color_options[128];
-static char freq_options[64];
-
-static void build_translated_options() {
-    // Background colors
-    snprintf(bg_color_options, sizeof(bg_color_options), "%s\n%s\n%s\n%s\n%s",
-        tr(STR_BG_LIGHT_GRAY), tr(STR_BG_WHITE), tr(STR_BG_LIGHT_BLUE),
-        tr(STR_BG_LIGHT_GREEN), tr(STR_BG_CREAM));
-
-    // Frequency options
-    snprintf(freq_options, sizeof(freq_options), "%s\n%s",
-        tr(STR_FREQ_50HZ), tr(STR_FREQ_333HZ));
-}
+// =============================================================================
+// Layout
+// =============================================================================
+// Rows are fields of SETTINGS_SCHEMA (gui/config/settings_schema.h): the
+// schema gives control, range, label and unit, the page only places them
+enum Section : uint8_t {
+    SEC_LANGUAGE,
+    SEC_DISPLAY,
+    SEC_SERVO,
+    SEC_CG,
+    SEC_DEFL,
+    SEC_SYSTEM,
+    SECTION_COUNT
+};
 
-// UI elements we need to update when protocol changes
-static lv_obj_t* lbl_pwm_min = nullptr;
-static lv_obj_t* lbl_pwm_center = nullptr;
-static lv_obj_t* lbl_pwm_max = nullptr;
-static lv_obj_t* dd_frequency = nullptr;
-static lv_obj_t* dd_protocol = nullptr;
-
-// Per-servo step labels
-static lv_obj_t* lbl_servo_step[NUM_SERVOS] = {};
-static lv_obj_t* sl_servo_step[NUM_SERVOS] = {};
-
-// Helper to update PWM value labels
-static void update_servo_value_labels() {
-    if (lbl_pwm_min) {
-        char buf[16];
-        snprintf(buf, sizeof(buf), "%4d µs", g_settings.servo_pwm_min);
-        lv_label_set_text(lbl_pwm_min, buf);
-    }
-    if (lbl_pwm_center) {
-        char buf[16];
-        snprintf(buf, sizeof(buf), "%4d µs", g_settings.servo_pwm_center);
-        lv_label_set_text(lbl_pwm_center, buf);
-    }
-    if (lbl_pwm_max) {
-        char buf[16];
-        snprintf(buf, sizeof(buf), "%4d µs", g_settings.servo_pwm_max);
-        lv_label_set_text(lbl_pwm_max, buf);
-    }
-    if (dd_frequency) {
-        lv_dropdown_set_selected(dd_frequency, g_settings.servo_frequency == 333 ? 1 : 0);
-    }
-}
+struct SectionInfo {
+    StringId title;
+    FocusOrder focus;
+};
 
-// Callbacks
-static void on_language_change(lv_event_t* e) {
-    lv_obj_t* dd = lv_event_get_target_obj(e);
-    uint16_t sel = lv_dropdown_get_selected(dd);
-    g_settings.language = (uint8_t)sel;
-    lang_set((Language)sel);
-    gui_set_page(PAGE_SETTINGS);  // Refresh to show new language (triggers destroy->save)
-}
+static const SectionInfo SECTIONS[SECTION_COUNT] = {
+    { STR_SETTINGS_LANGUAGE,   FO_SEC_LANGUAGE },
+    { STR_SETTINGS_DISPLAY,    FO_SEC_DISPLAY },
+    { STR_SETTINGS_SERVO,      FO_SEC_SERVO },
+    { STR_SETTINGS_CG_SCALE,   FO_SEC_CG },
+    { STR_SETTINGS_DEFLECTION, FO_SEC_DEFL },
+    { STR_SETTINGS_SYSTEM,     FO_SEC_SYSTEM },
+};
 
-static void on_brightness_change(lv_event_t* e) {
-    lv_obj_t* sl = lv_event_get_target_obj(e);
-    g_settings.brightness = (uint8_t)lv_slider_get_value(sl);
-    // TODO: Apply brightness to display
-}
+struct FieldRow {
+    Section section;
+    SettingId id;
+    uint8_t index;          // Array element
+    FocusOrder focus;
+};
 
-static void on_bg_color_change(lv_event_t* e) {
-    lv_obj_t* dd = lv_event_get_target_obj(e);
-    uint16_t sel = lv_dropdown_get_selected(dd);
-    g_settings.bg_color = (uint8_t)sel;
-    gui_set_bg_color((BgColorPreset)sel);
-}
+static const FieldRow ROWS[] = {
+    { SEC_LANGUAGE, SET_LANGUAGE,             0, FO_LANGUAGE },
+    { SEC_DISPLAY,  SET_BRIGHTNESS,           0, FO_BRIGHTNESS },
+    { SEC_DISPLAY,  SET_BG_COLOR,             0, FO_BACKGROUND },
+    { SEC_SERVO,    SET_SERVO_PROTOCOL,       0, FO_PROTOCOL },
+    { SEC_SERVO,    SET_SERVO_FREQUENCY,      0, FO_FREQUENCY },
+    { SEC_SERVO,    SET_SERVO_PWM_MIN,        0, FO_PWM_MIN },
+    { SEC_SERVO,    SET_SERVO_PWM_CENTER,     0, FO_PWM_CENTER },
+    { SEC_SERVO,    SET_SERVO_PWM_MAX,        0, FO_PWM_MAX },
+    { SEC_SERVO,    SET_SERVO_SWEEP_PROFILE,  0, FO_SWEEP_PROFILE },
+    { SEC_SERVO,    SET_SERVO_SWEEP_DWELL_MS, 0, FO_SWEEP_DWELL },
+    { SEC_SERVO,    SET_SERVO_PWM_STEP,       0, FO_SERVO_STEP_1 },
+    { SEC_SERVO,    SET_SERVO_PWM_STEP,       1, FO_SERVO_STEP_2 },
+    { SEC_SERVO,    SET_SERVO_PWM_STEP,       2, FO_SERVO_STEP_3 },
+    { SEC_SERVO,    SET_SERVO_PWM_STEP,       3, FO_SERVO_STEP_4 },
+    { SEC_SERVO,    SET_SERVO_PWM_STEP,       4, FO_SERVO_STEP_5 },
+    { SEC_SERVO,    SET_SERVO_PWM_STEP,       5, FO_SERVO_STEP_6 },
+    { SEC_CG,       SET_CG_LE_OFFSET_MM,      0, FO_CG_LE_OFFSET },
+    { SEC_CG,       SET_CG_SUPPORT_DIST_MM,   0, FO_CG_DISTANCE },
+    { SEC_CG,       SET_CG_CAL_MASS_G,        0, FO_CG_REF_MASS },
+    { SEC_DEFL,     SET_DEFL_CHORD_MM,        0, FO_DEFL_CHORD },
+};
+constexpr int ROW_COUNT = sizeof(ROWS) / sizeof(ROWS[0]);
 
-// Servo callbacks
-static void on_servo_protocol_change(lv_event_t* e) {
-    lv_obj_t* dd = lv_event_get_target_obj(e);
-    uint16_t sel = lv_dropdown_get_selected(dd);
+// Slider or dropdown of each row
+static lv_obj_t* row_widget[ROW_COUNT] = {};
 
-    if (sel != SERVO_CUSTOM) {
-        servo_apply_preset((ServoProtocol)sel);
-        update_servo_value_labels();
+// =============================================================================
+// Rows
+// =============================================================================
+
+// Slider value label: "1500 µs"
+static void set_slider_label(lv_obj_t* sl, int value, const char* unit) {
+    lv_obj_t* lbl = lv_obj_get_child(lv_obj_get_parent(sl), 1);
+    if (!lbl) return;
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%4d %s", value, unit);
+    lv_label_set_text(lbl, buf);
+}
+
+// Show the current value of a row
+static void refresh_row(int n) {
+    lv_obj_t* w = row_widget[n];
+    if (!w) return;
+    const SettingField& f = settings_field(ROWS[n].id);
+    int32_t value = settings_get(ROWS[n].id, ROWS[n].index);
+    if (f.widget == WIDGET_SLIDER) {
+        lv_slider_set_value(w, value / f.step, LV_ANIM_OFF);
+        set_slider_label(w, value, f.unit);
     } else {
-        g_settings.servo_protocol = SERVO_CUSTOM;
+        lv_dropdown_set_selected(w, settings_option_index(f, value));
     }
 }
 
-static void on_servo_frequency_change(lv_event_t* e) {
-    lv_obj_t* dd = lv_event_get_target_obj(e);
-    uint16_t sel = lv_dropdown_get_selected(dd);
-    g_settings.servo_frequency = (sel == 1) ? 333 : 50;
-
-    // Switch to custom if values don't match a preset
-    g_settings.servo_protocol = SERVO_CUSTOM;
-    if (dd_protocol) lv_dropdown_set_selected(dd_protocol, SERVO_CUSTOM);
+static void refresh_field(SettingId id) {
+    for (int n = 0; n < ROW_COUNT; n++) {
+        if (ROWS[n].id == id) refresh_row(n);
+    }
 }
 
-static void on_servo_pwm_min_change(lv_event_t* e) {
-    lv_obj_t* sl = lv_event_get_target_obj(e);
-    g_settings.servo_pwm_min = (uint16_t)lv_slider_get_value(sl);
-
-    // Update label and switch to custom
-    char buf[16];
-    snprintf(buf, sizeof(buf), "%4d µs", g_settings.servo_pwm_min);
-    if (lbl_pwm_min) lv_label_set_text(lbl_pwm_min, buf);
-
-    g_settings.servo_protocol = SERVO_CUSTOM;
-    if (dd_protocol) lv_dropdown_set_selected(dd_protocol, SERVO_CUSTOM);
+// Side effects of a changed setting
+static void on_field_changed(SettingId id) {
+    switch (id) {
+        case SET_LANGUAGE:
+            lang_set((Language)g_settings.language);
+            gui_page_cache_clear();       // Cached pages still show the old language
+            gui_set_page(PAGE_SETTINGS);  // Refresh to show new language (triggers destroy->save)
+            break;
+        case SET_BG_COLOR:
+            gui_set_bg_color((BgColorPreset)g_settings.bg_color);
+            break;
+        case SET_BRIGHTNESS:
+            // TODO: Apply brightness to display
+            break;
+        case SET_SERVO_PROTOCOL:
+            // Custom keeps the current values
+            if (g_settings.servo_protocol != SERVO_CUSTOM) {
+                servo_apply_preset((ServoProtocol)g_settings.servo_protocol);
+                refresh_field(SET_SERVO_FREQUENCY);
+                refresh_field(SET_SERVO_PWM_MIN);
+                refresh_field(SET_SERVO_PWM_CENTER);
+                refresh_field(SET_SERVO_PWM_MAX);
+            }
+            break;
+        case SET_SERVO_FREQUENCY:
+        case SET_SERVO_PWM_MIN:
+        case SET_SERVO_PWM_CENTER:
+        case SET_SERVO_PWM_MAX:
+            // Values no longer match a preset
+            g_settings.servo_protocol = SERVO_CUSTOM;
+            refresh_field(SET_SERVO_PROTOCOL);
+            break;
+        default:
+            break;
+    }
 }
 
-static void on_servo_pwm_center_change(lv_event_t* e) {
-    lv_obj_t* sl = lv_event_get_target_obj(e);
-    g_settings.servo_pwm_center = (uint16_t)lv_slider_get_value(sl);
-
-    char buf[16];
-    snprintf(buf, sizeof(buf), "%4d µs", g_settings.servo_pwm_center);
-    if (lbl_pwm_center) lv_label_set_text(lbl_pwm_center, buf);
-
-    g_settings.servo_protocol = SERVO_CUSTOM;
-    if (dd_protocol) lv_dropdown_set_selected(dd_protocol, SERVO_CUSTOM);
+// One callback for all rows (user_data: row index)
+static void on_row_change(lv_event_t* e) {
+    int n = (int)reinterpret_cast<intptr_t>(lv_event_get_user_data(e));
+    if (n < 0 || n >= ROW_COUNT) return;
+
+    const FieldRow& row = ROWS[n];
+    const SettingField& f = settings_field(row.id);
+    lv_obj_t* w = lv_event_get_target_obj(e);
+    if (f.widget == WIDGET_SLIDER) {
+        settings_set(row.id, row.index, lv_slider_get_value(w) * f.step);
+        set_slider_label(w, settings_get(row.id, row.index), f.unit);
+    } else {
+        settings_set(row.id, row.index, settings_option_value(f, lv_dropdown_get_selected(w)));
+    }
+    on_field_changed(row.id);
 }
 
-static void on_servo_pwm_max_change(lv_event_t* e) {
-    lv_obj_t* sl = lv_event_get_target_obj(e);
-    g_settings.servo_pwm_max = (uint16_t)lv_slider_get_value(sl);
-
-    char buf[16];
-    snprintf(buf, sizeof(buf), "%4d µs", g_settings.servo_pwm_max);
-    if (lbl_pwm_max) lv_label_set_text(lbl_pwm_max, buf);
-
-    g_settings.servo_protocol = SERVO_CUSTOM;
-    if (dd_protocol) lv_dropdown_set_selected(dd_protocol, SERVO_CUSTOM);
+// Dropdown option text: fixed, or translated into buf
+static const char* row_options(const SettingField& f, char* buf, size_t len) {
+    if (f.options) return f.options;
+    size_t pos = 0;
+    buf[0] = '\0';
+    for (int i = 0; i < f.option_count && pos < len; i++) {
+        pos += snprintf(buf + pos, len - pos, i ? "\n%s" : "%s", tr((StringId)(f.first_option + i)));
+    }
+    return buf;
 }
 
-// Per-servo PWM step callbacks
-static void on_servo_step_change(lv_event_t* e) {
-    int idx = reinterpret_cast<intptr_t>(lv_event_get_user_data(e));
-    if (idx < 0 || idx >= NUM_SERVOS) return;
+static lv_obj_t* create_row(SettingsBuilder& sb, int n) {
+    const FieldRow& row = ROWS[n];
+    const SettingField& f = settings_field(row.id);
+    void* user_data = (void*)(intptr_t)n;
 
-    lv_obj_t* sl = lv_event_get_target_obj(e);
-    g_settings.servo_pwm_step[idx] = (uint8_t)lv_slider_get_value(sl);
+    // Array elements are numbered: "Servo step 3"
+    char label[32];
+    if (f.count > 1) {
+        snprintf(label, sizeof(label), "%s %d", tr(f.label), row.index + 1);
+    } else {
+        snprintf(label, sizeof(label), "%s", tr(f.label));
+    }
 
-    if (lbl_servo_step[idx]) {
-        char buf[16];
-        snprintf(buf, sizeof(buf), "%4d µs", g_settings.servo_pwm_step[idx]);
-        lv_label_set_text(lbl_servo_step[idx], buf);
+    if (f.widget == WIDGET_SLIDER) {
+        row_widget[n] = sb.slider(label, f.min / f.step, f.max / f.step, 0, on_row_change, user_data);
+    } else {
+        char options[128];
+        row_widget[n] = sb.dropdown(label, row_options(f, options, sizeof(options)), 0,
+                                    on_row_change, user_data);
     }
+    refresh_row(n);
+    return row_widget[n];
 }
 
 static void on_servo_reset(lv_event_t* e) {
     (void)e;
     // Reset all servo PWM steps to default
     servo_reset_pwm_steps();
+    refresh_field(SET_SERVO_PWM_STEP);
+}
 
-    // Update all step slider UI
-    for (int i = 0; i < NUM_SERVOS; i++) {
-        if (sl_servo_step[i]) {
-            lv_slider_set_value(sl_servo_step[i], DEFAULT_PWM_STEP, LV_ANIM_OFF);
-        }
-        if (lbl_servo_step[i]) {
-            char buf[16];
-            snprintf(buf, sizeof(buf), "%4d µs", DEFAULT_PWM_STEP);
-            lv_label_set_text(lbl_servo_step[i], buf);
-        }
+// Rows of a section, built when it is first expanded (user_data: Section)
+static void build_section(SettingsBuilder& sb, void* user_data) {
+    int s = (int)reinterpret_cast<intptr_t>(user_data);
+
+    for (int n = 0; n < ROW_COUNT; n++) {
+        if (ROWS[n].section == s) focus_builder.add(create_row(sb, n), ROWS[n].focus);
+    }
+
+    if (s == SEC_SERVO) {
+        // Reset servos button
+        lv_obj_t* btn_reset = sb.button(tr(STR_SETTINGS_SERVO_RESET), on_servo_reset);
+        focus_builder.add(btn_reset, FO_SERVO_RESET);
+    } else if (s == SEC_SYSTEM) {
+        // Firmware and LVGL version
+        sb.info(tr(STR_SETTINGS_FIRMWARE), APP_VERSION);
+        sb.info("LVGL", LVGL_VERSION_STRING);
     }
 }
 
+// Section rows are about to be freed (collapsed while the LVGL heap is tight)
+static void release_section(void* user_data) {
+    int s = (int)reinterpret_cast<intptr_t>(user_data);
+
+    for (int n = 0; n < ROW_COUNT; n++) {
+        if (ROWS[n].section != s) continue;
+        focus_builder.add(nullptr, ROWS[n].focus);
+        row_widget[n] = nullptr;
+    }
+    if (s == SEC_SERVO) focus_builder.add(nullptr, FO_SERVO_RESET);
+}
+
 void page_settings_create(lv_obj_t* parent) {
     // Initialize focus builder
     focus_builder.init();
@@ -233,90 +285,15 @@ void page_settings_create(lv_obj_t* parent) {
     // Record this page in navigation history
     input_push_page(PAGE_SETTINGS);
 
-    // Build translated option strings
-    build_translated_options();
-
     SettingsBuilder sb(parent);
 
-    // Language section
-    lv_obj_t* sec_lang = sb.begin_section(tr(STR_SETTINGS_LANGUAGE));
-    focus_builder.add(sec_lang, FO_SEC_LANGUAGE);
-    lv_obj_t* dd_lang = sb.dropdown(tr(STR_SETTINGS_LANGUAGE), LANGUAGE_OPTIONS,
-                lang_get(), on_language_change);
-    focus_builder.add(dd_lang, FO_LANGUAGE);
-    sb.end_section();
-
-    // Display section
-    lv_obj_t* sec_display = sb.begin_section(tr(STR_SETTINGS_DISPLAY));
-    focus_builder.add(sec_display, FO_SEC_DISPLAY);
-    lv_obj_t* sl_brightness = sb.slider(tr(STR_SETTINGS_BRIGHTNESS), 10, 100, g_settings.brightness, on_brightness_change);
-    focus_builder.add(sl_brightness, FO_BRIGHTNESS);
-    lv_obj_t* dd_bg = sb.dropdown(tr(STR_SETTINGS_BACKGROUND), bg_color_options, gui_get_bg_color(), on_bg_color_change);
-    focus_builder.add(dd_bg, FO_BACKGROUND);
-    sb.end_section();
-
-    // Servo section
-    lv_obj_t* sec_servo = sb.begin_section(tr(STR_SETTINGS_SERVO));
-    focus_builder.add(sec_servo, FO_SEC_SERVO);
-
-    // Protocol dropdown
-    dd_protocol = sb.dropdown(tr(STR_SETTINGS_PROTOCOL), SERVO_PROTOCOL_OPTIONS,
-                              g_settings.servo_protocol, on_servo_protocol_change);
-    focus_builder.add(dd_protocol, FO_PROTOCOL);
-
-    // Frequency dropdown
-    dd_frequency = sb.dropdown(tr(STR_SETTINGS_FREQUENCY), freq_options,
-                               g_settings.servo_frequency == 333 ? 1 : 0, on_servo_frequency_change);
-    focus_builder.add(dd_frequency, FO_FREQUENCY);
-
-    // PWM value sliders (500-2500 range, step 10)
-    char pwm_buf[16];
-
-    lv_obj_t* sl_min = sb.slider(tr(STR_SETTINGS_PWM_MIN), 500, 1500, g_settings.servo_pwm_min, on_servo_pwm_min_change);
-    lbl_pwm_min = lv_obj_get_child(lv_obj_get_parent(sl_min), 1);  // Value label
-    snprintf(pwm_buf, sizeof(pwm_buf), "%4d µs", g_settings.servo_pwm_min);
-    lv_label_set_text(lbl_pwm_min, pwm_buf);
-    focus_builder.add(sl_min, FO_PWM_MIN);
-
-    lv_obj_t* sl_center = sb.slider(tr(STR_SETTINGS_PWM_CENTER), 1000, 2000, g_settings.servo_pwm_center, on_servo_pwm_center_change);
-    lbl_pwm_center = lv_obj_get_child(lv_obj_get_parent(sl_center), 1);
-    snprintf(pwm_buf, sizeof(pwm_buf), "%4d µs", g_settings.servo_pwm_center);
-    lv_label_set_text(lbl_pwm_center, pwm_buf);
-    focus_builder.add(sl_center, FO_PWM_CENTER);
-
-    lv_obj_t* sl_max = sb.slider(tr(STR_SETTINGS_PWM_MAX), 1500, 2500, g_settings.servo_pwm_max, on_servo_pwm_max_change);
-    lbl_pwm_max = lv_obj_get_child(lv_obj_get_parent(sl_max), 1);
-    snprintf(pwm_buf, sizeof(pwm_buf), "%4d µs", g_settings.servo_pwm_max);
-    lv_label_set_text(lbl_pwm_max, pwm_buf);
-    focus_builder.add(sl_max, FO_PWM_MAX);
-
-    // Per-servo PWM step sliders (1-100 µs range)
-    char step_label[32];
-    char step_value[16];
-    for (int i = 0; i < NUM_SERVOS; i++) {
-        snprintf(step_label, sizeof(step_label), "%s %d", tr(STR_SETTINGS_SERVO_STEP), i + 1);
-        sl_servo_step[i] = sb.slider(step_label, 1, 100, g_settings.servo_pwm_step[i],
-                                      on_servo_step_change, (void*)(intptr_t)i);
-        lbl_servo_step[i] = lv_obj_get_child(lv_obj_get_parent(sl_servo_step[i]), 1);
-        // Initialize label with unit
-        snprintf(step_value, sizeof(step_value), "%4d µs", g_settings.servo_pwm_step[i]);
-        lv_label_set_text(lbl_servo_step[i], step_value);
-        focus_builder.add(sl_servo_step[i], FO_SERVO_STEP_1 + i);
+    // Only the headers: rows are created when a section is opened
+    for (int s = 0; s < SECTION_COUNT; s++) {
+        lv_obj_t* header = sb.lazy_section(tr(SECTIONS[s].title), build_section, release_section,
+                                           (void*)(intptr_t)s);
+        focus_builder.add(header, SECTIONS[s].focus);
     }
 
-    // Reset servos button
-    lv_obj_t* btn_reset = sb.button(tr(STR_SETTINGS_SERVO_RESET), on_servo_reset);
-    focus_builder.add(btn_reset, FO_SERVO_RESET);
-
-    sb.end_section();
-
-    // System section - shows firmware and LVGL version
-    lv_obj_t* sec_system = sb.begin_section(tr(STR_SETTINGS_SYSTEM));
-    focus_builder.add(sec_system, FO_SEC_SYSTEM);
-    sb.info(tr(STR_SETTINGS_FIRMWARE), APP_VERSION);
-    sb.info("LVGL", LVGL_VERSION_STRING);
-    sb.end_section();
-
     // Add footer buttons to focus order
     focus_builder.add(gui_get_btn_home(), FO_BTN_HOME);
     focus_builder.add(gui_get_btn_prev(), FO_BTN_PREV);
@@ -335,15 +312,7 @@ void page_settings_destroy() {
     focus_builder.destroy();
 
     // Reset static pointers to avoid use-after-free
-    lbl_pwm_min = nullptr;
-    lbl_pwm_center = nullptr;
-    lbl_pwm_max = nullptr;
-    dd_frequency = nullptr;
-    dd_protocol = nullptr;
-
-    // Reset per-servo step pointers
-    for (int i = 0; i < NUM_SERVOS; i++) {
-        lbl_servo_step[i] = nullptr;
-        sl_servo_step[i] = nullptr;
+    for (int n = 0; n < ROW_COUNT; n++) {
+        row_widget[n] = nullptr;
     }
 }
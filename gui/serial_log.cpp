@@ -1,40 +1,115 @@
 #include "serial_log.h"
 
-#if defined(ESP_PLATFORM) || defined(ARDUINO)
-
-#include <Arduino.h>
 #include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include "mpsc_queue.h"
+#include "gui/app_tasks.h"
 #include "gui/pages/page_serial.h"
 
-static char line_buffer[256] = "";
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+#include <Arduino.h>
+#endif
 
-void serial_log_add_message(const char* msg) {
-    page_serial_add_message(msg);
+// ============================================================================
+// Queue
+// ============================================================================
+static constexpr size_t LOG_QUEUE_LEN = 64;       // Messages buffered for the log task
+static constexpr size_t LOG_TEXT_LEN = 120;       // Longer messages are truncated
+static constexpr uint32_t LOG_DRAIN_IDLE_MS = 10; // Log task sleep when the queue is empty
+
+static constexpr uint8_t LOG_FLAG_NEWLINE = 0x01; // log_println: terminate the line
+
+struct LogRecord {
+    const char* tag;
+    uint8_t level;
+    uint8_t flags;
+    char text[LOG_TEXT_LEN];
+};
+
+static MpscQueue<LogRecord, LOG_QUEUE_LEN> log_queue;
+static std::atomic<uint32_t> log_dropped{0};
+
+static void enqueue_text(uint8_t level, const char* tag, uint8_t flags, const char* format, va_list args) {
+    bool ok = log_queue.push_with([&](LogRecord& rec) {
+        rec.tag = tag;
+        rec.level = level;
+        rec.flags = flags;
+        vsnprintf(rec.text, sizeof(rec.text), format, args);
+    });
+    if (!ok) log_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void enqueue_copy(uint8_t level, const char* tag, uint8_t flags, const char* msg) {
+    bool ok = log_queue.push_with([&](LogRecord& rec) {
+        rec.tag = tag;
+        rec.level = level;
+        rec.flags = flags;
+        strncpy(rec.text, msg, sizeof(rec.text) - 1);
+        rec.text[sizeof(rec.text) - 1] = '\0';
+    });
+    if (!ok) log_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// Producers (any task)
+// ============================================================================
+void log_write(uint8_t level, const char* tag, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    enqueue_text(level, tag, LOG_FLAG_NEWLINE, format, args);
+    va_end(args);
 }
 
 void log_println(const char* msg) {
-    Serial.println(msg);
-    page_serial_add_message(msg);
-    line_buffer[0] = '\0';  // Clear any partial line
+    if (!msg) return;
+    enqueue_copy(LOG_LEVEL_INFO, nullptr, LOG_FLAG_NEWLINE, msg);
 }
 
 void serial_printf(const char* format, ...) {
-    char buffer[256];
     va_list args;
     va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    enqueue_text(LOG_LEVEL_INFO, nullptr, 0, format, args);
     va_end(args);
+}
 
-    Serial.print(buffer);
+void log_print(const char* msg) {
+    if (!msg) return;
+    enqueue_copy(LOG_LEVEL_INFO, nullptr, 0, msg);
+}
+
+uint32_t serial_log_get_dropped() {
+    return log_dropped.load(std::memory_order_relaxed);
+}
 
-    // Accumulate in line buffer
-    strncat(line_buffer, buffer, sizeof(line_buffer) - strlen(line_buffer) - 1);
+// ============================================================================
+// Consumer (log task)
+// ============================================================================
+
+// Partial monitor line (serial_printf/log_print without newline) - log task only
+static char line_buffer[256] = "";
+
+void serial_log_add_message(const char* msg) {
+    LvglLock lock;
+    page_serial_add_message(msg);
+}
+
+static void uart_write(const char* text) {
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+    Serial.print(text);
+#else
+    fputs(text, stdout);
+#endif
+}
+
+// Accumulate text and hand every completed line to the monitor page
+static void monitor_write(const char* text) {
+    strncat(line_buffer, text, sizeof(line_buffer) - strlen(line_buffer) - 1);
 
-    // If there's a newline, flush to display
     char* newline = strchr(line_buffer, '\n');
     while (newline) {
-        *newline = '\0';  // Replace newline with null terminator
-        page_serial_add_message(line_buffer);
+        *newline = '\0';
+        serial_log_add_message(line_buffer);
 
         // Move remaining text to start of buffer
         size_t remaining_len = strlen(newline + 1);
@@ -44,22 +119,42 @@ void serial_printf(const char* format, ...) {
     }
 }
 
-void log_print(const char* msg) {
-    Serial.print(msg);
+static void emit(const LogRecord& rec) {
+    char tag[24] = "";
+    if (rec.tag) snprintf(tag, sizeof(tag), "[%s] ", rec.tag);
 
-    // Accumulate in line buffer (no newline = no flush to display yet)
-    strncat(line_buffer, msg, sizeof(line_buffer) - strlen(line_buffer) - 1);
+    const char* severity = "";
+    if (rec.level == LOG_LEVEL_ERROR) severity = "ERROR: ";
+    else if (rec.level == LOG_LEVEL_WARN) severity = "WARNING: ";
 
-    // If there's a newline, flush to display
-    char* newline = strchr(line_buffer, '\n');
-    if (newline) {
-        *newline = '\0';
-        page_serial_add_message(line_buffer);
+    char out[LOG_TEXT_LEN + 40];
+    snprintf(out, sizeof(out), "%s%s%s%s", tag, severity, rec.text,
+             (rec.flags & LOG_FLAG_NEWLINE) ? "\n" : "");
 
-        // Move remaining text to start
-        size_t remaining_len = strlen(newline + 1);
-        memmove(line_buffer, newline + 1, remaining_len + 1);
-    }
+    uart_write(out);
+    monitor_write(out);
 }
 
-#endif
+void serial_log_task_main(void* arg) {
+    (void)arg;
+    uint32_t reported_dropped = 0;
+    LogRecord rec;
+
+    for (;;) {
+        while (log_queue.pop(rec)) {
+            emit(rec);
+        }
+
+        uint32_t dropped = serial_log_get_dropped();
+        if (dropped != reported_dropped) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "[LOG] WARNING: %lu messages dropped\n",
+                     (unsigned long)(dropped - reported_dropped));
+            reported_dropped = dropped;
+            uart_write(msg);
+            monitor_write(msg);
+        }
+
+        app_task_delay_ms(LOG_DRAIN_IDLE_MS);
+    }
+}
@@ -12,12 +12,53 @@
 //   Instead of:  Serial.print("Value: "); Serial.println(value);
 //   Use:         serial_printf("Value: %d\n", value);
 //
+//   Tagged, leveled messages:
+//                LOG_I("NFC", "Found PN5%02X", chip);      -> "[NFC] Found PN532"
+//                LOG_E("NFC", "No PN532 found");           -> "[NFC] ERROR: No PN532 found"
+//
 // The Serial Monitor page (Home → Serial Monitor) will display all messages
 // in a scrolling terminal-style view (green on black).
+//
+// Calls never block on the UART or LVGL: messages go into a lock-free queue
+// that the log task (serial_log_task_main) drains at low priority. If the queue
+// is full the message is dropped and counted. Safe from any task, not from
+// interrupt handlers (formatting and the queue are not IRAM-resident).
+//
+// LEVEL FILTERING:
+//   Messages above RC_LOG_LEVEL are removed at compile time (arguments are
+//   not evaluated). Set it per file before the first #include:
+//       #define RC_LOG_LEVEL LOG_LEVEL_DEBUG
+//   or globally with -D RC_LOG_DEFAULT_LEVEL=... in build_flags.
+//   (Not LOG_LOCAL_LEVEL: that one belongs to ESP-IDF's esp_log.h.)
 // ============================================================================
 
-#if defined(ESP_PLATFORM) || defined(ARDUINO)
-#include <Arduino.h>
+#include <stdint.h>
+
+#define LOG_LEVEL_NONE    0
+#define LOG_LEVEL_ERROR   1
+#define LOG_LEVEL_WARN    2
+#define LOG_LEVEL_INFO    3
+#define LOG_LEVEL_DEBUG   4
+
+#ifndef RC_LOG_DEFAULT_LEVEL
+#define RC_LOG_DEFAULT_LEVEL LOG_LEVEL_INFO
+#endif
+
+#ifndef RC_LOG_LEVEL
+#define RC_LOG_LEVEL RC_LOG_DEFAULT_LEVEL
+#endif
+
+// Queue a leveled message (tag may be nullptr). printf-style formatting.
+void log_write(uint8_t level, const char* tag, const char* format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+#define LOG_AT(level, tag, format, ...) \
+    do { if ((level) <= RC_LOG_LEVEL) log_write((level), (tag), format, ##__VA_ARGS__); } while (0)
+
+#define LOG_E(tag, format, ...) LOG_AT(LOG_LEVEL_ERROR, tag, format, ##__VA_ARGS__)
+#define LOG_W(tag, format, ...) LOG_AT(LOG_LEVEL_WARN,  tag, format, ##__VA_ARGS__)
+#define LOG_I(tag, format, ...) LOG_AT(LOG_LEVEL_INFO,  tag, format, ##__VA_ARGS__)
+#define LOG_D(tag, format, ...) LOG_AT(LOG_LEVEL_DEBUG, tag, format, ##__VA_ARGS__)
 
 // Add a message to the on-screen serial monitor
 void serial_log_add_message(const char* msg);
@@ -26,15 +67,14 @@ void serial_log_add_message(const char* msg);
 void log_println(const char* msg);
 
 // Print formatted string to both Serial and TFT display
-void serial_printf(const char* format, ...);
+void serial_printf(const char* format, ...) __attribute__((format(printf, 1, 2)));
 
 // For building multi-part lines, call log_print() then log_println() to flush
 void log_print(const char* msg);
 
-#else
-// Simulator stub
-inline void serial_log_add_message(const char* msg) {}
-inline void log_println(const char* msg) {}
-inline void serial_printf(const char* format, ...) {}
-inline void log_print(const char* msg) {}
-#endif
+// Log task body: drains the queue to the UART (stdout in the simulator) and the
+// on-screen monitor. Start once with app_task_create() (see gui/app_tasks.h).
+void serial_log_task_main(void* arg);
+
+// Messages dropped because the queue was full
+uint32_t serial_log_get_dropped();
@@ -25,6 +25,56 @@ SettingsBuilder::SettingsBuilder(lv_obj_t* parent)
     lv_obj_add_flag(cont_, LV_OBJ_FLAG_SCROLLABLE);
 }
 
+SettingsBuilder::SettingsBuilder(lv_obj_t* cont, lv_obj_t* section_cont)
+    : cont_(cont), section_cont_(section_cont), section_count_(0) {}
+
+// =============================================================================
+// Lazy sections
+// =============================================================================
+// State hangs off the header (user data), freed with it. Only headers tagged
+// with LAZY_HEADER carry it: other children of the page may use user data too.
+
+namespace {
+    constexpr lv_obj_flag_t LAZY_HEADER = LV_OBJ_FLAG_USER_1;
+
+    struct LazySection {
+        section_build_cb_t build;
+        section_release_cb_t release;
+        void* user_data;
+        bool built;
+    };
+
+    LazySection* lazy_state(lv_obj_t* header) {
+        if (!lv_obj_has_flag(header, LAZY_HEADER)) return nullptr;
+        return static_cast<LazySection*>(lv_obj_get_user_data(header));
+    }
+
+    bool heap_high() {
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        return mon.total_size > 0 && mon.used_pct >= SETTINGS_HEAP_HIGH_PCT;
+    }
+
+    void release_rows(lv_obj_t* content, LazySection* lazy) {
+        if (lazy->release) lazy->release(lazy->user_data);
+        lv_obj_clean(content);
+        lazy->built = false;
+    }
+
+    // Free the rows of all collapsed lazy sections of the page
+    void release_collapsed(lv_obj_t* cont) {
+        uint32_t n = lv_obj_get_child_count(cont);
+        for (uint32_t i = 0; i + 1 < n; i++) {
+            lv_obj_t* header = lv_obj_get_child(cont, i);
+            LazySection* lazy = lazy_state(header);
+            lv_obj_t* content = lv_obj_get_child(cont, i + 1);
+            if (lazy && lazy->built && lv_obj_has_flag(content, LV_OBJ_FLAG_HIDDEN)) {
+                release_rows(content, lazy);
+            }
+        }
+    }
+}
+
 void SettingsBuilder::on_header_click(lv_event_t* e) {
     lv_obj_t* header = lv_event_get_target_obj(e);
 
@@ -35,17 +85,63 @@ void SettingsBuilder::on_header_click(lv_event_t* e) {
 
     if (!arrow || !content) return;
 
+    LazySection* lazy = lazy_state(header);
+
     // Check current state by looking at content visibility
     bool is_hidden = lv_obj_has_flag(content, LV_OBJ_FLAG_HIDDEN);
 
     // Toggle
     if (is_hidden) {
+        if (lazy && !lazy->built) {
+            // Make room first if the heap is tight
+            if (heap_high()) release_collapsed(lv_obj_get_parent(header));
+            SettingsBuilder sb(lv_obj_get_parent(header), content);
+            lazy->build(sb, lazy->user_data);
+            lazy->built = true;
+        }
         lv_obj_clear_flag(content, LV_OBJ_FLAG_HIDDEN);
         lv_label_set_text(arrow, SYM_DOWN);
     } else {
         lv_obj_add_flag(content, LV_OBJ_FLAG_HIDDEN);
         lv_label_set_text(arrow, SYM_RIGHT);
+        if (lazy && lazy->built && heap_high()) release_rows(content, lazy);
+    }
+}
+
+void SettingsBuilder::on_header_delete(lv_event_t* e) {
+    lv_obj_t* header = lv_event_get_target_obj(e);
+    lv_free(lv_obj_get_user_data(header));
+    lv_obj_set_user_data(header, nullptr);
+    lv_obj_clear_flag(header, LAZY_HEADER);
+}
+
+lv_obj_t* SettingsBuilder::lazy_section(const char* title, section_build_cb_t build,
+                                        section_release_cb_t release, void* user_data,
+                                        bool start_expanded) {
+    lv_obj_t* header = begin_section(title, start_expanded);
+    if (!header) return nullptr;
+
+    LazySection* lazy = static_cast<LazySection*>(lv_malloc(sizeof(LazySection)));
+    if (!lazy) {
+        // No room for the state: build now like a plain section
+        build(*this, user_data);
+        end_section();
+        return header;
+    }
+    lazy->build = build;
+    lazy->release = release;
+    lazy->user_data = user_data;
+    lazy->built = false;
+    lv_obj_set_user_data(header, lazy);
+    lv_obj_add_flag(header, LAZY_HEADER);
+    lv_obj_add_event_cb(header, on_header_delete, LV_EVENT_DELETE, nullptr);
+
+    if (start_expanded) {
+        build(*this, user_data);
+        lazy->built = true;
     }
+    end_section();
+    return header;
 }
 
 lv_obj_t* SettingsBuilder::begin_section(const char* title, bool start_expanded) {
@@ -11,6 +11,16 @@ constexpr lv_coord_t SETTINGS_LABEL_W = 120;
 constexpr lv_coord_t SETTINGS_CTRL_W = 100;
 constexpr int SETTINGS_MAX_SECTIONS = 10;
 
+// LVGL heap use (%) from which collapsed lazy sections give their rows back
+constexpr uint8_t SETTINGS_HEAP_HIGH_PCT = 70;
+
+class SettingsBuilder;
+
+// Lazy section callbacks: build adds the rows to sb (first expand), release
+// drops the page's pointers to them before they are deleted
+typedef void (*section_build_cb_t)(SettingsBuilder& sb, void* user_data);
+typedef void (*section_release_cb_t)(void* user_data);
+
 class SettingsBuilder {
     lv_obj_t* cont_;           // Main scrollable container
     lv_obj_t* section_cont_;   // Current section's content container
@@ -19,8 +29,12 @@ class SettingsBuilder {
     // Create a row container with label on left, control on right
     lv_obj_t* make_row(const char* label_text);
 
-    // Toggle section visibility
+    // Builder adding rows to an existing section (lazy sections)
+    SettingsBuilder(lv_obj_t* cont, lv_obj_t* section_cont);
+
+    // Toggle section visibility (builds / releases lazy sections)
     static void on_header_click(lv_event_t* e);
+    static void on_header_delete(lv_event_t* e);
 
 public:
     explicit SettingsBuilder(lv_obj_t* parent);
@@ -32,6 +46,13 @@ public:
     // End the current section
     void end_section();
 
+    // Collapsible section whose rows are created on first expand (no end_section).
+    // Collapsing frees them again while the LVGL heap is above SETTINGS_HEAP_HIGH_PCT.
+    // Returns the header object so it can be added to focus navigation
+    lv_obj_t* lazy_section(const char* title, section_build_cb_t build,
+                           section_release_cb_t release, void* user_data = nullptr,
+                           bool start_expanded = false);
+
     // Dropdown selector (returns dropdown for further customization)
     lv_obj_t* dropdown(const char* label, const char* options, int selected_idx,
                        lv_event_cb_t on_change = nullptr, void* user_data = nullptr);
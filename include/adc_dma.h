@@ -0,0 +1,72 @@
+// include/adc_dma.h - Continuous ADC sampling on the PIN_ADC[] inputs
+// The ADC digital controller converts the selected inputs in a fixed pattern at
+// a fixed rate and DMAs the results into a driver ring buffer - no CPU work per
+// sample. Readers drain it in chunks without blocking.
+//
+// Sample timing: conversions are paced by the ADC controller clock, so sample
+// number n of the stream was taken at adc_dma_start_time_us() + n / rate.
+//
+// ESP32:     ADC1 digital controller (adc_digi_* driver, Arduino-ESP32 2.x / IDF 4.4)
+// Simulator: samples come from a source function (adc_dma_set_sim_source)
+//
+// One owner at a time (the IO task): adc_dma_start() fails while running.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "pins.h"
+#include "adc_filter.h"
+
+constexpr uint32_t ADC_DMA_RATE_MIN_HZ = 611;      // Controller limits (all inputs together)
+constexpr uint32_t ADC_DMA_RATE_MAX_HZ = 83333;
+constexpr uint16_t ADC_DMA_RAW_MAX = 4095;         // 12 bit
+
+struct AdcSample {
+    uint8_t input;      // Index into PIN_ADC[]
+    uint16_t raw;       // 0 .. ADC_DMA_RAW_MAX
+};
+
+/**
+ * Start continuous conversion
+ * @param input_mask Bit N = PIN_ADC[N]
+ * @param rate_hz Conversions per second over all selected inputs
+ * @return false if already running or the driver refused the configuration
+ */
+bool adc_dma_start(uint8_t input_mask, uint32_t rate_hz);
+
+// Stop conversion and release the driver
+void adc_dma_stop();
+
+bool adc_dma_running();
+
+/**
+ * Drain converted samples (never blocks)
+ * @param out Destination
+ * @param max Capacity of out
+ * @param first_seq Stream number of out[0] (counted from adc_dma_start)
+ * @return Number of samples written
+ */
+size_t adc_dma_read(AdcSample* out, size_t max, uint32_t* first_seq);
+
+// app_time_us() of stream sample 0
+uint32_t adc_dma_start_time_us();
+
+// Actual conversion rate (the controller rounds the requested rate)
+uint32_t adc_dma_rate_hz();
+
+// Times the driver ring buffer overflowed (samples lost - stream timing after an
+// overrun is no longer exact, measurements spanning one should be discarded)
+uint32_t adc_dma_overruns();
+
+/**
+ * Raw -> mV table of the sampled inputs (11 dB attenuation)
+ * @return false if the chip has no eFuse calibration (nominal reference used)
+ */
+bool adc_dma_calibration(AdcCalTable& out);
+
+// Simulator only: value of an input at a point in time (ignored on ESP32).
+// The simulated converter is ideal, ADC_DMA_SIM_FULL_SCALE_MV at raw 4096.
+constexpr uint16_t ADC_DMA_SIM_FULL_SCALE_MV = 3100;
+typedef uint16_t (*adc_sim_source_t)(uint8_t input, uint32_t t_us);
+void adc_dma_set_sim_source(adc_sim_source_t source);
@@ -0,0 +1,91 @@
+// include/adc_filter.h - Fixed-point ADC filter chain and calibration table
+// Platform-agnostic, integer only: runs on the IO task and on the host.
+//
+// Per input:  raw 12 bit samples
+//   -> oversampling: sum of 2^OVERSAMPLE_LOG2 samples = raw with OVERSAMPLE_LOG2
+//      fractional bits (noise / 2^(OVERSAMPLE_LOG2 / 2))
+//   -> 1st order IIR on the block sums: y += (x - y) / 2^IIR_SHIFT, state kept
+//      scaled by 2^IIR_SHIFT so nothing is truncated
+//   -> AdcCalTable: filtered raw -> µV, piecewise linear through the points of
+//      the chip calibration (eFuse), interpolated with the fractional bits
+
+#pragma once
+
+#include <stdint.h>
+
+template <uint8_t OVERSAMPLE_LOG2, uint8_t IIR_SHIFT>
+class AdcFilter {
+    static_assert(OVERSAMPLE_LOG2 + IIR_SHIFT + 12 <= 31, "AdcFilter state would overflow");
+
+public:
+    static constexpr uint8_t FRAC_BITS = OVERSAMPLE_LOG2;
+    static constexpr uint32_t BLOCK = 1u << OVERSAMPLE_LOG2;
+    static constexpr uint32_t SETTLE_BLOCKS = 3u << IIR_SHIFT;     // ~95% of a step
+
+    // Feed one raw sample; returns true when it completed an oversampling block
+    bool push(uint16_t raw) {
+        sum_ += raw;
+        if (++count_ < BLOCK) return false;
+
+        if (blocks_ == 0) acc_ = sum_ << IIR_SHIFT;     // Start at the first value, no ramp
+        else acc_ += sum_ - (acc_ >> IIR_SHIFT);
+        if (blocks_ < SETTLE_BLOCKS) blocks_++;
+        block_ = sum_;
+        sum_ = 0;
+        count_ = 0;
+        return true;
+    }
+
+    // Filtered value: raw counts with FRAC_BITS fractional bits
+    uint32_t value_q() const { return acc_ >> IIR_SHIFT; }
+
+    // Last oversampling block before the IIR (same scale), for transient measurements
+    uint32_t block_q() const { return block_; }
+
+    bool valid() const { return blocks_ > 0; }
+    bool settled() const { return blocks_ >= SETTLE_BLOCKS; }
+
+    void reset() {
+        sum_ = 0;
+        acc_ = 0;
+        block_ = 0;
+        count_ = 0;
+        blocks_ = 0;
+    }
+
+private:
+    uint32_t sum_ = 0;
+    uint32_t acc_ = 0;
+    uint32_t block_ = 0;
+    uint32_t count_ = 0;
+    uint32_t blocks_ = 0;
+};
+
+// Raw -> voltage at the pin, one point every 256 counts (raw 0 .. 4096)
+struct AdcCalTable {
+    static constexpr uint8_t SEGMENT_LOG2 = 8;
+    static constexpr uint8_t POINTS = (4096 >> SEGMENT_LOG2) + 1;
+
+    uint16_t mv[POINTS];
+
+    // Ideal converter (simulator, chips without calibration)
+    static AdcCalTable linear(uint16_t full_scale_mv) {
+        AdcCalTable t;
+        for (uint8_t i = 0; i < POINTS; i++) {
+            t.mv[i] = static_cast<uint16_t>((static_cast<uint32_t>(i) << SEGMENT_LOG2) * full_scale_mv / 4096);
+        }
+        return t;
+    }
+
+    // raw_q: raw counts with frac fractional bits
+    uint32_t to_uv(uint32_t raw_q, uint8_t frac) const {
+        const uint8_t shift = SEGMENT_LOG2 + frac;
+        uint32_t idx = raw_q >> shift;
+        if (idx > POINTS - 2) idx = POINTS - 2;
+        int64_t rem = static_cast<int64_t>(raw_q) - (static_cast<int64_t>(idx) << shift);
+        int64_t lo = mv[idx] * 1000;
+        int64_t span = (mv[idx + 1] - mv[idx]) * 1000;
+        int64_t uv = lo + ((span * rem) >> shift);
+        return uv > 0 ? static_cast<uint32_t>(uv) : 0;
+    }
+};
@@ -0,0 +1,128 @@
+// include/cg_solver.h - Center of gravity from the support loads
+// Platform-agnostic, integer only: runs on the GUI task and on the host
+// against recorded or synthetic load traces.
+//
+// Supports lie on the longitudinal axis at x (µm from the datum, the leading
+// edge stop of the CG scale); two or three of them carry the model:
+//
+//   x_cg = sum(m_i * x_i) / sum(m_i)
+//
+// Masses come in mg (LoadCellCal), so the moment sum stays far inside int64
+// (8 kg * 2 m = 1.6e13 mg*µm).
+//
+// CgTracker follows the solution over time: exponentially weighted mean and
+// variance of x_cg (fixed point, 1/2^SHIFT per update) give the displayed
+// value, its standard deviation and the "settled" decision.
+
+#pragma once
+
+#include <stdint.h>
+
+constexpr uint8_t CG_MAX_SUPPORTS = 4;
+constexpr int32_t CG_MIN_TOTAL_MG = 20000;          // Less: nothing on the scale
+
+struct CgSolution {
+    bool valid;             // Enough mass and x_cg inside the supports' span (+- 1 span)
+    int32_t total_mg;
+    int32_t x_um;           // CG from the datum
+};
+
+/**
+ * Solve one reading
+ * @param load_mg Load per support (negative values are kept: a support pulled
+ *                up by a tail-heavy model is still a valid moment)
+ * @param x_um    Support positions from the datum
+ * @param mask    Supports to use (bit N = support N)
+ */
+inline CgSolution cg_solve(const int32_t* load_mg, const int32_t* x_um, uint8_t count, uint8_t mask) {
+    CgSolution s = {};
+    int64_t total = 0, moment = 0;
+    int32_t x_min = INT32_MAX, x_max = INT32_MIN;
+    for (uint8_t i = 0; i < count && i < CG_MAX_SUPPORTS; i++) {
+        if (!(mask & (1 << i))) continue;
+        total += load_mg[i];
+        moment += static_cast<int64_t>(load_mg[i]) * x_um[i];
+        if (x_um[i] < x_min) x_min = x_um[i];
+        if (x_um[i] > x_max) x_max = x_um[i];
+    }
+    if (total > INT32_MAX) total = INT32_MAX;
+    s.total_mg = static_cast<int32_t>(total);
+    if (total < CG_MIN_TOTAL_MG || x_max <= x_min) return s;     // Need two positions
+
+    // Round to nearest
+    int64_t x = (moment >= 0 ? moment + total / 2 : moment - total / 2) / total;
+    int64_t span = static_cast<int64_t>(x_max) - x_min;
+    if (x < x_min - span || x > x_max + span) return s;         // Support wrongly assigned / calibrated
+    s.x_um = static_cast<int32_t>(x);
+    s.valid = true;
+    return s;
+}
+
+template <uint8_t SHIFT>
+class CgTracker {
+    static_assert(SHIFT >= 1 && SHIFT <= 8, "CgTracker shift out of range");
+
+public:
+    static constexpr uint32_t WARMUP = 2u << SHIFT;     // Updates before settled() may be true
+
+    // Feed one solution; an invalid one restarts the tracking
+    void update(const CgSolution& s) {
+        if (!s.valid) {
+            reset();
+            return;
+        }
+        const int64_t x = static_cast<int64_t>(s.x_um) << SHIFT;
+        if (!count_) {
+            mean_q_ = x;
+            var_q_ = 0;
+        } else {
+            // Weighted update: var = (1 - a) * (var + a * d^2), a = 1/2^SHIFT,
+            // kept as var << SHIFT so that a * d^2 is simply d^2
+            int64_t d = x - mean_q_;
+            mean_q_ += d >> SHIFT;
+            int64_t d_um = d >> SHIFT;
+            int64_t v = var_q_ + d_um * d_um;
+            var_q_ = v - (v >> SHIFT);
+        }
+        total_mg_ = s.total_mg;
+        if (count_ < WARMUP) count_++;
+    }
+
+    bool valid() const { return count_ > 0; }
+    int32_t x_um() const { return static_cast<int32_t>(mean_q_ >> SHIFT); }
+    int32_t total_mg() const { return total_mg_; }
+
+    // Standard deviation of x_cg (µm)
+    uint32_t stddev_um() const { return isqrt(static_cast<uint64_t>(var_q_) >> SHIFT); }
+
+    // Stable within limit_um (1 sigma) after the warm-up
+    bool settled(uint32_t limit_um) const { return count_ >= WARMUP && stddev_um() <= limit_um; }
+
+    void reset() {
+        mean_q_ = 0;
+        var_q_ = 0;
+        total_mg_ = 0;
+        count_ = 0;
+    }
+
+private:
+    static uint32_t isqrt(uint64_t v) {
+        uint64_t r = 0, bit = 1ull << 62;
+        while (bit > v) bit >>= 2;
+        while (bit) {
+            if (v >= r + bit) {
+                v -= r + bit;
+                r = (r >> 1) + bit;
+            } else {
+                r >>= 1;
+            }
+            bit >>= 2;
+        }
+        return static_cast<uint32_t>(r);
+    }
+
+    int64_t mean_q_ = 0;        // µm << SHIFT
+    int64_t var_q_ = 0;         // µm^2 << SHIFT
+    int32_t total_mg_ = 0;
+    uint32_t count_ = 0;
+};
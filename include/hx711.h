@@ -0,0 +1,54 @@
+// include/hx711.h - HX711 load cell amplifiers for the CG scale
+// All modules share PIN_HX711_SCK and are read in lock-step: the scale task
+// sleeps until a DOUT-ready edge (interrupt, no spin-waiting), waits until every
+// connected module is ready and shifts all of them out with the same 25 clock
+// pulses (24 data bits + channel A / gain 128 for the next conversion).
+// Interrupts are disabled only during that shift (~60 µs): the HX711 powers
+// down if SCK stays high longer than 60 µs.
+//
+// Each cell runs through LoadCellFilter (include/load_cell_filter.h); readings
+// are filtered raw counts. Converting to mass (tare, two-point calibration)
+// is up to the caller with LoadCellCal and the values persisted in settings.
+//
+// Threads: hx711_start/stop/poll from the GUI task,
+//          hx711_task_main is the scale task (see gui/app_tasks.h).
+
+#pragma once
+
+#include <stdint.h>
+#include "pins.h"
+#include "load_cell_filter.h"
+
+constexpr uint32_t HX711_RATE_SPS = 80;             // RATE pin high on the modules
+constexpr uint8_t HX711_SETTLE_SAMPLES = 4;         // Dropped after power up / channel select
+constexpr uint32_t HX711_PUBLISH_MS = 50;           // Reading rate to the GUI
+
+constexpr uint8_t HX711_MEDIAN = 5;                 // Samples
+constexpr uint8_t HX711_AVERAGE = 16;               // Medians (200 ms)
+
+typedef LoadCellFilter<HX711_MEDIAN, HX711_AVERAGE> Hx711Filter;
+
+struct ScaleReading {
+    uint8_t present_mask;               // Bit N = module N answers
+    uint8_t full_mask;                  // Bit N = filter window of cell N complete
+    int32_t raw[NUM_LOAD_CELLS];        // Filtered raw counts
+    int32_t spread[NUM_LOAD_CELLS];     // Counts, see LoadCellFilter::spread()
+    uint32_t samples;                   // Lock-step reads since hx711_start
+};
+
+// Power the modules up/down (the page that shows the readings owns the scale)
+void hx711_start();
+void hx711_stop();
+
+// Fetch the latest reading (GUI task). Returns false when none is pending.
+bool hx711_poll(ScaleReading& out);
+
+// Restart the filters (after the load changed on purpose, e.g. before a tare)
+void hx711_reset_filters();
+
+// Lock-step reads and shifts that timed out (diagnostics)
+uint32_t hx711_read_count();
+uint32_t hx711_timeout_count();
+
+// Scale task body (never returns)
+void hx711_task_main(void* arg);
@@ -0,0 +1,98 @@
+// include/i2c_bus.h - Shared I2C bus manager (PIN_I2C_SDA / PIN_I2C_SCL)
+// The bus task owns the I2C peripheral. Drivers register their device (address,
+// fastest clock it allows) and hand transfers to the bus task:
+//
+//   - Transfers are queued by priority (I2C_PRIO_HIGH first) and run one at a
+//     time; the clock is switched per device, so a 400 kHz sensor is not held
+//     back by a 100 kHz one.
+//   - i2c_bus_submit() returns at once (async): the caller keeps working and
+//     collects the result with i2c_bus_wait(). The I2cTransfer (and its
+//     buffers) must stay alive until then.
+//   - A transfer is one bus transaction. Devices that need time between
+//     command and answer (PN532) wait outside the bus between transfers,
+//     so a slow device never blocks the queue.
+//
+// Counters (per device and bus utilization) are kept by the bus task and can
+// be read from any task.
+//
+// Threads: i2c_bus_add_device/submit/wait from any task,
+//          i2c_bus_task_main is the bus task (see gui/app_tasks.h).
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+
+constexpr uint8_t I2C_MAX_DEVICES = 8;
+constexpr uint32_t I2C_CLOCK_STANDARD = 100000;
+constexpr uint32_t I2C_CLOCK_FAST = 400000;
+
+typedef int8_t I2cDevice;
+constexpr I2cDevice I2C_NO_DEVICE = -1;
+
+enum I2cPriority : uint8_t {
+    I2C_PRIO_HIGH = 0,      // Sensor streams (IMU FIFO)
+    I2C_PRIO_NORMAL,        // Commands, configuration
+    I2C_PRIO_LOW,           // Polling, bulk transfers
+    I2C_PRIO_COUNT,
+};
+
+enum I2cStatus : uint8_t {
+    I2C_IDLE = 0,
+    I2C_PENDING,            // Queued or running
+    I2C_DONE,
+    I2C_FAILED,             // NACK, timeout or queue full
+};
+
+struct I2cTransfer {
+    I2cDevice dev = I2C_NO_DEVICE;
+    I2cPriority prio = I2C_PRIO_NORMAL;
+    const uint8_t* tx = nullptr;    // Written first (register address, data)
+    uint8_t tx_len = 0;
+    uint8_t* rx = nullptr;          // Read after a repeated start
+    uint8_t rx_len = 0;
+
+    // Bus task side
+    std::atomic<uint8_t> status{I2C_IDLE};
+    uint32_t submitted_us = 0;
+    void* waiter = nullptr;         // Task notified on completion
+};
+
+struct I2cDeviceStats {
+    const char* name;
+    uint8_t addr;
+    uint32_t clock_hz;
+    uint32_t transfers;
+    uint32_t errors;
+    uint32_t bytes;
+    uint32_t latency_avg_us;        // Submit -> done (queue wait included), running average
+    uint32_t latency_max_us;
+};
+
+/**
+ * Register a device (call once from the driver's init)
+ * @param clock_hz Fastest clock the device allows (I2C_CLOCK_STANDARD / _FAST)
+ * @return Device handle, I2C_NO_DEVICE if the table is full
+ */
+I2cDevice i2c_bus_add_device(const char* name, uint8_t addr, uint32_t clock_hz);
+
+// Queue a transfer (returns at once). False: queue full, status is I2C_FAILED.
+bool i2c_bus_submit(I2cTransfer& t);
+
+// Block until a submitted transfer completed. Returns true on success.
+bool i2c_bus_wait(I2cTransfer& t);
+
+// Submit + wait
+bool i2c_bus_transfer(I2cDevice dev, I2cPriority prio, const uint8_t* tx, uint8_t tx_len,
+                      uint8_t* rx, uint8_t rx_len);
+
+// Register helpers (write one byte / read with a repeated start)
+bool i2c_bus_write_reg(I2cDevice dev, I2cPriority prio, uint8_t reg, uint8_t value);
+bool i2c_bus_read_regs(I2cDevice dev, I2cPriority prio, uint8_t reg, uint8_t* buf, uint8_t len);
+
+// Counters
+bool i2c_bus_device_stats(I2cDevice dev, I2cDeviceStats& out);
+uint16_t i2c_bus_utilization_permille();    // Bus busy time over the last second
+
+// Bus task body (never returns)
+void i2c_bus_task_main(void* arg);
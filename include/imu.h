@@ -0,0 +1,66 @@
+// include/imu.h - IMU attitude service (MPU6050 family) for the deflection and angle pages
+// The sensor samples on its own clock into its FIFO; the IMU task empties the
+// FIFO in I2C bursts every IMU_READ_MS (a few samples per transfer instead of
+// one register read per sample, so the bus stays free for the PN532), runs
+// every sample through the Mahony filter (include/imu_fusion.h) and
+// publishes the newest attitude in a SeqLock (include/seqlock.h): pages read
+// it without locks and never wait for the bus.
+//
+// A second sensor (AD0 high) on the control surface enables the differential
+// mode of the deflection page: both sensors are fused separately, every sample
+// is timestamped from its FIFO position (include/imu_sync.h) and the pair is
+// published interpolated to the same instant, so a moving surface does not
+// show up as a difference between two reads 20 ms apart.
+//
+// Threads: imu_start/stop/read from the GUI task (imu_read from any task),
+//          imu_task_main is the IMU task (see gui/app_tasks.h).
+
+#pragma once
+
+#include <stdint.h>
+
+enum ImuSensor : uint8_t {
+    IMU_REFERENCE = 0,          // Wing / fuselage (or the only sensor)
+    IMU_SURFACE,                // Control surface (deflection page)
+    IMU_SENSOR_COUNT,
+};
+
+constexpr uint8_t IMU_I2C_ADDR[IMU_SENSOR_COUNT] = { 0x68, 0x69 };     // AD0 low / high
+constexpr uint32_t IMU_SAMPLE_HZ = 200;             // Sensor output data rate (fusion rate)
+constexpr uint32_t IMU_READ_MS = 20;                // FIFO burst interval (4 samples)
+
+struct ImuAttitude {
+    uint32_t timestamp_us;      // Newest fused sample (app_time_us clock)
+    uint32_t samples;           // Fused since imu_start
+    float roll_deg;             // See include/imu_fusion.h for the axes
+    float pitch_deg;
+    float rate_dps;             // Gyro magnitude: how much the sensor is moving
+};
+
+struct ImuPair {
+    bool valid;
+    uint32_t timestamp_us;      // Both sensors interpolated to this instant
+    uint32_t skew_us;           // Distance between the sensors' newest samples
+    float roll_deg[IMU_SENSOR_COUNT];
+    float pitch_deg[IMU_SENSOR_COUNT];
+};
+
+// Wake the sensors and start fusing / put them back to sleep
+void imu_start();
+void imu_stop();
+
+// Sensor answered the last probe (after imu_start)
+bool imu_present(ImuSensor sensor = IMU_REFERENCE);
+
+// Newest attitude (any task, lock-free). Returns false until the first sample.
+bool imu_read(ImuAttitude& out, ImuSensor sensor = IMU_REFERENCE);
+
+// Both sensors at the same instant. Returns false unless both are fused.
+bool imu_read_pair(ImuPair& out);
+
+// Diagnostics: FIFO overflows (samples lost) and I2C transfers that failed, all sensors
+uint32_t imu_overflow_count();
+uint32_t imu_error_count();
+
+// IMU task body (never returns)
+void imu_task_main(void* arg);
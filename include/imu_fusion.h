@@ -0,0 +1,135 @@
+// include/imu_fusion.h - Attitude from gyro + accelerometer (Mahony filter)
+// Platform-agnostic, single precision float (ESP32-S3 FPU): runs on the IMU
+// task and on the host against recorded or synthetic samples.
+//
+// The gyro is integrated into a quaternion; the accelerometer pulls the
+// estimated gravity direction back with a PI controller:
+//   proportional (kp): how fast the accelerometer corrects the gyro drift
+//   integral (ki):     learns the gyro bias, so a resting sensor stops drifting
+// Samples while the sensor is being moved (|a| away from 1 g) only integrate
+// the gyro: a bumped table does not tilt the reading.
+//
+// Angles (degrees, sensor frame, x forward, z up when flat):
+//   roll  about x, positive right side down
+//   pitch about y, positive nose down (right-hand rule about y)
+
+#pragma once
+
+#include <math.h>
+
+constexpr float IMU_FUSION_KP = 1.0f;
+constexpr float IMU_FUSION_KI = 0.3f;
+constexpr float IMU_FUSION_ACCEL_GATE = 0.1f;      // Correct only within 1 g +- 10 %
+
+class MahonyFilter {
+public:
+    /**
+     * One sample
+     * @param gyro  Angular rate (rad/s)
+     * @param accel Acceleration (g)
+     * @param dt    Sample period (s)
+     */
+    void update(const float* gyro, const float* accel, float dt) {
+        float ax = accel[0], ay = accel[1], az = accel[2];
+        float a_norm = sqrtf(ax * ax + ay * ay + az * az);
+        if (!initialized_) {
+            if (a_norm < 0.5f) return;     // No gravity seen yet
+            init_from_accel(ax, ay, az);
+            return;
+        }
+
+        float gx = gyro[0], gy = gyro[1], gz = gyro[2];
+        if (fabsf(a_norm - 1.0f) < IMU_FUSION_ACCEL_GATE) {
+            ax /= a_norm;
+            ay /= a_norm;
+            az /= a_norm;
+
+            // Gravity direction from the current estimate
+            float vx = 2.0f * (q_[1] * q_[3] - q_[0] * q_[2]);
+            float vy = 2.0f * (q_[0] * q_[1] + q_[2] * q_[3]);
+            float vz = q_[0] * q_[0] - q_[1] * q_[1] - q_[2] * q_[2] + q_[3] * q_[3];
+
+            // Error: cross product of measured and estimated gravity
+            float ex = ay * vz - az * vy;
+            float ey = az * vx - ax * vz;
+            float ez = ax * vy - ay * vx;
+
+            bias_[0] += ki_ * ex * dt;
+            bias_[1] += ki_ * ey * dt;
+            bias_[2] += ki_ * ez * dt;
+            gx += kp_ * ex + bias_[0];
+            gy += kp_ * ey + bias_[1];
+            gz += kp_ * ez + bias_[2];
+        } else {
+            gx += bias_[0];
+            gy += bias_[1];
+            gz += bias_[2];
+        }
+
+        // q += 0.5 * q * (0, g) * dt
+        float h = 0.5f * dt;
+        float q0 = q_[0], q1 = q_[1], q2 = q_[2], q3 = q_[3];
+        q_[0] += (-q1 * gx - q2 * gy - q3 * gz) * h;
+        q_[1] += (q0 * gx + q2 * gz - q3 * gy) * h;
+        q_[2] += (q0 * gy - q1 * gz + q3 * gx) * h;
+        q_[3] += (q0 * gz + q1 * gy - q2 * gx) * h;
+        normalize();
+    }
+
+    bool valid() const { return initialized_; }
+
+    float roll_deg() const {
+        return to_degrees(atan2f(2.0f * (q_[0] * q_[1] + q_[2] * q_[3]),
+                              1.0f - 2.0f * (q_[1] * q_[1] + q_[2] * q_[2])));
+    }
+
+    float pitch_deg() const {
+        float s = 2.0f * (q_[0] * q_[2] - q_[3] * q_[1]);
+        if (s > 1.0f) s = 1.0f;
+        if (s < -1.0f) s = -1.0f;
+        return to_degrees(asinf(s));
+    }
+
+    void set_gains(float kp, float ki) {
+        kp_ = kp;
+        ki_ = ki;
+    }
+
+    void reset() {
+        q_[0] = 1.0f;
+        q_[1] = q_[2] = q_[3] = 0.0f;
+        bias_[0] = bias_[1] = bias_[2] = 0.0f;
+        initialized_ = false;
+    }
+
+private:
+    static float to_degrees(float rad) { return rad * (180.0f / static_cast<float>(M_PI)); }
+
+    // Start at the accelerometer's attitude (yaw 0) instead of converging from level
+    void init_from_accel(float ax, float ay, float az) {
+        float roll = atan2f(ay, az);
+        float pitch = atan2f(-ax, sqrtf(ay * ay + az * az));
+        float cr = cosf(roll * 0.5f), sr = sinf(roll * 0.5f);
+        float cp = cosf(pitch * 0.5f), sp = sinf(pitch * 0.5f);
+        q_[0] = cr * cp;
+        q_[1] = sr * cp;
+        q_[2] = cr * sp;
+        q_[3] = -sr * sp;
+        initialized_ = true;
+    }
+
+    void normalize() {
+        float n = sqrtf(q_[0] * q_[0] + q_[1] * q_[1] + q_[2] * q_[2] + q_[3] * q_[3]);
+        if (n <= 0.0f) {
+            reset();
+            return;
+        }
+        for (auto& v : q_) v /= n;
+    }
+
+    float q_[4] = { 1.0f, 0.0f, 0.0f, 0.0f };
+    float bias_[3] = {};        // Learned gyro bias correction (rad/s)
+    float kp_ = IMU_FUSION_KP;
+    float ki_ = IMU_FUSION_KI;
+    bool initialized_ = false;
+};
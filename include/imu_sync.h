@@ -0,0 +1,136 @@
+// include/imu_sync.h - Sample timestamps from the FIFO stream, time-aligned angles
+// Platform-agnostic: runs on the IMU task and on the host.
+//
+// Two sensors sample on their own clocks and are read one after the other,
+// so their newest samples are up to a read interval apart. Comparing "newest
+// with newest" would turn that skew into a fake angle difference whenever the
+// surface moves. Instead:
+//
+//   FifoClock:    every sample gets a timestamp from its position in the FIFO
+//                 stream (one period apart), anchored to the read times. A
+//                 read only tells that the newest sample arrived within the
+//                 last period, so the anchor follows the reads slowly; the
+//                 period itself is tracked too (sensor clocks are only ~1 %).
+//   AngleHistory: the last few fused angles with their timestamps; at() linearly
+//                 interpolates both sensors to the same instant.
+
+#pragma once
+
+#include <stdint.h>
+
+class FifoClock {
+public:
+    static constexpr uint8_t PHASE_SHIFT = 4;       // Anchor follows the reads over ~16 batches
+    static constexpr uint8_t RATE_SHIFT = 7;        // Period follows a persistent drift over ~128 batches
+    static constexpr uint32_t RATE_TOLERANCE = 50;  // Sensor clock within 1/50 (2 %) of nominal
+    static constexpr uint32_t RESYNC_PERIODS = 4;   // Further off: samples were lost, start over
+
+    explicit FifoClock(uint32_t period_us) : nominal_q8_(period_us << 8), period_q8_(period_us << 8) {}
+
+    /**
+     * Timestamp a batch read from the FIFO
+     * @param newest_us Read time minus the samples still left in the FIFO
+     * @param n         Samples in the batch
+     * @return Timestamp of the first (oldest) sample, add offset_us(i) for the others
+     */
+    uint32_t stamp(uint32_t newest_us, uint8_t n) {
+        if (!n) return next_us_;
+        // The newest sample arrived within the last period: expect it half a period back
+        const uint32_t period_us = period_q8_ >> 8;
+        const uint32_t observed = newest_us - offset_us(n - 1) - period_us / 2;
+        const int32_t err = static_cast<int32_t>(observed - next_us_);
+        const int32_t limit = static_cast<int32_t>(RESYNC_PERIODS * period_us);
+        if (!valid_ || err > limit || err < -limit) {
+            next_us_ = observed;
+            frac_q8_ = 0;
+            period_q8_ = nominal_q8_;
+            valid_ = true;
+        } else {
+            next_us_ += err / (1 << PHASE_SHIFT);
+            // An error that keeps coming back: the sensor clock is off nominal
+            int32_t step = err * 256 / (static_cast<int32_t>(n) << RATE_SHIFT);
+            uint32_t period = period_q8_ + step;
+            const uint32_t tolerance = nominal_q8_ / RATE_TOLERANCE;
+            if (period < nominal_q8_ - tolerance) period = nominal_q8_ - tolerance;
+            if (period > nominal_q8_ + tolerance) period = nominal_q8_ + tolerance;
+            period_q8_ = period;
+        }
+        const uint32_t first = next_us_;
+        const uint32_t advance_q8 = n * period_q8_ + frac_q8_;
+        next_us_ += advance_q8 >> 8;
+        frac_q8_ = advance_q8 & 0xFF;
+        return first;
+    }
+
+    // Sample i of a batch, relative to its first sample
+    uint32_t offset_us(uint8_t i) const { return (i * period_q8_) >> 8; }
+
+    // Estimated sample period in 1/256 us
+    uint32_t period_q8() const { return period_q8_; }
+
+    void reset() { valid_ = false; }
+
+private:
+    uint32_t nominal_q8_;
+    uint32_t period_q8_;
+    uint32_t next_us_ = 0;      // Expected timestamp of the next sample
+    uint32_t frac_q8_ = 0;
+    bool valid_ = false;
+};
+
+template <uint8_t N>
+class AngleHistory {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "AngleHistory size must be a power of two");
+
+public:
+    void push(uint32_t t_us, float pitch_deg, float roll_deg) {
+        Entry& e = buf_[head_ & (N - 1)];
+        e.t_us = t_us;
+        e.pitch = pitch_deg;
+        e.roll = roll_deg;
+        head_++;
+        if (count_ < N) count_++;
+    }
+
+    bool empty() const { return count_ == 0; }
+    uint32_t newest_us() const { return buf_[(head_ - 1) & (N - 1)].t_us; }
+
+    /**
+     * Angles at t_us, interpolated between the samples around it
+     * @return false if t_us is outside the history
+     */
+    bool at(uint32_t t_us, float& pitch_deg, float& roll_deg) const {
+        for (uint8_t i = 0; i + 1 < count_; i++) {
+            const Entry& newer = buf_[(head_ - 1 - i) & (N - 1)];
+            const Entry& older = buf_[(head_ - 2 - i) & (N - 1)];
+            int32_t from_older = static_cast<int32_t>(t_us - older.t_us);
+            int32_t span = static_cast<int32_t>(newer.t_us - older.t_us);
+            if (from_older < 0 || span <= 0) continue;
+            if (from_older > span) return false;        // Newer than the newest sample
+            float f = static_cast<float>(from_older) / span;
+            pitch_deg = older.pitch + (newer.pitch - older.pitch) * f;
+            roll_deg = older.roll + (newer.roll - older.roll) * f;
+            return true;
+        }
+        if (count_ && t_us == newest_us()) {
+            const Entry& e = buf_[(head_ - 1) & (N - 1)];
+            pitch_deg = e.pitch;
+            roll_deg = e.roll;
+            return true;
+        }
+        return false;
+    }
+
+    void reset() { head_ = count_ = 0; }
+
+private:
+    struct Entry {
+        uint32_t t_us;
+        float pitch;
+        float roll;
+    };
+
+    Entry buf_[N] = {};
+    uint8_t head_ = 0;
+    uint8_t count_ = 0;
+};
@@ -0,0 +1,229 @@
+// include/lipo_analysis.h - LiPo cell count and internal resistance math
+// Platform-agnostic and allocation free: the IO task runs it on live traces,
+// the host on recorded ones (test/lipo_ir_bench, benchmarks against measured packs).
+//
+// Cell count: balancer tap N carries the pack voltage up to cell N + 1, so
+// cells are the differences of consecutive taps. Taps count from the first one
+// for as long as every difference is a plausible LiPo cell voltage.
+//
+// Internal resistance from the sag under a switched known load:
+//
+//   tap mV   ‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾‾|              pre:    line fit, extrapolated to t_on
+//                            |\___________   loaded: line fit after the switching
+//                            |    ‾‾‾‾‾‾‾‾           transient, extrapolated back to t_on
+//                          t_on         t_off
+//
+//   R_cell = (V_pre(t_on) - V_load(t_on)) / I,  I = V_pack_loaded / R_load
+//
+// Extrapolating both fits to the switching instant separates the ohmic drop
+// from the slow polarization sag that follows it. Each fit is repeated once
+// without the samples beyond 3x its residual rms (outlier rejection), and its
+// standard error at t_on gives the uncertainty of each resistance.
+
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+constexpr uint8_t LIPO_ANALYSIS_MAX_CELLS = 8;
+constexpr uint16_t LIPO_TAP_MIN_MV = 500;           // Below: tap not connected
+constexpr uint16_t LIPO_CELL_MIN_MV = 2500;         // Plausible cell voltage range
+constexpr uint16_t LIPO_CELL_MAX_MV = 4500;
+constexpr uint32_t LIPO_IR_SETTLE_US = 30000;       // Skipped after the load switches on
+constexpr uint16_t LIPO_IR_MIN_CURRENT_MA = 200;    // Less: load not connected
+
+// =============================================================================
+// Cell count
+// =============================================================================
+
+struct LipoCells {
+    uint8_t count;                                  // 0 = no battery
+    uint16_t cell_mv[LIPO_ANALYSIS_MAX_CELLS];
+    uint16_t total_mv;
+    bool implausible;       // A connected tap gave a cell outside the LiPo range
+};
+
+inline LipoCells lipo_cells_from_taps(const uint16_t* tap_mv, uint8_t taps) {
+    LipoCells c = {};
+    uint16_t below = 0;
+    for (uint8_t i = 0; i < taps && i < LIPO_ANALYSIS_MAX_CELLS; i++) {
+        if (tap_mv[i] < LIPO_TAP_MIN_MV) break;
+        int32_t cell = static_cast<int32_t>(tap_mv[i]) - below;
+        if (cell < LIPO_CELL_MIN_MV || cell > LIPO_CELL_MAX_MV) {
+            // Open tap above the last cell reads close to the tap below: not a cell
+            if (cell >= LIPO_TAP_MIN_MV) c.implausible = true;
+            break;
+        }
+        c.cell_mv[c.count++] = static_cast<uint16_t>(cell);
+        below = tap_mv[i];
+    }
+    c.total_mv = below;
+    return c;
+}
+
+// =============================================================================
+// Line fit with outlier rejection
+// =============================================================================
+
+struct LipoLineFit {
+    float at_x0;            // Fitted value at x0
+    float stderr_x0;        // Standard error of at_x0
+    float rms;              // Residual rms of the kept samples
+    uint16_t used;          // Samples kept
+    uint16_t rejected;
+};
+
+namespace lipo_detail {
+
+struct Sums {
+    float n, mx, my, sxx, sxy;
+};
+
+// Centered sums over [from, to) of samples with |y - line| <= limit (limit < 0: all)
+template <typename Sample>
+inline Sums sums(Sample y, size_t from, size_t to, float slope, float icpt, float limit) {
+    Sums s = {};
+    for (size_t k = from; k < to; k++) {
+        float v = y(k);
+        if (limit >= 0.0f && fabsf(v - (icpt + slope * k)) > limit) continue;
+        s.n += 1.0f;
+        s.mx += k;
+        s.my += v;
+    }
+    if (s.n < 1.0f) return s;
+    s.mx /= s.n;
+    s.my /= s.n;
+    for (size_t k = from; k < to; k++) {
+        float v = y(k);
+        if (limit >= 0.0f && fabsf(v - (icpt + slope * k)) > limit) continue;
+        float dx = k - s.mx;
+        s.sxx += dx * dx;
+        s.sxy += dx * (v - s.my);
+    }
+    return s;
+}
+
+}  // namespace lipo_detail
+
+/**
+ * Least squares line through y(from) .. y(to - 1), evaluated at x0
+ * @param y Sample accessor, y(k) -> float (no copy of the trace is made)
+ */
+template <typename Sample>
+inline LipoLineFit lipo_fit_line(Sample y, size_t from, size_t to, float x0) {
+    using namespace lipo_detail;
+    LipoLineFit fit = {};
+    if (to < from + 3) return fit;
+
+    float slope = 0.0f, icpt = 0.0f, rms = 0.0f;
+    float limit = -1.0f;
+    Sums s = {};
+    for (int pass = 0; pass < 2; pass++) {
+        s = sums(y, from, to, slope, icpt, limit);
+        if (s.n < 3.0f) return fit;
+        slope = (s.sxx > 0.0f) ? s.sxy / s.sxx : 0.0f;
+        icpt = s.my - slope * s.mx;
+
+        float sq = 0.0f;
+        for (size_t k = from; k < to; k++) {
+            float r = y(k) - (icpt + slope * k);
+            if (limit >= 0.0f && fabsf(r) > limit) continue;
+            sq += r * r;
+        }
+        rms = sqrtf(sq / (s.n - 2.0f));
+        limit = 3.0f * (rms > 0.5f ? rms : 0.5f);     // Floor: 1 mV quantization
+    }
+
+    float dx = x0 - s.mx;
+    fit.at_x0 = icpt + slope * x0;
+    fit.stderr_x0 = rms * sqrtf(1.0f / s.n + (s.sxx > 0.0f ? dx * dx / s.sxx : 0.0f));
+    fit.rms = rms;
+    fit.used = static_cast<uint16_t>(s.n);
+    fit.rejected = static_cast<uint16_t>((to - from) - fit.used);
+    return fit;
+}
+
+// =============================================================================
+// Internal resistance
+// =============================================================================
+
+struct LipoTrace {
+    const uint16_t* tap_mv[LIPO_ANALYSIS_MAX_CELLS];    // One equidistant array per tap
+    uint8_t taps;
+    size_t samples;
+    uint32_t period_us;
+    size_t load_on;             // First sample taken entirely with the load on (the one
+                                // before may straddle the switching and is ignored)
+    size_t load_off;            // First sample after the load was switched off (or samples)
+    uint32_t load_milliohm;     // Known load resistance
+};
+
+struct LipoIrResult {
+    bool valid;
+    uint8_t cells;
+    uint16_t current_ma;
+    uint16_t ir_x10_mohm[LIPO_ANALYSIS_MAX_CELLS];      // Per cell, 0.1 mOhm
+    uint16_t uncertainty_x10_mohm[LIPO_ANALYSIS_MAX_CELLS];   // 1 sigma
+    uint16_t confidence_permille;   // Worst cell: 1000 * (1 - 2 sigma / R), clamped to 0
+    uint16_t rejected;              // Outlier samples over all fits
+};
+
+inline LipoIrResult lipo_estimate_ir(const LipoTrace& t) {
+    LipoIrResult r = {};
+    if (!t.taps || !t.period_us || !t.load_milliohm || t.load_off > t.samples) return r;
+
+    const size_t skip = (LIPO_IR_SETTLE_US + t.period_us - 1) / t.period_us;
+    const size_t load_from = t.load_on + skip;
+    const size_t pre = t.load_on - 1;
+    if (t.load_on < 4 || load_from + 3 > t.load_off) return r;
+
+    // Cell count from the pre-load averages
+    uint16_t tap_avg[LIPO_ANALYSIS_MAX_CELLS] = {};
+    for (uint8_t i = 0; i < t.taps && i < LIPO_ANALYSIS_MAX_CELLS; i++) {
+        uint32_t sum = 0;
+        for (size_t k = 0; k < pre; k++) sum += t.tap_mv[i][k];
+        tap_avg[i] = static_cast<uint16_t>(sum / pre);
+    }
+    LipoCells cells = lipo_cells_from_taps(tap_avg, t.taps);
+    if (!cells.count) return r;
+    r.cells = cells.count;
+
+    // The load switched on during sample load_on - 1: take its center as t_on
+    const float x0 = static_cast<float>(pre);
+
+    // Load current from the pack voltage right after switching on
+    const uint16_t* top = t.tap_mv[cells.count - 1];
+    LipoLineFit pack = lipo_fit_line([top](size_t k) { return static_cast<float>(top[k]); },
+                                     load_from, t.load_off, x0);
+    float current_a = pack.at_x0 / t.load_milliohm;     // mV / mOhm = A
+    r.current_ma = static_cast<uint16_t>(current_a * 1000.0f + 0.5f);
+    if (r.current_ma < LIPO_IR_MIN_CURRENT_MA) return r;
+
+    float worst = 1.0f;
+    for (uint8_t c = 0; c < cells.count; c++) {
+        const uint16_t* hi = t.tap_mv[c];
+        const uint16_t* lo = c ? t.tap_mv[c - 1] : nullptr;
+        auto cell = [hi, lo](size_t k) {
+            return static_cast<float>(hi[k]) - (lo ? static_cast<float>(lo[k]) : 0.0f);
+        };
+        LipoLineFit before = lipo_fit_line(cell, 0, pre, x0);
+        LipoLineFit loaded = lipo_fit_line(cell, load_from, t.load_off, x0);
+        r.rejected += before.rejected + loaded.rejected;
+
+        float sag_mv = before.at_x0 - loaded.at_x0;
+        float sigma_mv = sqrtf(before.stderr_x0 * before.stderr_x0 + loaded.stderr_x0 * loaded.stderr_x0);
+        float ir = sag_mv / current_a;          // mOhm
+        float sigma = sigma_mv / current_a;
+        if (ir < 0.0f) ir = 0.0f;
+
+        r.ir_x10_mohm[c] = static_cast<uint16_t>(ir * 10.0f + 0.5f);
+        r.uncertainty_x10_mohm[c] = static_cast<uint16_t>(sigma * 10.0f + 0.5f);
+
+        float conf = (ir > 0.0f) ? 1.0f - 2.0f * sigma / ir : 0.0f;
+        if (conf < worst) worst = conf;
+    }
+    r.confidence_permille = static_cast<uint16_t>((worst > 0.0f ? worst : 0.0f) * 1000.0f);
+    r.valid = true;
+    return r;
+}
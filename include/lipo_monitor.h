@@ -0,0 +1,57 @@
+// include/lipo_monitor.h - LiPo cell voltages from the balancer taps
+// The continuous ADC (include/adc_dma.h) samples every tap at LIPO_TAP_RATE_HZ;
+// the IO task runs each tap through AdcFilter (64x oversampling + IIR), converts
+// with the eFuse calibration table and publishes a reading every LIPO_PUBLISH_MS.
+// No analogRead polling: the CPU only sums DMA'd samples.
+//
+// Taps are wired as described in include/pins.h (adc_tap_divider). Cell count
+// and internal resistance math live in include/lipo_analysis.h.
+//
+// Internal resistance: on request the load on PIN_LIPO_LOAD is switched on for
+// LIPO_IR_LOAD_MS. The oversampling blocks (before the IIR) of every tap are
+// recorded from LIPO_IR_PRE_MS before until the load switches off, and the
+// trace goes through lipo_estimate_ir.
+//
+// Threads: lipo_monitor_start/stop/measure_ir/poll from the GUI task,
+//          lipo_monitor_service from the IO task.
+
+#pragma once
+
+#include <stdint.h>
+#include "pins.h"
+#include "lipo_analysis.h"
+
+constexpr uint8_t LIPO_MAX_CELLS = NUM_ADC_PINS;
+constexpr uint32_t LIPO_TAP_RATE_HZ = 4000;         // Per tap
+constexpr uint32_t LIPO_PUBLISH_MS = 100;           // Display rate
+constexpr uint32_t LIPO_IR_PRE_MS = 500;            // Unloaded record before the pulse
+constexpr uint32_t LIPO_IR_LOAD_MS = 300;           // Load pulse: short, little polarization sag
+
+static_assert(LIPO_MAX_CELLS <= LIPO_ANALYSIS_MAX_CELLS, "More taps than lipo_analysis handles");
+
+struct LipoReading {
+    uint8_t cells;                          // 0 = no battery
+    uint16_t cell_mv[LIPO_MAX_CELLS];
+    uint16_t tap_mv[LIPO_MAX_CELLS];        // Pack voltage up to each tap
+    uint16_t total_mv;
+    bool implausible;                       // A tap reads outside the LiPo cell range
+    bool settled;                           // Filters have converged
+    bool calibrated;                        // eFuse calibration available
+};
+
+// Start/stop sampling (the page that shows the readings owns the monitor)
+void lipo_monitor_start();
+void lipo_monitor_stop();
+
+// Fetch the latest reading (GUI task). Returns false when none is pending.
+bool lipo_monitor_poll(LipoReading& out);
+
+// Pulse the load and estimate the cell resistances (ignored without a battery)
+void lipo_monitor_measure_ir();
+bool lipo_monitor_ir_running();
+
+// Fetch the result of the last measurement (GUI task). Returns false when none is pending.
+bool lipo_monitor_poll_ir(LipoIrResult& out);
+
+// Drain the ADC and publish readings (IO task loop, never blocks)
+void lipo_monitor_service();
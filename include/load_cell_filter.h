@@ -0,0 +1,107 @@
+// include/load_cell_filter.h - Load cell filter chain and calibration
+// Platform-agnostic, integer only: runs on the scale task and on the host.
+//
+// Per cell:  raw 24 bit HX711 samples (80 SPS)
+//   -> median of the last MEDIAN samples: drops single-sample spikes (a bumped
+//      table, a bit slip on the shared clock line) without smearing steps
+//   -> moving average of the last AVERAGE medians: noise / sqrt(AVERAGE)
+//   -> LoadCellCal: raw -> mg, zero offset and slope from a two-point calibration
+
+#pragma once
+
+#include <stdint.h>
+
+template <uint8_t MEDIAN, uint8_t AVERAGE>
+class LoadCellFilter {
+    static_assert(MEDIAN % 2 == 1 && MEDIAN <= 9, "LoadCellFilter median window must be odd and small");
+    static_assert(AVERAGE >= 1 && AVERAGE <= 64, "LoadCellFilter average window out of range");
+
+public:
+    // Feed one raw sample; returns true once the output is valid
+    bool push(int32_t raw) {
+        med_[med_pos_] = raw;
+        med_pos_ = (med_pos_ + 1) % MEDIAN;
+        if (med_count_ < MEDIAN) {
+            med_count_++;
+            if (med_count_ < MEDIAN) return false;
+        }
+
+        int32_t m = median();
+        sum_ += m - avg_[avg_pos_];
+        avg_[avg_pos_] = m;
+        avg_pos_ = (avg_pos_ + 1) % AVERAGE;
+        if (avg_count_ < AVERAGE) avg_count_++;
+        return true;
+    }
+
+    bool valid() const { return avg_count_ > 0; }
+    bool full() const { return avg_count_ == AVERAGE; }     // Whole window after the last reset
+
+    // Filtered raw value (average of the medians collected so far)
+    int32_t value() const { return avg_count_ ? static_cast<int32_t>(sum_ / avg_count_) : 0; }
+
+    // Largest minus smallest median in the window: how still the load is
+    int32_t spread() const {
+        if (!avg_count_) return 0;
+        int32_t lo = avg_[0], hi = avg_[0];
+        for (uint8_t i = 1; i < avg_count_; i++) {
+            if (avg_[i] < lo) lo = avg_[i];
+            if (avg_[i] > hi) hi = avg_[i];
+        }
+        return hi - lo;
+    }
+
+    void reset() {
+        med_pos_ = med_count_ = 0;
+        avg_pos_ = avg_count_ = 0;
+        sum_ = 0;
+        for (auto& v : avg_) v = 0;
+    }
+
+private:
+    int32_t median() const {
+        int32_t s[MEDIAN];
+        for (uint8_t i = 0; i < MEDIAN; i++) {      // Insertion sort, MEDIAN <= 9
+            int32_t v = med_[i];
+            uint8_t j = i;
+            while (j > 0 && s[j - 1] > v) {
+                s[j] = s[j - 1];
+                j--;
+            }
+            s[j] = v;
+        }
+        return s[MEDIAN / 2];
+    }
+
+    int32_t med_[MEDIAN] = {};
+    int32_t avg_[AVERAGE] = {};
+    int64_t sum_ = 0;
+    uint8_t med_pos_ = 0, med_count_ = 0;
+    uint8_t avg_pos_ = 0, avg_count_ = 0;
+};
+
+// Raw -> mass for one cell
+struct LoadCellCal {
+    int32_t zero;               // Raw reading without load (tare)
+    int32_t counts_per_kg;      // Slope, 0 = not calibrated (sign follows the wiring)
+
+    bool calibrated() const { return counts_per_kg != 0; }
+
+    int32_t to_mg(int32_t raw) const {
+        if (!counts_per_kg) return 0;
+        return static_cast<int32_t>(static_cast<int64_t>(raw - zero) * 1000000 / counts_per_kg);
+    }
+
+    /**
+     * Two-point calibration: raw readings at two known masses
+     * @return false if the points are too close to give a slope
+     */
+    static bool from_points(int32_t raw_a, int32_t mg_a, int32_t raw_b, int32_t mg_b, LoadCellCal& out) {
+        if (mg_b == mg_a) return false;
+        int64_t slope = static_cast<int64_t>(raw_b - raw_a) * 1000000 / (mg_b - mg_a);
+        if (slope == 0 || slope > INT32_MAX || slope < -INT32_MAX) return false;
+        out.counts_per_kg = static_cast<int32_t>(slope);
+        out.zero = raw_a - static_cast<int32_t>(static_cast<int64_t>(mg_a) * slope / 1000000);
+        return true;
+    }
+};
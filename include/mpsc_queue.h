@@ -0,0 +1,78 @@
+// include/mpsc_queue.h - Lock-free bounded multi-producer / single-consumer queue
+// Dmitry Vyukov's bounded queue: every slot carries a sequence number, producers
+// claim a slot with one compare-and-swap and publish it with a release store.
+// Producers never wait for each other, so push() is safe from any task and from
+// interrupt handlers (a preempted producer only delays the consumer, never another
+// producer). Exactly one task may call pop().
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+template <typename T, size_t N>
+class MpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "MpscQueue size must be a power of two");
+
+public:
+    MpscQueue() {
+        for (size_t i = 0; i < N; i++) {
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Producer side: claim a slot and let fill(T&) write it in place.
+    // Returns false (nothing written) when the queue is full.
+    template <typename Fill>
+    bool push_with(Fill fill) {
+        Cell* cell;
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells_[pos & (N - 1)];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;   // Full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        fill(cell->data);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool push(const T& item) {
+        return push_with([&item](T& slot) { slot = item; });
+    }
+
+    // Consumer side (single task). Returns false when empty or when the oldest
+    // slot is claimed but not yet published.
+    bool pop(T& out) {
+        Cell* cell = &cells_[dequeue_pos_ & (N - 1)];
+        size_t seq = cell->seq.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(dequeue_pos_ + 1) < 0) return false;
+
+        out = cell->data;
+        cell->seq.store(dequeue_pos_ + N, std::memory_order_release);
+        dequeue_pos_++;
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T data;
+    };
+
+    Cell cells_[N];
+    std::atomic<size_t> enqueue_pos_{0};
+    size_t dequeue_pos_ = 0;   // Consumer only
+};
@@ -0,0 +1,132 @@
+// include/msg_queue.h - Blocking fixed-size message queue between tasks
+// ESP32:     FreeRTOS static queue (no heap allocation)
+// Simulator: std::mutex + std::condition_variable, so the task layout can be
+//            exercised with std::thread on the host
+//
+// Messages are copied by value - keep T small and trivially copyable.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Timeout value for "block until the operation succeeds"
+constexpr uint32_t MSG_WAIT_FOREVER = UINT32_MAX;
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+template <typename T, size_t N>
+class MsgQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "MsgQueue messages must be trivially copyable");
+
+public:
+    MsgQueue() {
+        handle_ = xQueueCreateStatic(N, sizeof(T), storage_, &queue_buf_);
+    }
+
+    MsgQueue(const MsgQueue&) = delete;
+    MsgQueue& operator=(const MsgQueue&) = delete;
+
+    // Returns false if the queue stayed full for timeout_ms
+    bool send(const T& msg, uint32_t timeout_ms = 0) {
+        return xQueueSend(handle_, &msg, to_ticks(timeout_ms)) == pdTRUE;
+    }
+
+    // Non-blocking send from an interrupt handler
+    bool send_from_isr(const T& msg) {
+        BaseType_t higher_prio_woken = pdFALSE;
+        bool ok = xQueueSendFromISR(handle_, &msg, &higher_prio_woken) == pdTRUE;
+        if (higher_prio_woken) portYIELD_FROM_ISR();
+        return ok;
+    }
+
+    // Returns false if no message arrived within timeout_ms
+    bool receive(T& msg, uint32_t timeout_ms = MSG_WAIT_FOREVER) {
+        return xQueueReceive(handle_, &msg, to_ticks(timeout_ms)) == pdTRUE;
+    }
+
+    size_t count() const {
+        return uxQueueMessagesWaiting(handle_);
+    }
+
+private:
+    static TickType_t to_ticks(uint32_t timeout_ms) {
+        return (timeout_ms == MSG_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    }
+
+    QueueHandle_t handle_ = nullptr;
+    StaticQueue_t queue_buf_;
+    uint8_t storage_[N * sizeof(T)];
+};
+
+#else
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+template <typename T, size_t N>
+class MsgQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "MsgQueue messages must be trivially copyable");
+
+public:
+    MsgQueue() = default;
+
+    MsgQueue(const MsgQueue&) = delete;
+    MsgQueue& operator=(const MsgQueue&) = delete;
+
+    bool send(const T& msg, uint32_t timeout_ms = 0) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!wait(lock, not_full_, timeout_ms, [this] { return count_ < N; })) return false;
+
+        buf_[(head_ + count_) % N] = msg;
+        count_++;
+        not_empty_.notify_one();
+        return true;
+    }
+
+    // No interrupts on the host - same as a non-blocking send
+    bool send_from_isr(const T& msg) {
+        return send(msg, 0);
+    }
+
+    bool receive(T& msg, uint32_t timeout_ms = MSG_WAIT_FOREVER) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!wait(lock, not_empty_, timeout_ms, [this] { return count_ > 0; })) return false;
+
+        msg = buf_[head_];
+        head_ = (head_ + 1) % N;
+        count_--;
+        not_full_.notify_one();
+        return true;
+    }
+
+    size_t count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+private:
+    template <typename Pred>
+    static bool wait(std::unique_lock<std::mutex>& lock, std::condition_variable& cv,
+                     uint32_t timeout_ms, Pred ready) {
+        if (timeout_ms == MSG_WAIT_FOREVER) {
+            cv.wait(lock, ready);
+            return true;
+        }
+        return cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), ready);
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    T buf_[N];
+    size_t head_ = 0;
+    size_t count_ = 0;
+};
+
+#endif
@@ -51,6 +51,29 @@ constexpr int PIN_ADC[] = {1, 2, 3};  // ADC1 channels
 // Example: 10k + 10k divider = factor 2.0
 constexpr float ADC_VOLTAGE_DIVIDER = 2.0f;
 
+// LiPo balancer taps: PIN_ADC[N] measures the pack up to cell N + 1 through a
+// (N + 1) x ADC_VOLTAGE_DIVIDER divider, so every tap stays below 2.1 V at the pin
+constexpr float adc_tap_divider(int tap) { return (tap + 1) * ADC_VOLTAGE_DIVIDER; }
+
+// LiPo internal resistance test: MOSFET switching a known load across the pack
+constexpr int PIN_LIPO_LOAD = 4;
+constexpr uint32_t LIPO_LOAD_MILLIOHM = 10000;  // 10 Ohm (1.3 A at 3S, 0.4 A at 1S)
+
+// =============================================================================
+// CG Scale load cells (HX711 modules, RATE pin high = 80 SPS)
+// =============================================================================
+// All modules share SCK so they convert and shift out in lock-step
+constexpr int NUM_LOAD_CELLS = 3;
+constexpr int PIN_HX711_SCK = 45;                   // Strapping pin: low at boot (SCK idles low)
+constexpr int PIN_HX711_DOUT[] = {46, 42, 38};      // Front left, front right, tail
+
+// GPIO46 is a boot strapping pin and a powered HX711 holds DOUT high until its
+// first conversion. Normal boot (GPIO0 high) ignores GPIO46, but GPIO0 low with
+// GPIO46 high is an invalid combination, so download mode via the BOOT button
+// or the UART auto-reset fails while load cell 1 is powered. Flash over the
+// native USB port (download mode without strapping pins) or unplug load cell 1.
+// No other GPIO is free on the DevKitC-1 headers (see GPIO Summary).
+
 // =============================================================================
 // Rotary Encoder (EC11 with push button)
 // =============================================================================
@@ -62,11 +85,15 @@ constexpr int PIN_ENC_DT  = 35;  // Encoder output B (DT)
 constexpr int PIN_ENC_SW  = 37;  // Encoder push button (active LOW)
 
 // =============================================================================
-// I2C Bus (for future I2C expander, sensors, etc.)
+// I2C Bus (PN532, IMU, future I2C expander, sensors, etc.)
 // =============================================================================
 constexpr int PIN_I2C_SDA = 47;
 constexpr int PIN_I2C_SCL = 39;  // Keep NeoPixel on GPIO48
 
+// IMU (MPU6050 / GY-521) at 0x68 on the I2C bus, optional second one for the
+// control surface at 0x69 (AD0 to VCC). INT is not connected: the FIFOs are
+// read in bursts (see include/imu.h)
+
 // =============================================================================
 // NFC (PN532) - HW-147C breakout (I2C mode, DIP: 1/0)
 // =============================================================================
@@ -81,7 +108,7 @@ constexpr int PIN_PN532_RST = 40; // Hardware reset
 //   1       - free GPIO
 //   2       - free GPIO
 //   3       - free GPIO
-//   4       - free GPIO (SD card chip select not used)
+//   4       - LiPo IR test load (SD card chip select not used)
 //   5       - TFT Backlight PWM
 //   6       - Servo 1
 //   7       - TOUCH_IRQ
@@ -102,11 +129,13 @@ constexpr int PIN_PN532_RST = 40; // Hardware reset
 //  37       - Encoder SW (button)
 //  40       - PN532_RST
 //  41       - PN532_IRQ
-//  47       - I2C SDA (PN532)
-//  39       - I2C SCL (PN532)
+//  47       - I2C SDA (PN532, IMU)
+//  39       - I2C SCL (PN532, IMU)
 //  48       - NeoPixel
-//  38       - CS_BREAK (SPI breakout)
-//  42       - IRQ_BREAK (SPI breakout)
+//  38       - HX711 DOUT 3 (CS_BREAK on the SPI breakout)
+//  42       - HX711 DOUT 2 (IRQ_BREAK on the SPI breakout)
+//  45       - HX711 SCK (strapping pin)
+//  46       - HX711 DOUT 1 (strapping pin: blocks UART download mode, see above)
 
 // Available GPIOs:
-//  45, 46  - Available (strapping pins, use with care)
+//  none left on the DevKitC-1 headers (43/44 = UART0 console)
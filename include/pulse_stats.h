@@ -0,0 +1,157 @@
+// include/pulse_stats.h - Servo signal statistics from captured edge timestamps
+// Platform-agnostic: fed by the MCPWM capture driver on ESP32 (src/servo_capture.cpp)
+// and by a synthetic edge stream in the simulator; runs on the host as is.
+//
+// Timestamps are free-running counter ticks (wrap-around safe). A pulse is
+// rising -> falling edge, a frame period is rising -> rising edge. A missing
+// edge resynchronizes on the next rising edge instead of producing a bogus width.
+
+#pragma once
+
+#include <stdint.h>
+
+struct PulseReport {
+    bool     signal;            // At least one complete pulse in the window
+    uint32_t pulses;            // Complete pulses in the window
+    uint32_t width_ns;          // Last pulse width
+    uint32_t width_mean_ns;
+    uint32_t width_jitter_ns;   // Standard deviation of the width
+    uint32_t width_min_ns;      // Since the last reset (not per window)
+    uint32_t width_max_ns;
+    uint32_t period_ns;         // Mean frame period
+    uint32_t period_jitter_ns;  // Standard deviation of the period
+    uint32_t freq_mhz;          // Frame rate in mHz (333.333 Hz -> 333333)
+    uint32_t lost_frames;       // Frames missing from the stream since the last reset
+    uint32_t glitches;          // Edge sequence errors since the last reset
+};
+
+class PulseStats {
+public:
+    explicit PulseStats(uint32_t clk_hz) : clk_hz_(clk_hz) { reset(); }
+
+    // Clear everything, including min/max and error counters
+    void reset() {
+        width_ = {};
+        period_ = {};
+        width_min_ = UINT32_MAX;
+        width_max_ = 0;
+        last_width_ = 0;
+        last_period_ = 0;
+        lost_ = 0;
+        glitches_ = 0;
+        have_rise_ = false;
+        high_ = false;
+    }
+
+    void on_edge(bool rising, uint32_t ticks) {
+        if (rising) {
+            if (high_) glitches_++;         // Falling edge lost
+            if (have_rise_) add_period(ticks - last_rise_);
+            last_rise_ = ticks;
+            have_rise_ = true;
+            high_ = true;
+        } else if (high_) {
+            uint32_t width = ticks - last_rise_;
+            width_.add(width);
+            last_width_ = width;
+            if (width < width_min_) width_min_ = width;
+            if (width > width_max_) width_max_ = width;
+            high_ = false;
+        } else if (have_rise_) {
+            glitches_++;                    // Rising edge lost
+        }
+    }
+
+    // Summarize the window since the previous report and start a new one
+    PulseReport take_report() {
+        PulseReport r = {};
+        r.pulses = width_.n;
+        r.signal = width_.n > 0;
+        r.lost_frames = lost_;
+        r.glitches = glitches_;
+        if (r.signal) {
+            r.width_ns = to_ns(last_width_);
+            r.width_mean_ns = to_ns(width_.mean());
+            r.width_jitter_ns = to_ns(width_.stddev());
+            r.width_min_ns = to_ns(width_min_);
+            r.width_max_ns = to_ns(width_max_);
+        }
+        if (period_.n > 0) {
+            r.period_ns = to_ns(period_.mean());
+            r.period_jitter_ns = to_ns(period_.stddev());
+            if (r.period_ns) r.freq_mhz = static_cast<uint32_t>(1000000000000ULL / r.period_ns);
+        }
+        width_ = {};
+        period_ = {};
+        return r;
+    }
+
+private:
+    // Count, sum and sum of squares: mean and standard deviation without storing samples
+    struct Accum {
+        uint32_t n;
+        uint64_t sum;
+        uint64_t sum_sq;
+
+        void add(uint32_t v) {
+            n++;
+            sum += v;
+            sum_sq += static_cast<uint64_t>(v) * v;
+        }
+        uint32_t mean() const { return n ? static_cast<uint32_t>(sum / n) : 0; }
+        // var = (n * sum_sq - sum^2) / n^2 - exact in integers (a truncated mean
+        // would add ~2 * mean of error). Fits 64 bit for report windows of a
+        // few seconds at 400 Hz with 80 MHz ticks.
+        uint32_t stddev() const {
+            if (n < 2) return 0;
+            uint64_t a = n * sum_sq;
+            uint64_t b = sum * sum;
+            uint64_t nn = static_cast<uint64_t>(n) * n;
+            return a > b ? isqrt((a - b + nn / 2) / nn) : 0;
+        }
+    };
+
+    static uint32_t isqrt(uint64_t v) {
+        uint64_t r = 0;
+        uint64_t bit = 1ULL << 62;
+        while (bit > v) bit >>= 2;
+        while (bit) {
+            if (v >= r + bit) {
+                v -= r + bit;
+                r = (r >> 1) + bit;
+            } else {
+                r >>= 1;
+            }
+            bit >>= 2;
+        }
+        return static_cast<uint32_t>(r);
+    }
+
+    void add_period(uint32_t period) {
+        // A gap of 1.5+ periods means whole frames are missing: count them,
+        // but keep the gap out of the period statistics
+        if (last_period_ && period > last_period_ + last_period_ / 2) {
+            lost_ += (period + last_period_ / 2) / last_period_ - 1;
+            return;
+        }
+        period_.add(period);
+        last_period_ = period;
+    }
+
+    uint32_t to_ns(uint32_t ticks) const {
+        return static_cast<uint32_t>(static_cast<uint64_t>(ticks) * 1000000000ULL / clk_hz_);
+    }
+
+    uint32_t clk_hz_;
+    Accum width_;
+    Accum period_;
+    uint32_t width_min_;
+    uint32_t width_max_;
+    uint32_t last_width_;
+    uint32_t last_period_;
+    uint32_t last_rise_ = 0;
+    uint32_t lost_;
+    uint32_t glitches_;
+    bool have_rise_;
+    bool high_;
+};
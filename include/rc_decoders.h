@@ -0,0 +1,261 @@
+// include/rc_decoders.h - RC receiver protocol decoders (PPM, SBUS, iBUS)
+// Platform-agnostic streaming decoders: bytes (SBUS, iBUS) or edge timestamps
+// (PPM) go in one at a time, a complete frame comes out. They are fed straight
+// from the UART read chunk / capture edge queue - no frame is buffered or
+// copied before decoding - and run on the host against recorded streams.
+//
+//   SBUS  100 kbaud 8E2 inverted, 25 bytes: 0x0F, 16 x 11 bit channels, flags, footer
+//   iBUS  115200 8N1, 32 bytes: 0x20 0x40, 14 x 16 bit channels, checksum
+//         (channels 15+ are packed into the top nibbles by 18 channel receivers)
+//   PPM   one pulse train: rising edge to rising edge = channel, long gap = sync
+//
+// Statistics count what the stream itself reports: valid frames, malformed
+// frames (bad footer/checksum/timing), frames the receiver flagged as lost and
+// frames sent in failsafe (SBUS only - iBUS and PPM have no flags).
+
+#pragma once
+
+#include <stdint.h>
+
+constexpr uint8_t RC_MAX_CHANNELS = 16;
+
+struct RcFrame {
+    uint16_t ch_us[RC_MAX_CHANNELS];
+    uint8_t num_channels;
+    bool frame_lost;        // Receiver missed a frame from the transmitter
+    bool failsafe;          // Receiver is outputting failsafe values
+};
+
+struct RcLinkStats {
+    uint32_t frames;            // Valid frames
+    uint32_t bad_frames;        // Dropped: footer, checksum or timing error
+    uint32_t lost_frames;       // Valid frames flagged "frame lost" by the receiver
+    uint32_t failsafe_frames;   // Valid frames flagged failsafe
+};
+
+// Common frame/statistics bookkeeping
+class RcDecoder {
+public:
+    const RcFrame& frame() const { return frame_; }
+    const RcLinkStats& stats() const { return stats_; }
+    void reset_stats() { stats_ = {}; }
+
+protected:
+    void commit(const uint16_t* ch_us, uint8_t num_channels, bool frame_lost, bool failsafe) {
+        for (uint8_t i = 0; i < num_channels; i++) frame_.ch_us[i] = ch_us[i];
+        for (uint8_t i = num_channels; i < RC_MAX_CHANNELS; i++) frame_.ch_us[i] = 0;
+        frame_.num_channels = num_channels;
+        frame_.frame_lost = frame_lost;
+        frame_.failsafe = failsafe;
+        stats_.frames++;
+        if (frame_lost) stats_.lost_frames++;
+        if (failsafe) stats_.failsafe_frames++;
+    }
+
+    RcFrame frame_ = {};
+    RcLinkStats stats_ = {};
+};
+
+// =============================================================================
+// SBUS (Futaba, FrSky, ...)
+// =============================================================================
+class SbusDecoder : public RcDecoder {
+public:
+    static constexpr uint32_t BAUD = 100000;
+    static constexpr uint8_t HEADER = 0x0F;
+    static constexpr uint8_t FRAME_LEN = 25;
+    static constexpr uint8_t FLAG_FRAME_LOST = 0x04;
+    static constexpr uint8_t FLAG_FAILSAFE = 0x08;
+
+    // Feed one byte; returns true when it completed a valid frame
+    bool push(uint8_t b) {
+        if (pos_ == 0) {
+            if (b != HEADER) return false;
+            bits_ = 0;
+            nbits_ = 0;
+            count_ = 0;
+            pos_ = 1;
+            return false;
+        }
+
+        if (pos_ < FRAME_LEN - 2) {
+            // 22 data bytes, channels packed LSB first
+            bits_ |= static_cast<uint32_t>(b) << nbits_;
+            nbits_ += 8;
+            while (nbits_ >= 11) {
+                raw_[count_++] = to_us(bits_ & 0x7FF);
+                bits_ >>= 11;
+                nbits_ -= 11;
+            }
+            pos_++;
+            return false;
+        }
+
+        if (pos_ == FRAME_LEN - 2) {
+            flags_ = b;
+            pos_++;
+            return false;
+        }
+
+        // Footer: 0x00, or 0x04/0x14/0x24/0x34 with SBUS2 telemetry slots
+        pos_ = 0;
+        if (b != 0x00 && (b & 0x0F) != 0x04) {
+            stats_.bad_frames++;
+            return false;
+        }
+        commit(raw_, RC_MAX_CHANNELS, flags_ & FLAG_FRAME_LOST, flags_ & FLAG_FAILSAFE);
+        return true;
+    }
+
+    // 172 .. 1811 -> 988 .. 2012 µs (0.625 µs per count around 992 = 1500 µs)
+    static uint16_t to_us(uint32_t raw) {
+        return static_cast<uint16_t>(1500 + ((static_cast<int32_t>(raw) - 992) * 5) / 8);
+    }
+
+private:
+    uint16_t raw_[RC_MAX_CHANNELS] = {};
+    uint32_t bits_ = 0;
+    uint8_t nbits_ = 0;
+    uint8_t count_ = 0;
+    uint8_t pos_ = 0;
+    uint8_t flags_ = 0;
+};
+
+// =============================================================================
+// iBUS (FlySky)
+// =============================================================================
+class IbusDecoder : public RcDecoder {
+public:
+    static constexpr uint32_t BAUD = 115200;
+    static constexpr uint8_t FRAME_LEN = 32;
+    static constexpr uint8_t HEADER_LEN = 0x20;     // Length byte = frame length
+    static constexpr uint8_t HEADER_CMD = 0x40;     // Servo data command
+    static constexpr uint8_t WORDS = 14;
+
+    // Feed one byte; returns true when it completed a valid frame
+    bool push(uint8_t b) {
+        if (pos_ == 0) {
+            if (b != HEADER_LEN) return false;
+            sum_ = b;
+            pos_ = 1;
+            return false;
+        }
+        if (pos_ == 1) {
+            if (b != HEADER_CMD) {
+                pos_ = (b == HEADER_LEN) ? 1 : 0;
+                return false;
+            }
+            sum_ += b;
+            pos_ = 2;
+            return false;
+        }
+
+        if (pos_ < FRAME_LEN - 2) {
+            uint8_t w = (pos_ - 2) / 2;
+            if (pos_ & 1) words_[w] |= static_cast<uint16_t>(b) << 8;
+            else words_[w] = b;
+            sum_ += b;
+            pos_++;
+            return false;
+        }
+
+        if (pos_ == FRAME_LEN - 2) {
+            checksum_ = b;
+            pos_++;
+            return false;
+        }
+
+        pos_ = 0;
+        checksum_ |= static_cast<uint16_t>(b) << 8;
+        if (checksum_ != static_cast<uint16_t>(0xFFFF - sum_)) {
+            stats_.bad_frames++;
+            return false;
+        }
+
+        uint16_t ch[RC_MAX_CHANNELS];
+        uint8_t n = WORDS;
+        bool extended = false;
+        for (uint8_t i = 0; i < WORDS; i++) {
+            ch[i] = words_[i] & 0x0FFF;
+            if (words_[i] >> 12) extended = true;
+        }
+        // 18 channel receivers: channel 15 + k spreads over the top nibbles of words 3k .. 3k + 2
+        if (extended) {
+            for (uint8_t k = 0; WORDS + k < RC_MAX_CHANNELS; k++) {
+                ch[WORDS + k] = (words_[3 * k] >> 12) | ((words_[3 * k + 1] >> 12) << 4) |
+                                ((words_[3 * k + 2] >> 12) << 8);
+            }
+            n = RC_MAX_CHANNELS;
+        }
+        commit(ch, n, false, false);
+        return true;
+    }
+
+private:
+    uint16_t words_[WORDS] = {};
+    uint16_t sum_ = 0;
+    uint16_t checksum_ = 0;
+    uint8_t pos_ = 0;
+};
+
+// =============================================================================
+// PPM (sum signal)
+// =============================================================================
+// Uses one edge polarity only, so positive and negative PPM decode the same.
+class PpmDecoder : public RcDecoder {
+public:
+    static constexpr uint32_t SYNC_MIN_US = 2700;   // Longer than any channel = frame gap
+    static constexpr uint32_t CH_MIN_US = 700;
+    static constexpr uint32_t CH_MAX_US = 2300;
+    static constexpr uint8_t MIN_CHANNELS = 4;
+
+    explicit PpmDecoder(uint32_t clk_hz) : ticks_per_us_(clk_hz / 1000000) {}
+
+    // Feed one captured edge; returns true when a sync gap completed a valid frame
+    bool on_edge(bool rising, uint32_t ticks) {
+        if (!rising) return false;
+        if (!have_edge_) {
+            have_edge_ = true;
+            last_ = ticks;
+            return false;
+        }
+
+        uint32_t us = (ticks - last_) / ticks_per_us_;
+        last_ = ticks;
+
+        if (us >= SYNC_MIN_US) {
+            bool done = false;
+            if (synced_ && !bad_) {
+                if (count_ >= MIN_CHANNELS) {
+                    commit(ch_, count_, false, false);
+                    done = true;
+                } else {
+                    stats_.bad_frames++;
+                }
+            }
+            synced_ = true;
+            bad_ = false;
+            count_ = 0;
+            return done;
+        }
+
+        if (!synced_ || bad_) return false;
+        if (us < CH_MIN_US || us > CH_MAX_US || count_ >= RC_MAX_CHANNELS) {
+            // Broken frame: drop it, resynchronize on the next gap
+            stats_.bad_frames++;
+            bad_ = true;
+            return false;
+        }
+        ch_[count_++] = static_cast<uint16_t>(us);
+        return false;
+    }
+
+private:
+    uint32_t ticks_per_us_;
+    uint32_t last_ = 0;
+    uint16_t ch_[RC_MAX_CHANNELS] = {};
+    uint8_t count_ = 0;
+    bool have_edge_ = false;
+    bool synced_ = false;
+    bool bad_ = false;
+};
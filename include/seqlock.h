@@ -0,0 +1,61 @@
+// include/seqlock.h - Lock-free latest-value snapshot (sequence lock)
+// One task writes, any number of tasks read; the writer never waits, a reader
+// retries if the writer was busy while it copied. For small plain structs that
+// are overwritten at a high rate (newest value only, nothing queued).
+// Platform-agnostic: used by ESP32 drivers and compiled on the host.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock value must be trivially copyable");
+
+public:
+    // Writer side (single writer)
+    void write(const T& value) {
+        uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);        // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        copy_in(value);
+        seq_.store(seq + 2, std::memory_order_release);        // Even: consistent
+    }
+
+    // Reader side. Returns false if nothing was written yet.
+    bool read(T& out) const {
+        for (;;) {
+            uint32_t before = seq_.load(std::memory_order_acquire);
+            if (before == 0) return false;
+            if (before & 1) continue;                           // Writer busy
+            copy_out(out);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == before) return true;
+        }
+    }
+
+    // Bumped on every write: readers can tell whether anything changed
+    uint32_t version() const { return seq_.load(std::memory_order_acquire) >> 1; }
+
+private:
+    // Word-wise relaxed atomics: no torn or reordered copies, no data race
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    void copy_in(const T& value) {
+        uint32_t words[WORDS] = {};
+        memcpy(words, &value, sizeof(T));
+        for (size_t i = 0; i < WORDS; i++) data_[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    void copy_out(T& out) const {
+        uint32_t words[WORDS];
+        for (size_t i = 0; i < WORDS; i++) words[i] = data_[i].load(std::memory_order_relaxed);
+        memcpy(&out, words, sizeof(T));
+    }
+
+    std::atomic<uint32_t> seq_{0};
+    std::atomic<uint32_t> data_[WORDS] = {};
+};
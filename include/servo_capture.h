@@ -0,0 +1,71 @@
+// include/servo_capture.h - Servo signal capture for the signal analyzer
+// Measures the PWM signal of an external receiver/servo tester on the servo header pins.
+//
+// ESP32:     MCPWM capture units (2 x 3 channels) latch an 80 MHz timestamp on
+//            every edge in hardware. The capture ISR only queues the timestamp;
+//            the IO task turns edges into statistics.
+// Simulator: synthetic signals on channels 1 and 2 feed the same path.
+//
+// Bus modes decode a receiver sum signal on servo header 1 (CAPTURE_BUS_CHANNEL):
+//   PPM        edges from the same capture channel (include/rc_decoders.h)
+//   SBUS/iBUS  UART1 RX on the header pin, decoded straight from the read chunks
+//
+// Threads: capture_start/stop/reset_minmax and capture_poll from the GUI task,
+//          capture_service from the IO task.
+
+#pragma once
+
+#include <stdint.h>
+#include "pins.h"
+#include "pulse_stats.h"
+#include "rc_decoders.h"
+
+constexpr uint32_t CAPTURE_REPORT_MS = 100;     // Statistics window per report
+
+enum CaptureMode : uint8_t {
+    CAPTURE_MODE_PWM = 0,   // Pulse statistics on every servo header pin
+    CAPTURE_MODE_PPM,
+    CAPTURE_MODE_SBUS,
+    CAPTURE_MODE_IBUS,
+    CAPTURE_MODE_COUNT
+};
+
+// Servo header used as the receiver input in the bus modes
+constexpr uint8_t CAPTURE_BUS_CHANNEL = 0;
+
+struct CaptureReport {
+    uint8_t channel;        // Servo header index (0 .. NUM_SERVO_PINS - 1)
+    PulseReport stats;
+};
+
+struct BusReport {
+    CaptureMode mode;
+    bool signal;                // At least one valid frame in the window
+    uint32_t frame_rate_mhz;    // Valid frames per second in mHz
+    RcFrame frame;              // Latest valid frame
+    RcLinkStats stats;          // Since the start or the last reset
+};
+
+// Take over the servo pins in mask as inputs and start measuring
+// (servo outputs on these pins are released, see servo_release_pins)
+void capture_start(uint8_t mask);
+
+// Take over CAPTURE_BUS_CHANNEL and decode a PPM/SBUS/iBUS receiver signal
+void capture_start_bus(CaptureMode mode);
+
+// Stop measuring and hand the pins back to the servo driver
+void capture_stop();
+
+// Clear min/max and error counters of all channels (bus modes: link statistics)
+void capture_reset_minmax();
+
+// Drain captured edges and publish a report per channel every CAPTURE_REPORT_MS
+// (IO task loop, never blocks)
+void capture_service();
+
+// Fetch the next report (GUI task). Returns false when none is pending.
+bool capture_poll(CaptureReport& out);
+bool capture_poll_bus(BusReport& out);
+
+// Edges lost because the IO task fell behind the capture ISR
+uint32_t capture_get_dropped();
@@ -4,20 +4,66 @@
 #pragma once
 
 #include <cstdint>
+#include "pins.h"
+#include "servo_trajectory.h"
 
 // Servo PWM parameters
-constexpr int SERVO_PWM_FREQ_HZ = 50;          // 50 Hz = 20ms period
-constexpr int SERVO_PWM_RESOLUTION = 14;       // 14-bit resolution (max achievable at 50Hz)
+constexpr int SERVO_PWM_FREQ_HZ = 50;          // Default frame rate: 50 Hz = 20ms period
+constexpr int SERVO_PWM_FREQ_MIN_HZ = 50;      // Analog servos
+constexpr int SERVO_PWM_FREQ_MAX_HZ = 400;     // Fast digital servos (333 Hz typical)
+constexpr int SERVO_PWM_RESOLUTION = 14;       // Max LEDC duty resolution on ESP32-S3
+constexpr uint32_t SERVO_LEDC_CLK_HZ = 80000000; // LEDC source clock (APB)
+constexpr int SERVO_FRAME_GAP_MIN_US = 100;    // Pulses are clamped to leave this low time per frame
 constexpr int SERVO_PULSE_MIN_US = 500;        // Minimum pulse width (microseconds)
 constexpr int SERVO_PULSE_MAX_US = 2500;       // Maximum pulse width (microseconds)
 constexpr int SERVO_PULSE_CENTER_US = 1500;    // Center position (microseconds)
 
+constexpr uint8_t SERVO_MASK_ALL = 0xFF;       // All outputs (masked to the available servos)
+
+// High-resolution output mode (RMT)
+constexpr uint32_t SERVO_HIRES_TICK_NS = 100;  // 0.1 µs pulse steps, exact frame period
+constexpr int SERVO_HIRES_MAX_CHANNELS = 4;    // RMT TX channels on ESP32-S3
+
+/**
+ * LEDC duty resolution for a frame rate: as many bits as the source clock
+ * allows (floor(log2(clk / freq))), capped at the hardware maximum
+ * 50 Hz -> 14 bit (1.22 µs/count), 333 Hz -> 14 bit (0.18 µs/count)
+ */
+constexpr int servo_duty_resolution(uint32_t freq_hz) {
+    int bits = 0;
+    while (bits < SERVO_PWM_RESOLUTION && (SERVO_LEDC_CLK_HZ / freq_hz) >> (bits + 1)) bits++;
+    return bits;
+}
+
+/**
+ * Pulse widths for several servos, applied together by servo_commit()
+ * Only servos whose bit is set in mask are changed
+ */
+struct ServoFrame {
+    uint8_t mask = 0;                           // Bit N = servo N included
+    uint32_t pulse_ns[NUM_SERVO_PINS] = {};     // Pulse widths in nanoseconds
+
+    void set_us(uint8_t servo_idx, uint16_t pulse_us) { set_ns(servo_idx, pulse_us * 1000UL); }
+    void set_ns(uint8_t servo_idx, uint32_t ns) {
+        if (servo_idx >= NUM_SERVO_PINS) return;
+        mask |= static_cast<uint8_t>(1 << servo_idx);
+        pulse_ns[servo_idx] = ns;
+    }
+};
+
 /**
  * Initialize all servo LEDC channels
- * Must be called once at startup before using servo functions
+ * Called by servo_task_main() - the RT task owns the LEDC hardware
  */
 void servo_driver_init();
 
+/**
+ * RT task body: initializes the hardware, then applies commands posted by the
+ * servo_* functions below. Start once with app_task_create() (see gui/app_tasks.h).
+ * All other servo functions are safe to call from any task.
+ */
+void servo_task_main(void* arg);
+
 /**
  * Set PWM pulse width for a single servo
  * @param servo_idx Servo index (0-5)
@@ -32,6 +78,30 @@ void servo_set_pulse(uint8_t servo_idx, uint16_t pulse_us);
  */
 void servo_set_pulse_mask(uint8_t mask, uint16_t pulse_us);
 
+/**
+ * Set pulse width in nanoseconds for a single servo
+ * LEDC outputs round to the duty step, high-resolution outputs to 100 ns
+ * @param servo_idx Servo index (0-5)
+ * @param pulse_ns Pulse width in nanoseconds (500000-2500000)
+ */
+void servo_set_pulse_ns(uint8_t servo_idx, uint32_t pulse_ns);
+
+/**
+ * Set pulse width in nanoseconds for multiple servos using a bitmask
+ * @param mask Bitmask where bit N = servo N
+ * @param pulse_ns Pulse width in nanoseconds (500000-2500000)
+ */
+void servo_set_pulse_ns_mask(uint8_t mask, uint32_t pulse_ns);
+
+/**
+ * Apply a frame of pulse widths atomically
+ * Every servo in frame.mask that shares a frame rate switches at the same PWM
+ * period boundary (latched from the LEDC timer overflow interrupt), so mixed
+ * moves never show a period with half the outputs updated
+ * @param frame Pulse widths (clamped to 500-2500 µs like servo_set_pulse)
+ */
+void servo_commit(const ServoFrame& frame);
+
 /**
  * Enable/disable servo output for a single servo
  * When disabled, no PWM signal is sent (servo can freewheel)
@@ -52,9 +122,115 @@ void servo_enable_mask(uint8_t mask, bool enable);
  */
 void servo_disable_all();
 
+/**
+ * Set the PWM frame rate for servos in a bitmask
+ * Outputs sharing a frame rate share one LEDC timer; up to 4 different
+ * frame rates can be active at once (request is ignored if none is free)
+ * @param mask Bitmask where bit N = servo N
+ * @param freq_hz Frame rate in Hz (50-400, clamped)
+ */
+void servo_set_frequency(uint8_t mask, uint16_t freq_hz);
+
+/**
+ * Get the requested frame rate for a servo
+ * @param servo_idx Servo index (0-5)
+ * @return Frame rate in Hz
+ */
+uint16_t servo_get_frequency(uint8_t servo_idx);
+
+/**
+ * Select high-resolution output (RMT, 0.1 µs steps) or standard LEDC output
+ * At most SERVO_HIRES_MAX_CHANNELS outputs can be high-resolution; further
+ * requests stay on LEDC (check with servo_hires_active)
+ * @param mask Bitmask where bit N = servo N
+ * @param enable true for high-resolution, false for LEDC
+ */
+void servo_set_high_resolution(uint8_t mask, bool enable);
+
+/**
+ * Check whether a servo is currently driven in high-resolution mode
+ * @param servo_idx Servo index (0-5)
+ * @return true if the output runs on an RMT channel
+ */
+bool servo_hires_active(uint8_t servo_idx);
+
+/**
+ * Hand servo pins over to an input peripheral (signal analyzer) and back
+ * Released outputs stop and their pins become inputs; reclaimed outputs are
+ * reconnected to their PWM channel but stay disabled until servo_enable()
+ * @param mask Bitmask where bit N = servo N
+ * @param release true to release the pins, false to drive them again
+ */
+void servo_release_pins(uint8_t mask, bool release);
+
+/**
+ * Run a sweep profile on servos in a bitmask
+ * The driver advances the trajectory every PWM frame from the timer interrupt,
+ * independent of GUI load. Each servo joins at its current position.
+ * Setting a pulse (servo_set_pulse, servo_commit) on a servo stops its trajectory.
+ * @param mask Bitmask where bit N = servo N
+ * @param traj Profile, end points (500-2500 µs), dwell and speed
+ */
+void servo_trajectory_start(uint8_t mask, const ServoTrajectory& traj);
+
+/**
+ * Change the travel speed of running trajectories without restarting them
+ * @param mask Bitmask where bit N = servo N
+ * @param speed_us_per_s Travel speed in µs per second
+ */
+void servo_trajectory_set_speed(uint8_t mask, uint32_t speed_us_per_s);
+
+/**
+ * Stop trajectories; the servos hold their last position
+ * @param mask Bitmask where bit N = servo N
+ */
+void servo_trajectory_stop(uint8_t mask);
+
+/**
+ * Check whether a servo is following a trajectory
+ * @param servo_idx Servo index (0-5)
+ */
+bool servo_trajectory_running(uint8_t servo_idx);
+
+/**
+ * Get current pulse width for a servo in nanoseconds
+ * Follows the trajectory position while one is running
+ * @param servo_idx Servo index (0-5)
+ * @return Current pulse width in nanoseconds
+ */
+uint32_t servo_get_pulse_ns(uint8_t servo_idx);
+
 /**
  * Get current pulse width for a servo
  * @param servo_idx Servo index (0-5)
  * @return Current pulse width in microseconds
  */
 uint16_t servo_get_pulse(uint8_t servo_idx);
+
+/**
+ * Time at which the last servo_commit() value reached the output
+ * Start of the first PWM frame with the new width, so step response
+ * measurements can reference the real output edge. LEDC channels are stamped
+ * at the timer overflow that applies the duty (one period after it is
+ * written), high-resolution channels at the next start of their RMT frame loop.
+ * On LEDC the value updates only once that frame has started.
+ * @param servo_idx Servo index (0-5)
+ * @return Timestamp on the app_time_us() clock, 0 if nothing was committed yet
+ */
+uint32_t servo_get_commit_time_us(uint8_t servo_idx);
+
+/**
+ * Number of commands dropped because the RT task queue stayed full
+ * @return Dropped command count since boot
+ */
+uint32_t servo_get_dropped_count();
+
+/**
+ * Simulator only: pulse width at the output at a point in time (0 on ESP32)
+ * Models the frame boundary latch independently of servo_get_commit_time_us(),
+ * so the simulated servo reacts to the output, not to the driver's stamp
+ * @param servo_idx Servo index (0-5)
+ * @param t_us Time on the app_time_us() clock (recent past or present)
+ * @return Pulse width in nanoseconds
+ */
+uint32_t servo_sim_output_ns(uint8_t servo_idx, uint32_t t_us);
@@ -0,0 +1,96 @@
+// include/servo_test.h - Servo response latency and deadband measurement
+// Steps a servo through the servo driver and records its feedback (position
+// potentiometer or supply current shunt wired to a PIN_ADC[] input) with the
+// continuous ADC (include/adc_dma.h):
+//
+//   step runs  alternate low -> high -> low ... N times; each record is analyzed
+//              with step_analyze (dead time, 10-90% rise, overshoot)
+//   deadband   approach center from one side, then step back towards it in 1 µs
+//              increments until the output moves (both sides, averaged)
+//
+// Timing: the step time is the PWM period boundary at which the servo driver
+// latched the command (servo_get_commit_time_us), the sample times come from the
+// ADC conversion clock - both on the app_time_us() clock, so the dead time does
+// not include the wait for the next PWM period or any task latency.
+//
+// Threads: servo_test_start/abort/state/result/export from the GUI task,
+//          servo_test_service from the IO task.
+
+#pragma once
+
+#include <stdint.h>
+
+constexpr uint8_t SERVO_TEST_MAX_RUNS = 20;
+constexpr uint8_t SERVO_TEST_DEADBAND_MAX_US = 20;   // Give up probing beyond this
+
+struct ServoTestConfig {
+    uint8_t servo;          // Servo index
+    uint8_t adc_input;      // Index into PIN_ADC[]
+    uint16_t low_us;        // Step endpoints
+    uint16_t high_us;
+    uint16_t center_us;     // Deadband probe position
+    uint8_t runs;           // 1 .. SERVO_TEST_MAX_RUNS
+};
+
+enum ServoTestState : uint8_t {
+    SERVO_TEST_IDLE = 0,
+    SERVO_TEST_RUNNING,
+    SERVO_TEST_DONE,
+    SERVO_TEST_FAILED
+};
+
+enum ServoTestError : uint8_t {
+    SERVO_TEST_OK = 0,
+    SERVO_TEST_ERR_ADC,             // ADC could not be started
+    SERVO_TEST_ERR_NO_RESPONSE,     // Feedback did not follow the steps
+    SERVO_TEST_ERR_ABORTED
+};
+
+struct ServoTestRun {
+    uint16_t from_us;
+    uint16_t to_us;
+    bool moved;
+    uint32_t dead_time_us;
+    uint32_t rise_us;               // 10% -> 90%
+    uint16_t overshoot_permille;
+};
+
+struct ServoTestResult {
+    ServoTestConfig config;
+    uint8_t runs_done;
+    ServoTestRun run[SERVO_TEST_MAX_RUNS];
+
+    // Over the runs that moved
+    uint32_t dead_mean_us;
+    uint32_t dead_min_us;
+    uint32_t dead_max_us;
+    uint32_t rise_mean_us;
+    uint32_t slew_us_per_s;         // Command µs per second over the 10-90% segment
+    uint16_t overshoot_permille;    // Largest
+
+    // Command change needed to reverse direction, 0 = not found
+    uint8_t deadband_up_us;
+    uint8_t deadband_down_us;
+    uint8_t deadband_us;            // Average of the two sides
+};
+
+// Start a measurement (ignored while one is running)
+void servo_test_start(const ServoTestConfig& config);
+
+// Stop a running measurement (servo returns to center)
+void servo_test_abort();
+
+ServoTestState servo_test_state();
+ServoTestError servo_test_error();
+
+// 0 .. 100
+uint8_t servo_test_progress();
+
+// Copy of the last result (valid in SERVO_TEST_DONE)
+bool servo_test_result(ServoTestResult& out);
+
+// Print the last result as CSV to the serial log
+void servo_test_export();
+
+// Run the measurement (IO task loop, never blocks)
+void servo_test_service();
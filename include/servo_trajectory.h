@@ -0,0 +1,168 @@
+// include/servo_trajectory.h - Servo sweep profiles (integer-only)
+// Evaluated once per PWM frame by the servo driver: from the LEDC timer overflow
+// interrupt on ESP32, from the RT task loop in the simulator. No floats, no
+// allocation, no platform code - safe in an ISR and compiled on the host.
+//
+// A sweep cycle is four legs:  RISE (min -> max), HOLD at max (dwell),
+//                              FALL (max -> min), HOLD at min (dwell)
+// The profile only shapes the RISE/FALL legs:
+//   LINEAR    constant speed up, jump back down (sawtooth)
+//   SINE      half-cosine per leg, so the whole cycle is a sine wave
+//   TRIANGLE  constant speed up and down
+//   STEP      hold for the travel time, then jump to the other end
+//   S_CURVE   smoothstep per leg (zero speed at both ends)
+
+#pragma once
+
+#include <stdint.h>
+
+enum ServoProfile : uint8_t {
+    SERVO_PROFILE_LINEAR = 0,
+    SERVO_PROFILE_SINE,
+    SERVO_PROFILE_TRIANGLE,
+    SERVO_PROFILE_STEP,
+    SERVO_PROFILE_S_CURVE,
+    SERVO_PROFILE_COUNT
+};
+
+struct ServoTrajectory {
+    ServoProfile profile;
+    uint16_t min_us;
+    uint16_t max_us;
+    uint16_t dwell_ms;          // Hold time at each end
+    uint32_t speed_us_per_s;    // Average travel speed between min and max
+};
+
+enum ServoTrajLeg : uint8_t {
+    TRAJ_LEG_RISE = 0,
+    TRAJ_LEG_HOLD_HIGH,
+    TRAJ_LEG_FALL,
+    TRAJ_LEG_HOLD_LOW,
+};
+
+// Progress through a RISE/FALL leg is Q24: fine enough for slow sweeps at 400 Hz
+constexpr uint32_t TRAJ_PHASE_ONE = 1u << 24;
+constexpr uint32_t TRAJ_FRAC_ONE = 1u << 16;   // Shape output (Q16)
+
+struct ServoTrajState {
+    uint32_t phase;         // Progress through the current leg (Q24)
+    uint32_t phase_step;    // Phase increment per PWM frame
+    uint32_t hold_us;       // Time left in the current dwell
+    uint8_t leg;            // ServoTrajLeg
+};
+
+// Half-cosine (1 - cos(pi x)) / 2 at x = i/64, Q16
+static const uint16_t TRAJ_SINE_LUT[65] = {
+    0, 39, 158, 355, 630, 982, 1411, 1915,
+    2494, 3146, 3869, 4662, 5522, 6448, 7438, 8489,
+    9598, 10762, 11980, 13248, 14563, 15922, 17321, 18758,
+    20228, 21729, 23256, 24806, 26375, 27960, 29556, 31160,
+    32768, 34376, 35980, 37576, 39161, 40730, 42280, 43807,
+    45308, 46778, 48215, 49614, 50973, 52288, 53556, 54774,
+    55938, 57047, 58098, 59088, 60014, 60874, 61667, 62390,
+    63042, 63621, 64125, 64554, 64906, 65181, 65378, 65497,
+    65535,
+};
+
+// Fraction of the leg travelled (Q16) after phase (Q24) of its duration
+inline uint32_t traj_shape(ServoProfile profile, uint32_t phase) {
+    if (phase >= TRAJ_PHASE_ONE) return TRAJ_FRAC_ONE;
+
+    switch (profile) {
+        case SERVO_PROFILE_SINE: {
+            uint32_t idx = phase >> 18;                 // 64 segments
+            uint32_t frac = (phase >> 2) & 0xFFFF;      // Position inside the segment
+            uint32_t a = TRAJ_SINE_LUT[idx];
+            uint32_t b = TRAJ_SINE_LUT[idx + 1];
+            return a + (((b - a) * frac) >> 16);
+        }
+        case SERVO_PROFILE_S_CURVE: {
+            // 3x^2 - 2x^3
+            uint64_t x = phase >> 8;
+            return static_cast<uint32_t>((x * x * (3 * TRAJ_FRAC_ONE - 2 * x)) >> 32);
+        }
+        case SERVO_PROFILE_STEP:
+            return 0;
+        case SERVO_PROFILE_LINEAR:
+        case SERVO_PROFILE_TRIANGLE:
+        default:
+            return phase >> 8;
+    }
+}
+
+// Phase increment per frame so a leg takes (max - min) / speed seconds
+inline uint32_t traj_phase_step(const ServoTrajectory& traj, uint16_t frame_hz) {
+    uint32_t span_us = traj.max_us - traj.min_us;
+    if (span_us == 0 || frame_hz == 0) return TRAJ_PHASE_ONE;
+
+    uint64_t step = (static_cast<uint64_t>(traj.speed_us_per_s) << 24) / (static_cast<uint64_t>(span_us) * frame_hz);
+    if (step < 1) step = 1;
+    if (step > TRAJ_PHASE_ONE) step = TRAJ_PHASE_ONE;
+    return static_cast<uint32_t>(step);
+}
+
+// Pulse width for the current state
+inline uint32_t traj_position_ns(const ServoTrajectory& traj, const ServoTrajState& st) {
+    const uint32_t min_ns = traj.min_us * 1000u;
+    const uint64_t span_ns = (traj.max_us - traj.min_us) * 1000u;
+
+    switch (st.leg) {
+        case TRAJ_LEG_RISE:
+            return min_ns + static_cast<uint32_t>((span_ns * traj_shape(traj.profile, st.phase)) >> 16);
+        case TRAJ_LEG_FALL:
+            return min_ns + static_cast<uint32_t>(span_ns - ((span_ns * traj_shape(traj.profile, st.phase)) >> 16));
+        case TRAJ_LEG_HOLD_HIGH:
+            return traj.max_us * 1000u;
+        case TRAJ_LEG_HOLD_LOW:
+        default:
+            return min_ns;
+    }
+}
+
+inline void traj_enter_leg(const ServoTrajectory& traj, ServoTrajState& st, uint8_t leg) {
+    // Sawtooth: no travel back down, the hold at min follows directly
+    if (leg == TRAJ_LEG_FALL && traj.profile == SERVO_PROFILE_LINEAR) leg = TRAJ_LEG_HOLD_LOW;
+    st.leg = leg;
+    st.phase = 0;
+    st.hold_us = traj.dwell_ms * 1000u;
+}
+
+// Advance by one PWM frame of frame_us and return the new pulse width
+inline uint32_t traj_advance(const ServoTrajectory& traj, ServoTrajState& st, uint32_t frame_us) {
+    switch (st.leg) {
+        case TRAJ_LEG_RISE:
+        case TRAJ_LEG_FALL:
+            st.phase += st.phase_step;
+            if (st.phase >= TRAJ_PHASE_ONE) {
+                // Land exactly on the end point, dwell starts with the next frame
+                traj_enter_leg(traj, st, st.leg + 1);
+            }
+            break;
+        default:
+            if (st.hold_us > frame_us) {
+                st.hold_us -= frame_us;
+            } else {
+                traj_enter_leg(traj, st, (st.leg + 1) & 3);
+            }
+            break;
+    }
+    return traj_position_ns(traj, st);
+}
+
+// Start on the RISE leg at the phase closest to pulse_ns, so a running
+// servo joins the sweep without a jump
+inline void traj_begin(const ServoTrajectory& traj, ServoTrajState& st, uint32_t pulse_ns, uint16_t frame_hz) {
+    traj_enter_leg(traj, st, TRAJ_LEG_RISE);
+    st.phase_step = traj_phase_step(traj, frame_hz);
+    if (traj.profile == SERVO_PROFILE_STEP) return;
+
+    // Shapes are monotonic: binary search the phase
+    uint32_t lo = 0, hi = TRAJ_PHASE_ONE;
+    while (lo < hi) {
+        st.phase = lo + (hi - lo) / 2;
+        if (traj_position_ns(traj, st) < pulse_ns) lo = st.phase + 1;
+        else hi = st.phase;
+    }
+    st.phase = lo;
+    if (st.phase >= TRAJ_PHASE_ONE) traj_enter_leg(traj, st, TRAJ_LEG_HOLD_HIGH);
+}
@@ -0,0 +1,165 @@
+// include/step_response.h - Step response analysis of a sampled servo feedback signal
+// Platform-agnostic, integer only: runs on the IO task and on the host against
+// recorded captures.
+//
+// Input is one equidistant record of a feedback channel (servo potentiometer or
+// supply current shunt) that starts before the command step:
+//
+//   |<- pre: baseline ->|<- dead ->|<- rise 10..90% ->|<- settle, final ->|
+//                       step
+//
+//   baseline   mean of the samples before the step, noise = their largest deviation
+//   final      mean of the last 1/8 of the record
+//   dead time  step -> signal leaves the baseline noise band
+//   rise time  10% -> 90% of the travel
+//   overshoot  peak beyond final (minus noise), per mille of the travel
+//
+// Crossings are interpolated between samples, so the time resolution is finer
+// than the sample period.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct StepResponse {
+    bool moved;                 // Travel clearly above the noise band
+    uint32_t dead_time_us;
+    uint32_t rise_us;           // 10% -> 90%
+    uint16_t overshoot_permille;
+    int32_t travel;             // final - baseline in ADC counts
+    uint16_t noise;             // Largest baseline deviation in counts
+};
+
+namespace step_detail {
+
+struct Baseline {
+    int32_t mean;
+    int32_t mean_x16;       // 1/16 count resolution for small shifts
+    uint32_t noise;         // Largest deviation from mean
+    uint32_t var_x16;       // Variance * 16
+};
+
+inline Baseline baseline(const uint16_t* s, size_t n) {
+    Baseline b = {};
+    if (!n) return b;
+    int64_t sum = 0;
+    for (size_t i = 0; i < n; i++) sum += s[i];
+    b.mean_x16 = static_cast<int32_t>(sum * 16 / static_cast<int64_t>(n));
+    b.mean = (b.mean_x16 + 8) / 16;
+    int64_t sq = 0;
+    for (size_t i = 0; i < n; i++) {
+        int32_t d16 = s[i] * 16 - b.mean_x16;
+        uint32_t dev = static_cast<uint32_t>((d16 < 0 ? -d16 : d16) + 15) / 16;
+        if (dev > b.noise) b.noise = dev;
+        sq += static_cast<int64_t>(d16) * d16;
+    }
+    b.var_x16 = static_cast<uint32_t>(sq / static_cast<int64_t>(n) / 16);
+    return b;
+}
+
+inline uint32_t isqrt(uint32_t v) {
+    uint32_t r = 0;
+    for (uint32_t bit = 1u << 30; bit; bit >>= 2) {
+        if (v >= r + bit) {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+    }
+    return r;
+}
+
+// Time (ns from sample 0) where y first reaches level at or after index from
+// y = (s - base) * dir, linear interpolation between neighbouring samples
+inline bool crossing_ns(const uint16_t* s, size_t n, size_t from, int32_t base, int32_t dir,
+                        int32_t level, uint32_t period_ns, uint64_t& out_ns) {
+    for (size_t i = from; i < n; i++) {
+        int32_t y = (s[i] - base) * dir;
+        if (y < level) continue;
+        if (i == 0 || i == from) {
+            out_ns = static_cast<uint64_t>(i) * period_ns;
+            return true;
+        }
+        int32_t y0 = (s[i - 1] - base) * dir;
+        uint64_t frac = (y > y0) ? static_cast<uint64_t>(level - y0) * period_ns / (y - y0) : 0;
+        out_ns = static_cast<uint64_t>(i - 1) * period_ns + frac;
+        return true;
+    }
+    return false;
+}
+
+}  // namespace step_detail
+
+/**
+ * Analyze one step record
+ * @param s Samples, s[0] taken at t = 0
+ * @param n Number of samples
+ * @param period_ns Sample period
+ * @param step_us Time of the command step relative to s[0]
+ */
+inline StepResponse step_analyze(const uint16_t* s, size_t n, uint32_t period_ns, uint32_t step_us) {
+    using namespace step_detail;
+    StepResponse r = {};
+    if (!period_ns) return r;
+
+    size_t pre = static_cast<size_t>(static_cast<uint64_t>(step_us) * 1000 / period_ns);
+    size_t tail = n / 8;
+    if (pre < 8 || pre + tail >= n || tail < 8) return r;
+
+    Baseline b = baseline(s, pre);
+    Baseline f = baseline(s + n - tail, tail);
+    r.noise = static_cast<uint16_t>(b.noise);
+    r.travel = f.mean - b.mean;
+
+    const int32_t band = 2 * static_cast<int32_t>(b.noise) + 2;
+    const int32_t dir = (r.travel < 0) ? -1 : 1;
+    const int32_t amp = r.travel * dir;
+    if (amp <= band) return r;
+    r.moved = true;
+
+    const uint64_t step_ns = static_cast<uint64_t>(step_us) * 1000;
+    uint64_t t_dead, t10, t90;
+    if (crossing_ns(s, n, pre, b.mean, dir, band, period_ns, t_dead)) {
+        r.dead_time_us = (t_dead > step_ns) ? static_cast<uint32_t>((t_dead - step_ns) / 1000) : 0;
+    }
+    if (crossing_ns(s, n, pre, b.mean, dir, amp / 10, period_ns, t10) &&
+        crossing_ns(s, n, pre, b.mean, dir, amp - amp / 10, period_ns, t90) && t90 > t10) {
+        r.rise_us = static_cast<uint32_t>((t90 - t10) / 1000);
+    }
+
+    int32_t peak = 0;
+    for (size_t i = pre; i < n; i++) {
+        int32_t y = (s[i] - b.mean) * dir;
+        if (y > peak) peak = y;
+    }
+    int32_t over = peak - amp - static_cast<int32_t>(b.noise);
+    if (over > 0) r.overshoot_permille = static_cast<uint16_t>(static_cast<int64_t>(over) * 1000 / amp);
+    return r;
+}
+
+/**
+ * Did the output shift at all after the step? For deadband probing, where a
+ * servo moves by a fraction of the noise: compares the baseline mean with the
+ * mean of the last 1/4 of the record against the standard error of the means.
+ */
+inline bool step_shifted(const uint16_t* s, size_t n, uint32_t period_ns, uint32_t step_us) {
+    using namespace step_detail;
+    if (!period_ns) return false;
+    size_t pre = static_cast<size_t>(static_cast<uint64_t>(step_us) * 1000 / period_ns);
+    size_t tail = n / 4;
+    if (pre < 8 || pre + tail >= n) return false;
+
+    Baseline b = baseline(s, pre);
+    Baseline f = baseline(s + n - tail, tail);
+    int32_t shift_x16 = f.mean_x16 - b.mean_x16;
+    if (shift_x16 < 0) shift_x16 = -shift_x16;
+
+    // 4 standard errors, at least one count
+    size_t m = pre < tail ? pre : tail;
+    uint32_t sd_x16 = 4 * isqrt(b.var_x16);
+    uint32_t limit_x16 = 4 * sd_x16 / isqrt(static_cast<uint32_t>(m));
+    if (limit_x16 < 16) limit_x16 = 16;
+    return static_cast<uint32_t>(shift_x16) > limit_x16;
+}
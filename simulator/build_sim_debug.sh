@@ -29,7 +29,7 @@ done
 
 # Build the simulator with debug symbols
 clang++ $DEBUG_FLAGS simulator/main.cpp simulator/sim_state.cpp simulator/input_sim.cpp \
-    gui/*.cpp gui/config/*.cpp gui/pages/*.cpp src/servo_driver.cpp \
+    gui/*.cpp gui/config/*.cpp gui/pages/*.cpp src/servo_driver.cpp src/servo_capture.cpp src/adc_dma.cpp src/servo_test.cpp src/lipo_monitor.cpp src/hx711.cpp src/imu.cpp src/i2c_bus.cpp \
     "${FONT_OBJS[@]}" "${IMAGE_OBJS[@]}" \
     $INCLUDES \
     -std=c++17 \
@@ -7,6 +7,17 @@
 #include "gui/gui.h"
 #include "gui/gui_data.h"
 #include "gui/input.h"
+#include "gui/display_flush.h"
+#include "gui/app_tasks.h"
+#include "gui/config/settings.h"
+#include "gui/serial_log.h"
+#include "servo_driver.h"
+#include "servo_capture.h"
+#include "servo_test.h"
+#include "lipo_monitor.h"
+#include "hx711.h"
+#include "imu.h"
+#include "i2c_bus.h"
 
 // Forward declaration for input_sim.cpp
 void input_handle_sdl_event(const SDL_Event& e);
@@ -14,10 +25,19 @@ void input_handle_sdl_event(const SDL_Event& e);
 constexpr int HRES = 320;
 constexpr int VRES = 240;
 
+// Upper bound for the main loop sleep (LV_NO_TIMER_READY when no timer is armed)
+constexpr uint32_t LOOP_MAX_IDLE_MS = 50;
+
 static SDL_Texture*  tex  = nullptr;
 static SDL_Renderer* ren  = nullptr;
 
-static void flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* data) {
+// Fake display transport - mimics the DMA handshake of the ESP32 build:
+// start() only queues the transfer, completion is reported when LVGL polls is_done()
+// (i.e. when it needs the buffer back), exactly like a DMA transfer still in flight.
+static bool sim_transfer_pending = false;
+
+static void sim_transport_start(lv_display_t* disp, const lv_area_t* area, uint8_t* data, uint32_t px_count) {
+    (void)px_count;
     const int w = lv_area_get_width(area);
     const int h = lv_area_get_height(area);
     SDL_Rect r{area->x1, area->y1, w, h};
@@ -35,7 +55,29 @@ static void flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* data) {
         SDL_RenderCopy(ren, tex, nullptr, nullptr);
         SDL_RenderPresent(ren);
     }
-    lv_display_flush_ready(disp);
+    sim_transfer_pending = true;
+}
+
+static bool sim_transport_is_done() {
+    // "Transfer" completes on the first poll after start
+    bool done = sim_transfer_pending;
+    sim_transfer_pending = false;
+    return done;
+}
+
+static const DisplayTransport SIM_TRANSPORT = { sim_transport_start, sim_transport_is_done, nullptr };
+
+// IO task stand-in: no NFC reader, only the signal analyzer capture service
+constexpr uint32_t SIM_IO_SLICE_MS = 50;
+
+static void sim_io_task_main(void* arg) {
+    (void)arg;
+    for (;;) {
+        capture_service();
+        servo_test_service();
+        lipo_monitor_service();
+        app_task_delay_ms(SIM_IO_SLICE_MS);
+    }
 }
 
 extern "C" void gui_sim_init();   // defined in sim_state.cpp
@@ -46,6 +88,9 @@ int main(int argc, char** argv) {
 
     lv_init();
     SDL_Init(SDL_INIT_VIDEO);
+
+    // LVGL clock comes from SDL's millisecond counter (same model as millis() on ESP32)
+    lv_tick_set_cb(SDL_GetTicks);
     SDL_Window *win = SDL_CreateWindow("LVGL Simulator", 1000, 800, w, h,
         SDL_WINDOW_ALWAYS_ON_TOP | SDL_WINDOW_ALLOW_HIGHDPI);
     ren = SDL_CreateRenderer(win, -1, SDL_RENDERER_ACCELERATED);
@@ -67,7 +112,7 @@ int main(int argc, char** argv) {
         return 1;
     }
     lv_display_set_draw_buffers(disp, &draw_buf, nullptr);
-    lv_display_set_flush_cb(disp, flush_cb);
+    display_flush_init(disp, &SIM_TRANSPORT);
     // PARTIAL mode: only invalidated (dirty) areas are redrawn - much more efficient!
     lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_PARTIAL);
 
@@ -83,20 +128,36 @@ int main(int argc, char** argv) {
     // Initialize encoder input system (creates LVGL encoder indev)
     input_init();
 
+    // Same task layout as the ESP32 build: the servo RT and IO tasks run on their own
+    // threads; the RT task receives commands through the real message queue (see gui/app_tasks.h)
+    app_tasks_init();
+    app_task_create("log", serial_log_task_main, nullptr, LOG_TASK_STACK, LOG_TASK_PRIORITY, LOG_TASK_CORE);
+    app_task_create("servo_rt", servo_task_main, nullptr, RT_TASK_STACK, RT_TASK_PRIORITY, RT_TASK_CORE);
+    app_task_create("i2c", i2c_bus_task_main, nullptr, I2C_TASK_STACK, I2C_TASK_PRIORITY, I2C_TASK_CORE);
+    app_task_create("scale", hx711_task_main, nullptr, SCALE_TASK_STACK, SCALE_TASK_PRIORITY, SCALE_TASK_CORE);
+    app_task_create("imu", imu_task_main, nullptr, IMU_TASK_STACK, IMU_TASK_PRIORITY, IMU_TASK_CORE);
+    app_task_create("store", settings_task_main, nullptr, STORE_TASK_STACK, STORE_TASK_PRIORITY, STORE_TASK_CORE);
+    app_task_create("io", sim_io_task_main, nullptr, IO_TASK_STACK, IO_TASK_PRIORITY, IO_TASK_CORE);
+
     gui_sim_init();   // ← starts your real GUI
 
-    Uint32 last = SDL_GetTicks();
     while (true) {
-        Uint32 now = SDL_GetTicks();
-        lv_tick_inc(now - last);
-        last = now;
-        lv_timer_handler();
+        // Run due LVGL timers, then sleep until the next one is due or an SDL event arrives
+        uint32_t idle_ms;
+        {
+            LvglLock lock;
+            idle_ms = lv_timer_handler();
+        }
+        if (idle_ms > LOOP_MAX_IDLE_MS) idle_ms = LOOP_MAX_IDLE_MS;
+
         SDL_Event e;
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) return 0;
-            // Handle keyboard input → feeds encoder events
-            input_handle_sdl_event(e);
+        if (SDL_WaitEventTimeout(&e, static_cast<int>(idle_ms))) {
+            do {
+                if (e.type == SDL_QUIT) return 0;
+                // Handle keyboard input → feeds encoder events
+                LvglLock lock;
+                input_handle_sdl_event(e);
+            } while (SDL_PollEvent(&e));
         }
-        SDL_Delay(5);
     }
 }
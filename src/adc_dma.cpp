@@ -0,0 +1,216 @@
+// src/adc_dma.cpp - Continuous ADC sampling (ADC1 digital controller + DMA)
+
+#include "adc_dma.h"
+#include "gui/app_tasks.h"
+#include "gui/serial_log.h"
+
+static bool running = false;
+static uint32_t start_us = 0;
+static uint32_t rate_hz = 0;
+static uint32_t next_seq = 0;           // Stream number of the next sample handed out
+static volatile uint32_t overruns = 0;
+
+static uint32_t clamp_rate(uint32_t hz) {
+    if (hz < ADC_DMA_RATE_MIN_HZ) return ADC_DMA_RATE_MIN_HZ;
+    if (hz > ADC_DMA_RATE_MAX_HZ) return ADC_DMA_RATE_MAX_HZ;
+    return hz;
+}
+
+// =============================================================================
+// Hardware Layer
+// =============================================================================
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+
+#include <driver/adc.h>
+#include <esp_adc_cal.h>
+
+// DMA interrupt every 64 conversions; the ring holds ~100 ms at 20 kHz so the
+// IO task can sit in a 50 ms wait without losing samples
+static constexpr uint32_t ADC_DMA_FRAME_BYTES = 64 * SOC_ADC_DIGI_RESULT_BYTES;
+static constexpr uint32_t ADC_DMA_RING_BYTES = 2048 * SOC_ADC_DIGI_RESULT_BYTES;
+
+// Reference used by esp_adc_cal when the eFuse holds no calibration
+static constexpr uint32_t ADC_DMA_DEFAULT_VREF_MV = 1100;
+
+static uint8_t read_buf[ADC_DMA_FRAME_BYTES];
+static int8_t channel_input[SOC_ADC_CHANNEL_NUM(0)];   // ADC1 channel -> PIN_ADC[] index
+
+// ESP32-S3: GPIO1 .. GPIO10 are ADC1 channels 0 .. 9
+static uint8_t adc1_channel_for_pin(int pin) {
+    return static_cast<uint8_t>(pin - 1);
+}
+
+bool adc_dma_start(uint8_t input_mask, uint32_t hz) {
+    if (running) return false;
+    input_mask &= (1 << NUM_ADC_PINS) - 1;
+    if (!input_mask) return false;
+
+    adc_digi_pattern_config_t pattern[NUM_ADC_PINS] = {};
+    uint32_t pattern_num = 0;
+    uint32_t chan_mask = 0;
+    for (auto& ci : channel_input) ci = -1;
+
+    for (uint8_t i = 0; i < NUM_ADC_PINS; i++) {
+        if (!(input_mask & (1 << i))) continue;
+        uint8_t ch = adc1_channel_for_pin(PIN_ADC[i]);
+        pattern[pattern_num].atten = ADC_ATTEN_DB_11;
+        pattern[pattern_num].channel = ch;
+        pattern[pattern_num].unit = 0;      // ADC1
+        pattern[pattern_num].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+        pattern_num++;
+        chan_mask |= 1u << ch;
+        channel_input[ch] = static_cast<int8_t>(i);
+    }
+
+    adc_digi_init_config_t init = {};
+    init.max_store_buf_size = ADC_DMA_RING_BYTES;
+    init.conv_num_each_intr = ADC_DMA_FRAME_BYTES;
+    init.adc1_chan_mask = chan_mask;
+    init.adc2_chan_mask = 0;
+    if (adc_digi_initialize(&init) != ESP_OK) {
+        LOG_E("ADC", "DMA init failed");
+        return false;
+    }
+
+    rate_hz = clamp_rate(hz);
+    adc_digi_configuration_t conf = {};
+    conf.conv_limit_en = false;
+    conf.conv_limit_num = 250;
+    conf.pattern_num = pattern_num;
+    conf.adc_pattern = pattern;
+    conf.sample_freq_hz = rate_hz;
+    conf.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    conf.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+    if (adc_digi_controller_configure(&conf) != ESP_OK) {
+        LOG_E("ADC", "DMA config failed (%lu Hz)", (unsigned long)rate_hz);
+        adc_digi_deinitialize();
+        return false;
+    }
+
+    next_seq = 0;
+    start_us = app_time_us();
+    adc_digi_start();
+    running = true;
+    return true;
+}
+
+void adc_dma_stop() {
+    if (!running) return;
+    adc_digi_stop();
+    adc_digi_deinitialize();
+    running = false;
+}
+
+size_t adc_dma_read(AdcSample* out, size_t max, uint32_t* first_seq) {
+    if (first_seq) *first_seq = next_seq;
+    if (!running) return 0;
+
+    size_t n = 0;
+    while (n < max) {
+        uint32_t want = (max - n) * SOC_ADC_DIGI_RESULT_BYTES;
+        if (want > sizeof(read_buf)) want = sizeof(read_buf);
+
+        uint32_t got = 0;
+        esp_err_t err = adc_digi_read_bytes(read_buf, want, &got, 0);
+        if (err == ESP_ERR_INVALID_STATE) overruns++;   // Data still returned
+        else if (err != ESP_OK) break;
+        if (got == 0) break;
+
+        for (uint32_t off = 0; off + SOC_ADC_DIGI_RESULT_BYTES <= got; off += SOC_ADC_DIGI_RESULT_BYTES) {
+            const adc_digi_output_data_t* r = reinterpret_cast<const adc_digi_output_data_t*>(&read_buf[off]);
+            if (r->type2.unit != 0 || r->type2.channel >= SOC_ADC_CHANNEL_NUM(0)) continue;
+            int8_t input = channel_input[r->type2.channel];
+            if (input < 0) continue;
+            out[n].input = static_cast<uint8_t>(input);
+            out[n].raw = r->type2.data;
+            n++;
+        }
+    }
+    next_seq += n;
+    return n;
+}
+
+bool adc_dma_calibration(AdcCalTable& out) {
+    esp_adc_cal_characteristics_t chars;
+    esp_adc_cal_value_t type = esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12,
+                                                        ADC_DMA_DEFAULT_VREF_MV, &chars);
+    for (uint8_t i = 0; i < AdcCalTable::POINTS; i++) {
+        out.mv[i] = static_cast<uint16_t>(esp_adc_cal_raw_to_voltage(i << AdcCalTable::SEGMENT_LOG2, &chars));
+    }
+    return type != ESP_ADC_CAL_VAL_DEFAULT_VREF;
+}
+
+void adc_dma_set_sim_source(adc_sim_source_t source) {
+    (void)source;
+}
+
+#else
+// Simulator: samples are computed when read, at the times the controller would
+// have taken them
+
+static adc_sim_source_t sim_source = nullptr;
+static uint8_t sim_inputs[NUM_ADC_PINS];
+static uint8_t sim_input_count = 0;
+
+bool adc_dma_start(uint8_t input_mask, uint32_t hz) {
+    if (running) return false;
+    sim_input_count = 0;
+    for (uint8_t i = 0; i < NUM_ADC_PINS; i++) {
+        if (input_mask & (1 << i)) sim_inputs[sim_input_count++] = i;
+    }
+    if (!sim_input_count) return false;
+
+    rate_hz = clamp_rate(hz);
+    next_seq = 0;
+    start_us = app_time_us();
+    running = true;
+    return true;
+}
+
+void adc_dma_stop() {
+    running = false;
+}
+
+size_t adc_dma_read(AdcSample* out, size_t max, uint32_t* first_seq) {
+    if (first_seq) *first_seq = next_seq;
+    if (!running) return 0;
+
+    uint64_t due = static_cast<uint64_t>(app_time_us() - start_us) * rate_hz / 1000000;
+    size_t n = 0;
+    while (n < max && next_seq < due) {
+        uint8_t input = sim_inputs[next_seq % sim_input_count];
+        uint32_t t = start_us + static_cast<uint32_t>(static_cast<uint64_t>(next_seq) * 1000000 / rate_hz);
+        out[n].input = input;
+        out[n].raw = sim_source ? sim_source(input, t) : 0;
+        n++;
+        next_seq++;
+    }
+    return n;
+}
+
+bool adc_dma_calibration(AdcCalTable& out) {
+    out = AdcCalTable::linear(ADC_DMA_SIM_FULL_SCALE_MV);
+    return true;
+}
+
+void adc_dma_set_sim_source(adc_sim_source_t source) {
+    sim_source = source;
+}
+
+#endif
+
+bool adc_dma_running() {
+    return running;
+}
+
+uint32_t adc_dma_start_time_us() {
+    return start_us;
+}
+
+uint32_t adc_dma_rate_hz() {
+    return rate_hz;
+}
+
+uint32_t adc_dma_overruns() {
+    return overruns;
+}
@@ -0,0 +1,318 @@
+// src/hx711.cpp - HX711 load cells, read in lock-step by the scale task
+//
+// Data path:  DOUT-ready edge (ISR) -> scale task wakes -> all DOUTs low?
+//             -> 25 clock shift with interrupts off -> LoadCellFilter per cell
+//             -> reading queue -> GUI
+//
+// Modules that never pull DOUT low (not plugged in) are left out of the
+// lock-step; a module that stops answering triggers a rescan.
+
+#include "hx711.h"
+#include "spsc_queue.h"
+#include "gui/app_tasks.h"
+#include "gui/serial_log.h"
+#include <atomic>
+
+static constexpr uint8_t ALL_CELLS = (1 << NUM_LOAD_CELLS) - 1;
+static constexpr uint32_t SAMPLE_PERIOD_US = 1000000 / HX711_RATE_SPS;
+static constexpr uint32_t READY_TIMEOUT_MS = 3 * 1000 / HX711_RATE_SPS + 1;    // 3 conversions
+static constexpr uint32_t IDLE_WAIT_MS = 100;
+static constexpr uint32_t RESCAN_MS = 500;
+static constexpr uint8_t DATA_BITS = 24;
+static constexpr uint8_t GAIN_PULSES = 1;       // 25th pulse: channel A, gain 128
+static constexpr size_t READING_QUEUE_LEN = 4;
+
+static SpscQueue<ScaleReading, READING_QUEUE_LEN> readings;  // Scale task -> GUI
+static std::atomic<bool> requested{false};                    // GUI -> scale task
+static std::atomic<bool> reset_requested{false};
+static std::atomic<uint32_t> read_count{0};
+static std::atomic<uint32_t> timeout_count{0};
+
+// Scale task state
+static Hx711Filter filters[NUM_LOAD_CELLS];
+static bool active = false;
+static uint8_t present = 0;             // Modules in the lock-step
+static uint8_t settle = 0;              // Samples still to drop
+static uint32_t samples = 0;
+static uint32_t last_publish_us = 0;
+
+// =============================================================================
+// Hardware Layer
+// =============================================================================
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+
+#include <Arduino.h>
+#include <driver/gpio.h>
+
+static TaskHandle_t scale_task = nullptr;
+static portMUX_TYPE shift_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void IRAM_ATTR dout_isr() {
+    if (!scale_task) return;
+    BaseType_t higher_prio_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(scale_task, &higher_prio_woken);
+    if (higher_prio_woken) portYIELD_FROM_ISR();
+}
+
+static void hw_init() {
+    // SCK high = powered down until a page starts the scale
+    pinMode(PIN_HX711_SCK, OUTPUT);
+    digitalWrite(PIN_HX711_SCK, HIGH);
+    for (int i = 0; i < NUM_LOAD_CELLS; i++) {
+        pinMode(PIN_HX711_DOUT[i], INPUT_PULLUP);   // Unplugged module reads "busy"
+    }
+    scale_task = xTaskGetCurrentTaskHandle();
+}
+
+static void hw_power(bool on) {
+    if (on) {
+        digitalWrite(PIN_HX711_SCK, LOW);           // Wake up, conversions restart
+        for (int i = 0; i < NUM_LOAD_CELLS; i++) {
+            attachInterrupt(digitalPinToInterrupt(PIN_HX711_DOUT[i]), dout_isr, FALLING);
+        }
+    } else {
+        for (int i = 0; i < NUM_LOAD_CELLS; i++) {
+            detachInterrupt(digitalPinToInterrupt(PIN_HX711_DOUT[i]));
+        }
+        digitalWrite(PIN_HX711_SCK, HIGH);          // > 60 µs high: power down
+    }
+}
+
+// Bit N set: module N has a conversion ready (DOUT low)
+static uint8_t hw_ready_mask() {
+    uint8_t mask = 0;
+    for (int i = 0; i < NUM_LOAD_CELLS; i++) {
+        if (!gpio_get_level(static_cast<gpio_num_t>(PIN_HX711_DOUT[i]))) mask |= 1 << i;
+    }
+    return mask;
+}
+
+// Sleep until a DOUT-ready edge, a start/stop request or the timeout
+static void hw_wait(uint32_t ms) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms));
+}
+
+static void hw_wake() {
+    if (scale_task) xTaskNotifyGive(scale_task);
+}
+
+// Shift every module out with the same clock pulses
+static void hw_shift(int32_t* raw) {
+    const gpio_num_t sck = static_cast<gpio_num_t>(PIN_HX711_SCK);
+    uint32_t bits[NUM_LOAD_CELLS] = {};
+
+    portENTER_CRITICAL(&shift_lock);
+    for (uint8_t b = 0; b < DATA_BITS + GAIN_PULSES; b++) {
+        gpio_set_level(sck, 1);
+        delayMicroseconds(1);                       // DOUT valid 0.1 µs after the rising edge
+        if (b < DATA_BITS) {
+            for (int i = 0; i < NUM_LOAD_CELLS; i++) {
+                bits[i] = (bits[i] << 1) | gpio_get_level(static_cast<gpio_num_t>(PIN_HX711_DOUT[i]));
+            }
+        }
+        gpio_set_level(sck, 0);
+        delayMicroseconds(1);
+    }
+    portEXIT_CRITICAL(&shift_lock);
+
+    // The data bits on DOUT fired the ready interrupt: not a new conversion
+    ulTaskNotifyTake(pdTRUE, 0);
+
+    for (int i = 0; i < NUM_LOAD_CELLS; i++) {
+        raw[i] = static_cast<int32_t>(bits[i] << 8) >> 8;  // 24 bit two's complement
+    }
+}
+
+#else
+
+// Simulator: model on three supports, uncalibrated cells with offsets,
+// noise and an occasional spike for the median to remove
+static const int32_t SIM_ZERO[NUM_LOAD_CELLS] = { 8200, -15300, 4100 };
+static const int32_t SIM_LOAD_MG[NUM_LOAD_CELLS] = { 1240000, 1180000, 460000 };
+static constexpr int32_t SIM_COUNTS_PER_KG = 420000;
+static constexpr int32_t SIM_NOISE_COUNTS = 300;    // +- per sample
+static constexpr uint32_t SIM_SPIKE_EVERY = 97;     // Samples
+static constexpr int32_t SIM_SPIKE_COUNTS = 60000;
+
+static uint32_t sim_next_us = 0;
+static uint32_t sim_noise = 24680;
+static uint32_t sim_count = 0;
+
+static void hw_init() {}
+
+static void hw_power(bool on) {
+    if (on) sim_next_us = app_time_us() + SAMPLE_PERIOD_US;
+}
+
+static uint8_t hw_ready_mask() {
+    return static_cast<int32_t>(app_time_us() - sim_next_us) >= 0 ? ALL_CELLS : 0;
+}
+
+static void hw_wait(uint32_t ms) {
+    int32_t until_us = static_cast<int32_t>(sim_next_us - app_time_us());
+    if (until_us > 0 && static_cast<uint32_t>(until_us) / 1000 + 1 < ms) ms = until_us / 1000 + 1;
+    app_task_delay_ms(ms);
+}
+
+static void hw_wake() {}
+
+static void hw_shift(int32_t* raw) {
+    sim_count++;
+    for (int i = 0; i < NUM_LOAD_CELLS; i++) {
+        sim_noise = sim_noise * 1103515245u + 12345u;
+        int32_t noise = static_cast<int32_t>((sim_noise >> 16) % (2 * SIM_NOISE_COUNTS + 1)) - SIM_NOISE_COUNTS;
+        raw[i] = SIM_ZERO[i] + static_cast<int32_t>(static_cast<int64_t>(SIM_LOAD_MG[i]) * SIM_COUNTS_PER_KG / 1000000) + noise;
+    }
+    if (sim_count % SIM_SPIKE_EVERY == 0) raw[sim_count % NUM_LOAD_CELLS] += SIM_SPIKE_COUNTS;
+
+    sim_next_us += SAMPLE_PERIOD_US;
+    if (static_cast<int32_t>(app_time_us() - sim_next_us) > 0) sim_next_us = app_time_us() + SAMPLE_PERIOD_US;
+}
+
+#endif
+
+// =============================================================================
+// Scale Task
+// =============================================================================
+
+// Modules that pull DOUT low within a few conversion periods
+static uint8_t scan() {
+    uint8_t seen = 0;
+    uint32_t start = app_time_us();
+    for (;;) {
+        seen |= hw_ready_mask();
+        uint32_t waited_ms = (app_time_us() - start) / 1000;
+        if (seen == ALL_CELLS || waited_ms >= READY_TIMEOUT_MS) return seen;
+        hw_wait(READY_TIMEOUT_MS - waited_ms);
+    }
+}
+
+static void update_present(uint8_t seen) {
+    if (seen == present) return;
+    for (int i = 0; i < NUM_LOAD_CELLS; i++) {
+        if ((present ^ seen) & (1 << i)) filters[i].reset();
+    }
+    present = seen;
+    if (present) LOG_I("HX711", "Load cells present: mask 0x%02X", present);
+    else LOG_W("HX711", "No HX711 answering - check wiring");
+}
+
+// Sleep until every module in the lock-step has a conversion ready
+static bool wait_ready() {
+    uint32_t start = app_time_us();
+    for (;;) {
+        if ((hw_ready_mask() & present) == present) return true;
+        uint32_t waited_ms = (app_time_us() - start) / 1000;
+        if (waited_ms >= READY_TIMEOUT_MS || requested.load() != active) return false;
+        hw_wait(READY_TIMEOUT_MS - waited_ms);
+    }
+}
+
+static void publish() {
+    bool any = false;
+    for (auto& f : filters) any |= f.valid();
+    if (!any) return;       // Nothing to show yet
+
+    ScaleReading r = {};
+    r.present_mask = present;
+    r.samples = samples;
+    for (int i = 0; i < NUM_LOAD_CELLS; i++) {
+        if (!filters[i].valid()) continue;
+        r.raw[i] = filters[i].value();
+        r.spread[i] = filters[i].spread();
+        if (filters[i].full()) r.full_mask |= 1 << i;
+    }
+    readings.push(r);   // GUI not draining: drop, the next reading replaces it
+}
+
+void hx711_task_main(void* arg) {
+    (void)arg;
+    hw_init();
+
+    for (;;) {
+        bool want = requested.load();
+        if (want != active) {
+            hw_power(want);
+            active = want;
+            if (active) {
+                for (auto& f : filters) f.reset();
+                present = 0;
+                samples = 0;
+                settle = HX711_SETTLE_SAMPLES;
+                last_publish_us = app_time_us();
+                update_present(scan());
+            }
+        }
+        if (!active) {
+            hw_wait(IDLE_WAIT_MS);
+            continue;
+        }
+
+        if (!present) {
+            hw_wait(RESCAN_MS);
+            update_present(scan());
+            continue;
+        }
+
+        if (!wait_ready()) {
+            if (requested.load() != active) continue;
+            timeout_count++;
+            update_present(scan());
+            continue;
+        }
+
+        int32_t raw[NUM_LOAD_CELLS];
+        hw_shift(raw);
+        read_count++;
+        if (settle) {
+            settle--;
+            continue;
+        }
+
+        if (reset_requested.exchange(false)) {
+            for (auto& f : filters) f.reset();
+        }
+        for (int i = 0; i < NUM_LOAD_CELLS; i++) {
+            if (present & (1 << i)) filters[i].push(raw[i]);
+        }
+        samples++;
+
+        uint32_t now = app_time_us();
+        if (now - last_publish_us >= HX711_PUBLISH_MS * 1000) {
+            last_publish_us = now;
+            publish();
+        }
+    }
+}
+
+// =============================================================================
+// Public API
+// =============================================================================
+
+void hx711_start() {
+    requested.store(true);
+    hw_wake();
+}
+
+void hx711_stop() {
+    requested.store(false);
+    hw_wake();
+}
+
+bool hx711_poll(ScaleReading& out) {
+    bool got = false;
+    while (readings.pop(out)) got = true;   // Latest only
+    return got;
+}
+
+void hx711_reset_filters() {
+    reset_requested.store(true);
+}
+
+uint32_t hx711_read_count() {
+    return read_count.load();
+}
+
+uint32_t hx711_timeout_count() {
+    return timeout_count.load();
+}
@@ -0,0 +1,332 @@
+// src/i2c_bus.cpp - I2C bus manager, transfers run on the bus task
+//
+// Data path:  driver task: i2c_bus_submit() -> request queue (per priority)
+//             + doorbell -> bus task: highest priority first, clock per device
+//             -> Wire -> status + NOTIFY_I2C_DONE -> i2c_bus_wait()
+//
+// Every request is one Wire transaction, so the bus is never held across a
+// device's processing time (PN532 commands are split at the ACK/response).
+
+#include "i2c_bus.h"
+#include "mpsc_queue.h"
+#include "msg_queue.h"
+#include "pins.h"
+#include "gui/app_tasks.h"
+#include "gui/serial_log.h"
+
+static constexpr size_t REQUEST_QUEUE_LEN = 16;     // Per priority
+static constexpr size_t BELL_QUEUE_LEN = 32;
+static constexpr uint32_t UTIL_WINDOW_MS = 1000;
+static constexpr uint8_t LATENCY_SHIFT = 4;         // Running average over ~16 transfers
+static constexpr uint32_t WAIT_SLICE_MS = 10;       // Re-check a waited-for status at least this often
+
+struct DeviceSlot {
+    const char* name;
+    uint8_t addr;
+    uint32_t clock_hz;
+    std::atomic<bool> used{false};
+    std::atomic<uint32_t> transfers{0};
+    std::atomic<uint32_t> errors{0};
+    std::atomic<uint32_t> bytes{0};
+    std::atomic<uint32_t> latency_avg_us{0};
+    std::atomic<uint32_t> latency_max_us{0};
+};
+
+static DeviceSlot devices[I2C_MAX_DEVICES];
+static std::atomic<uint8_t> device_count{0};
+static MpscQueue<I2cTransfer*, REQUEST_QUEUE_LEN> requests[I2C_PRIO_COUNT];  // Any task -> bus task
+static MsgQueue<uint8_t, BELL_QUEUE_LEN> bell;                               // Doorbell: wakes the bus task
+static std::atomic<uint16_t> utilization{0};
+
+// Bus task state
+static uint32_t current_clock = 0;
+static uint32_t busy_us = 0;            // In the current utilization window
+
+// =============================================================================
+// Hardware Layer
+// =============================================================================
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// 1 = swap SDA/SCL (HW-147C PN532 breakout with swapped labels, see platformio.ini)
+#ifndef PN532_SWAP_I2C
+#define PN532_SWAP_I2C 0
+#endif
+
+// ============================================================================
+// Debug Flags - Set to 1 to enable specific debug features
+// ============================================================================
+#define I2C_DEBUG 1     // Enable I2C bus scanner at startup
+
+#if I2C_DEBUG
+// Scan all addresses to find connected devices
+static void scan(int sda_pin, int scl_pin) {
+    log_println("[I2C] Scanning I2C bus...");
+    serial_printf("[I2C] SDA=GPIO%d, SCL=GPIO%d\n", sda_pin, scl_pin);
+
+    int devices_found = 0;
+    for (uint8_t addr = 1; addr < 127; addr++) {
+        Wire.beginTransmission(addr);
+        uint8_t error = Wire.endTransmission();
+
+        if (error == 0) {
+            devices_found++;
+            const char* device_name = "";
+
+            // Known device identification
+            if (addr == 0x24) {
+                device_name = " <- PN532 (Elechouse V3)";
+            } else if (addr == 0x28) {
+                device_name = " <- PN532 (HW-147C/alternate)";
+            } else if (addr == 0x48) {
+                device_name = " <- PN532 (alternate address)";
+            } else if (addr == 0x68 || addr == 0x69) {
+                device_name = " <- IMU (MPU6050 family)";
+            }
+
+            serial_printf("[I2C] Found device at 0x%02X%s\n", addr, device_name);
+        } else if (error == 4) {
+            serial_printf("[I2C] Unknown error at 0x%02X\n", addr);
+        }
+    }
+
+    if (devices_found == 0) {
+        log_println("[I2C] ERROR: No devices found on I2C bus!");
+        log_println("[I2C] Check: SDA/SCL wiring, pull-up resistors, power");
+    } else {
+        serial_printf("[I2C] Scan complete: %d device(s) found\n", devices_found);
+    }
+}
+#endif
+
+static void hw_init() {
+    const int sda = PN532_SWAP_I2C ? PIN_I2C_SCL : PIN_I2C_SDA;
+    const int scl = PN532_SWAP_I2C ? PIN_I2C_SDA : PIN_I2C_SCL;
+    pinMode(sda, INPUT_PULLUP);
+    pinMode(scl, INPUT_PULLUP);
+    Wire.begin(sda, scl);
+    Wire.setClock(I2C_CLOCK_STANDARD);
+    current_clock = I2C_CLOCK_STANDARD;
+
+#if I2C_DEBUG
+    scan(sda, scl);
+#endif
+}
+
+static void hw_set_clock(uint32_t hz) {
+    Wire.setClock(hz);
+}
+
+// Write tx, then read rx after a repeated start. Nothing to send: address probe.
+static bool hw_transfer(uint8_t addr, const uint8_t* tx, uint8_t tx_len, uint8_t* rx, uint8_t rx_len) {
+    if (tx_len || !rx_len) {
+        Wire.beginTransmission(addr);
+        if (tx_len) Wire.write(tx, tx_len);
+        if (Wire.endTransmission(rx_len == 0) != 0) return false;
+    }
+    if (!rx_len) return true;
+    if (Wire.requestFrom(addr, rx_len) != rx_len) return false;
+    return Wire.readBytes(rx, rx_len) == rx_len;
+}
+
+static void* hw_current_task() {
+    return xTaskGetCurrentTaskHandle();
+}
+
+// Completion wakes the waiter on its own notification bit, so the driver's
+// wakeups (NOTIFY_WAKE: IRQ lines, start/stop) are neither taken nor faked
+static void hw_notify(void* task) {
+    if (task) xTaskNotify(static_cast<TaskHandle_t>(task), NOTIFY_I2C_DONE, eSetBits);
+}
+
+static void hw_wait_notify() {
+    app_notify_wait(NOTIFY_I2C_DONE, WAIT_SLICE_MS);
+}
+
+#else
+
+// Simulator: no devices on the bus, every transfer is NACKed
+static void hw_init() {
+    current_clock = I2C_CLOCK_STANDARD;
+}
+
+static void hw_set_clock(uint32_t hz) {
+    (void)hz;
+}
+
+static bool hw_transfer(uint8_t addr, const uint8_t* tx, uint8_t tx_len, uint8_t* rx, uint8_t rx_len) {
+    (void)addr; (void)tx; (void)tx_len; (void)rx; (void)rx_len;
+    return false;
+}
+
+static void* hw_current_task() {
+    return nullptr;
+}
+
+static void hw_notify(void* task) {
+    (void)task;
+}
+
+static void hw_wait_notify() {
+    app_task_delay_ms(1);
+}
+
+#endif
+
+// =============================================================================
+// Bus Task
+// =============================================================================
+
+static bool next_request(I2cTransfer*& t) {
+    for (auto& q : requests) {
+        if (q.pop(t)) return true;
+    }
+    return false;
+}
+
+static void account(DeviceSlot& d, bool ok, uint32_t bytes, uint32_t latency_us) {
+    d.transfers.fetch_add(1, std::memory_order_relaxed);
+    if (!ok) d.errors.fetch_add(1, std::memory_order_relaxed);
+    d.bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    int32_t avg = static_cast<int32_t>(d.latency_avg_us.load(std::memory_order_relaxed));
+    avg += (static_cast<int32_t>(latency_us) - avg) >> LATENCY_SHIFT;
+    d.latency_avg_us.store(static_cast<uint32_t>(avg), std::memory_order_relaxed);
+    if (latency_us > d.latency_max_us.load(std::memory_order_relaxed)) {
+        d.latency_max_us.store(latency_us, std::memory_order_relaxed);
+    }
+}
+
+static void run(I2cTransfer* t) {
+    DeviceSlot& d = devices[t->dev];
+    if (d.clock_hz != current_clock) {
+        hw_set_clock(d.clock_hz);
+        current_clock = d.clock_hz;
+    }
+
+    void* waiter = t->waiter;
+    const uint32_t submitted_us = t->submitted_us;
+    const uint32_t start_us = app_time_us();
+    const bool ok = hw_transfer(d.addr, t->tx, t->tx_len, t->rx, t->rx_len);
+    const uint32_t bytes = t->tx_len + t->rx_len;
+    const uint32_t end_us = app_time_us();
+    busy_us += end_us - start_us;
+    account(d, ok, bytes, end_us - submitted_us);
+
+    // The caller may release the transfer as soon as it sees the final status
+    t->status.store(ok ? I2C_DONE : I2C_FAILED, std::memory_order_release);
+    hw_notify(waiter);
+}
+
+void i2c_bus_task_main(void* arg) {
+    (void)arg;
+    hw_init();
+
+    uint32_t window_start_us = app_time_us();
+    for (;;) {
+        uint32_t elapsed_ms = (app_time_us() - window_start_us) / 1000;
+        if (elapsed_ms >= UTIL_WINDOW_MS) {
+            utilization.store(static_cast<uint16_t>(static_cast<uint64_t>(busy_us) / elapsed_ms));
+            window_start_us = app_time_us();
+            busy_us = 0;
+            elapsed_ms = 0;
+        }
+
+        uint8_t b;
+        if (!bell.receive(b, UTIL_WINDOW_MS - elapsed_ms)) continue;
+
+        // Highest priority first, re-checked after every transfer
+        I2cTransfer* t;
+        while (next_request(t)) run(t);
+    }
+}
+
+// =============================================================================
+// Public API
+// =============================================================================
+
+I2cDevice i2c_bus_add_device(const char* name, uint8_t addr, uint32_t clock_hz) {
+    uint8_t id = device_count.fetch_add(1);
+    if (id >= I2C_MAX_DEVICES) {
+        device_count.store(I2C_MAX_DEVICES);
+        LOG_E("I2C", "Device table full - %s not added", name);
+        return I2C_NO_DEVICE;
+    }
+    DeviceSlot& d = devices[id];
+    d.name = name;
+    d.addr = addr;
+    d.clock_hz = clock_hz;
+    d.used.store(true, std::memory_order_release);
+    return static_cast<I2cDevice>(id);
+}
+
+static bool valid_device(I2cDevice dev) {
+    return dev >= 0 && dev < I2C_MAX_DEVICES && devices[dev].used.load(std::memory_order_acquire);
+}
+
+bool i2c_bus_submit(I2cTransfer& t) {
+    if (!valid_device(t.dev) || t.prio >= I2C_PRIO_COUNT) {
+        t.status.store(I2C_FAILED);
+        return false;
+    }
+    t.waiter = hw_current_task();
+    t.submitted_us = app_time_us();
+    t.status.store(I2C_PENDING, std::memory_order_relaxed);
+    if (!requests[t.prio].push(&t)) {
+        devices[t.dev].errors.fetch_add(1, std::memory_order_relaxed);
+        t.status.store(I2C_FAILED);
+        return false;
+    }
+    bell.send(0, 0);                // Full: the bus task is awake anyway
+    return true;
+}
+
+bool i2c_bus_wait(I2cTransfer& t) {
+    for (;;) {
+        uint8_t s = t.status.load(std::memory_order_acquire);
+        if (s == I2C_DONE) return true;
+        if (s == I2C_FAILED || s == I2C_IDLE) return false;
+        hw_wait_notify();
+    }
+}
+
+bool i2c_bus_transfer(I2cDevice dev, I2cPriority prio, const uint8_t* tx, uint8_t tx_len,
+                      uint8_t* rx, uint8_t rx_len) {
+    I2cTransfer t;
+    t.dev = dev;
+    t.prio = prio;
+    t.tx = tx;
+    t.tx_len = tx_len;
+    t.rx = rx;
+    t.rx_len = rx_len;
+    return i2c_bus_submit(t) && i2c_bus_wait(t);
+}
+
+bool i2c_bus_write_reg(I2cDevice dev, I2cPriority prio, uint8_t reg, uint8_t value) {
+    const uint8_t tx[2] = { reg, value };
+    return i2c_bus_transfer(dev, prio, tx, sizeof(tx), nullptr, 0);
+}
+
+bool i2c_bus_read_regs(I2cDevice dev, I2cPriority prio, uint8_t reg, uint8_t* buf, uint8_t len) {
+    return i2c_bus_transfer(dev, prio, &reg, 1, buf, len);
+}
+
+bool i2c_bus_device_stats(I2cDevice dev, I2cDeviceStats& out) {
+    if (!valid_device(dev)) return false;
+    const DeviceSlot& d = devices[dev];
+    out.name = d.name;
+    out.addr = d.addr;
+    out.clock_hz = d.clock_hz;
+    out.transfers = d.transfers.load(std::memory_order_relaxed);
+    out.errors = d.errors.load(std::memory_order_relaxed);
+    out.bytes = d.bytes.load(std::memory_order_relaxed);
+    out.latency_avg_us = d.latency_avg_us.load(std::memory_order_relaxed);
+    out.latency_max_us = d.latency_max_us.load(std::memory_order_relaxed);
+    return true;
+}
+
+uint16_t i2c_bus_utilization_permille() {
+    return utilization.load();
+}
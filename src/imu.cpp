@@ -0,0 +1,442 @@
+// src/imu.cpp - MPU6050 attitude service, FIFO burst reads on the IMU task
+//
+// Data path:  sensor samples (200 Hz, own clock) -> sensor FIFO
+//             -> IMU task wakes every IMU_READ_MS -> FIFO count + burst read
+//             -> MahonyFilter per sample -> SeqLock snapshot -> pages
+//
+// Each sensor has its own filter and FIFO timeline. The fused samples go into
+// a short history; once both sensors are running, the pair is interpolated to
+// the newest instant both histories cover and published as an ImuPair.
+//
+// The I2C bus is shared with the PN532 (include/i2c_bus.h). The IMU runs at
+// 400 kHz with the highest bus priority; the chunks of a burst are queued
+// together and run back to back on the bus task.
+
+#include "imu.h"
+#include "imu_fusion.h"
+#include "imu_sync.h"
+#include "seqlock.h"
+#include "i2c_bus.h"
+#include "gui/app_tasks.h"
+#include "gui/serial_log.h"
+#include <atomic>
+#include <math.h>
+
+static constexpr uint32_t SAMPLE_PERIOD_US = 1000000 / IMU_SAMPLE_HZ;
+static constexpr float SAMPLE_PERIOD_S = 1.0f / IMU_SAMPLE_HZ;
+static constexpr uint32_t IDLE_WAIT_MS = 100;
+static constexpr uint32_t RESCAN_MS = 1000;
+static constexpr uint8_t IMU_BURST_SAMPLES = 10;    // 120 bytes: fits the Wire buffer (128)
+static constexpr uint8_t IMU_BURSTS_PER_READ = 4;
+static constexpr uint8_t MAX_SAMPLES_PER_READ = IMU_BURSTS_PER_READ * IMU_BURST_SAMPLES;
+static constexpr uint8_t HISTORY_SAMPLES = 16;      // 80 ms: covers the read skew between the sensors
+
+// Full scale: accel +-2 g, gyro +-250 °/s
+static constexpr float ACCEL_LSB_PER_G = 16384.0f;
+static constexpr float GYRO_LSB_PER_DPS = 131.0f;
+static constexpr float RAD_PER_DEG = static_cast<float>(M_PI) / 180.0f;
+
+struct ImuRaw {
+    int16_t accel[3];
+    int16_t gyro[3];
+};
+
+struct Sensor {
+    SeqLock<ImuAttitude> attitude;                    // IMU task -> any reader
+    std::atomic<bool> present{false};
+
+    // IMU task state
+    ImuSensor id;
+    MahonyFilter filter;
+    FifoClock clock{SAMPLE_PERIOD_US};
+    AngleHistory<HISTORY_SAMPLES> history;
+    uint32_t samples = 0;
+    uint32_t last_probe_us = 0;
+};
+
+static Sensor sensors[IMU_SENSOR_COUNT];
+static SeqLock<ImuPair> pair;                         // IMU task -> any reader
+static std::atomic<bool> requested{false};            // GUI -> IMU task
+static std::atomic<uint32_t> overflow_count{0};
+static std::atomic<uint32_t> error_count{0};
+
+// IMU task state
+static bool active = false;
+static uint32_t pair_us = 0;                          // Last published pair
+
+// =============================================================================
+// Hardware Layer
+// =============================================================================
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+
+#include <Arduino.h>
+
+// MPU6050 registers
+static constexpr uint8_t REG_SMPLRT_DIV = 0x19;
+static constexpr uint8_t REG_CONFIG = 0x1A;
+static constexpr uint8_t REG_GYRO_CONFIG = 0x1B;
+static constexpr uint8_t REG_ACCEL_CONFIG = 0x1C;
+static constexpr uint8_t REG_FIFO_EN = 0x23;
+static constexpr uint8_t REG_INT_STATUS = 0x3A;
+static constexpr uint8_t REG_USER_CTRL = 0x6A;
+static constexpr uint8_t REG_PWR_MGMT_1 = 0x6B;
+static constexpr uint8_t REG_FIFO_COUNT_H = 0x72;
+static constexpr uint8_t REG_FIFO_R_W = 0x74;
+static constexpr uint8_t REG_WHO_AM_I = 0x75;
+
+static constexpr uint8_t PWR_RESET = 0x80;
+static constexpr uint8_t PWR_SLEEP = 0x40;
+static constexpr uint8_t PWR_CLK_PLL_GYRO_X = 0x01;
+static constexpr uint8_t DLPF_44HZ = 3;                          // 1 kHz internal rate
+static constexpr uint8_t SMPLRT_DIV = 1000 / IMU_SAMPLE_HZ - 1;
+static constexpr uint8_t FIFO_EN_ACCEL_GYRO = 0x78;              // 12 bytes per sample
+static constexpr uint8_t USER_CTRL_FIFO_EN = 0x40;
+static constexpr uint8_t USER_CTRL_FIFO_RESET = 0x04;
+static constexpr uint8_t INT_FIFO_OFLOW = 0x10;
+static constexpr uint16_t FIFO_SIZE = 1024;
+static constexpr uint8_t SAMPLE_BYTES = 12;
+
+static const char* const DEVICE_NAMES[IMU_SENSOR_COUNT] = { "IMU", "IMU surface" };
+
+static TaskHandle_t imu_task = nullptr;
+static I2cDevice imu_dev[IMU_SENSOR_COUNT] = { I2C_NO_DEVICE, I2C_NO_DEVICE };
+
+static bool reg_write(const Sensor& s, uint8_t reg, uint8_t value) {
+    return i2c_bus_write_reg(imu_dev[s.id], I2C_PRIO_HIGH, reg, value);
+}
+
+static bool reg_read(const Sensor& s, uint8_t reg, uint8_t* buf, uint8_t len) {
+    return i2c_bus_read_regs(imu_dev[s.id], I2C_PRIO_HIGH, reg, buf, len);
+}
+
+static bool fifo_reset(const Sensor& s) {
+    return reg_write(s, REG_USER_CTRL, USER_CTRL_FIFO_RESET) &&
+           reg_write(s, REG_USER_CTRL, USER_CTRL_FIFO_EN);
+}
+
+static void hw_init() {
+    for (uint8_t i = 0; i < IMU_SENSOR_COUNT; i++) {
+        imu_dev[i] = i2c_bus_add_device(DEVICE_NAMES[i], IMU_I2C_ADDR[i], I2C_CLOCK_FAST);
+    }
+    imu_task = xTaskGetCurrentTaskHandle();
+}
+
+// Probe and configure; false if no MPU6050-compatible sensor answers
+static bool hw_power(Sensor& s, bool on) {
+    if (!on) {
+        reg_write(s, REG_PWR_MGMT_1, PWR_SLEEP);
+        return false;
+    }
+
+    uint8_t who = 0;
+    if (!reg_read(s, REG_WHO_AM_I, &who, 1)) return false;
+    // MPU6050 / MPU6500 / MPU9250 / MPU9255: same FIFO and data registers
+    if (who != 0x68 && who != 0x70 && who != 0x71 && who != 0x73) {
+        LOG_W("IMU", "Unsupported sensor (WHO_AM_I 0x%02X)", who);
+        return false;
+    }
+
+    reg_write(s, REG_PWR_MGMT_1, PWR_RESET);
+    vTaskDelay(pdMS_TO_TICKS(100));
+    bool ok = reg_write(s, REG_PWR_MGMT_1, PWR_CLK_PLL_GYRO_X) &&
+              reg_write(s, REG_CONFIG, DLPF_44HZ) &&
+              reg_write(s, REG_SMPLRT_DIV, SMPLRT_DIV) &&
+              reg_write(s, REG_GYRO_CONFIG, 0) &&       // +-250 °/s
+              reg_write(s, REG_ACCEL_CONFIG, 0) &&      // +-2 g
+              reg_write(s, REG_FIFO_EN, FIFO_EN_ACCEL_GYRO) &&
+              fifo_reset(s);
+    if (ok) LOG_I("IMU", "Sensor 0x%02X at 0x%02X, %lu Hz", who, IMU_I2C_ADDR[s.id], (unsigned long)IMU_SAMPLE_HZ);
+    return ok;
+}
+
+// Start/stop wakeups use NOTIFY_WAKE - the bus reports transfers on NOTIFY_I2C_DONE
+static void hw_wait(uint32_t ms) {
+    app_notify_wait(NOTIFY_WAKE, ms);
+}
+
+static void hw_wake() {
+    if (imu_task) xTaskNotify(imu_task, NOTIFY_WAKE, eSetBits);
+}
+
+/**
+ * Empty the FIFO in bursts
+ * @param left Samples still in the FIFO after the last one returned
+ * @return Samples read, -1 on a bus error
+ */
+static int hw_read_fifo(Sensor& s, ImuRaw* out, uint8_t max, uint16_t& left) {
+    static uint8_t buf[IMU_BURSTS_PER_READ][IMU_BURST_SAMPLES * SAMPLE_BYTES];
+    static const uint8_t fifo_reg = REG_FIFO_R_W;
+    uint8_t status, count_be[2];
+    if (!reg_read(s, REG_INT_STATUS, &status, 1) || !reg_read(s, REG_FIFO_COUNT_H, count_be, 2)) return -1;
+    uint16_t count = (count_be[0] << 8) | count_be[1];
+
+    // Overflowed: the byte stream lost its sample alignment, start over
+    if ((status & INT_FIFO_OFLOW) || count > FIFO_SIZE - SAMPLE_BYTES) {
+        overflow_count++;
+        s.clock.reset();                                // The timeline has a gap
+        left = 0;
+        return fifo_reset(s) ? 0 : -1;
+    }
+
+    uint16_t available = count / SAMPLE_BYTES;
+    uint8_t n = (available < max) ? available : max;
+
+    // Queue every chunk at once, then collect them in order
+    I2cTransfer xfer[IMU_BURSTS_PER_READ];
+    uint8_t chunks = 0;
+    for (uint8_t done = 0; done < n; done += IMU_BURST_SAMPLES, chunks++) {
+        uint8_t chunk = (n - done < IMU_BURST_SAMPLES) ? n - done : IMU_BURST_SAMPLES;
+        I2cTransfer& t = xfer[chunks];
+        t.dev = imu_dev[s.id];
+        t.prio = I2C_PRIO_HIGH;
+        t.tx = &fifo_reg;
+        t.tx_len = 1;
+        t.rx = buf[chunks];
+        t.rx_len = chunk * SAMPLE_BYTES;
+        i2c_bus_submit(t);
+    }
+    bool ok = true;
+    for (uint8_t c = 0; c < chunks; c++) ok &= i2c_bus_wait(xfer[c]);
+    if (!ok) return -1;
+
+    for (uint8_t k = 0; k < n; k++) {
+        const uint8_t* p = buf[k / IMU_BURST_SAMPLES] + (k % IMU_BURST_SAMPLES) * SAMPLE_BYTES;
+        for (int i = 0; i < 3; i++) {
+            out[k].accel[i] = static_cast<int16_t>((p[2 * i] << 8) | p[2 * i + 1]);
+            out[k].gyro[i] = static_cast<int16_t>((p[6 + 2 * i] << 8) | p[7 + 2 * i]);
+        }
+    }
+    left = available - n;
+    return n;
+}
+
+#else
+
+// Simulator: reference sensor on a slowly rocking wing, surface sensor on a
+// flap moving against it; gyro bias and noise on both. The surface sensor's
+// clock runs 0.5 % slow, as real ones do.
+static constexpr float SIM_PITCH_DEG = -3.0f;
+static constexpr float SIM_PITCH_SWING_DEG = 2.0f;
+static constexpr float SIM_SWING_HZ = 0.05f;
+static constexpr float SIM_ROLL_DEG = 1.5f;
+static constexpr float SIM_FLAP_DEG = 5.0f;         // Trailing edge down
+static constexpr float SIM_FLAP_SWING_DEG = 10.0f;
+static constexpr float SIM_FLAP_HZ = 0.2f;
+static constexpr float SIM_GYRO_BIAS_DPS[IMU_SENSOR_COUNT][3] = { { 0.8f, -1.2f, 0.4f }, { -0.5f, 0.6f, 1.0f } };
+static constexpr uint32_t SIM_PERIOD_US[IMU_SENSOR_COUNT] = { SAMPLE_PERIOD_US, SAMPLE_PERIOD_US * 1005 / 1000 };
+static constexpr int32_t SIM_ACCEL_NOISE = 60;      // LSB +-
+static constexpr int32_t SIM_GYRO_NOISE = 20;
+
+struct SimSensor {
+    uint32_t next_us;
+    uint32_t start_us;
+};
+
+static SimSensor sim[IMU_SENSOR_COUNT];
+static uint32_t sim_noise = 13579;
+
+static int16_t sim_jitter(float value, int32_t amplitude) {
+    sim_noise = sim_noise * 1103515245u + 12345u;
+    int32_t noise = static_cast<int32_t>((sim_noise >> 16) % (2 * amplitude + 1)) - amplitude;
+    return static_cast<int16_t>(lroundf(value) + noise);
+}
+
+static void hw_init() {}
+
+static bool hw_power(Sensor& s, bool on) {
+    sim[s.id].next_us = sim[s.id].start_us = app_time_us();
+    return on;
+}
+
+static void hw_wait(uint32_t ms) {
+    app_task_delay_ms(ms);
+}
+
+static void hw_wake() {}
+
+static int hw_read_fifo(Sensor& s, ImuRaw* out, uint8_t max, uint16_t& left) {
+    SimSensor& ss = sim[s.id];
+    const uint32_t period_us = SIM_PERIOD_US[s.id];
+    uint8_t n = 0;
+    while (n < max && static_cast<int32_t>(app_time_us() - ss.next_us) >= 0) {
+        // The motion runs on the true time, so both sensors see the same wing
+        float t = (ss.next_us - sim[IMU_REFERENCE].start_us) * 1e-6f;
+        float w = 2.0f * static_cast<float>(M_PI) * SIM_SWING_HZ;
+        float pitch_deg = SIM_PITCH_DEG + SIM_PITCH_SWING_DEG * sinf(w * t);
+        float pitch_rate_dps = SIM_PITCH_SWING_DEG * w * cosf(w * t);
+        if (s.id == IMU_SURFACE) {
+            // Trailing edge down is nose up for a sensor pointing at the hinge line
+            float wf = 2.0f * static_cast<float>(M_PI) * SIM_FLAP_HZ;
+            pitch_deg -= SIM_FLAP_DEG + SIM_FLAP_SWING_DEG * sinf(wf * t);
+            pitch_rate_dps -= SIM_FLAP_SWING_DEG * wf * cosf(wf * t);
+        }
+        float pitch = pitch_deg * RAD_PER_DEG;
+        float roll = SIM_ROLL_DEG * RAD_PER_DEG;
+
+        // Gravity in the sensor frame (see include/imu_fusion.h)
+        const float g[3] = { -sinf(pitch), cosf(pitch) * sinf(roll), cosf(pitch) * cosf(roll) };
+        const float rate[3] = { 0.0f, pitch_rate_dps, 0.0f };
+        for (int i = 0; i < 3; i++) {
+            out[n].accel[i] = sim_jitter(g[i] * ACCEL_LSB_PER_G, SIM_ACCEL_NOISE);
+            out[n].gyro[i] = sim_jitter((rate[i] + SIM_GYRO_BIAS_DPS[s.id][i]) * GYRO_LSB_PER_DPS, SIM_GYRO_NOISE);
+        }
+        n++;
+        ss.next_us += period_us;
+    }
+    int32_t behind_us = static_cast<int32_t>(app_time_us() - ss.next_us);
+    left = (behind_us > 0) ? behind_us / period_us : 0;
+    return n;
+}
+
+#endif
+
+// =============================================================================
+// IMU Task
+// =============================================================================
+
+static void fuse(Sensor& s, const ImuRaw& r, float& rate_dps) {
+    float accel[3], gyro[3];
+    float rate_sq = 0.0f;
+    for (int i = 0; i < 3; i++) {
+        accel[i] = r.accel[i] / ACCEL_LSB_PER_G;
+        float dps = r.gyro[i] / GYRO_LSB_PER_DPS;
+        rate_sq += dps * dps;
+        gyro[i] = dps * RAD_PER_DEG;
+    }
+    rate_dps = sqrtf(rate_sq);
+    s.filter.update(gyro, accel, SAMPLE_PERIOD_S);
+}
+
+// Returns true if samples are still waiting in the FIFO
+static bool service(Sensor& s) {
+    ImuRaw raw[MAX_SAMPLES_PER_READ];
+    uint16_t left = 0;
+    uint32_t read_us = app_time_us();
+    int n = hw_read_fifo(s, raw, MAX_SAMPLES_PER_READ, left);
+    if (n < 0) {
+        error_count++;
+        return false;
+    }
+    if (n == 0) return false;
+
+    uint32_t first_us = s.clock.stamp(read_us - left * (s.clock.period_q8() >> 8), n);
+    float rate_dps = 0.0f;
+    for (int i = 0; i < n; i++) {
+        fuse(s, raw[i], rate_dps);
+        if (s.filter.valid()) s.history.push(first_us + s.clock.offset_us(i), s.filter.pitch_deg(), s.filter.roll_deg());
+    }
+    s.samples += n;
+    if (!s.filter.valid()) return left > 0;
+
+    ImuAttitude a;
+    a.timestamp_us = s.history.newest_us();
+    a.samples = s.samples;
+    a.roll_deg = s.filter.roll_deg();
+    a.pitch_deg = s.filter.pitch_deg();
+    a.rate_dps = rate_dps;
+    s.attitude.write(a);
+    return left > 0;
+}
+
+// Both sensors at the newest instant both have reached
+static void publish_pair() {
+    const Sensor& ref = sensors[IMU_REFERENCE];
+    const Sensor& surf = sensors[IMU_SURFACE];
+    if (ref.history.empty() || surf.history.empty()) return;
+
+    uint32_t ref_us = ref.history.newest_us();
+    uint32_t surf_us = surf.history.newest_us();
+    int32_t diff = static_cast<int32_t>(surf_us - ref_us);
+    uint32_t t = (diff < 0) ? surf_us : ref_us;
+    if (t == pair_us) return;
+
+    ImuPair p;
+    if (!ref.history.at(t, p.pitch_deg[IMU_REFERENCE], p.roll_deg[IMU_REFERENCE]) ||
+        !surf.history.at(t, p.pitch_deg[IMU_SURFACE], p.roll_deg[IMU_SURFACE])) return;
+    p.valid = true;
+    p.timestamp_us = t;
+    p.skew_us = static_cast<uint32_t>(diff < 0 ? -diff : diff);
+    pair.write(p);
+    pair_us = t;
+}
+
+static void restart(Sensor& s, bool on) {
+    s.filter.reset();
+    s.clock.reset();
+    s.history.reset();
+    s.samples = 0;
+    s.attitude.write(ImuAttitude{});        // Readers: nothing since the restart
+    s.present.store(hw_power(s, on));
+    s.last_probe_us = app_time_us();
+}
+
+void imu_task_main(void* arg) {
+    (void)arg;
+    for (uint8_t i = 0; i < IMU_SENSOR_COUNT; i++) sensors[i].id = static_cast<ImuSensor>(i);
+    hw_init();
+
+    for (;;) {
+        bool want = requested.load();
+        if (want != active) {
+            active = want;
+            for (Sensor& s : sensors) restart(s, want);
+            pair.write(ImuPair{});
+        }
+        if (!active) {
+            hw_wait(IDLE_WAIT_MS);
+            continue;
+        }
+
+        bool any = false;
+        bool more = false;
+        for (Sensor& s : sensors) {
+            if (!s.present.load()) {
+                // Plugged in later: probe again now and then
+                if (app_time_us() - s.last_probe_us >= RESCAN_MS * 1000) {
+                    s.present.store(hw_power(s, true));
+                    s.last_probe_us = app_time_us();
+                }
+                continue;
+            }
+            any = true;
+            if (service(s)) more = true;
+        }
+        publish_pair();
+
+        if (!more) hw_wait(any ? IMU_READ_MS : IDLE_WAIT_MS);
+    }
+}
+
+// =============================================================================
+// Public API
+// =============================================================================
+
+void imu_start() {
+    requested.store(true);
+    hw_wake();
+}
+
+void imu_stop() {
+    requested.store(false);
+    hw_wake();
+}
+
+bool imu_present(ImuSensor sensor) {
+    return sensors[sensor].present.load();
+}
+
+bool imu_read(ImuAttitude& out, ImuSensor sensor) {
+    return sensors[sensor].attitude.read(out) && out.samples > 0;
+}
+
+bool imu_read_pair(ImuPair& out) {
+    return pair.read(out) && out.valid;
+}
+
+uint32_t imu_overflow_count() {
+    return overflow_count.load();
+}
+
+uint32_t imu_error_count() {
+    return error_count.load();
+}
@@ -1,15 +1,18 @@
 // src/input_hw.cpp - ESP32 hardware input handling (EC11 rotary encoder)
 // Uses interrupts for responsive encoder reading with button gesture detection
 
+// Set to LOG_LEVEL_DEBUG to enable encoder debug output (compiled out otherwise)
+#define RC_LOG_LEVEL LOG_LEVEL_INFO
+
 #include "gui/input.h"
+#include "gui/serial_log.h"
 
 #if defined(ESP_PLATFORM) || defined(ARDUINO)
 
 #include <Arduino.h>
 #include "pins.h"
 
-// Uncomment to enable encoder debug output
-// #define DEBUG_ENCODER
+static constexpr bool ENC_DEBUG = (RC_LOG_LEVEL >= LOG_LEVEL_DEBUG);
 
 // =============================================================================
 // Encoder State (interrupt-safe)
@@ -28,7 +31,7 @@ static volatile bool btn_pressed = false;
 static volatile int click_count = 0;
 static volatile bool long_press_fired = false;  // Suppress click after long press
 
-// Debug: ISR activity counter and last sampled states (can't print from ISR, but can store)
+// Debug: ISR activity counter and last sampled states (only written when ENC_DEBUG)
 static volatile uint32_t isr_count = 0;
 static volatile uint8_t last_isr_clk = 0;
 static volatile uint8_t last_isr_dt = 0;
@@ -36,14 +39,32 @@ static volatile uint8_t last_isr_state = 0;
 static volatile int8_t last_isr_dir = 0;
 static volatile int8_t last_isr_count = 0;
 
+// Task woken by encoder/button interrupts (the task that runs input_poll)
+static TaskHandle_t wake_task = nullptr;
+
 // Timing constants (ms)
 static constexpr uint32_t DEBOUNCE_MS     = 5;
 static constexpr uint32_t LONG_PRESS_MS   = 800;
 static constexpr uint32_t DOUBLE_CLICK_MS = 300;
 
 // =============================================================================
-// Interrupt Service Routine for Encoder
+// Interrupt Service Routines
 // =============================================================================
+
+// Wake the polling task so input is handled without waiting for its next timeout
+static inline void IRAM_ATTR wake_poll_task() {
+    if (wake_task) {
+        BaseType_t higher_prio_woken = pdFALSE;
+        vTaskNotifyGiveFromISR(wake_task, &higher_prio_woken);
+        if (higher_prio_woken) portYIELD_FROM_ISR();
+    }
+}
+
+// Button edges only wake the poll task - debounce and gestures stay in poll_button()
+static void IRAM_ATTR button_isr() {
+    wake_poll_task();
+}
+
 // Gray code state machine - bulletproof decoding
 // States: 00=0, 01=1, 11=2, 10=3 (Gray code order)
 // CW sequence:  0->1->2->3->0 (decimal: 0,1,3,2,0)
@@ -58,7 +79,7 @@ static const int8_t ENC_STATES[] = {
 };
 
 static void IRAM_ATTR encoder_isr() {
-    isr_count++;  // Debug: count ISR invocations
+    if (ENC_DEBUG) isr_count++;  // Debug: count ISR invocations
 
     // Read both pins
     uint8_t clk = digitalRead(PIN_ENC_CLK);
@@ -70,14 +91,16 @@ static void IRAM_ATTR encoder_isr() {
     enc_state = new_state;
 
     // Debug: store last sampled values
-    last_isr_clk = clk;
-    last_isr_dt = dt;
-    last_isr_state = new_state;
-    last_isr_dir = dir;
+    if (ENC_DEBUG) {
+        last_isr_clk = clk;
+        last_isr_dt = dt;
+        last_isr_state = new_state;
+        last_isr_dir = dir;
+    }
 
     if (dir != 0) {
         enc_count += dir;
-        last_isr_count = enc_count;
+        if (ENC_DEBUG) last_isr_count = enc_count;
 
         // EC11 has 4 state changes per detent
         // Count one step when we've accumulated 4 transitions in same direction
@@ -93,6 +116,7 @@ static void IRAM_ATTR encoder_isr() {
                 // Small oscillation at detent, reset
                 enc_count = 0;
             }
+            wake_poll_task();
         }
     }
 }
@@ -107,19 +131,21 @@ void input_hw_init() {
     pinMode(PIN_ENC_DT, INPUT_PULLUP);
     pinMode(PIN_ENC_SW, INPUT_PULLUP);
 
-#ifdef DEBUG_ENCODER
-    Serial.printf("[ENC-INIT] Pins: CLK=%d DT=%d SW=%d\n", PIN_ENC_CLK, PIN_ENC_DT, PIN_ENC_SW);
-    Serial.printf("[ENC-INIT] Raw pin state: CLK=%d DT=%d SW=%d (SW expect 1=HIGH)\n",
-                  digitalRead(PIN_ENC_CLK), digitalRead(PIN_ENC_DT), digitalRead(PIN_ENC_SW));
-#endif
+    LOG_D("ENC-INIT", "Pins: CLK=%d DT=%d SW=%d", PIN_ENC_CLK, PIN_ENC_DT, PIN_ENC_SW);
+    LOG_D("ENC-INIT", "Raw pin state: CLK=%d DT=%d SW=%d (SW expect 1=HIGH)",
+          digitalRead(PIN_ENC_CLK), digitalRead(PIN_ENC_DT), digitalRead(PIN_ENC_SW));
 
     // Read initial encoder state
     enc_state = (digitalRead(PIN_ENC_CLK) << 1) | digitalRead(PIN_ENC_DT);
     enc_count = 0;
 
+    // The calling task runs input_poll() - notify it from the ISRs
+    wake_task = xTaskGetCurrentTaskHandle();
+
     // Attach interrupts on BOTH encoder pins for full quadrature decoding
     attachInterrupt(digitalPinToInterrupt(PIN_ENC_CLK), encoder_isr, CHANGE);
     attachInterrupt(digitalPinToInterrupt(PIN_ENC_DT), encoder_isr, CHANGE);
+    attachInterrupt(digitalPinToInterrupt(PIN_ENC_SW), button_isr, CHANGE);
 
     encoder_pos = 0;
     last_encoder_pos = 0;
@@ -128,9 +154,7 @@ void input_hw_init() {
     btn_release_time = millis();  // Initialize to prevent stale timeout
     isr_count = 0;
 
-#ifdef DEBUG_ENCODER
-    Serial.printf("[ENC-INIT] Complete: enc_state=0x%02X\n", enc_state);
-#endif
+    LOG_D("ENC-INIT", "Complete: enc_state=0x%02X", enc_state);
 }
 
 // Poll button state (called from input_hw_poll)
@@ -147,9 +171,7 @@ static void poll_button() {
             btn_press_time = now;
             long_press_fired = false;  // Reset on new press
             last_press = now;
-#ifdef DEBUG_ENCODER
-            Serial.printf("[BTN] PRESS detected at %lu\n", now);
-#endif
+            LOG_D("BTN", "PRESS detected at %lu", (unsigned long)now);
         }
     } else if (!pressed && btn_pressed) {
         // Button just released
@@ -163,22 +185,19 @@ static void poll_button() {
                 // Short press - could be first click of double-click
                 click_count++;
             }
-#ifdef DEBUG_ENCODER
-            Serial.printf("[BTN] RELEASE duration=%lu click_count=%d long_fired=%d\n",
-                          press_duration, click_count, long_press_fired);
+            LOG_D("BTN", "RELEASE duration=%lu click_count=%d long_fired=%d",
+                  (unsigned long)press_duration, click_count, long_press_fired);
         } else {
-            Serial.printf("[BTN] RELEASE after long press, ignoring\n");
-#endif
+            LOG_D("BTN", "RELEASE after long press, ignoring");
         }
         long_press_fired = false;  // Reset for next press
     }
 }
 
 void input_hw_poll() {
-#ifdef DEBUG_ENCODER
     // Periodic raw state dump
     static uint32_t last_dbg = 0;
-    if (millis() - last_dbg > 500) {
+    if (ENC_DEBUG && millis() - last_dbg > 500) {
         last_dbg = millis();
         noInterrupts();
         uint32_t isr_cnt = isr_count;
@@ -189,12 +208,11 @@ void input_hw_poll() {
         int8_t dbg_dir = last_isr_dir;
         int8_t dbg_count = last_isr_count;
         interrupts();
-        Serial.printf("[ENC-POLL] RAW: CLK=%d DT=%d SW=%d pos=%ld isr=%lu | last: CLK=%d DT=%d state=0x%02X dir=%d cnt=%d\n",
-                      digitalRead(PIN_ENC_CLK), digitalRead(PIN_ENC_DT),
-                      digitalRead(PIN_ENC_SW), pos_dbg, isr_cnt,
-                      dbg_clk, dbg_dt, dbg_state, dbg_dir, dbg_count);
+        LOG_D("ENC-POLL", "RAW: CLK=%d DT=%d SW=%d pos=%ld isr=%lu | last: CLK=%d DT=%d state=0x%02X dir=%d cnt=%d",
+              digitalRead(PIN_ENC_CLK), digitalRead(PIN_ENC_DT),
+              digitalRead(PIN_ENC_SW), (long)pos_dbg, (unsigned long)isr_cnt,
+              dbg_clk, dbg_dt, dbg_state, dbg_dir, dbg_count);
     }
-#endif
 
     // Button is polled (slow human input, debounce needed)
     poll_button();
@@ -209,9 +227,7 @@ void input_hw_poll() {
         int delta = pos - last_encoder_pos;
         last_encoder_pos = pos;
 
-#ifdef DEBUG_ENCODER
-        Serial.printf("[ENC] ROTATION delta=%d pos=%ld\n", delta, pos);
-#endif
+        LOG_D("ENC", "ROTATION delta=%d pos=%ld", delta, (long)pos);
         // Feed rotation to LVGL encoder system
         input_feed_encoder(delta);
     }
@@ -222,9 +238,7 @@ void input_hw_poll() {
         if (now - btn_press_time > LONG_PRESS_MS && !long_press_fired) {
             // Long press detected - set flag to prevent click on release
             long_press_fired = true;
-#ifdef DEBUG_ENCODER
-            Serial.printf("[BTN] LONG_PRESS fired at %lu\n", now);
-#endif
+            LOG_D("BTN", "LONG_PRESS fired at %lu", (unsigned long)now);
             input_feed_button(INPUT_ENC_LONG_PRESS);
         }
     }
@@ -242,9 +256,7 @@ void input_hw_poll() {
             } else {
                 ev = INPUT_ENC_PRESS;
             }
-#ifdef DEBUG_ENCODER
-            Serial.printf("[BTN] FIRE event=%d clicks=%d\n", ev, click_count);
-#endif
+            LOG_D("BTN", "FIRE event=%d clicks=%d", ev, click_count);
             click_count = 0;
             input_feed_button(ev);
         }
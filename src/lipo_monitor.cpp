@@ -0,0 +1,345 @@
+// src/lipo_monitor.cpp - LiPo cell voltages from the balancer taps
+//
+// Data path:  ADC controller + DMA (all taps, round robin) -> IO task:
+//             AdcFilter per tap -> calibration -> divider -> reading queue -> GUI
+//
+// Noise budget (ESP32-S3, 11 dB): ~4 mV rms per sample at the pin, x6 at the
+// 3S tap. 64x oversampling divides it by 8, the IIR (1/8) by ~4: about 1 mV rms
+// per tap, well inside the 5 mV the display resolves.
+//
+// IR test: the same stream, but the oversampling blocks are recorded before
+// the IIR (16 ms, ~3 mV rms at the 3S tap). Block k of every tap starts at
+// stream sample 64 * NUM_ADC_PINS * k, so the ADC timestamps place the load
+// switching between two blocks without sampling the GPIO.
+
+#include "lipo_monitor.h"
+#include "adc_dma.h"
+#include "adc_filter.h"
+#include "spsc_queue.h"
+#include "gui/app_tasks.h"
+#include "gui/serial_log.h"
+#include <atomic>
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+#include <driver/gpio.h>
+#else
+#include <math.h>
+#endif
+
+typedef AdcFilter<6, 3> TapFilter;      // 64x oversampling, IIR time constant 8 blocks (128 ms)
+
+static constexpr size_t READ_CHUNK = 128;
+static constexpr size_t READING_QUEUE_LEN = 4;
+
+// IR trace: one entry per oversampling block and tap
+static constexpr uint32_t IR_BLOCK_US = TapFilter::BLOCK * 1000000u / LIPO_TAP_RATE_HZ;
+static constexpr size_t IR_PRE_BLOCKS = LIPO_IR_PRE_MS * 1000u / IR_BLOCK_US;
+static constexpr size_t IR_LOAD_BLOCKS = LIPO_IR_LOAD_MS * 1000u / IR_BLOCK_US;
+static constexpr size_t IR_TRACE_LEN = IR_PRE_BLOCKS + IR_LOAD_BLOCKS + 8;
+static constexpr uint32_t IR_TIMEOUT_US = (LIPO_IR_PRE_MS + LIPO_IR_LOAD_MS + 500) * 1000u;
+
+// Divider factors in Q16 (pins.h)
+static constexpr uint32_t tap_divider_q16(int tap) {
+    return static_cast<uint32_t>(adc_tap_divider(tap) * 65536.0f + 0.5f);
+}
+
+static SpscQueue<LipoReading, READING_QUEUE_LEN> readings;   // IO task -> GUI
+static std::atomic<bool> requested{false};                    // GUI -> IO task
+static SpscQueue<LipoIrResult, 2> ir_results;                 // IO task -> GUI
+static std::atomic<bool> ir_requested{false};                 // GUI -> IO task
+static std::atomic<bool> ir_busy{false};
+
+// IO task state
+static TapFilter filters[NUM_ADC_PINS];
+static AdcCalTable cal;
+static bool calibrated = false;
+static bool active = false;
+static uint32_t last_publish_us = 0;
+static uint8_t last_cells = 0;
+
+enum IrPhase {
+    IR_IDLE,
+    IR_ARM,         // Wait for a block boundary of tap 0 (keeps the taps aligned)
+    IR_PRE,         // Recording unloaded
+    IR_LOAD,        // Load on
+};
+
+static IrPhase ir_phase = IR_IDLE;
+static uint16_t ir_trace[NUM_ADC_PINS][IR_TRACE_LEN];
+static size_t ir_count[NUM_ADC_PINS];
+static size_t ir_load_on = 0;           // 0 = first loaded block not seen yet
+static uint32_t ir_switch_us = 0;
+static uint32_t ir_started_us = 0;
+
+// =============================================================================
+// Simulator: 3S pack on the balancer connector
+// =============================================================================
+#if !(defined(ESP_PLATFORM) || defined(ARDUINO))
+
+static const uint16_t SIM_CELL_MV[LIPO_MAX_CELLS] = { 3852, 3867, 3841 };
+static const float SIM_CELL_MOHM[LIPO_MAX_CELLS] = { 9.0f, 11.0f, 14.0f };
+static constexpr float SIM_POLARIZATION_MOHM = 4.0f;   // Slow sag under load
+static constexpr float SIM_POLARIZATION_TAU_US = 300000.0f;
+static constexpr int32_t SIM_NOISE_COUNTS = 6;      // +- per sample
+static uint32_t sim_noise = 54321;
+
+// Load switching times: samples are generated after the fact, so the model
+// needs the history, not only the current state
+static bool sim_load = false;
+static bool sim_load_used = false;
+static uint32_t sim_load_on_us = 0;
+static uint32_t sim_load_off_us = 0;
+
+static bool sim_loaded(uint32_t t_us) {
+    if (!sim_load_used || static_cast<int32_t>(t_us - sim_load_on_us) < 0) return false;
+    return sim_load || static_cast<int32_t>(t_us - sim_load_off_us) < 0;
+}
+
+static uint16_t sim_tap(uint8_t input, uint32_t t_us) {
+    float tap_mv = 0.0f;
+    for (uint8_t i = 0; i <= input && i < LIPO_MAX_CELLS; i++) tap_mv += SIM_CELL_MV[i];
+
+    if (sim_loaded(t_us)) {
+        float pack_mv = 0.0f;
+        for (uint8_t i = 0; i < LIPO_MAX_CELLS; i++) pack_mv += SIM_CELL_MV[i];
+        float amps = pack_mv / LIPO_LOAD_MILLIOHM;
+        float pol = SIM_POLARIZATION_MOHM * (1.0f - expf(-static_cast<float>(t_us - sim_load_on_us) / SIM_POLARIZATION_TAU_US));
+        for (uint8_t i = 0; i <= input && i < LIPO_MAX_CELLS; i++) tap_mv -= amps * (SIM_CELL_MOHM[i] + pol);
+    }
+
+    // Pin voltage -> raw of the ideal simulated converter
+    float pin_mv = tap_mv / adc_tap_divider(input);
+    int32_t raw = static_cast<int32_t>(pin_mv * 4096.0f / ADC_DMA_SIM_FULL_SCALE_MV + 0.5f);
+
+    sim_noise = sim_noise * 1103515245u + 12345u;
+    raw += static_cast<int32_t>((sim_noise >> 16) % (2 * SIM_NOISE_COUNTS + 1)) - SIM_NOISE_COUNTS;
+    if (raw < 0) raw = 0;
+    if (raw > ADC_DMA_RAW_MAX) raw = ADC_DMA_RAW_MAX;
+    return static_cast<uint16_t>(raw);
+}
+
+static void sim_attach() {
+    adc_dma_set_sim_source(sim_tap);
+}
+
+static void hw_load_init() {}
+
+static void hw_load_set(bool on) {
+    if (on == sim_load) return;
+    if (on) sim_load_on_us = app_time_us();
+    else sim_load_off_us = app_time_us();
+    sim_load = on;
+    sim_load_used = true;
+}
+
+#else
+
+static void sim_attach() {}
+
+static void hw_load_init() {
+    static bool done = false;
+    if (done) return;
+    gpio_reset_pin(static_cast<gpio_num_t>(PIN_LIPO_LOAD));
+    gpio_set_level(static_cast<gpio_num_t>(PIN_LIPO_LOAD), 0);
+    gpio_set_direction(static_cast<gpio_num_t>(PIN_LIPO_LOAD), GPIO_MODE_OUTPUT);
+    done = true;
+}
+
+static void hw_load_set(bool on) {
+    gpio_set_level(static_cast<gpio_num_t>(PIN_LIPO_LOAD), on ? 1 : 0);
+}
+
+#endif
+
+// =============================================================================
+// IO Task
+// =============================================================================
+
+static bool start_sampling() {
+    sim_attach();
+    hw_load_init();
+    if (!adc_dma_start((1 << NUM_ADC_PINS) - 1, LIPO_TAP_RATE_HZ * NUM_ADC_PINS)) return false;
+
+    calibrated = adc_dma_calibration(cal);
+    if (!calibrated) LOG_W("LIPO", "No ADC eFuse calibration, readings use the nominal reference");
+    for (auto& f : filters) f.reset();
+    last_publish_us = app_time_us();
+    last_cells = 0;
+    return true;
+}
+
+// Filter scale (raw with FRAC_BITS) -> mV at the tap
+static uint16_t tap_mv(uint8_t tap, uint32_t raw_q) {
+    uint32_t pin_uv = cal.to_uv(raw_q, TapFilter::FRAC_BITS);
+    uint64_t tap_uv = (static_cast<uint64_t>(pin_uv) * tap_divider_q16(tap)) >> 16;
+    return static_cast<uint16_t>((tap_uv + 500) / 1000);
+}
+
+static void publish() {
+    LipoReading r = {};
+    r.calibrated = calibrated;
+    r.settled = true;
+
+    for (uint8_t i = 0; i < NUM_ADC_PINS; i++) {
+        if (!filters[i].valid()) return;    // Nothing to show yet
+        if (!filters[i].settled()) r.settled = false;
+        r.tap_mv[i] = tap_mv(i, filters[i].value_q());
+    }
+
+    LipoCells c = lipo_cells_from_taps(r.tap_mv, NUM_ADC_PINS);
+    r.cells = c.count;
+    for (uint8_t i = 0; i < c.count; i++) r.cell_mv[i] = c.cell_mv[i];
+    r.total_mv = c.total_mv;
+    r.implausible = c.implausible;
+    last_cells = r.settled ? r.cells : 0;
+
+    readings.push(r);   // GUI not draining: drop, the next reading replaces it
+}
+
+// =============================================================================
+// IR Measurement (IO task)
+// =============================================================================
+
+static void ir_finish(bool ok) {
+    hw_load_set(false);
+    ir_phase = IR_IDLE;
+
+    LipoIrResult res = {};
+    if (ok) {
+        LipoTrace t = {};
+        t.taps = NUM_ADC_PINS;
+        t.samples = IR_TRACE_LEN;
+        for (uint8_t i = 0; i < NUM_ADC_PINS; i++) {
+            t.tap_mv[i] = ir_trace[i];
+            if (ir_count[i] < t.samples) t.samples = ir_count[i];
+        }
+        t.period_us = IR_BLOCK_US;
+        t.load_on = ir_load_on;
+        t.load_off = t.samples;
+        t.load_milliohm = LIPO_LOAD_MILLIOHM;
+        res = lipo_estimate_ir(t);
+    }
+
+    if (res.valid) {
+        LOG_I("LIPO", "IR %uS at %u mA, confidence %u%%, %u outliers", res.cells, res.current_ma,
+              res.confidence_permille / 10, res.rejected);
+    } else {
+        LOG_W("LIPO", "IR measurement failed");
+    }
+    ir_results.push(res);
+    ir_busy.store(false);
+}
+
+// Block of one tap completed; first_us: time of its first sample
+static void ir_record(uint8_t tap, uint32_t first_us) {
+    if (ir_phase == IR_ARM) {
+        if (tap != 0) return;
+        for (auto& c : ir_count) c = 0;
+        ir_phase = IR_PRE;
+    }
+    if (ir_count[tap] >= IR_TRACE_LEN) return;
+
+    if (tap == 0 && ir_phase == IR_LOAD && !ir_load_on &&
+        static_cast<int32_t>(first_us - ir_switch_us) >= 0) {
+        ir_load_on = ir_count[0];
+    }
+    ir_trace[tap][ir_count[tap]++] = tap_mv(tap, filters[tap].block_q());
+}
+
+static void ir_step() {
+    if (ir_phase == IR_IDLE) {
+        if (!ir_requested.exchange(false)) return;
+        if (!last_cells) {
+            ir_results.push(LipoIrResult{});
+            ir_busy.store(false);
+            return;
+        }
+        ir_load_on = 0;
+        ir_started_us = app_time_us();
+        ir_phase = IR_ARM;
+        return;
+    }
+
+    if (app_time_us() - ir_started_us > IR_TIMEOUT_US) {
+        ir_finish(false);       // ADC stalled: never leave the load on
+        return;
+    }
+
+    if (ir_phase == IR_PRE && ir_count[0] >= IR_PRE_BLOCKS) {
+        hw_load_set(true);
+        ir_switch_us = app_time_us();
+        ir_phase = IR_LOAD;
+    } else if (ir_phase == IR_LOAD && ir_load_on &&
+               (ir_count[0] >= ir_load_on + IR_LOAD_BLOCKS || ir_count[0] >= IR_TRACE_LEN)) {
+        ir_finish(true);
+    }
+}
+
+void lipo_monitor_service() {
+    bool want = requested.load();
+    if (want != active) {
+        if (want) {
+            if (!start_sampling()) return;  // ADC busy (other owner): retry next pass
+        } else {
+            if (ir_phase != IR_IDLE) ir_finish(false);
+            adc_dma_stop();
+        }
+        active = want;
+    }
+    if (!active) return;
+
+    const uint32_t t0 = adc_dma_start_time_us();
+    const uint32_t rate = adc_dma_rate_hz();
+    const uint32_t block_span = TapFilter::BLOCK * NUM_ADC_PINS;
+
+    AdcSample chunk[READ_CHUNK];
+    uint32_t seq;
+    size_t n;
+    while ((n = adc_dma_read(chunk, READ_CHUNK, &seq)) > 0) {
+        for (size_t i = 0; i < n; i++, seq++) {
+            const uint8_t tap = chunk[i].input;
+            if (!filters[tap].push(chunk[i].raw) || ir_phase == IR_IDLE) continue;
+            uint32_t first = seq + 1 - block_span;
+            ir_record(tap, t0 + static_cast<uint32_t>(static_cast<uint64_t>(first) * 1000000u / rate));
+        }
+    }
+    ir_step();
+
+    uint32_t now = app_time_us();
+    if (now - last_publish_us < LIPO_PUBLISH_MS * 1000) return;
+    last_publish_us = now;
+    publish();
+}
+
+// =============================================================================
+// Public API
+// =============================================================================
+
+void lipo_monitor_start() {
+    requested.store(true);
+}
+
+void lipo_monitor_stop() {
+    requested.store(false);
+    ir_requested.store(false);
+    ir_busy.store(false);
+}
+
+bool lipo_monitor_poll(LipoReading& out) {
+    bool got = false;
+    while (readings.pop(out)) got = true;   // Latest only
+    return got;
+}
+
+void lipo_monitor_measure_ir() {
+    if (ir_busy.exchange(true)) return;
+    ir_requested.store(true);
+}
+
+bool lipo_monitor_ir_running() {
+    return ir_busy.load();
+}
+
+bool lipo_monitor_poll_ir(LipoIrResult& out) {
+    return ir_results.pop(out);
+}
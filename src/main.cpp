@@ -8,8 +8,17 @@
 #include "gui/gui.h"
 #include "gui/input.h"
 #include "gui/serial_log.h"
+#include "gui/display_flush.h"
+#include "gui/app_tasks.h"
+#include "gui/config/settings.h"
 #include "servo_driver.h"
 #include "nfc_pn532.h"
+#include "servo_capture.h"
+#include "servo_test.h"
+#include "lipo_monitor.h"
+#include "hx711.h"
+#include "imu.h"
+#include "i2c_bus.h"
 
 // TFT instance (configured via build_flags in platformio.ini)
 TFT_eSPI tft = TFT_eSPI();
@@ -18,17 +27,39 @@ TFT_eSPI tft = TFT_eSPI();
 Adafruit_NeoPixel pixel(NEOPIXEL_COUNT, NEOPIXEL_PIN, NEO_GRB + NEO_KHZ800);
 
 // LVGL draw buffers - larger buffer = fewer SPI transactions = smoother rendering
-// Double buffering: LVGL renders to buf2 while buf1 is being transmitted via SPI
+// Double buffering: LVGL renders to buf2 while buf1 is being transmitted via SPI DMA
 // 40 lines = good balance between memory usage and performance
+// Must stay in internal RAM (DMA capable) - do not move to PSRAM
 static lv_color_t buf1[SCREEN_WIDTH * 40];
 static lv_color_t buf2[SCREEN_WIDTH * 40];
 static lv_display_t *display;
 static lv_indev_t *touch_indev;
 
+// Upper bound for the GUI task sleep (LV_NO_TIMER_READY when no timer is armed)
+static constexpr uint32_t LOOP_MAX_IDLE_MS = 50;
+
+// Longest single blocking wait of the IO task service loop
+// (bounds the latency of draining the signal analyzer edge queues)
+static constexpr uint32_t IO_SERVICE_SLICE_MS = 50;
+
 // Forward declarations
-void my_disp_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
+static void gui_task_main(void *arg);
+static void io_task_main(void *arg);
+static uint32_t lvgl_tick_get();
 void my_touch_read(lv_indev_t *drv, lv_indev_data_t *data);
 
+// --- Display transports (see gui/display_flush.h) ---
+// DMA: start the transfer and return, completion is polled via dmaBusy()
+// (TFT_eSPI has no transfer-done callback; display_flush sleeps between polls)
+static void tft_dma_start(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map, uint32_t px_count);
+static bool tft_dma_is_done();
+static void tft_dma_finish();
+// Blocking fallback if DMA init fails
+static void tft_blocking_start(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map, uint32_t px_count);
+
+static const DisplayTransport TFT_DMA_TRANSPORT = { tft_dma_start, tft_dma_is_done, tft_dma_finish };
+static const DisplayTransport TFT_BLOCKING_TRANSPORT = { tft_blocking_start, nullptr, nullptr };
+
 void setup()
 {
     Serial.begin(115200);
@@ -36,9 +67,57 @@ void setup()
     Serial.println("\n\n*** BOOT ***");
     Serial.flush();
 
+    // Task layout (see gui/app_tasks.h): GUI on core 1, drivers on core 0
+    app_tasks_init();
+
+    // Log task first so boot messages reach the UART as early as possible
+    app_task_create("log", serial_log_task_main, nullptr, LOG_TASK_STACK, LOG_TASK_PRIORITY, LOG_TASK_CORE);
+
     delay(100);
     log_println("=== RC TOOLBOX BOOT ===");
 
+    // RT task owns the servo PWM hardware; commands are queued until it is up
+    log_println("[0] Starting servo RT task...");
+    if (!app_task_create("servo_rt", servo_task_main, nullptr, RT_TASK_STACK, RT_TASK_PRIORITY, RT_TASK_CORE)) {
+        log_println("[0] ERROR: servo RT task not started");
+    }
+
+    // I2C bus task owns the bus; drivers queue their transfers (started before any driver)
+    if (!app_task_create("i2c", i2c_bus_task_main, nullptr, I2C_TASK_STACK, I2C_TASK_PRIORITY, I2C_TASK_CORE)) {
+        log_println("[0] ERROR: I2C bus task not started");
+    }
+
+    // Scale task sleeps (modules powered down) until the CG scale page starts it
+    if (!app_task_create("scale", hx711_task_main, nullptr, SCALE_TASK_STACK, SCALE_TASK_PRIORITY, SCALE_TASK_CORE)) {
+        log_println("[0] ERROR: scale task not started");
+    }
+
+    // IMU task sleeps (sensor asleep) until the deflection or angle page starts it
+    if (!app_task_create("imu", imu_task_main, nullptr, IMU_TASK_STACK, IMU_TASK_PRIORITY, IMU_TASK_CORE)) {
+        log_println("[0] ERROR: IMU task not started");
+    }
+
+    // Settings task writes the settings block once changes have settled (never from the GUI task)
+    if (!app_task_create("store", settings_task_main, nullptr, STORE_TASK_STACK, STORE_TASK_PRIORITY, STORE_TASK_CORE)) {
+        log_println("[0] ERROR: settings task not started");
+    }
+
+    if (!app_task_create("gui", gui_task_main, nullptr, GUI_TASK_STACK, GUI_TASK_PRIORITY, GUI_TASK_CORE)) {
+        log_println("[0] ERROR: GUI task not started");
+    }
+}
+
+void loop()
+{
+    // All work happens in the tasks started by setup()
+    vTaskDelete(nullptr);
+}
+
+// --- GUI Task (core 1): the only task driving LVGL, display and input ---
+static void gui_task_main(void *arg)
+{
+    (void)arg;
+
     // Initialize TFT
     log_println("[1] Starting TFT...");
     tft.init();
@@ -58,10 +137,22 @@ void setup()
     log_println("[2] Starting LVGL...");
     lv_init();
 
+    // LVGL clock comes straight from millis() (esp_timer) - it cannot drift
+    // no matter how long a loop pass takes
+    lv_tick_set_cb(lvgl_tick_get);
+
     // Create display (LVGL 9.x API)
     display = lv_display_create(SCREEN_WIDTH, SCREEN_HEIGHT);
-    lv_display_set_flush_cb(display, my_disp_flush);
     lv_display_set_buffers(display, buf1, buf2, sizeof(buf1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    // Asynchronous flush: LVGL renders the next band while DMA sends the previous one
+    if (tft.initDMA()) {
+        display_flush_init(display, &TFT_DMA_TRANSPORT);
+        log_println("[2] Display flush: SPI DMA");
+    } else {
+        display_flush_init(display, &TFT_BLOCKING_TRANSPORT);
+        log_println("[2] Display flush: blocking (DMA init failed)");
+    }
     lv_display_set_default(display);
 
     // Set refresh period to 20ms (default is 33ms) for smoother updates
@@ -81,12 +172,11 @@ void setup()
     log_println("[3] Starting GUI...");
     gui_init();
 
-    // Initialize servo PWM driver
-    log_println("[4] Initializing servo driver...");
-    servo_driver_init();
-
-    // Initialize NFC (PN532)
-    nfc_pn532_init();
+    // Drivers on core 0: I/O task owns NFC (started once the log page exists)
+    log_println("[4] Starting I/O task...");
+    if (!app_task_create("io", io_task_main, nullptr, IO_TASK_STACK, IO_TASK_PRIORITY, IO_TASK_CORE)) {
+        log_println("[4] ERROR: I/O task not started");
+    }
 
     // NeoPixel ready indicator (solid green)
     pixel.begin();
@@ -94,35 +184,90 @@ void setup()
     pixel.setPixelColor(0, pixel.Color(0, 255, 0));  // Green
     pixel.show();
 
-    log_println("[4] Servo driver complete - RC TOOLBOX ready!");
+    log_println("[4] Tasks started - RC TOOLBOX ready!");
+
+    for (;;) {
+        uint32_t idle_ms;
+        {
+            LvglLock lock;
+            input_poll();       // Poll encoder hardware
+            nfc_pn532_poll();   // Tag events from the I/O task
+
+            // Run due LVGL timers; returns ms until the next one is due
+            idle_ms = lv_timer_handler();
+        }
+        if (idle_ms > LOOP_MAX_IDLE_MS) idle_ms = LOOP_MAX_IDLE_MS;
+
+        // Sleep until the next timer is due (CPU idles instead of fixed 5 ms polling).
+        // Encoder interrupts notify this task to wake early (see input_hw.cpp).
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(idle_ms));
+    }
 }
 
-void loop()
+// --- I/O Task (core 0): NFC, signal analyzer capture, servo test, LiPo taps, other slow peripherals later ---
+static void io_task_main(void *arg)
+{
+    (void)arg;
+
+    // Initialize NFC (PN532) - talks to it through the I2C bus task
+    nfc_pn532_init();
+
+    for (;;) {
+        nfc_pn532_service(IO_SERVICE_SLICE_MS);
+        capture_service();
+        servo_test_service();
+        lipo_monitor_service();
+    }
+}
+
+// --- LVGL Tick Source ---
+static uint32_t lvgl_tick_get()
 {
-    lv_tick_inc(5);
-    lv_timer_handler();
-    input_poll();  // Poll encoder hardware
-    nfc_pn532_poll();
-    delay(5);
+    return millis();
 }
 
-// --- LVGL Display Flush Callback ---
-void my_disp_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+// --- Display Transports ---
+static void tft_dma_start(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map, uint32_t px_count)
 {
-    uint32_t w = area->x2 - area->x1 + 1;
-    uint32_t h = area->y2 - area->y1 + 1;
+    LV_UNUSED(disp);
+
+    // Panel expects big-endian RGB565; swap in place (LVGL discards the buffer after flush)
+    lv_draw_sw_rgb565_swap(px_map, px_count);
+
+    // Transaction stays open until tft_dma_finish() - the bus is ours while DMA runs
+    tft.startWrite();
+    tft.setAddrWindow(area->x1, area->y1, lv_area_get_width(area), lv_area_get_height(area));
+    tft.pushPixelsDMA((uint16_t *)px_map, px_count);
+}
+
+static bool tft_dma_is_done()
+{
+    return !tft.dmaBusy();
+}
+
+static void tft_dma_finish()
+{
+    tft.endWrite();
+}
+
+static void tft_blocking_start(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map, uint32_t px_count)
+{
+    LV_UNUSED(disp);
 
     tft.startWrite();
-    tft.setAddrWindow(area->x1, area->y1, w, h);
-    tft.pushColors((uint16_t *)px_map, w * h, true);
+    tft.setAddrWindow(area->x1, area->y1, lv_area_get_width(area), lv_area_get_height(area));
+    tft.pushColors((uint16_t *)px_map, px_count, true);
     tft.endWrite();
 
-    lv_display_flush_ready(disp);
+    display_flush_complete();
 }
 
 // --- LVGL Touch Input Callback ---
 void my_touch_read(lv_indev_t *drv, lv_indev_data_t *data)
 {
+    // XPT2046 shares the SPI bus with the display - let a running DMA transfer finish first
+    display_flush_wait();
+
     uint16_t x, y;
     bool touched = tft.getTouch(&x, &y);
 
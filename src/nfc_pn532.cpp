@@ -1,89 +1,137 @@
-// nfc_pn532.cpp - NFC driver using Adafruit PN532 library
+// nfc_pn532.cpp - NFC driver for the PN532 (I2C + IRQ line)
 // Hardware: Elechouse PN532 V3 @ I2C address 0x24
 // Connections: SDA=GPIO47, SCL=GPIO39, IRQ=GPIO41, RST=GPIO40
+//
+// Every exchange is split into queued I2C bus transfers (include/i2c_bus.h):
+// write the command, read the ACK, read the response. The PN532 signals each
+// frame on its IRQ line; the waits in between sleep on that line without
+// holding the bus, so IMU reads are never queued behind a PN532 command.
+// Frame format: src/pn532_frame.h.
 
 #include "nfc_pn532.h"
 
 #if defined(ESP_PLATFORM) || defined(ARDUINO)
 
-#include <Wire.h>
-#include <Adafruit_PN532.h>
+#include <Arduino.h>
 #include "pins.h"
+#include "i2c_bus.h"
+#include "spsc_queue.h"
+#include "nfc_tag_tracker.h"
+#include "pn532_frame.h"
+#include "gui/app_tasks.h"
 #include "gui/serial_log.h"
 
-#ifndef PN532_SWAP_I2C
-#define PN532_SWAP_I2C 0
-#endif
-
 // ============================================================================
-// Debug Flags - Set to 1 to enable specific debug features
+// NFC Service - runs in the IO task, blocks on the PN532 IRQ line instead of polling
 // ============================================================================
-#define I2C_DEBUG 1     // Enable I2C bus scanner at startup
+// InListPassiveTarget is armed once and the PN532 searches on its own; IRQ goes
+// low when a tag answered. While a tag is present the search is re-armed
+// periodically; if no answer arrives within NFC_REMOVAL_TIMEOUT_MS the tag is
+// reported removed.
 
-// Create PN532 instance with I2C (IRQ and RESET pins)
-Adafruit_PN532 nfc(PIN_PN532_IRQ, PIN_PN532_RST);
+static constexpr uint32_t NFC_RECHECK_MS         = 150;   // Re-arm interval while a tag is present
+static constexpr uint32_t NFC_REMOVAL_TIMEOUT_MS = 300;   // No answer within this = tag removed
 
-// ============================================================================
-// I2C Scanner - Scans all addresses to find connected devices
-// ============================================================================
-#if I2C_DEBUG
-void i2c_scan(int sda_pin, int scl_pin) {
-  log_println("[I2C] Scanning I2C bus...");
-  serial_printf("[I2C] SDA=GPIO%d, SCL=GPIO%d\n", sda_pin, scl_pin);
-
-  int devices_found = 0;
-  for (uint8_t addr = 1; addr < 127; addr++) {
-    Wire.beginTransmission(addr);
-    uint8_t error = Wire.endTransmission();
-
-    if (error == 0) {
-      // Device found
-      devices_found++;
-      const char* device_name = "";
-
-      // Known device identification
-      if (addr == 0x24) {
-        device_name = " <- PN532 (Elechouse V3)";
-      } else if (addr == 0x28) {
-        device_name = " <- PN532 (HW-147C/alternate)";
-      } else if (addr == 0x48) {
-        device_name = " <- PN532 (alternate address)";
-      }
-
-      serial_printf("[I2C] Found device at 0x%02X%s\n", addr, device_name);
-    } else if (error == 4) {
-      serial_printf("[I2C] Unknown error at 0x%02X\n", addr);
-    }
-  }
+static constexpr uint32_t PN532_ACK_TIMEOUT_MS      = 50;
+static constexpr uint32_t PN532_RESPONSE_TIMEOUT_MS = 100;
+static constexpr uint8_t PN532_STATUS_READY = 0x01;       // I2C status byte: frame ready
+static constexpr uint8_t PN532_RESPONSE_MAX = 48;         // Longest response read (10 byte UID + short ATS)
+static constexpr I2cPriority PN532_PRIO = I2C_PRIO_LOW;
 
-  if (devices_found == 0) {
-    log_println("[I2C] ERROR: No devices found on I2C bus!");
-    log_println("[I2C] Check: SDA/SCL wiring, pull-up resistors, power");
-  } else {
-    serial_printf("[I2C] Scan complete: %d device(s) found\n", devices_found);
-  }
-}
-#endif
+// Event passed from the IO task to the GUI thread
+struct NfcEventMsg {
+  NfcTagEvent type;
+  uint8_t uid_len;
+  uint8_t uid[NFC_UID_MAX_LEN];
+};
 
 namespace {
   bool nfc_ready = false;
-  uint8_t last_uid[10] = {0};
-  uint8_t last_uid_len = 0;
-  bool tag_present = false;  // Track if tag is currently present
+  I2cDevice pn532_dev = I2C_NO_DEVICE;
+  TaskHandle_t nfc_task = nullptr;            // Task running nfc_pn532_service()
+  NfcTagTracker tracker;                      // Owned by the IO task
+  SpscQueue<NfcEventMsg, 8> nfc_events;       // IO task -> GUI thread
+  volatile uint32_t nfc_events_dropped = 0;
 
-  bool uid_equals_last(const uint8_t *uid, uint8_t uid_len) {
-    if (uid_len != last_uid_len) return false;
-    for (uint8_t i = 0; i < uid_len; i++) {
-      if (uid[i] != last_uid[i]) return false;
+  bool search_armed = false;
+  uint32_t armed_at = 0;                      // millis() when the search was armed
+  uint32_t rearm_at = 0;                      // millis() before which we don't re-arm
+
+  void IRAM_ATTR pn532_irq_isr() {
+    if (!nfc_task) return;
+    BaseType_t higher_prio_woken = pdFALSE;
+    xTaskNotifyFromISR(nfc_task, NOTIFY_WAKE, eSetBits, &higher_prio_woken);
+    if (higher_prio_woken) portYIELD_FROM_ISR();
+  }
+
+  void publish(NfcTagEvent type) {
+    if (type == NfcTagEvent::NONE) return;
+
+    NfcEventMsg msg = {};
+    msg.type = type;
+    msg.uid_len = tracker.uid_len();
+    memcpy(msg.uid, tracker.uid(), NFC_UID_MAX_LEN);
+    if (!nfc_events.push(msg)) nfc_events_dropped++;
+  }
+
+  // Wait up to timeout_ms for IRQ low (PN532 has a frame ready)
+  bool wait_irq(uint32_t timeout_ms) {
+    uint32_t start = millis();
+    while (digitalRead(PIN_PN532_IRQ) != LOW) {
+      uint32_t elapsed = millis() - start;
+      if (elapsed >= timeout_ms) return false;
+      app_notify_wait(NOTIFY_WAKE, timeout_ms - elapsed);   // I2C completions use their own bit
     }
     return true;
   }
 
-  void store_last_uid(const uint8_t *uid, uint8_t uid_len) {
-    last_uid_len = uid_len;
-    for (size_t i = 0; i < sizeof(last_uid); i++) {
-      last_uid[i] = (i < uid_len) ? uid[i] : 0;
-    }
+  // Read status byte + frame (call once IRQ is low); false if the PN532 was not ready
+  bool read_frame(uint8_t* buf, uint8_t len) {
+    return i2c_bus_transfer(pn532_dev, PN532_PRIO, nullptr, 0, buf, len) &&
+           (buf[0] & PN532_STATUS_READY);
+  }
+
+  // Write a command and read its ACK
+  bool send_command(uint8_t cmd, const uint8_t* params, uint8_t n) {
+    uint8_t frame[PN532_COMMAND_OVERHEAD + 8];
+    if (n > sizeof(frame) - PN532_COMMAND_OVERHEAD) return false;
+    size_t len = pn532_build_command(frame, cmd, params, n);
+    if (!i2c_bus_transfer(pn532_dev, PN532_PRIO, frame, static_cast<uint8_t>(len), nullptr, 0)) return false;
+
+    uint8_t ack[1 + PN532_ACK_LEN];
+    if (!wait_irq(PN532_ACK_TIMEOUT_MS) || !read_frame(ack, sizeof(ack))) return false;
+    // Reading the ACK released IRQ - drop its wakeup so the next wait sleeps
+    ulTaskNotifyValueClear(nullptr, NOTIFY_WAKE);
+    return pn532_is_ack(ack + 1, PN532_ACK_LEN);
+  }
+
+  // Read the response to cmd into buf; returns the payload length, -1 on error
+  int read_response(uint8_t cmd, uint8_t* buf, const uint8_t** data) {
+    if (!read_frame(buf, 1 + PN532_RESPONSE_MAX)) return -1;
+    return pn532_parse_response(buf + 1, PN532_RESPONSE_MAX, cmd, data);
+  }
+
+  // Command, ACK and response; the bus is free while the PN532 works
+  int exchange(uint8_t cmd, const uint8_t* params, uint8_t n, uint8_t* buf, const uint8_t** data) {
+    if (!send_command(cmd, params, n) || !wait_irq(PN532_RESPONSE_TIMEOUT_MS)) return -1;
+    return read_response(cmd, buf, data);
+  }
+
+  // Start a passive target search; returns false if the PN532 did not ACK
+  bool arm_detection() {
+    static const uint8_t params[] = { 1, 0x00 };    // One target, 106 kbps type A
+    if (!send_command(PN532_CMD_IN_LIST_PASSIVE_TARGET, params, sizeof(params))) return false;
+    search_armed = true;
+    armed_at = millis();
+    return true;
+  }
+
+  // Read the target found by the armed search (IRQ low); returns the UID length, 0 on error
+  uint8_t read_detected_uid(uint8_t* uid) {
+    uint8_t buf[1 + PN532_RESPONSE_MAX];
+    const uint8_t* data;
+    int n = read_response(PN532_CMD_IN_LIST_PASSIVE_TARGET, buf, &data);
+    return n < 0 ? 0 : pn532_target_uid(data, n, uid, NFC_UID_MAX_LEN);
   }
 
   void print_uid(const uint8_t *uid, uint8_t uid_len) {
@@ -100,82 +148,113 @@ namespace {
 }
 
 void nfc_pn532_init() {
-  log_println("[NFC] Initializing Adafruit PN532 library...");
-
-  // Initialize I2C
-  const int pn532_sda = PN532_SWAP_I2C ? PIN_I2C_SCL : PIN_I2C_SDA;
-  const int pn532_scl = PN532_SWAP_I2C ? PIN_I2C_SDA : PIN_I2C_SCL;
-  pinMode(pn532_sda, INPUT_PULLUP);
-  pinMode(pn532_scl, INPUT_PULLUP);
-  Wire.begin(pn532_sda, pn532_scl);
-  Wire.setClock(100000);
-
-#if I2C_DEBUG
-  // Scan I2C bus to verify PN532 is visible
-  i2c_scan(pn532_sda, pn532_scl);
-#endif
+  log_println("[NFC] Initializing PN532...");
 
-  // Initialize PN532
-  nfc.begin();
+  // The bus task started Wire; the PN532 stays at standard mode
+  pn532_dev = i2c_bus_add_device("PN532", PN532_I2C_ADDR, I2C_CLOCK_STANDARD);
+
+  // IRQ wakes this (IO) task for every frame the PN532 has ready, from the first command on
+  tracker.reset();
+  search_armed = false;
+  nfc_task = xTaskGetCurrentTaskHandle();
+  pinMode(PIN_PN532_IRQ, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(PIN_PN532_IRQ), pn532_irq_isr, FALLING);
+
+  // Hardware reset
+  pinMode(PIN_PN532_RST, OUTPUT);
+  digitalWrite(PIN_PN532_RST, LOW);
+  vTaskDelay(pdMS_TO_TICKS(400));
+  digitalWrite(PIN_PN532_RST, HIGH);
+  vTaskDelay(pdMS_TO_TICKS(10));
 
   // Check firmware version
-  uint32_t versiondata = nfc.getFirmwareVersion();
-  if (!versiondata) {
+  uint8_t buf[1 + PN532_RESPONSE_MAX];
+  const uint8_t* data;
+  if (exchange(PN532_CMD_GET_FIRMWARE_VERSION, nullptr, 0, buf, &data) < 4) {
     log_println("[NFC] ERROR: No PN532 found - check wiring!");
     nfc_ready = false;
     return;
   }
 
-  // Print version info
+  // Print version info (IC, version, revision, supported protocols)
   char version_msg[64];
   snprintf(version_msg, sizeof(version_msg),
-           "[NFC] Found PN5%02X, Firmware v%d.%d",
-           (versiondata >> 24) & 0xFF,
-           (versiondata >> 16) & 0xFF,
-           (versiondata >> 8) & 0xFF);
+           "[NFC] Found PN5%02X, Firmware v%d.%d", data[0], data[1], data[2]);
   log_println(version_msg);
 
-  // Configure board to read RFID tags
-  nfc.SAMConfig();
+  // Configure board to read RFID tags: normal mode, 1 s virtual card timeout, use IRQ
+  static const uint8_t sam_params[] = { 0x01, 0x14, 0x01 };
+  if (exchange(PN532_CMD_SAM_CONFIGURATION, sam_params, sizeof(sam_params), buf, &data) < 0) {
+    log_println("[NFC] ERROR: SAMConfiguration failed");
+    nfc_ready = false;
+    return;
+  }
 
   log_println("[NFC] Ready - waiting for ISO14443A tags...");
   nfc_ready = true;
 }
 
-void nfc_pn532_poll() {
-  if (!nfc_ready) return;
+void nfc_pn532_service(uint32_t max_wait_ms) {
+  if (!nfc_ready) {
+    vTaskDelay(pdMS_TO_TICKS(max_wait_ms));
+    return;
+  }
 
-  // Poll every 250ms
-  static uint32_t last_poll = 0;
   uint32_t now = millis();
-  if (now - last_poll < 250) return;
-  last_poll = now;
-
-  // Try to read a tag
-  uint8_t uid[7];
-  uint8_t uidLength;
-
-  // Use passive mode with 100ms timeout
-  if (nfc.readPassiveTargetID(PN532_MIFARE_ISO14443A, uid, &uidLength, 100)) {
-    // Tag detected
-    if (!tag_present) {
-      // Tag just appeared (was absent, now present)
-      print_uid(uid, uidLength);
-      store_last_uid(uid, uidLength);
-      tag_present = true;
-    } else if (!uid_equals_last(uid, uidLength)) {
-      // Different tag detected while previous was present
-      print_uid(uid, uidLength);
-      store_last_uid(uid, uidLength);
+  if (!search_armed) {
+    // Tag just read - give it a moment before asking again
+    if ((int32_t)(rearm_at - now) > 0) {
+      uint32_t wait_ms = rearm_at - now;
+      vTaskDelay(pdMS_TO_TICKS(wait_ms < max_wait_ms ? wait_ms : max_wait_ms));
+      return;
     }
-    // Same tag still present - don't spam
-  } else {
-    // No tag detected
-    if (tag_present) {
+    if (!arm_detection()) {
+      vTaskDelay(pdMS_TO_TICKS(max_wait_ms));
+      return;
+    }
+  }
+
+  // No tag: sleep the full slice. Tag present: never past the removal deadline.
+  uint32_t wait_ms = max_wait_ms;
+  if (tracker.tag_present()) {
+    uint32_t elapsed = millis() - armed_at;
+    uint32_t left = (elapsed < NFC_REMOVAL_TIMEOUT_MS) ? NFC_REMOVAL_TIMEOUT_MS - elapsed : 0;
+    if (left < wait_ms) wait_ms = left;
+  }
+
+  uint8_t uid[NFC_UID_MAX_LEN];
+  uint8_t uid_len = 0;
+  if (wait_irq(wait_ms)) {
+    search_armed = false;
+    rearm_at = millis() + NFC_RECHECK_MS;
+    uid_len = read_detected_uid(uid);
+    if (uid_len) publish(tracker.on_tag(uid, uid_len));
+  } else if (tracker.tag_present() && millis() - armed_at >= NFC_REMOVAL_TIMEOUT_MS) {
+    // Search still pending - the next command aborts it
+    search_armed = false;
+    publish(tracker.on_no_tag());
+  }
+}
+
+void nfc_pn532_poll() {
+  if (!nfc_ready) return;
+
+  // Drain events from the IO task: tag events drive GUI state, so the GUI
+  // thread is the one consumer of this SPSC queue
+  NfcEventMsg msg;
+  while (nfc_events.pop(msg)) {
+    if (msg.type == NfcTagEvent::ARRIVED) {
+      print_uid(msg.uid, msg.uid_len);
+    } else {
       log_println("[NFC] Tag removed");
-      tag_present = false;
     }
   }
+
+  static uint32_t reported_dropped = 0;
+  if (nfc_events_dropped != reported_dropped) {
+    reported_dropped = nfc_events_dropped;
+    LOG_W("NFC", "%lu events dropped (GUI not draining)", (unsigned long)reported_dropped);
+  }
 }
 
 #endif
@@ -1,12 +1,19 @@
-// nfc_pn532.h - NFC driver interface using Adafruit PN532 library
+// nfc_pn532.h - NFC driver interface (PN532 on the shared I2C bus)
 #pragma once
 
 #if defined(ESP_PLATFORM) || defined(ARDUINO)
 
-// Initialize NFC reader
+#include <stdint.h>
+
+// Initialize NFC reader (IO task - the calling task owns the PN532 from now on)
 void nfc_pn532_init();
 
-// Poll for NFC tags (call periodically)
+// Run tag detection for up to max_wait_ms (IO task loop).
+// Sleeps on the PN532 IRQ line; posts tag arrived/removed events for the GUI.
+void nfc_pn532_service(uint32_t max_wait_ms);
+
+// Handle tag arrived/removed events from the IO task (call periodically from the GUI task).
+// Never blocks - the PN532 is only accessed by the IO task.
 void nfc_pn532_poll();
 
 #endif
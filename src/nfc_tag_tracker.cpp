@@ -0,0 +1,47 @@
+// src/nfc_tag_tracker.cpp - NFC tag presence state machine
+
+#include "nfc_tag_tracker.h"
+
+NfcTagEvent NfcTagTracker::on_tag(const uint8_t* uid, uint8_t uid_len) {
+    if (uid_len > NFC_UID_MAX_LEN) uid_len = NFC_UID_MAX_LEN;
+
+    if (!present_) {
+        // Tag just appeared (was absent, now present)
+        store_uid(uid, uid_len);
+        present_ = true;
+        return NfcTagEvent::ARRIVED;
+    }
+    if (!uid_equals_last(uid, uid_len)) {
+        // Different tag detected while previous was present
+        store_uid(uid, uid_len);
+        return NfcTagEvent::ARRIVED;
+    }
+    // Same tag still present - don't spam
+    return NfcTagEvent::NONE;
+}
+
+NfcTagEvent NfcTagTracker::on_no_tag() {
+    if (!present_) return NfcTagEvent::NONE;
+    present_ = false;
+    return NfcTagEvent::REMOVED;
+}
+
+void NfcTagTracker::reset() {
+    present_ = false;
+    store_uid(nullptr, 0);
+}
+
+bool NfcTagTracker::uid_equals_last(const uint8_t* uid, uint8_t uid_len) const {
+    if (uid_len != uid_len_) return false;
+    for (uint8_t i = 0; i < uid_len; i++) {
+        if (uid[i] != uid_[i]) return false;
+    }
+    return true;
+}
+
+void NfcTagTracker::store_uid(const uint8_t* uid, uint8_t uid_len) {
+    uid_len_ = uid_len;
+    for (uint8_t i = 0; i < NFC_UID_MAX_LEN; i++) {
+        uid_[i] = (i < uid_len) ? uid[i] : 0;
+    }
+}
@@ -0,0 +1,39 @@
+// src/nfc_tag_tracker.h - NFC tag presence state machine
+// Turns raw "tag seen" / "no tag" reader results into arrival/removal events.
+// Hardware-independent: the PN532 task feeds it, a fake reader can drive it on the host.
+
+#pragma once
+
+#include <cstdint>
+
+constexpr uint8_t NFC_UID_MAX_LEN = 10;   // ISO14443A triple-size UID
+
+enum class NfcTagEvent : uint8_t {
+    NONE,       // No change (same tag still present, or still no tag)
+    ARRIVED,    // New tag in the field (first tag, or a different UID replaced the last one)
+    REMOVED     // Previously present tag has left the field
+};
+
+class NfcTagTracker {
+public:
+    // Reader returned a tag with this UID
+    NfcTagEvent on_tag(const uint8_t* uid, uint8_t uid_len);
+
+    // Reader found no tag (detection timed out)
+    NfcTagEvent on_no_tag();
+
+    // Forget the current tag without generating an event
+    void reset();
+
+    bool tag_present() const { return present_; }
+    const uint8_t* uid() const { return uid_; }
+    uint8_t uid_len() const { return uid_len_; }
+
+private:
+    bool uid_equals_last(const uint8_t* uid, uint8_t uid_len) const;
+    void store_uid(const uint8_t* uid, uint8_t uid_len);
+
+    bool present_ = false;
+    uint8_t uid_[NFC_UID_MAX_LEN] = {0};
+    uint8_t uid_len_ = 0;
+};
@@ -0,0 +1,69 @@
+// src/pn532_frame.cpp - PN532 host interface frames
+
+#include "pn532_frame.h"
+
+static constexpr uint8_t TFI_HOST = 0xD4;       // Host -> PN532
+static constexpr uint8_t TFI_PN532 = 0xD5;      // PN532 -> host
+
+size_t pn532_build_command(uint8_t* out, uint8_t cmd, const uint8_t* params, uint8_t n) {
+    const uint8_t len = n + 2;                  // TFI + CMD + params
+    size_t p = 0;
+    out[p++] = 0x00;                            // Preamble
+    out[p++] = 0x00;                            // Start code
+    out[p++] = 0xFF;
+    out[p++] = len;
+    out[p++] = static_cast<uint8_t>(-len);
+    out[p++] = TFI_HOST;
+    out[p++] = cmd;
+    uint8_t sum = TFI_HOST + cmd;
+    for (uint8_t i = 0; i < n; i++) {
+        out[p++] = params[i];
+        sum += params[i];
+    }
+    out[p++] = static_cast<uint8_t>(-sum);
+    out[p++] = 0x00;                            // Postamble
+    return p;
+}
+
+// Index of LEN after the 00 FF start code (the preamble may be longer than one byte)
+static int find_start(const uint8_t* buf, size_t len) {
+    for (size_t i = 0; i + 1 < len; i++) {
+        if (buf[i] == 0x00 && buf[i + 1] == 0xFF) return static_cast<int>(i + 2);
+        if (buf[i] != 0x00) return -1;
+    }
+    return -1;
+}
+
+bool pn532_is_ack(const uint8_t* buf, size_t len) {
+    int p = find_start(buf, len);
+    return p >= 0 && static_cast<size_t>(p) + 2 <= len && buf[p] == 0x00 && buf[p + 1] == 0xFF;
+}
+
+int pn532_parse_response(const uint8_t* buf, size_t len, uint8_t cmd, const uint8_t** data) {
+    int p = find_start(buf, len);
+    if (p < 0 || static_cast<size_t>(p) + 2 > len) return -1;
+
+    const uint8_t flen = buf[p];
+    if (static_cast<uint8_t>(flen + buf[p + 1]) != 0) return -1;
+    if (flen < 2) return -1;                    // ACK (00 FF), error frame (01 FF 7F ...)
+    const size_t body = static_cast<size_t>(p) + 2;
+    if (body + flen + 1 > len) return -1;       // Truncated: body + DCS
+
+    uint8_t sum = 0;
+    for (size_t i = body; i <= body + flen; i++) sum += buf[i];
+    if (sum != 0) return -1;
+    if (buf[body] != TFI_PN532) return -1;
+    if (buf[body + 1] != static_cast<uint8_t>(cmd + 1)) return -1;
+
+    *data = buf + body + 2;
+    return flen - 2;
+}
+
+uint8_t pn532_target_uid(const uint8_t* data, int len, uint8_t* uid, uint8_t max_len) {
+    // NbTg, Tg, SENS_RES (2), SEL_RES, NFCIDLength, NFCID1 ...
+    if (len < 6 || data[0] < 1) return 0;
+    const uint8_t uid_len = data[5];
+    if (uid_len == 0 || uid_len > max_len || len < 6 + uid_len) return 0;
+    for (uint8_t i = 0; i < uid_len; i++) uid[i] = data[6 + i];
+    return uid_len;
+}
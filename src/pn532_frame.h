@@ -0,0 +1,48 @@
+// src/pn532_frame.h - PN532 host interface frames (normal information frames)
+// Builds command frames and checks the ACK and response frames read back.
+// Hardware-independent: the PN532 driver moves the bytes through the I2C bus
+// manager, the host test feeds recorded frames.
+//
+//   Command:  00 00 FF LEN LCS D4 CMD params... DCS 00
+//   ACK:      00 00 FF 00 FF 00
+//   Response: 00 00 FF LEN LCS D5 CMD+1 data... DCS 00
+//
+// LEN counts TFI (D4/D5) to the last data byte; LEN + LCS and TFI + ... + DCS
+// are 0 (mod 256). Over I2C every read starts with a status byte (bit 0 =
+// frame ready) that is not part of the frame - the driver strips it.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr uint8_t PN532_I2C_ADDR = 0x24;
+
+constexpr uint8_t PN532_CMD_GET_FIRMWARE_VERSION   = 0x02;
+constexpr uint8_t PN532_CMD_SAM_CONFIGURATION      = 0x14;
+constexpr uint8_t PN532_CMD_IN_LIST_PASSIVE_TARGET = 0x4A;
+
+constexpr uint8_t PN532_COMMAND_OVERHEAD = 9;   // Frame bytes besides the params
+constexpr uint8_t PN532_ACK_LEN = 6;
+
+// Build a command frame (out: n + PN532_COMMAND_OVERHEAD bytes); returns its length
+size_t pn532_build_command(uint8_t* out, uint8_t cmd, const uint8_t* params, uint8_t n);
+
+// True if buf starts with an ACK frame
+bool pn532_is_ack(const uint8_t* buf, size_t len);
+
+/**
+ * Check a response frame and locate its payload
+ * @param cmd  Command the frame must answer
+ * @param data Set to the first payload byte (after D5 CMD+1)
+ * @return Payload length, -1 if the frame is truncated, corrupt, an ACK or
+ *         error frame, or answers another command
+ */
+int pn532_parse_response(const uint8_t* buf, size_t len, uint8_t cmd, const uint8_t** data);
+
+/**
+ * UID of the first target in an InListPassiveTarget (106 kbps type A) payload
+ * @param uid Room for max_len bytes
+ * @return UID length, 0 if no target or the UID does not fit
+ */
+uint8_t pn532_target_uid(const uint8_t* data, int len, uint8_t* uid, uint8_t max_len);
@@ -0,0 +1,503 @@
+// src/servo_capture.cpp - Servo signal capture (MCPWM capture on ESP32)
+//
+// Data path:  edge ISR -> per-channel edge queue -> IO task (PulseStats)
+//             -> report queue -> GUI (page_analyzer)
+// Both queues are single-producer/single-consumer, so nothing takes a lock.
+// The ISR does no arithmetic: the timestamp was already latched by the
+// capture hardware on the edge itself, so interrupt latency adds no jitter.
+//
+// Capture channels map 1:1 to the servo header: servo N = MCPWM unit N / 3,
+// capture channel N % 3.
+//
+// Bus modes: PPM reuses the capture channel of CAPTURE_BUS_CHANNEL; SBUS/iBUS
+// read UART1. The decoders (include/rc_decoders.h) consume the bytes of each
+// UART read chunk in place and keep no frame buffer of their own.
+
+#include "servo_capture.h"
+#include "servo_driver.h"
+#include "spsc_queue.h"
+#include "gui/serial_log.h"
+#include <atomic>
+
+// 400 Hz frames with both edges = 800 edges/s: 128 entries cover 160 ms of
+// IO task stall (its longest wait is IO_SERVICE_SLICE_MS in src/main.cpp)
+static constexpr size_t CAPTURE_EDGE_QUEUE_LEN = 128;
+static constexpr size_t CAPTURE_REPORT_QUEUE_LEN = 32;
+static constexpr size_t BUS_REPORT_QUEUE_LEN = 4;
+static constexpr size_t BUS_READ_CHUNK = 64;
+
+// Capture timestamp clock (APB)
+static constexpr uint32_t CAPTURE_CLK_HZ = 80000000;
+
+struct CaptureEdge {
+    uint32_t ticks;
+    bool rising;
+};
+
+struct CaptureChannel {
+    SpscQueue<CaptureEdge, CAPTURE_EDGE_QUEUE_LEN> edges;   // ISR -> IO task
+    PulseStats stats{CAPTURE_CLK_HZ};                        // IO task only
+};
+
+static CaptureChannel channels[NUM_SERVO_PINS];
+static SpscQueue<CaptureReport, CAPTURE_REPORT_QUEUE_LEN> reports;   // IO task -> GUI
+static SpscQueue<BusReport, BUS_REPORT_QUEUE_LEN> bus_reports;        // IO task -> GUI
+
+// Bus decoders (IO task only)
+static PpmDecoder ppm{CAPTURE_CLK_HZ};
+static SbusDecoder sbus;
+static IbusDecoder ibus;
+
+// Requests from the GUI, applied by the IO task
+static std::atomic<uint8_t> requested_mask{0};
+static std::atomic<uint8_t> requested_mode{CAPTURE_MODE_PWM};
+static std::atomic<bool> reset_requested{false};
+
+// IO task state
+static uint8_t active_mask = 0;
+static CaptureMode active_mode = CAPTURE_MODE_PWM;
+static bool uart_active = false;
+static uint32_t last_report_ms = 0;
+static uint32_t last_report_frames = 0;
+
+static volatile uint32_t edges_dropped = 0;
+
+// =============================================================================
+// Hardware Layer (IO task only, except the ISR)
+// =============================================================================
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+
+#include <Arduino.h>
+#include <driver/gpio.h>
+#include <driver/mcpwm.h>
+#include <driver/uart.h>
+
+static constexpr int CAPTURE_CHANNELS_PER_UNIT = 3;
+
+static constexpr uart_port_t BUS_UART = UART_NUM_1;
+static constexpr int BUS_UART_RX_BUF = 1024;    // ~200 ms of SBUS/iBUS frames
+
+static mcpwm_unit_t capture_unit(uint8_t idx) {
+    return static_cast<mcpwm_unit_t>(idx / CAPTURE_CHANNELS_PER_UNIT);
+}
+
+static mcpwm_capture_channel_id_t capture_channel(uint8_t idx) {
+    return static_cast<mcpwm_capture_channel_id_t>(MCPWM_SELECT_CAP0 + idx % CAPTURE_CHANNELS_PER_UNIT);
+}
+
+// Called by the MCPWM driver ISR on every edge
+static bool IRAM_ATTR capture_isr(mcpwm_unit_t unit, mcpwm_capture_channel_id_t cap_channel,
+                                  const cap_event_data_t* edata, void* user_data) {
+    (void)unit;
+    (void)cap_channel;
+    CaptureChannel* ch = static_cast<CaptureChannel*>(user_data);
+    CaptureEdge edge = { edata->cap_value, edata->cap_edge == MCPWM_POS_EDGE };
+    if (!ch->edges.push(edge)) edges_dropped++;
+    return false;   // No task to wake: the IO task polls
+}
+
+static void hw_start(uint8_t idx) {
+    const gpio_num_t pin = static_cast<gpio_num_t>(PIN_SERVO[idx]);
+    const mcpwm_io_signals_t signal =
+        static_cast<mcpwm_io_signals_t>(MCPWM_CAP_0 + idx % CAPTURE_CHANNELS_PER_UNIT);
+
+    mcpwm_gpio_init(capture_unit(idx), signal, pin);
+    gpio_pulldown_en(pin);      // Unplugged input reads "no signal", not noise
+
+    mcpwm_capture_config_t conf = {};
+    conf.cap_edge = MCPWM_BOTH_EDGE;
+    conf.cap_prescale = 1;
+    conf.capture_cb = capture_isr;
+    conf.user_data = &channels[idx];
+    if (mcpwm_capture_enable_channel(capture_unit(idx), capture_channel(idx), &conf) != ESP_OK) {
+        LOG_E("CAP", "Capture on GPIO%d failed", PIN_SERVO[idx]);
+    }
+}
+
+static void hw_stop(uint8_t idx) {
+    mcpwm_capture_disable_channel(capture_unit(idx), capture_channel(idx));
+    gpio_pulldown_dis(static_cast<gpio_num_t>(PIN_SERVO[idx]));
+}
+
+static void hw_uart_start(CaptureMode mode) {
+    const bool is_sbus = (mode == CAPTURE_MODE_SBUS);
+
+    uart_config_t conf = {};
+    conf.baud_rate = is_sbus ? SbusDecoder::BAUD : IbusDecoder::BAUD;
+    conf.data_bits = UART_DATA_8_BITS;
+    conf.parity = is_sbus ? UART_PARITY_EVEN : UART_PARITY_DISABLE;
+    conf.stop_bits = is_sbus ? UART_STOP_BITS_2 : UART_STOP_BITS_1;
+    conf.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+    conf.source_clk = UART_SCLK_APB;
+
+    if (uart_driver_install(BUS_UART, BUS_UART_RX_BUF, 0, 0, nullptr, 0) != ESP_OK) {
+        LOG_E("CAP", "UART%d install failed", (int)BUS_UART);
+        return;
+    }
+    uart_param_config(BUS_UART, &conf);
+    uart_set_pin(BUS_UART, UART_PIN_NO_CHANGE, PIN_SERVO[CAPTURE_BUS_CHANNEL],
+                 UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+    // SBUS idles low (inverted UART), the UART inverts it back in hardware
+    uart_set_line_inverse(BUS_UART, is_sbus ? UART_SIGNAL_RXD_INV : UART_SIGNAL_INV_DISABLE);
+}
+
+static void hw_uart_stop() {
+    uart_driver_delete(BUS_UART);
+}
+
+// Non-blocking: whatever the UART driver has buffered, up to len bytes
+static size_t hw_uart_read(uint8_t* buf, size_t len) {
+    int n = uart_read_bytes(BUS_UART, buf, len, 0);
+    return n > 0 ? static_cast<size_t>(n) : 0;
+}
+
+static void hw_generate() {}
+
+static uint32_t hw_now_ms() {
+    return millis();
+}
+
+#else
+// Simulator: synthetic receiver signals instead of capture hardware.
+// Edges are generated for the time elapsed since the last service call and
+// pushed through the same queue the ISR uses.
+
+#include <chrono>
+
+struct SimSignal {
+    uint32_t period_us;     // 0 = no signal on this channel
+    uint32_t width_us;
+    uint32_t jitter_ns;     // Peak width/period noise
+};
+
+static const SimSignal SIM_SIGNALS[NUM_SERVO_PINS] = {
+    { 3003,  760, 50 },     // 333 Hz narrow pulse (tail rotor gyro)
+    { 20000, 1500, 200 },   // 50 Hz analog servo
+};
+
+// Bus modes: 8 channel PPM at 22.5 ms, SBUS at 14 ms, iBUS at 7 ms.
+// Every SIM_BAD_FRAME_EVERY-th serial frame is corrupted to exercise the statistics.
+static constexpr uint8_t SIM_PPM_CHANNELS = 8;
+static constexpr uint32_t SIM_PPM_FRAME_US = 22500;
+static constexpr uint32_t SIM_PPM_SEPARATOR_US = 300;
+static constexpr uint32_t SIM_SBUS_FRAME_US = 14000;
+static constexpr uint32_t SIM_IBUS_FRAME_US = 7000;
+static constexpr uint32_t SIM_BAD_FRAME_EVERY = 50;
+
+static uint64_t sim_next_rise[NUM_SERVO_PINS] = {0};
+static uint64_t sim_next_frame = 0;
+static uint32_t sim_frame_count = 0;
+static uint32_t sim_rng = 12345;
+
+static uint64_t sim_now_ticks() {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return static_cast<uint64_t>(ns) * (CAPTURE_CLK_HZ / 1000000) / 1000;
+}
+
+// Signed noise in [-peak_ns, peak_ns], as capture ticks
+static int32_t sim_noise_ticks(uint32_t peak_ns) {
+    if (peak_ns == 0) return 0;
+    sim_rng = sim_rng * 1103515245u + 12345u;
+    int32_t ns = static_cast<int32_t>((sim_rng >> 8) % (2 * peak_ns + 1)) - static_cast<int32_t>(peak_ns);
+    return ns * static_cast<int32_t>(CAPTURE_CLK_HZ / 1000000) / 1000;
+}
+
+// Receiver channel values: each channel sweeps 1000 .. 2000 µs with its own offset
+static uint16_t sim_channel_us(uint8_t ch, uint64_t ticks) {
+    uint32_t ms = static_cast<uint32_t>(ticks / (CAPTURE_CLK_HZ / 1000));
+    return static_cast<uint16_t>(1000 + (ms / 4 + ch * 62) % 1000);
+}
+
+static void hw_start(uint8_t idx) {
+    sim_next_rise[idx] = sim_now_ticks();
+}
+
+static void hw_stop(uint8_t) {}
+
+static void hw_uart_start(CaptureMode) {
+    sim_next_frame = sim_now_ticks();
+    sim_frame_count = 0;
+}
+
+static void hw_uart_stop() {}
+
+// Encode the frames due since the last call, as many as fit into buf
+static size_t hw_uart_read(uint8_t* buf, size_t len) {
+    const uint64_t now = sim_now_ticks();
+    const uint32_t ticks_per_us = CAPTURE_CLK_HZ / 1000000;
+    const bool is_sbus = (active_mode == CAPTURE_MODE_SBUS);
+    const size_t frame_len = is_sbus ? SbusDecoder::FRAME_LEN : IbusDecoder::FRAME_LEN;
+    size_t used = 0;
+
+    while (sim_next_frame <= now && used + frame_len <= len) {
+        uint8_t* f = buf + used;
+        if (is_sbus) {
+            f[0] = SbusDecoder::HEADER;
+            uint32_t bits = 0;
+            int nbits = 0;
+            size_t pos = 1;
+            for (uint8_t ch = 0; ch < RC_MAX_CHANNELS; ch++) {
+                uint32_t raw = (static_cast<int32_t>(sim_channel_us(ch, sim_next_frame)) - 1500) * 8 / 5 + 992;
+                bits |= (raw & 0x7FF) << nbits;
+                nbits += 11;
+                while (nbits >= 8) {
+                    f[pos++] = bits & 0xFF;
+                    bits >>= 8;
+                    nbits -= 8;
+                }
+            }
+            f[23] = 0;
+            f[24] = 0;
+        } else {
+            f[0] = IbusDecoder::HEADER_LEN;
+            f[1] = IbusDecoder::HEADER_CMD;
+            for (uint8_t ch = 0; ch < IbusDecoder::WORDS; ch++) {
+                uint16_t us = sim_channel_us(ch, sim_next_frame);
+                f[2 + 2 * ch] = us & 0xFF;
+                f[3 + 2 * ch] = us >> 8;
+            }
+            uint16_t sum = 0;
+            for (size_t i = 0; i < frame_len - 2; i++) sum += f[i];
+            sum = 0xFFFF - sum;
+            f[frame_len - 2] = sum & 0xFF;
+            f[frame_len - 1] = sum >> 8;
+        }
+        if (++sim_frame_count % SIM_BAD_FRAME_EVERY == 0) f[frame_len - 1] ^= 0x5A;
+
+        used += frame_len;
+        sim_next_frame += (is_sbus ? SIM_SBUS_FRAME_US : SIM_IBUS_FRAME_US) * ticks_per_us;
+    }
+    return used;
+}
+
+// PPM: separator pulse, channel time from rising edge to rising edge, then the sync gap
+static void sim_generate_ppm(uint64_t now) {
+    const uint32_t ticks_per_us = CAPTURE_CLK_HZ / 1000000;
+    uint64_t& t = sim_next_rise[CAPTURE_BUS_CHANNEL];
+    auto& edges = channels[CAPTURE_BUS_CHANNEL].edges;
+
+    while (t + SIM_PPM_FRAME_US * ticks_per_us <= now) {
+        uint64_t edge = t;
+        for (uint8_t ch = 0; ch <= SIM_PPM_CHANNELS; ch++) {
+            CaptureEdge rise_edge = { static_cast<uint32_t>(edge), true };
+            CaptureEdge fall_edge = { static_cast<uint32_t>(edge + SIM_PPM_SEPARATOR_US * ticks_per_us), false };
+            if (!edges.push(rise_edge)) edges_dropped++;
+            if (!edges.push(fall_edge)) edges_dropped++;
+            if (ch < SIM_PPM_CHANNELS) edge += sim_channel_us(ch, t) * ticks_per_us;
+        }
+        t += SIM_PPM_FRAME_US * ticks_per_us;
+    }
+}
+
+static void hw_generate() {
+    const uint64_t now = sim_now_ticks();
+    const uint32_t ticks_per_us = CAPTURE_CLK_HZ / 1000000;
+
+    if (active_mode == CAPTURE_MODE_PPM) {
+        sim_generate_ppm(now);
+        return;
+    }
+    if (active_mode != CAPTURE_MODE_PWM) return;
+
+    for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+        const SimSignal& sig = SIM_SIGNALS[i];
+        if (!(active_mask & (1 << i)) || sig.period_us == 0) continue;
+
+        for (;;) {
+            uint64_t fall = sim_next_rise[i] + sig.width_us * ticks_per_us + sim_noise_ticks(sig.jitter_ns);
+            if (fall > now) break;
+            CaptureEdge rise_edge = { static_cast<uint32_t>(sim_next_rise[i]), true };
+            CaptureEdge fall_edge = { static_cast<uint32_t>(fall), false };
+            if (!channels[i].edges.push(rise_edge)) edges_dropped++;
+            if (!channels[i].edges.push(fall_edge)) edges_dropped++;
+            sim_next_rise[i] += sig.period_us * ticks_per_us + sim_noise_ticks(sig.jitter_ns);
+        }
+    }
+}
+
+static uint32_t hw_now_ms() {
+    return static_cast<uint32_t>(sim_now_ticks() / (CAPTURE_CLK_HZ / 1000));
+}
+
+#endif
+
+// =============================================================================
+// IO Task
+// =============================================================================
+
+static RcDecoder* bus_decoder(CaptureMode mode) {
+    switch (mode) {
+        case CAPTURE_MODE_PPM:  return &ppm;
+        case CAPTURE_MODE_SBUS: return &sbus;
+        case CAPTURE_MODE_IBUS: return &ibus;
+        default:                return nullptr;
+    }
+}
+
+static void apply_requests() {
+    CaptureMode mode = static_cast<CaptureMode>(requested_mode.load());
+    uint8_t want = requested_mask.load();
+    // Serial buses use the UART, not the capture channel
+    bool want_uart = want && (mode == CAPTURE_MODE_SBUS || mode == CAPTURE_MODE_IBUS);
+    if (want_uart) want = 0;
+
+    if (mode != active_mode) {
+        // Restart everything with the new decoder
+        for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+            if (active_mask & (1 << i)) hw_stop(i);
+        }
+        if (uart_active) hw_uart_stop();
+        active_mask = 0;
+        uart_active = false;
+        active_mode = mode;
+    }
+
+    if (want != active_mask) {
+        for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+            uint8_t bit = 1 << i;
+            if ((want & bit) && !(active_mask & bit)) {
+                CaptureEdge stale;
+                while (channels[i].edges.pop(stale)) {}
+                channels[i].stats.reset();
+                hw_start(i);
+            } else if (!(want & bit) && (active_mask & bit)) {
+                hw_stop(i);
+            }
+        }
+        active_mask = want;
+        if (mode == CAPTURE_MODE_PPM) ppm = PpmDecoder(CAPTURE_CLK_HZ);
+        last_report_ms = hw_now_ms();
+        last_report_frames = 0;
+    }
+
+    if (want_uart != uart_active) {
+        if (want_uart) {
+            sbus = SbusDecoder();
+            ibus = IbusDecoder();
+            hw_uart_start(mode);
+        } else {
+            hw_uart_stop();
+        }
+        uart_active = want_uart;
+        last_report_ms = hw_now_ms();
+        last_report_frames = 0;
+    }
+
+    if (reset_requested.exchange(false)) {
+        for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) channels[i].stats.reset();
+        if (RcDecoder* dec = bus_decoder(active_mode)) dec->reset_stats();
+        last_report_frames = 0;
+    }
+}
+
+// Feed the bus decoder of the active mode, straight from the edge queue / UART chunk
+static void service_bus() {
+    if (active_mode == CAPTURE_MODE_PPM) {
+        CaptureEdge edge;
+        while (channels[CAPTURE_BUS_CHANNEL].edges.pop(edge)) {
+            ppm.on_edge(edge.rising, edge.ticks);
+        }
+    } else if (uart_active) {
+        uint8_t chunk[BUS_READ_CHUNK];
+        size_t n;
+        while ((n = hw_uart_read(chunk, sizeof(chunk))) > 0) {
+            for (size_t i = 0; i < n; i++) {
+                if (active_mode == CAPTURE_MODE_SBUS) sbus.push(chunk[i]);
+                else ibus.push(chunk[i]);
+            }
+        }
+    }
+}
+
+static void report_bus(uint32_t elapsed_ms) {
+    const RcDecoder* dec = bus_decoder(active_mode);
+    if (!dec) return;
+
+    BusReport report;
+    report.mode = active_mode;
+    report.stats = dec->stats();
+    report.frame = dec->frame();
+
+    uint32_t frames = report.stats.frames - last_report_frames;
+    last_report_frames = report.stats.frames;
+    report.signal = frames > 0;
+    report.frame_rate_mhz = elapsed_ms ? static_cast<uint32_t>(frames * 1000000ULL / elapsed_ms) : 0;
+
+    bus_reports.push(report);   // GUI not draining: drop, the next window replaces it
+}
+
+void capture_service() {
+    apply_requests();
+    if (!active_mask && !uart_active) return;
+
+    hw_generate();
+
+    if (active_mode == CAPTURE_MODE_PWM) {
+        for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+            if (!(active_mask & (1 << i))) continue;
+            CaptureEdge edge;
+            while (channels[i].edges.pop(edge)) {
+                channels[i].stats.on_edge(edge.rising, edge.ticks);
+            }
+        }
+    } else {
+        service_bus();
+    }
+
+    uint32_t now = hw_now_ms();
+    uint32_t elapsed = now - last_report_ms;
+    if (elapsed < CAPTURE_REPORT_MS) return;
+    last_report_ms = now;
+
+    if (active_mode != CAPTURE_MODE_PWM) {
+        report_bus(elapsed);
+        return;
+    }
+
+    for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+        if (!(active_mask & (1 << i))) continue;
+        CaptureReport report = { i, channels[i].stats.take_report() };
+        reports.push(report);   // GUI not draining: drop, the next window replaces it
+    }
+}
+
+// =============================================================================
+// Public API
+// =============================================================================
+
+void capture_start(uint8_t mask) {
+    mask &= (1 << NUM_SERVO_PINS) - 1;
+    servo_release_pins(mask, true);
+    requested_mode.store(CAPTURE_MODE_PWM);
+    requested_mask.store(mask);
+}
+
+void capture_start_bus(CaptureMode mode) {
+    if (mode == CAPTURE_MODE_PWM || mode >= CAPTURE_MODE_COUNT) return;
+    uint8_t mask = 1 << CAPTURE_BUS_CHANNEL;
+    servo_release_pins(mask, true);
+    requested_mode.store(mode);
+    requested_mask.store(mask);
+}
+
+void capture_stop() {
+    uint8_t mask = requested_mask.exchange(0);
+    if (mask) servo_release_pins(mask, false);
+}
+
+void capture_reset_minmax() {
+    reset_requested.store(true);
+}
+
+bool capture_poll(CaptureReport& out) {
+    return reports.pop(out);
+}
+
+bool capture_poll_bus(BusReport& out) {
+    return bus_reports.pop(out);
+}
+
+uint32_t capture_get_dropped() {
+    return edges_dropped;
+}
@@ -1,137 +1,916 @@
-// src/servo_driver.cpp - ESP32 LEDC-based servo PWM driver
+// src/servo_driver.cpp - ESP32 LEDC/RMT servo PWM driver
+//
+// The LEDC/RMT hardware belongs to the RT task (see gui/app_tasks.h). The public
+// servo_* API may be called from any task: it validates the request, updates
+// the cached state returned by the getters and posts a ServoMsg that
+// servo_task_main() applies to the hardware.
+//
+// Output modes per channel:
+//   LEDC (default)     - duty counter, 14 bit: 1.22 µs/count at 50 Hz, 0.18 µs at 333 Hz
+//   RMT (high-res)     - 10 MHz symbol clock: 0.1 µs pulse steps and an exact frame
+//                        period at any rate; limited to the 4 RMT TX channels
+//
+// Trajectories (sweep profiles, include/servo_trajectory.h) are advanced once per
+// PWM frame from the LEDC timer overflow interrupt, so sweeps stay smooth no
+// matter how busy the GUI is.
 
 #include "servo_driver.h"
 #include "pins.h"
+#include "gui/app_tasks.h"
 
+// Max time a caller waits for room in the servo queue before dropping a command
+static constexpr uint32_t SERVO_MSG_TIMEOUT_MS = 10;
+
+static constexpr uint32_t NS_PER_US = 1000;
+
+// Requested state (written by API callers, read by the getters)
+static uint32_t servo_pulse_ns[NUM_SERVO_PINS] = {0};
+static uint16_t servo_freq_hz[NUM_SERVO_PINS] = {0};
+static bool servo_hires[NUM_SERVO_PINS] = {false};
+static bool servo_traj[NUM_SERVO_PINS] = {false};
+static volatile uint32_t servo_msgs_dropped = 0;
+
+// Trajectory engine (RT task configures, frame tick advances)
+static ServoTrajectory traj_cfg[NUM_SERVO_PINS] = {};
+static ServoTrajState traj_state[NUM_SERVO_PINS] = {};
+static volatile uint8_t traj_mask = 0;                        // Servos following a trajectory
+static volatile uint32_t traj_pulse_ns[NUM_SERVO_PINS] = {0}; // Latest trajectory position
+
+// When the last committed pulse reached the output (app_time_us clock)
+static volatile uint32_t commit_latch_us[NUM_SERVO_PINS] = {0};
+
+// =============================================================================
+// Hardware Layer (RT task only)
+// =============================================================================
 #if defined(ESP_PLATFORM) || defined(ARDUINO)
 
 #include <Arduino.h>
 #include <driver/ledc.h>
+#include <driver/rmt.h>
+#include <hal/ledc_ll.h>
+#include <hal/rmt_ll.h>
+#include <soc/ledc_struct.h>
+#include <soc/rmt_struct.h>
+#include <esp_timer.h>
 
-// Track current pulse widths and enabled state
-static uint16_t servo_pulse_us[NUM_SERVO_PINS] = {0};
+// Track current pulse widths and enabled state as applied to the hardware
+static uint32_t hw_pulse_ns[NUM_SERVO_PINS] = {0};
 static bool servo_enabled[NUM_SERVO_PINS] = {false};
 
-// Convert microseconds to LEDC duty cycle value
-// At 50Hz with 14-bit resolution: 16384 counts = 20000µs
-// duty = pulse_us * 16384 / 20000
-static uint32_t pulse_to_duty(uint16_t pulse_us) {
-    constexpr uint32_t period_us = 1000000 / SERVO_PWM_FREQ_HZ; // 20000µs at 50Hz
-    constexpr uint32_t max_duty = (1 << SERVO_PWM_RESOLUTION) - 1; // 65535
-    return (static_cast<uint32_t>(pulse_us) * max_duty) / period_us;
+// LEDC timers are shared by all channels running at the same frame rate
+struct LedcTimerSlot {
+    uint16_t freq_hz;
+    uint8_t bits;       // Duty resolution for freq_hz
+    uint8_t users;      // Channels bound to this timer (0 = free)
+};
+static LedcTimerSlot ledc_timers[LEDC_TIMER_MAX] = {};
+static uint8_t channel_timer[NUM_SERVO_PINS] = {0};
+
+// Frame rate of a channel (LEDC timer also tracks it for RMT channels)
+static uint16_t channel_freq(uint8_t servo_idx) {
+    return ledc_timers[channel_timer[servo_idx]].freq_hz;
 }
 
-void servo_driver_init() {
+// Clamp a pulse so every frame keeps a low phase (matters at 333/400 Hz)
+static uint32_t clamp_to_frame(uint8_t servo_idx, uint32_t pulse_ns) {
+    const uint32_t period_ns = 1000000000UL / channel_freq(servo_idx);
+    const uint32_t max_ns = period_ns - SERVO_FRAME_GAP_MIN_US * NS_PER_US;
+    return (pulse_ns > max_ns) ? max_ns : pulse_ns;
+}
+
+// -----------------------------------------------------------------------------
+// LEDC output
+// -----------------------------------------------------------------------------
+
+// Convert nanoseconds to LEDC duty cycle value for the channel's timer
+// The counter wraps after 2^bits counts per period, so:
+// duty = pulse_ns * 2^bits / period_ns = pulse_ns * 2^bits * freq / 1e9 (rounded)
+static uint32_t pulse_to_duty(uint8_t servo_idx, uint32_t pulse_ns) {
+    const LedcTimerSlot& t = ledc_timers[channel_timer[servo_idx]];
+    const uint64_t counts = static_cast<uint64_t>(pulse_ns) * (1u << t.bits) * t.freq_hz;
+    return static_cast<uint32_t>((counts + 500000000ULL) / 1000000000ULL);
+}
+
+static void ledc_write_duty(uint8_t servo_idx, uint32_t duty) {
+    ledc_set_duty(LEDC_LOW_SPEED_MODE,
+                  static_cast<ledc_channel_t>(SERVO_LEDC_CHANNEL[servo_idx]),
+                  duty);
+    ledc_update_duty(LEDC_LOW_SPEED_MODE,
+                     static_cast<ledc_channel_t>(SERVO_LEDC_CHANNEL[servo_idx]));
+}
+
+// Route the pin to its LEDC channel (initially, or back from RMT)
+static void ledc_attach(uint8_t servo_idx) {
+    ledc_channel_config_t channel_conf = {
+        .gpio_num = PIN_SERVO[servo_idx],
+        .speed_mode = LEDC_LOW_SPEED_MODE,
+        .channel = static_cast<ledc_channel_t>(SERVO_LEDC_CHANNEL[servo_idx]),
+        .intr_type = LEDC_INTR_DISABLE,
+        .timer_sel = static_cast<ledc_timer_t>(channel_timer[servo_idx]),
+        .duty = 0,  // Start with output off
+        .hpoint = 0,
+        .flags = { .output_invert = 0 }
+    };
+    ledc_channel_config(&channel_conf);
+}
+
+static bool timer_configure(uint8_t timer_idx, uint16_t freq_hz) {
+    uint8_t bits = static_cast<uint8_t>(servo_duty_resolution(freq_hz));
+    ledc_timer_config_t timer_conf = {
+        .speed_mode = LEDC_LOW_SPEED_MODE,
+        .duty_resolution = static_cast<ledc_timer_bit_t>(bits),
+        .timer_num = static_cast<ledc_timer_t>(timer_idx),
+        .freq_hz = freq_hz,
+        .clk_cfg = LEDC_USE_APB_CLK
+    };
+    if (ledc_timer_config(&timer_conf) != ESP_OK) return false;
+
+    ledc_timers[timer_idx].freq_hz = freq_hz;
+    ledc_timers[timer_idx].bits = bits;
+    return true;
+}
+
+// Find the timer already running at freq_hz, or configure a free one. -1 if none left.
+static int timer_acquire(uint16_t freq_hz) {
+    for (uint8_t t = 0; t < LEDC_TIMER_MAX; t++) {
+        if (ledc_timers[t].users > 0 && ledc_timers[t].freq_hz == freq_hz) {
+            ledc_timers[t].users++;
+            return t;
+        }
+    }
+    for (uint8_t t = 0; t < LEDC_TIMER_MAX; t++) {
+        if (ledc_timers[t].users == 0 && timer_configure(t, freq_hz)) {
+            ledc_timers[t].users = 1;
+            return t;
+        }
+    }
+    return -1;
+}
+
+// -----------------------------------------------------------------------------
+// RMT output (high-resolution mode)
+// -----------------------------------------------------------------------------
+// The frame is a looped symbol list, so the period is exact (sum of durations).
+// Symbol 0 holds {pulse HIGH, anchor - pulse LOW}: a pulse change rewrites only
+// this one 32-bit word while the loop runs, so the frame length never changes
+// and there is no glitch. The rest of the frame is fixed LOW filler. The new
+// word goes out when the loop next reaches symbol 0: frames start at exact
+// multiples of the period after rmt_start_us, which locates that boundary.
+
+static constexpr uint8_t RMT_CLK_DIV = 8;                  // 80 MHz APB / 8 = 10 MHz
+static constexpr uint32_t RMT_TICK_NS = SERVO_HIRES_TICK_NS;
+static constexpr uint32_t RMT_MAX_DURATION = 32767;         // 15-bit symbol duration
+static constexpr uint32_t RMT_ANCHOR_TICKS = 30000;         // 3 ms: longest pulse + low time in symbol 0
+static constexpr int RMT_FRAME_SYMBOLS = 8;                  // 20 ms needs 4; fits one memory block
+
+static int8_t channel_rmt[NUM_SERVO_PINS] = {-1, -1, -1, -1, -1, -1};
+static bool rmt_in_use[SERVO_HIRES_MAX_CHANNELS] = {false};
+static bool rmt_running[SERVO_HIRES_MAX_CHANNELS] = {false};
+static int64_t rmt_start_us[SERVO_HIRES_MAX_CHANNELS] = {0};  // esp_timer time of the first frame
+
+static uint32_t frame_ticks(uint8_t servo_idx) {
+    return (1000000000UL / RMT_TICK_NS) / channel_freq(servo_idx);
+}
+
+static uint32_t anchor_ticks(uint8_t servo_idx) {
+    uint32_t period = frame_ticks(servo_idx);
+    return (period < RMT_ANCHOR_TICKS) ? period : RMT_ANCHOR_TICKS;
+}
+
+static rmt_item32_t rmt_pulse_symbol(uint8_t servo_idx, uint32_t pulse_ns) {
+    uint32_t anchor = anchor_ticks(servo_idx);
+    uint32_t high = (pulse_ns + RMT_TICK_NS / 2) / RMT_TICK_NS;
+    if (high < 1) high = 1;
+    if (high > anchor - 1) high = anchor - 1;
+
+    rmt_item32_t item = {};
+    item.level0 = 1;
+    item.duration0 = high;
+    item.level1 = 0;
+    item.duration1 = anchor - high;
+    return item;
+}
+
+// Build the full frame: pulse symbol + LOW filler. Returns symbol count.
+static int rmt_build_frame(uint8_t servo_idx, uint32_t pulse_ns, rmt_item32_t* items) {
+    items[0] = rmt_pulse_symbol(servo_idx, pulse_ns);
+    uint32_t filler = frame_ticks(servo_idx) - anchor_ticks(servo_idx);
+    if (filler == 0) return 1;
+
+    // Split filler into an even number of non-zero halves (two per symbol)
+    uint32_t halves = (filler + RMT_MAX_DURATION - 1) / RMT_MAX_DURATION;
+    if (halves & 1) halves++;
+    int n = 1;
+    for (uint32_t h = 0; h < halves; h += 2) {
+        uint32_t d0 = filler / halves + ((h < filler % halves) ? 1 : 0);
+        uint32_t d1 = filler / halves + ((h + 1 < filler % halves) ? 1 : 0);
+        items[n].level0 = 0;
+        items[n].duration0 = d0;
+        items[n].level1 = 0;
+        items[n].duration1 = d1;
+        n++;
+    }
+    return n;
+}
+
+static void rmt_stop_output(uint8_t servo_idx) {
+    int ch = channel_rmt[servo_idx];
+    if (ch < 0 || !rmt_running[ch]) return;
+    rmt_tx_stop(static_cast<rmt_channel_t>(ch));
+    rmt_running[ch] = false;
+}
+
+static void rmt_start_output(uint8_t servo_idx) {
+    int ch = channel_rmt[servo_idx];
+    rmt_item32_t items[RMT_FRAME_SYMBOLS];
+    int n = rmt_build_frame(servo_idx, clamp_to_frame(servo_idx, hw_pulse_ns[servo_idx]), items);
+
+    rmt_stop_output(servo_idx);
+    rmt_write_items(static_cast<rmt_channel_t>(ch), items, n, false);   // Loops until stopped
+    rmt_start_us[ch] = esp_timer_get_time();
+    rmt_running[ch] = true;
+}
+
+// Start of the first frame that reads symbol 0 after time t_us
+static uint32_t rmt_next_frame_us(uint8_t servo_idx, int64_t t_us) {
+    const int64_t start = rmt_start_us[channel_rmt[servo_idx]];
+    if (t_us <= start) return static_cast<uint32_t>(start);     // Output (re)started with it
+
+    const uint64_t period_ns = static_cast<uint64_t>(frame_ticks(servo_idx)) * RMT_TICK_NS;
+    const uint64_t frames = static_cast<uint64_t>(t_us - start) * 1000 / period_ns + 1;
+    return static_cast<uint32_t>(start + static_cast<int64_t>(frames * period_ns / 1000));
+}
+
+static bool rmt_attach(uint8_t servo_idx) {
+    int ch = -1;
+    for (int c = 0; c < SERVO_HIRES_MAX_CHANNELS; c++) {
+        if (!rmt_in_use[c]) { ch = c; break; }
+    }
+    if (ch < 0) return false;
+
+    rmt_config_t conf = {};
+    conf.rmt_mode = RMT_MODE_TX;
+    conf.channel = static_cast<rmt_channel_t>(ch);
+    conf.gpio_num = static_cast<gpio_num_t>(PIN_SERVO[servo_idx]);
+    conf.clk_div = RMT_CLK_DIV;
+    conf.mem_block_num = 1;
+    conf.tx_config.loop_en = true;
+    conf.tx_config.carrier_en = false;
+    conf.tx_config.idle_output_en = true;
+    conf.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+    if (rmt_config(&conf) != ESP_OK) return false;
+    if (rmt_driver_install(conf.channel, 0, 0) != ESP_OK) return false;
+
+    rmt_in_use[ch] = true;
+    channel_rmt[servo_idx] = static_cast<int8_t>(ch);
+    return true;
+}
+
+static void rmt_detach(uint8_t servo_idx) {
+    int ch = channel_rmt[servo_idx];
+    if (ch < 0) return;
+    rmt_stop_output(servo_idx);
+    rmt_driver_uninstall(static_cast<rmt_channel_t>(ch));
+    rmt_in_use[ch] = false;
+    channel_rmt[servo_idx] = -1;
+}
+
+// -----------------------------------------------------------------------------
+// Frame interrupt: synchronized frames (servo_commit) and trajectories
+// -----------------------------------------------------------------------------
+// The RT task stages duty values; the LEDC timer overflow interrupt writes them
+// right after a period boundary, so every staged channel on that timer latches
+// at the same next boundary. Low-speed LEDC applies a written duty only at the
+// following overflow, so the interrupt stamps the commit time there (first
+// pulse of the new width). The same interrupt advances running trajectories
+// by one frame. Overflow interrupts are only enabled while there is work.
+//
+// The interrupt is registered without ESP_INTR_FLAG_IRAM, so it and everything
+// it calls (trajectory math, ledc/rmt ll helpers) may live in flash. While flash
+// is written (settings save) it is held off: a staged commit latches one frame
+// later and a trajectory advances one frame late. Nothing here is IRAM_ATTR:
+// only a call tree that is IRAM-resident as a whole would make it safe to run
+// during flash writes, and the trajectory helpers are shared with the simulator.
+
+#if SOC_LEDC_SUPPORT_HS_MODE
+static constexpr uint32_t LS_TIMER_OVF_SHIFT = 4;   // ESP32: high-speed timer bits come first
+#else
+static constexpr uint32_t LS_TIMER_OVF_SHIFT = 0;   // ESP32-S3: low-speed timers are bits 0-3
+#endif
+static constexpr uint32_t LS_TIMER_OVF_ALL = 0x0Fu << LS_TIMER_OVF_SHIFT;
+
+static portMUX_TYPE stage_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t staged_duty[NUM_SERVO_PINS] = {0};
+static volatile uint8_t staged_mask = 0;      // Channels waiting for their timer's overflow
+static volatile uint8_t latch_mask = 0;       // Duty written, stamp at the next overflow
+static intr_handle_t ledc_isr_handle = nullptr;
+
+static inline uint32_t timer_ovf_bit(uint8_t timer_idx) {
+    return 1u << (LS_TIMER_OVF_SHIFT + timer_idx);
+}
+
+// Overflow bits for the timers of all staged or trajectory channels
+static uint32_t active_timer_bits() {
+    uint32_t bits = 0;
     for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
-        // Configure LEDC timer (timers 0-3 available, we use timer 0 for all)
-        ledc_timer_config_t timer_conf = {
-            .speed_mode = LEDC_LOW_SPEED_MODE,
-            .duty_resolution = static_cast<ledc_timer_bit_t>(SERVO_PWM_RESOLUTION),
-            .timer_num = LEDC_TIMER_0,
-            .freq_hz = SERVO_PWM_FREQ_HZ,
-            .clk_cfg = LEDC_AUTO_CLK
-        };
-        if (i == 0) { // Only configure timer once
-            ledc_timer_config(&timer_conf);
+        if ((staged_mask | latch_mask | traj_mask) & (1 << i)) bits |= timer_ovf_bit(channel_timer[i]);
+    }
+    return bits;
+}
+
+// Same register sequence as ledc_set_duty + ledc_update_duty, ISR-safe
+static void isr_write_duty(uint8_t servo_idx, uint32_t duty) {
+    ledc_channel_t ch = static_cast<ledc_channel_t>(SERVO_LEDC_CHANNEL[servo_idx]);
+    ledc_ll_set_duty_int_part(&LEDC, LEDC_LOW_SPEED_MODE, ch, duty);
+    ledc_ll_set_duty_start(&LEDC, LEDC_LOW_SPEED_MODE, ch, true);
+    ledc_ll_ls_channel_update(&LEDC, LEDC_LOW_SPEED_MODE, ch);
+}
+
+// One trajectory step for a channel whose timer just wrapped
+static void isr_traj_step(uint8_t servo_idx) {
+    uint32_t pulse_ns = traj_advance(traj_cfg[servo_idx], traj_state[servo_idx],
+                                     1000000UL / channel_freq(servo_idx));
+    traj_pulse_ns[servo_idx] = pulse_ns;
+    if (!servo_enabled[servo_idx]) return;
+
+    pulse_ns = clamp_to_frame(servo_idx, pulse_ns);
+    int ch = channel_rmt[servo_idx];
+    if (ch < 0) {
+        isr_write_duty(servo_idx, pulse_to_duty(servo_idx, pulse_ns));
+    } else if (rmt_running[ch]) {
+        // Rewrite the pulse symbol in RMT memory (what rmt_fill_tx_items does)
+        rmt_item32_t item = rmt_pulse_symbol(servo_idx, pulse_ns);
+        rmt_ll_write_memory(&RMTMEM, ch, &item, 1, 0);
+    }
+}
+
+static void servo_ledc_isr(void* arg) {
+    (void)arg;
+    uint32_t ovf = LEDC.int_st.val & LS_TIMER_OVF_ALL;
+    if (!ovf) return;
+    LEDC.int_clr.val = ovf;
+
+    portENTER_CRITICAL_ISR(&stage_lock);
+    for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+        if (!(ovf & timer_ovf_bit(channel_timer[i]))) continue;
+
+        // Duty written at the previous overflow starts its first pulse now
+        if (latch_mask & (1 << i)) {
+            latch_mask &= ~(1 << i);
+            commit_latch_us[i] = static_cast<uint32_t>(esp_timer_get_time());
         }
+        if (traj_mask & (1 << i)) {
+            isr_traj_step(i);
+        } else if (staged_mask & (1 << i)) {
+            isr_write_duty(i, staged_duty[i]);
+            staged_mask &= ~(1 << i);
+            latch_mask |= (1 << i);
+        }
+    }
+    // Leave overflow interrupts on only for timers that still have work
+    LEDC.int_ena.val = (LEDC.int_ena.val & ~LS_TIMER_OVF_ALL) | active_timer_bits();
+    portEXIT_CRITICAL_ISR(&stage_lock);
+}
 
-        // Configure LEDC channel
-        ledc_channel_config_t channel_conf = {
-            .gpio_num = PIN_SERVO[i],
-            .speed_mode = LEDC_LOW_SPEED_MODE,
-            .channel = static_cast<ledc_channel_t>(SERVO_LEDC_CHANNEL[i]),
-            .intr_type = LEDC_INTR_DISABLE,
-            .timer_sel = LEDC_TIMER_0,
-            .duty = 0,  // Start with output off
-            .hpoint = 0,
-            .flags = { .output_invert = 0 }
-        };
-        ledc_channel_config(&channel_conf);
-
-        servo_pulse_us[i] = SERVO_PULSE_CENTER_US;
-        servo_enabled[i] = false;
+// Drop a pending staged value (channel is about to be written directly, so a
+// written but not yet latched commit never reaches the output either)
+static void unstage(uint8_t servo_idx) {
+    portENTER_CRITICAL(&stage_lock);
+    staged_mask &= ~(1 << servo_idx);
+    latch_mask &= ~(1 << servo_idx);
+    portEXIT_CRITICAL(&stage_lock);
+}
+
+// -----------------------------------------------------------------------------
+// Channel operations
+// -----------------------------------------------------------------------------
+
+// Push the current pulse/enable state to whichever peripheral drives the pin
+static void hw_apply(uint8_t servo_idx) {
+    uint32_t pulse_ns = clamp_to_frame(servo_idx, hw_pulse_ns[servo_idx]);
+    int ch = channel_rmt[servo_idx];
+
+    if (ch >= 0) {
+        if (!servo_enabled[servo_idx]) {
+            rmt_stop_output(servo_idx);
+        } else if (!rmt_running[ch]) {
+            rmt_start_output(servo_idx);
+        } else {
+            // Running: swap only the pulse symbol (single word write, glitch-free)
+            rmt_item32_t item = rmt_pulse_symbol(servo_idx, pulse_ns);
+            rmt_fill_tx_items(static_cast<rmt_channel_t>(ch), &item, 1, 0);
+        }
+    } else {
+        // Start PWM with current pulse width, or stop output (duty = 0)
+        unstage(servo_idx);
+        ledc_write_duty(servo_idx, servo_enabled[servo_idx] ? pulse_to_duty(servo_idx, pulse_ns) : 0);
     }
 }
 
-void servo_set_pulse(uint8_t servo_idx, uint16_t pulse_us) {
-    if (servo_idx >= NUM_SERVO_PINS) return;
+void servo_driver_init() {
+    // All channels start on timer 0 at the default frame rate
+    timer_configure(0, SERVO_PWM_FREQ_HZ);
+    ledc_timers[0].users = NUM_SERVO_PINS;
 
-    // Clamp pulse width to valid range
-    if (pulse_us < SERVO_PULSE_MIN_US) pulse_us = SERVO_PULSE_MIN_US;
-    if (pulse_us > SERVO_PULSE_MAX_US) pulse_us = SERVO_PULSE_MAX_US;
+    for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+        channel_timer[i] = 0;
+        channel_rmt[i] = -1;
+        ledc_attach(i);
 
-    servo_pulse_us[servo_idx] = pulse_us;
+        hw_pulse_ns[i] = SERVO_PULSE_CENTER_US * NS_PER_US;
+        servo_enabled[i] = false;
+    }
+
+    // Timer overflow interrupt for synchronized frames (enabled on demand)
+    LEDC.int_ena.val &= ~LS_TIMER_OVF_ALL;
+    ledc_isr_register(servo_ledc_isr, nullptr, 0, &ledc_isr_handle);     // Not IRAM (see above)
+}
+
+static void hw_set_pulse(uint8_t servo_idx, uint32_t pulse_ns) {
+    hw_pulse_ns[servo_idx] = pulse_ns;
 
     // Only update hardware if servo is enabled
-    if (servo_enabled[servo_idx]) {
-        uint32_t duty = pulse_to_duty(pulse_us);
-        ledc_set_duty(LEDC_LOW_SPEED_MODE,
-                      static_cast<ledc_channel_t>(SERVO_LEDC_CHANNEL[servo_idx]),
-                      duty);
-        ledc_update_duty(LEDC_LOW_SPEED_MODE,
-                         static_cast<ledc_channel_t>(SERVO_LEDC_CHANNEL[servo_idx]));
+    if (servo_enabled[servo_idx]) hw_apply(servo_idx);
+}
+
+static void hw_enable(uint8_t servo_idx, bool enable) {
+    servo_enabled[servo_idx] = enable;
+    hw_apply(servo_idx);
+}
+
+static void hw_traj_start(uint8_t servo_idx, const ServoTrajectory& traj) {
+    ServoTrajState st;
+    traj_begin(traj, st, hw_pulse_ns[servo_idx], channel_freq(servo_idx));
+    uint32_t timer = timer_ovf_bit(channel_timer[servo_idx]);
+
+    portENTER_CRITICAL(&stage_lock);
+    traj_cfg[servo_idx] = traj;
+    traj_state[servo_idx] = st;
+    traj_pulse_ns[servo_idx] = traj_position_ns(traj, st);
+    staged_mask &= ~(1 << servo_idx);
+    traj_mask |= (1 << servo_idx);
+    if (!(LEDC.int_ena.val & timer)) LEDC.int_clr.val = timer;
+    LEDC.int_ena.val |= timer;
+    portEXIT_CRITICAL(&stage_lock);
+}
+
+static void hw_traj_stop(uint8_t servo_idx) {
+    if (!(traj_mask & (1 << servo_idx))) return;
+
+    portENTER_CRITICAL(&stage_lock);
+    traj_mask &= ~(1 << servo_idx);
+    portEXIT_CRITICAL(&stage_lock);
+
+    // Hold where the trajectory stopped (interrupt turns itself off when idle)
+    hw_pulse_ns[servo_idx] = traj_pulse_ns[servo_idx];
+}
+
+static void hw_traj_speed(uint8_t servo_idx, uint32_t speed_us_per_s) {
+    portENTER_CRITICAL(&stage_lock);
+    traj_cfg[servo_idx].speed_us_per_s = speed_us_per_s;
+    traj_state[servo_idx].phase_step = traj_phase_step(traj_cfg[servo_idx], channel_freq(servo_idx));
+    portEXIT_CRITICAL(&stage_lock);
+}
+
+// Trajectories are advanced by the frame interrupt - the RT task only waits for commands
+static uint32_t hw_wait_ms() { return MSG_WAIT_FOREVER; }
+static void hw_frame_tick() {}
+
+static void hw_set_frequency(uint8_t servo_idx, uint16_t freq_hz) {
+    uint8_t old_timer = channel_timer[servo_idx];
+    if (ledc_timers[old_timer].freq_hz == freq_hz) return;
+
+    // Pending frame values and trajectory steps were computed for the old timer
+    unstage(servo_idx);
+    bool tracking = traj_mask & (1 << servo_idx);
+    hw_traj_stop(servo_idx);
+
+    // Release first: a channel alone on its timer simply reconfigures that timer
+    ledc_timers[old_timer].users--;
+    int new_timer = timer_acquire(freq_hz);
+    if (new_timer < 0) {
+        ledc_timers[old_timer].users++;   // All timers busy with other rates - keep the old one
+        return;
     }
+
+    ledc_bind_channel_timer(LEDC_LOW_SPEED_MODE,
+                            static_cast<ledc_channel_t>(SERVO_LEDC_CHANNEL[servo_idx]),
+                            static_cast<ledc_timer_t>(new_timer));
+    channel_timer[servo_idx] = static_cast<uint8_t>(new_timer);
+
+    // Period and resolution changed - recompute duty / rebuild the RMT frame
+    if (channel_rmt[servo_idx] >= 0) rmt_stop_output(servo_idx);
+    hw_apply(servo_idx);
+    if (tracking) hw_traj_start(servo_idx, traj_cfg[servo_idx]);
 }
 
-void servo_set_pulse_mask(uint8_t mask, uint16_t pulse_us) {
+static void hw_commit(const ServoMsg& msg) {
+    uint32_t timers = 0;
+
+    portENTER_CRITICAL(&stage_lock);
     for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
-        if (mask & (1 << i)) {
-            servo_set_pulse(i, pulse_us);
+        if (!(msg.mask & (1 << i))) continue;
+        hw_pulse_ns[i] = msg.frame_ns[i];
+        if (!servo_enabled[i] || channel_rmt[i] >= 0) continue;
+
+        staged_duty[i] = pulse_to_duty(i, clamp_to_frame(i, msg.frame_ns[i]));
+        staged_mask |= (1 << i);
+        timers |= timer_ovf_bit(channel_timer[i]);
+    }
+    // Clear stale overflow flags so the first latch happens at the next real boundary
+    LEDC.int_clr.val = timers & ~LEDC.int_ena.val;
+    LEDC.int_ena.val |= timers;
+    portEXIT_CRITICAL(&stage_lock);
+
+    // High-resolution outputs run their own frame loop - update them directly
+    for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+        if ((msg.mask & (1 << i)) && servo_enabled[i] && channel_rmt[i] >= 0) {
+            const int64_t written_us = esp_timer_get_time();
+            hw_apply(i);
+            commit_latch_us[i] = rmt_next_frame_us(i, written_us);
         }
     }
 }
 
-void servo_enable(uint8_t servo_idx, bool enable) {
-    if (servo_idx >= NUM_SERVO_PINS) return;
+static void hw_release_pin(uint8_t servo_idx, bool release) {
+    if (release) {
+        hw_traj_stop(servo_idx);
+        hw_enable(servo_idx, false);
+        // Output driver off - the pin is an input for whoever claims it next
+        gpio_set_direction(static_cast<gpio_num_t>(PIN_SERVO[servo_idx]), GPIO_MODE_INPUT);
+    } else if (channel_rmt[servo_idx] >= 0) {
+        rmt_set_gpio(static_cast<rmt_channel_t>(channel_rmt[servo_idx]), RMT_MODE_TX,
+                     static_cast<gpio_num_t>(PIN_SERVO[servo_idx]), false);
+    } else {
+        ledc_attach(servo_idx);
+    }
+}
 
-    servo_enabled[servo_idx] = enable;
+static void hw_set_hires(uint8_t servo_idx, bool enable) {
+    bool active = channel_rmt[servo_idx] >= 0;
+    if (enable == active) return;
 
     if (enable) {
-        // Start PWM with current pulse width
-        uint32_t duty = pulse_to_duty(servo_pulse_us[servo_idx]);
-        ledc_set_duty(LEDC_LOW_SPEED_MODE,
-                      static_cast<ledc_channel_t>(SERVO_LEDC_CHANNEL[servo_idx]),
-                      duty);
-        ledc_update_duty(LEDC_LOW_SPEED_MODE,
-                         static_cast<ledc_channel_t>(SERVO_LEDC_CHANNEL[servo_idx]));
+        ledc_write_duty(servo_idx, 0);
+        if (!rmt_attach(servo_idx)) {
+            // No RMT channel left - stay on LEDC
+            hw_apply(servo_idx);
+            return;
+        }
     } else {
-        // Stop PWM output (duty = 0)
-        ledc_set_duty(LEDC_LOW_SPEED_MODE,
-                      static_cast<ledc_channel_t>(SERVO_LEDC_CHANNEL[servo_idx]),
-                      0);
-        ledc_update_duty(LEDC_LOW_SPEED_MODE,
-                         static_cast<ledc_channel_t>(SERVO_LEDC_CHANNEL[servo_idx]));
+        rmt_detach(servo_idx);
+        ledc_attach(servo_idx);
     }
+    hw_apply(servo_idx);
 }
 
-void servo_enable_mask(uint8_t mask, bool enable) {
+bool servo_hires_active(uint8_t servo_idx) {
+    if (servo_idx >= NUM_SERVO_PINS) return false;
+    return channel_rmt[servo_idx] >= 0;
+}
+
+uint32_t servo_sim_output_ns(uint8_t, uint32_t) { return 0; }
+
+#else
+// Stub hardware layer for simulator (queue and RT task still run).
+// There is no frame interrupt: the RT task steps trajectories at SIM_FRAME_HZ.
+// The output is modelled on a free-running frame grid per channel: a new width
+// starts with the next frame, like the LEDC latch on the hardware.
+
+#include <chrono>
+
+static constexpr uint16_t SIM_FRAME_HZ = 50;
+static constexpr std::chrono::microseconds SIM_FRAME_PERIOD(1000000 / SIM_FRAME_HZ);
+
+static volatile uint32_t hw_pulse_ns[NUM_SERVO_PINS] = {0};
+static std::chrono::steady_clock::time_point sim_next_frame;
+
+static uint16_t sim_freq_hz[NUM_SERVO_PINS] = {0};
+static volatile uint32_t sim_prev_ns[NUM_SERVO_PINS] = {0};    // Output before sim_change_us
+static volatile uint32_t sim_change_us[NUM_SERVO_PINS] = {0};  // First frame with hw_pulse_ns
+
+// Start of the channel's next frame after now
+static uint32_t sim_next_frame_us(uint8_t servo_idx, uint32_t now) {
+    const uint32_t period_us = 1000000UL / sim_freq_hz[servo_idx];
+    return (now / period_us + 1) * period_us;
+}
+
+// New output width from the next frame on; returns that frame's start
+static uint32_t sim_output(uint8_t servo_idx, uint32_t pulse_ns) {
+    const uint32_t now = app_time_us();
+    sim_prev_ns[servo_idx] = servo_sim_output_ns(servo_idx, now);
+    hw_pulse_ns[servo_idx] = pulse_ns;
+    sim_change_us[servo_idx] = sim_next_frame_us(servo_idx, now);
+    return sim_change_us[servo_idx];
+}
+
+void servo_driver_init() {
+    for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+        hw_pulse_ns[i] = SERVO_PULSE_CENTER_US * NS_PER_US;
+        sim_prev_ns[i] = hw_pulse_ns[i];
+        sim_freq_hz[i] = SERVO_PWM_FREQ_HZ;
+    }
+}
+static void hw_set_pulse(uint8_t servo_idx, uint32_t pulse_ns) { sim_output(servo_idx, pulse_ns); }
+static void hw_enable(uint8_t, bool) {}
+static void hw_set_frequency(uint8_t servo_idx, uint16_t freq_hz) { sim_freq_hz[servo_idx] = freq_hz; }
+static void hw_set_hires(uint8_t, bool) {}
+static void hw_release_pin(uint8_t, bool) {}
+static void hw_commit(const ServoMsg& msg) {
+    for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+        if (!(msg.mask & (1 << i))) continue;
+        commit_latch_us[i] = sim_output(i, msg.frame_ns[i]);
+    }
+}
+bool servo_hires_active(uint8_t servo_idx) {
+    return servo_idx < NUM_SERVO_PINS && servo_hires[servo_idx];
+}
+
+uint32_t servo_sim_output_ns(uint8_t servo_idx, uint32_t t_us) {
+    if (servo_idx >= NUM_SERVO_PINS) return 0;
+    if (traj_mask & (1 << servo_idx)) return traj_pulse_ns[servo_idx];
+    if (static_cast<int32_t>(t_us - sim_change_us[servo_idx]) < 0) return sim_prev_ns[servo_idx];
+    return hw_pulse_ns[servo_idx];
+}
+
+static void hw_traj_start(uint8_t servo_idx, const ServoTrajectory& traj) {
+    if (!traj_mask) sim_next_frame = std::chrono::steady_clock::now() + SIM_FRAME_PERIOD;
+    traj_cfg[servo_idx] = traj;
+    traj_begin(traj, traj_state[servo_idx], hw_pulse_ns[servo_idx], SIM_FRAME_HZ);
+    traj_pulse_ns[servo_idx] = traj_position_ns(traj, traj_state[servo_idx]);
+    traj_mask |= (1 << servo_idx);
+}
+
+static void hw_traj_stop(uint8_t servo_idx) {
+    if (!(traj_mask & (1 << servo_idx))) return;
+    traj_mask &= ~(1 << servo_idx);
+    hw_pulse_ns[servo_idx] = traj_pulse_ns[servo_idx];
+}
+
+static void hw_traj_speed(uint8_t servo_idx, uint32_t speed_us_per_s) {
+    traj_cfg[servo_idx].speed_us_per_s = speed_us_per_s;
+    traj_state[servo_idx].phase_step = traj_phase_step(traj_cfg[servo_idx], SIM_FRAME_HZ);
+}
+
+// Time until the next simulated frame (forever when nothing is moving)
+static uint32_t hw_wait_ms() {
+    if (!traj_mask) return MSG_WAIT_FOREVER;
+    auto now = std::chrono::steady_clock::now();
+    if (now >= sim_next_frame) return 0;
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(sim_next_frame - now);
+    return static_cast<uint32_t>(left.count()) + 1;
+}
+
+// Advance trajectories by every frame that has elapsed
+static void hw_frame_tick() {
+    if (!traj_mask) return;
+    auto now = std::chrono::steady_clock::now();
+    while (now >= sim_next_frame) {
+        for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+            if (!(traj_mask & (1 << i))) continue;
+            traj_pulse_ns[i] = traj_advance(traj_cfg[i], traj_state[i], SIM_FRAME_PERIOD.count());
+        }
+        sim_next_frame += SIM_FRAME_PERIOD;
+    }
+}
+
+#endif
+
+// =============================================================================
+// RT Task
+// =============================================================================
+
+void servo_task_main(void* arg) {
+    (void)arg;
+    servo_driver_init();
+
+    ServoMsg msg;
+    for (;;) {
+        bool received = g_servo_queue.receive(msg, hw_wait_ms());
+        hw_frame_tick();
+        if (!received) continue;
+
+        if (msg.cmd == SERVO_CMD_COMMIT) {
+            // An explicit pulse takes the servo back from its trajectory
+            for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+                if (msg.mask & (1 << i)) hw_traj_stop(i);
+            }
+            hw_commit(msg);
+            continue;
+        }
+
+        for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+            if (msg.cmd != SERVO_CMD_DISABLE_ALL && !(msg.mask & (1 << i))) continue;
+
+            switch (msg.cmd) {
+                case SERVO_CMD_SET_PULSE:     hw_traj_stop(i); hw_set_pulse(i, msg.value); break;
+                case SERVO_CMD_ENABLE:        hw_enable(i, msg.value != 0); break;
+                case SERVO_CMD_DISABLE_ALL:   hw_enable(i, false); break;
+                case SERVO_CMD_SET_FREQUENCY: hw_set_frequency(i, static_cast<uint16_t>(msg.value)); break;
+                case SERVO_CMD_SET_HIRES:     hw_set_hires(i, msg.value != 0); break;
+                case SERVO_CMD_TRAJ_START:    hw_traj_start(i, msg.traj); break;
+                case SERVO_CMD_TRAJ_SPEED:    hw_traj_speed(i, msg.value); break;
+                case SERVO_CMD_TRAJ_STOP:     hw_traj_stop(i); break;
+                case SERVO_CMD_RELEASE_PINS:  hw_release_pin(i, msg.value != 0); break;
+                case SERVO_CMD_COMMIT:        break;
+            }
+        }
+    }
+}
+
+// =============================================================================
+// Public API (any task)
+// =============================================================================
+
+static void send(const ServoMsg& msg) {
+    if (!g_servo_queue.send(msg, SERVO_MSG_TIMEOUT_MS)) {
+        servo_msgs_dropped++;
+    }
+}
+
+static void post(ServoCmd cmd, uint8_t mask, uint32_t value) {
+    ServoMsg msg = {};
+    msg.cmd = cmd;
+    msg.mask = mask;
+    msg.value = value;
+    send(msg);
+}
+
+static uint8_t valid_mask(uint8_t mask) {
+    return mask & static_cast<uint8_t>((1 << NUM_SERVO_PINS) - 1);
+}
+
+void servo_set_pulse(uint8_t servo_idx, uint16_t pulse_us) {
+    servo_set_pulse_ns(servo_idx, pulse_us * NS_PER_US);
+}
+
+void servo_set_pulse_mask(uint8_t mask, uint16_t pulse_us) {
+    servo_set_pulse_ns_mask(mask, pulse_us * NS_PER_US);
+}
+
+void servo_set_pulse_ns(uint8_t servo_idx, uint32_t pulse_ns) {
+    if (servo_idx >= NUM_SERVO_PINS) return;
+    servo_set_pulse_ns_mask(static_cast<uint8_t>(1 << servo_idx), pulse_ns);
+}
+
+void servo_set_pulse_ns_mask(uint8_t mask, uint32_t pulse_ns) {
+    mask = valid_mask(mask);
+    if (!mask) return;
+
+    // Clamp pulse width to valid range
+    if (pulse_ns < SERVO_PULSE_MIN_US * NS_PER_US) pulse_ns = SERVO_PULSE_MIN_US * NS_PER_US;
+    if (pulse_ns > SERVO_PULSE_MAX_US * NS_PER_US) pulse_ns = SERVO_PULSE_MAX_US * NS_PER_US;
+
     for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
         if (mask & (1 << i)) {
-            servo_enable(i, enable);
+            servo_pulse_ns[i] = pulse_ns;
+            servo_traj[i] = false;
         }
     }
+    post(SERVO_CMD_SET_PULSE, mask, pulse_ns);
+}
+
+void servo_commit(const ServoFrame& frame) {
+    ServoMsg msg = {};
+    msg.cmd = SERVO_CMD_COMMIT;
+    msg.mask = valid_mask(frame.mask);
+    if (!msg.mask) return;
+
+    // Bounds checks once per frame, not per channel call
+    for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+        if (!(msg.mask & (1 << i))) continue;
+        uint32_t pulse_ns = frame.pulse_ns[i];
+        if (pulse_ns < SERVO_PULSE_MIN_US * NS_PER_US) pulse_ns = SERVO_PULSE_MIN_US * NS_PER_US;
+        if (pulse_ns > SERVO_PULSE_MAX_US * NS_PER_US) pulse_ns = SERVO_PULSE_MAX_US * NS_PER_US;
+        msg.frame_ns[i] = pulse_ns;
+        servo_pulse_ns[i] = pulse_ns;
+        servo_traj[i] = false;
+    }
+    send(msg);
+}
+
+static uint16_t clamp_pulse_us(uint16_t pulse_us) {
+    if (pulse_us < SERVO_PULSE_MIN_US) return SERVO_PULSE_MIN_US;
+    if (pulse_us > SERVO_PULSE_MAX_US) return SERVO_PULSE_MAX_US;
+    return pulse_us;
+}
+
+void servo_trajectory_start(uint8_t mask, const ServoTrajectory& traj) {
+    ServoMsg msg = {};
+    msg.cmd = SERVO_CMD_TRAJ_START;
+    msg.mask = valid_mask(mask);
+    if (!msg.mask) return;
+
+    msg.traj = traj;
+    if (msg.traj.profile >= SERVO_PROFILE_COUNT) msg.traj.profile = SERVO_PROFILE_TRIANGLE;
+    msg.traj.min_us = clamp_pulse_us(traj.min_us);
+    msg.traj.max_us = clamp_pulse_us(traj.max_us);
+    if (msg.traj.min_us > msg.traj.max_us) {
+        msg.traj.min_us = clamp_pulse_us(traj.max_us);
+        msg.traj.max_us = clamp_pulse_us(traj.min_us);
+    }
+    if (msg.traj.speed_us_per_s == 0) msg.traj.speed_us_per_s = 1;
+
+    for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+        if (msg.mask & (1 << i)) servo_traj[i] = true;
+    }
+    send(msg);
+}
+
+void servo_trajectory_set_speed(uint8_t mask, uint32_t speed_us_per_s) {
+    mask = valid_mask(mask);
+    if (!mask) return;
+    post(SERVO_CMD_TRAJ_SPEED, mask, speed_us_per_s ? speed_us_per_s : 1);
+}
+
+void servo_trajectory_stop(uint8_t mask) {
+    mask = valid_mask(mask);
+    if (!mask) return;
+
+    for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+        if ((mask & (1 << i)) && servo_traj[i]) {
+            servo_traj[i] = false;
+            servo_pulse_ns[i] = traj_pulse_ns[i];
+        }
+    }
+    post(SERVO_CMD_TRAJ_STOP, mask, 0);
+}
+
+bool servo_trajectory_running(uint8_t servo_idx) {
+    return servo_idx < NUM_SERVO_PINS && servo_traj[servo_idx];
+}
+
+void servo_enable(uint8_t servo_idx, bool enable) {
+    if (servo_idx >= NUM_SERVO_PINS) return;
+    servo_enable_mask(static_cast<uint8_t>(1 << servo_idx), enable);
+}
+
+void servo_enable_mask(uint8_t mask, bool enable) {
+    mask = valid_mask(mask);
+    if (!mask) return;
+    post(SERVO_CMD_ENABLE, mask, enable ? 1 : 0);
 }
 
 void servo_disable_all() {
+    post(SERVO_CMD_DISABLE_ALL, 0, 0);
+}
+
+void servo_release_pins(uint8_t mask, bool release) {
+    mask = valid_mask(mask);
+    if (!mask) return;
+
+    if (release) {
+        for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+            if (mask & (1 << i)) servo_traj[i] = false;
+        }
+    }
+    post(SERVO_CMD_RELEASE_PINS, mask, release ? 1 : 0);
+}
+
+void servo_set_frequency(uint8_t mask, uint16_t freq_hz) {
+    mask = valid_mask(mask);
+    if (!mask) return;
+
+    if (freq_hz < SERVO_PWM_FREQ_MIN_HZ) freq_hz = SERVO_PWM_FREQ_MIN_HZ;
+    if (freq_hz > SERVO_PWM_FREQ_MAX_HZ) freq_hz = SERVO_PWM_FREQ_MAX_HZ;
+
     for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
-        servo_enable(i, false);
+        if (mask & (1 << i)) servo_freq_hz[i] = freq_hz;
     }
+    post(SERVO_CMD_SET_FREQUENCY, mask, freq_hz);
 }
 
-uint16_t servo_get_pulse(uint8_t servo_idx) {
-    if (servo_idx >= NUM_SERVO_PINS) return SERVO_PULSE_CENTER_US;
-    return servo_pulse_us[servo_idx];
+void servo_set_high_resolution(uint8_t mask, bool enable) {
+    mask = valid_mask(mask);
+    if (!mask) return;
+
+    for (uint8_t i = 0; i < NUM_SERVO_PINS; i++) {
+        if (mask & (1 << i)) servo_hires[i] = enable;
+    }
+    post(SERVO_CMD_SET_HIRES, mask, enable ? 1 : 0);
 }
 
-#else
-// Stub implementation for simulator
+uint16_t servo_get_frequency(uint8_t servo_idx) {
+    if (servo_idx >= NUM_SERVO_PINS) return SERVO_PWM_FREQ_HZ;
+    uint16_t freq_hz = servo_freq_hz[servo_idx];
+    return freq_hz ? freq_hz : SERVO_PWM_FREQ_HZ;
+}
 
-void servo_driver_init() {}
-void servo_set_pulse(uint8_t, uint16_t) {}
-void servo_set_pulse_mask(uint8_t, uint16_t) {}
-void servo_enable(uint8_t, bool) {}
-void servo_enable_mask(uint8_t, bool) {}
-void servo_disable_all() {}
-uint16_t servo_get_pulse(uint8_t) { return 1500; }
+uint32_t servo_get_pulse_ns(uint8_t servo_idx) {
+    if (servo_idx >= NUM_SERVO_PINS) return SERVO_PULSE_CENTER_US * NS_PER_US;
+    uint32_t pulse_ns = servo_traj[servo_idx] ? traj_pulse_ns[servo_idx] : servo_pulse_ns[servo_idx];
+    return pulse_ns ? pulse_ns : SERVO_PULSE_CENTER_US * NS_PER_US;
+}
 
-#endif
+uint16_t servo_get_pulse(uint8_t servo_idx) {
+    return static_cast<uint16_t>((servo_get_pulse_ns(servo_idx) + NS_PER_US / 2) / NS_PER_US);
+}
+
+uint32_t servo_get_commit_time_us(uint8_t servo_idx) {
+    if (servo_idx >= NUM_SERVO_PINS) return 0;
+    return commit_latch_us[servo_idx];
+}
+
+uint32_t servo_get_dropped_count() {
+    return servo_msgs_dropped;
+}
@@ -0,0 +1,455 @@
+// src/servo_test.cpp - Servo response latency and deadband measurement
+//
+// IO task state machine, one capture at a time:
+//
+//   SETTLE  servo holds a position, ADC samples are discarded
+//   PRE     samples collected until PRE_SAMPLES are buffered, then the step is
+//           committed (older samples are dropped, the buffer keeps the latest)
+//   POST    samples collected until the record is full, then analyzed
+//
+// The record is one ADC input at SAMPLE_RATE_HZ into a static buffer; nothing
+// is allocated while measuring. A capture that spans an ADC overrun is repeated.
+
+#include "servo_test.h"
+#include "adc_dma.h"
+#include "servo_driver.h"
+#include "step_response.h"
+#include "gui/app_tasks.h"
+#include "gui/serial_log.h"
+#include <atomic>
+#include <cstring>
+
+static constexpr uint32_t SAMPLE_RATE_HZ = 20000;
+static constexpr uint32_t PRE_MS = 20;              // Baseline before the step
+static constexpr uint32_t POST_RUN_MS = 300;        // Step run record after the step
+static constexpr uint32_t POST_PROBE_MS = 150;      // Deadband probe record
+static constexpr uint32_t SETTLE_MS = 500;          // Hold before a run / approach
+static constexpr uint16_t APPROACH_US = 50;         // Deadband approach distance
+static constexpr uint8_t MAX_RETRIES = 3;           // Captures repeated after ADC overruns
+
+static constexpr size_t PRE_SAMPLES = SAMPLE_RATE_HZ / 1000 * PRE_MS;
+static constexpr size_t RUN_SAMPLES = PRE_SAMPLES + SAMPLE_RATE_HZ / 1000 * POST_RUN_MS;
+static constexpr size_t PROBE_SAMPLES = PRE_SAMPLES + SAMPLE_RATE_HZ / 1000 * POST_PROBE_MS;
+static constexpr size_t READ_CHUNK = 128;
+
+enum Phase : uint8_t { PH_SETTLE, PH_PRE, PH_POST };
+
+enum Stage : uint8_t {
+    ST_RUNS,
+    ST_DB_UP_APPROACH,      // From below: center - APPROACH_US, then center
+    ST_DB_UP_PROBE,         // Probe down: center - k
+    ST_DB_DOWN_APPROACH,    // From above
+    ST_DB_DOWN_PROBE,       // Probe up: center + k
+};
+
+// Requests from the GUI
+static ServoTestConfig requested_config;
+static std::atomic<bool> start_requested{false};
+static std::atomic<bool> abort_requested{false};
+
+// Published state (result is only written while RUNNING)
+static std::atomic<uint8_t> state{SERVO_TEST_IDLE};
+static std::atomic<uint8_t> error{SERVO_TEST_OK};
+static std::atomic<uint8_t> progress{0};
+static ServoTestResult result;
+
+// IO task state
+static ServoTestConfig cfg;
+static Stage stage = ST_RUNS;
+static Phase phase = PH_SETTLE;
+static bool approached = false;         // Approach stages: first leg done
+static bool repeat_capture = false;     // Settling before a repeated capture
+static uint8_t probe_k = 0;
+static uint8_t retries = 0;
+static uint32_t settle_until_us = 0;
+static uint16_t step_from_us = 0;
+static uint16_t step_to_us = 0;
+static uint32_t step_cmd_us = 0;
+static uint32_t overruns_at_start = 0;
+
+static uint16_t samples[RUN_SAMPLES];
+static size_t fill = 0;
+static size_t capture_len = 0;
+static uint32_t first_seq = 0;          // ADC stream number of samples[0]
+
+// =============================================================================
+// Simulator: servo model behind the ADC input
+// =============================================================================
+#if !(defined(ESP_PLATFORM) || defined(ARDUINO))
+
+// Standard analog servo: 8 ms dead time, 2nd order with a speed limit and a
+// +-2 µs deadband; the potentiometer reads 2 counts per µs with +-3 counts noise
+static constexpr uint32_t SIM_DEAD_US = 8000;
+static constexpr float SIM_DEADBAND_US = 2.0f;
+static constexpr float SIM_OMEGA = 2.0f * 3.14159f * 9.0f;     // rad/s
+static constexpr float SIM_ZETA = 0.55f;
+static constexpr float SIM_SPEED_MAX = 6000.0f;                 // µs/s (0.1 s / 60 deg)
+
+static uint8_t sim_servo = 0;
+static float sim_pos = SERVO_PULSE_CENTER_US;
+static float sim_vel = 0.0f;
+static uint32_t sim_last_t = 0;
+static uint32_t sim_noise = 12345;
+
+static uint16_t sim_feedback(uint8_t input, uint32_t t_us) {
+    (void)input;
+    // The servo follows the output pulse SIM_DEAD_US late. The simulated output
+    // latches at frame boundaries on its own, so a commit stamp that misses the
+    // real edge shows up as a wrong dead time.
+    float target = servo_sim_output_ns(sim_servo, t_us - SIM_DEAD_US) / 1000.0f;
+
+    float dt = static_cast<int32_t>(t_us - sim_last_t) * 1e-6f;
+    sim_last_t = t_us;
+    if (dt > 0.0f && dt < 0.01f) {
+        float err = target - sim_pos;
+        float acc = -2.0f * SIM_ZETA * SIM_OMEGA * sim_vel;
+        if (err > SIM_DEADBAND_US || err < -SIM_DEADBAND_US) acc += SIM_OMEGA * SIM_OMEGA * err;
+        sim_vel += acc * dt;
+        if (sim_vel > SIM_SPEED_MAX) sim_vel = SIM_SPEED_MAX;
+        if (sim_vel < -SIM_SPEED_MAX) sim_vel = -SIM_SPEED_MAX;
+        sim_pos += sim_vel * dt;
+    }
+
+    sim_noise = sim_noise * 1103515245u + 12345u;
+    int32_t noise = static_cast<int32_t>((sim_noise >> 16) % 7) - 3;
+    int32_t raw = 500 + static_cast<int32_t>((sim_pos - 1000.0f) * 2.0f) + noise;
+    if (raw < 0) raw = 0;
+    if (raw > ADC_DMA_RAW_MAX) raw = ADC_DMA_RAW_MAX;
+    return static_cast<uint16_t>(raw);
+}
+
+static void sim_attach(uint8_t servo) {
+    sim_servo = servo;
+    sim_last_t = app_time_us();
+    adc_dma_set_sim_source(sim_feedback);
+}
+
+#else
+
+static void sim_attach(uint8_t servo) {
+    (void)servo;
+}
+
+#endif
+
+// =============================================================================
+// IO Task
+// =============================================================================
+
+static void command(uint16_t pulse_us) {
+    ServoFrame frame;
+    frame.set_us(cfg.servo, pulse_us);
+    servo_commit(frame);
+    step_cmd_us = app_time_us();
+}
+
+static void hold(uint16_t pulse_us, uint32_t ms) {
+    command(pulse_us);
+    settle_until_us = step_cmd_us + ms * 1000;
+    phase = PH_SETTLE;
+}
+
+static void begin_capture(uint16_t from_us, uint16_t to_us, size_t len) {
+    step_from_us = from_us;
+    step_to_us = to_us;
+    capture_len = len;
+    fill = 0;
+    overruns_at_start = adc_dma_overruns();
+    phase = PH_PRE;
+}
+
+static void update_progress() {
+    uint32_t total = cfg.runs + 2;
+    uint32_t done = result.runs_done;
+    if (stage >= ST_DB_DOWN_APPROACH) done++;
+    progress.store(static_cast<uint8_t>(done * 100 / total));
+}
+
+static void finish(ServoTestState final_state, ServoTestError err) {
+    adc_dma_stop();
+    command(cfg.center_us);
+    error.store(err);
+    if (final_state == SERVO_TEST_DONE) progress.store(100);
+    state.store(final_state);
+}
+
+// Summary over the runs that moved
+static bool summarize() {
+    uint32_t n = 0, dead_sum = 0, rise_sum = 0, rise_n = 0;
+    result.dead_min_us = UINT32_MAX;
+    result.dead_max_us = 0;
+    result.overshoot_permille = 0;
+    for (uint8_t i = 0; i < result.runs_done; i++) {
+        const ServoTestRun& r = result.run[i];
+        if (!r.moved) continue;
+        n++;
+        dead_sum += r.dead_time_us;
+        if (r.dead_time_us < result.dead_min_us) result.dead_min_us = r.dead_time_us;
+        if (r.dead_time_us > result.dead_max_us) result.dead_max_us = r.dead_time_us;
+        if (r.rise_us) {
+            rise_sum += r.rise_us;
+            rise_n++;
+        }
+        if (r.overshoot_permille > result.overshoot_permille) result.overshoot_permille = r.overshoot_permille;
+    }
+    if (!n) {
+        result.dead_min_us = 0;
+        return false;
+    }
+    result.dead_mean_us = dead_sum / n;
+    result.rise_mean_us = rise_n ? rise_sum / rise_n : 0;
+    // 10% -> 90% covers 80% of the commanded travel
+    uint32_t span = cfg.high_us - cfg.low_us;
+    result.slew_us_per_s = result.rise_mean_us
+        ? static_cast<uint32_t>(800000ULL * span / result.rise_mean_us) : 0;
+    return true;
+}
+
+static void start_deadband() {
+    stage = ST_DB_UP_APPROACH;
+    approached = false;
+    hold(cfg.center_us - APPROACH_US, SETTLE_MS);
+}
+
+static void next_run() {
+    uint8_t i = result.runs_done;
+    bool up = (i % 2) == 0;
+    begin_capture(up ? cfg.low_us : cfg.high_us, up ? cfg.high_us : cfg.low_us, RUN_SAMPLES);
+}
+
+// Record complete: analyze and pick the next capture
+static void on_capture_done(uint32_t period_ns, uint32_t step_us) {
+    if (stage == ST_RUNS) {
+        StepResponse sr = step_analyze(samples, fill, period_ns, step_us);
+        ServoTestRun& run = result.run[result.runs_done++];
+        run.from_us = step_from_us;
+        run.to_us = step_to_us;
+        run.moved = sr.moved;
+        run.dead_time_us = sr.dead_time_us;
+        run.rise_us = sr.rise_us;
+        run.overshoot_permille = sr.overshoot_permille;
+        update_progress();
+
+        if (result.runs_done < cfg.runs) {
+            hold(step_to_us, SETTLE_MS - POST_RUN_MS);
+            return;
+        }
+        if (!summarize()) {
+            finish(SERVO_TEST_FAILED, SERVO_TEST_ERR_NO_RESPONSE);
+            return;
+        }
+        start_deadband();
+        return;
+    }
+
+    // Deadband probe
+    bool up_side = (stage == ST_DB_UP_PROBE);
+    bool moved = step_shifted(samples, fill, period_ns, step_us);
+    if (!moved && probe_k < SERVO_TEST_DEADBAND_MAX_US) {
+        probe_k++;
+        int dir = up_side ? -1 : 1;
+        begin_capture(step_to_us, static_cast<uint16_t>(cfg.center_us + dir * probe_k), PROBE_SAMPLES);
+        return;
+    }
+
+    uint8_t db = moved ? probe_k : 0;
+    if (up_side) {
+        result.deadband_up_us = db;
+        stage = ST_DB_DOWN_APPROACH;
+        approached = false;
+        update_progress();
+        hold(cfg.center_us + APPROACH_US, SETTLE_MS);
+        return;
+    }
+    result.deadband_down_us = db;
+    uint8_t sides = (result.deadband_up_us ? 1 : 0) + (result.deadband_down_us ? 1 : 0);
+    result.deadband_us = sides ? (result.deadband_up_us + result.deadband_down_us) / sides : 0;
+    finish(SERVO_TEST_DONE, SERVO_TEST_OK);
+}
+
+static void on_settled() {
+    if (repeat_capture) {
+        repeat_capture = false;
+        begin_capture(step_from_us, step_to_us, capture_len);
+        return;
+    }
+    switch (stage) {
+        case ST_RUNS:
+            next_run();
+            break;
+        case ST_DB_UP_APPROACH:
+        case ST_DB_DOWN_APPROACH:
+            if (!approached) {
+                approached = true;
+                hold(cfg.center_us, SETTLE_MS);
+                return;
+            }
+            stage = (stage == ST_DB_UP_APPROACH) ? ST_DB_UP_PROBE : ST_DB_DOWN_PROBE;
+            probe_k = 1;
+            begin_capture(cfg.center_us,
+                          static_cast<uint16_t>(cfg.center_us + (stage == ST_DB_UP_PROBE ? -1 : 1)),
+                          PROBE_SAMPLES);
+            break;
+        default:
+            break;
+    }
+}
+
+static void capture_complete() {
+    const uint32_t rate = adc_dma_rate_hz();
+    const uint32_t period_ns = 1000000000u / rate;
+
+    // Sample clock: stream number -> app_time_us()
+    uint32_t t0 = adc_dma_start_time_us() + static_cast<uint32_t>(static_cast<uint64_t>(first_seq) * 1000000 / rate);
+
+    // Step = PWM boundary that latched the command (fallback: command time)
+    uint32_t latch = servo_get_commit_time_us(cfg.servo);
+    if (static_cast<int32_t>(latch - step_cmd_us) < 0) latch = step_cmd_us;
+    int32_t step_us = static_cast<int32_t>(latch - t0);
+
+    bool bad = adc_dma_overruns() != overruns_at_start || step_us <= 0 ||
+               static_cast<uint32_t>(step_us) >= capture_len * period_ns / 1000;
+    if (bad) {
+        if (++retries > MAX_RETRIES) {
+            LOG_W("SRVT", "Capture failed (overruns %lu)", (unsigned long)adc_dma_overruns());
+            finish(SERVO_TEST_FAILED, SERVO_TEST_ERR_ADC);
+            return;
+        }
+        // Back to the start position and repeat
+        repeat_capture = true;
+        hold(step_from_us, SETTLE_MS);
+        return;
+    }
+    retries = 0;
+    on_capture_done(period_ns, static_cast<uint32_t>(step_us));
+}
+
+static void drain_adc() {
+    AdcSample chunk[READ_CHUNK];
+    uint32_t seq;
+    size_t n;
+    while ((n = adc_dma_read(chunk, READ_CHUNK, &seq)) > 0) {
+        if (phase == PH_SETTLE) continue;
+
+        for (size_t i = 0; i < n && fill < capture_len; i++) {
+            if (fill == 0) first_seq = seq + static_cast<uint32_t>(i);
+            samples[fill++] = chunk[i].raw;
+        }
+
+        if (phase == PH_PRE) {
+            // Keep only the latest PRE_SAMPLES before the step
+            if (fill > PRE_SAMPLES) {
+                size_t drop = fill - PRE_SAMPLES;
+                memmove(samples, samples + drop, PRE_SAMPLES * sizeof(samples[0]));
+                first_seq += static_cast<uint32_t>(drop);
+                fill = PRE_SAMPLES;
+            }
+            if (fill == PRE_SAMPLES) {
+                command(step_to_us);
+                phase = PH_POST;
+            }
+        } else if (fill == capture_len) {
+            capture_complete();
+            if (state.load() != SERVO_TEST_RUNNING) return;
+        }
+    }
+}
+
+static void apply_start() {
+    cfg = requested_config;
+    if (cfg.runs < 1) cfg.runs = 1;
+    if (cfg.runs > SERVO_TEST_MAX_RUNS) cfg.runs = SERVO_TEST_MAX_RUNS;
+    result = ServoTestResult{};
+    result.config = cfg;
+    retries = 0;
+    repeat_capture = false;
+    progress.store(0);
+
+    servo_trajectory_stop(static_cast<uint8_t>(1 << cfg.servo));
+    servo_enable(cfg.servo, true);
+    sim_attach(cfg.servo);
+    if (!adc_dma_start(static_cast<uint8_t>(1 << cfg.adc_input), SAMPLE_RATE_HZ)) {
+        finish(SERVO_TEST_FAILED, SERVO_TEST_ERR_ADC);
+        return;
+    }
+    stage = ST_RUNS;
+    hold(cfg.low_us, SETTLE_MS);
+}
+
+void servo_test_service() {
+    if (start_requested.exchange(false)) apply_start();
+    if (state.load() != SERVO_TEST_RUNNING) {
+        abort_requested.store(false);
+        return;
+    }
+    if (abort_requested.exchange(false)) {
+        finish(SERVO_TEST_IDLE, SERVO_TEST_ERR_ABORTED);
+        return;
+    }
+
+    drain_adc();
+    if (state.load() != SERVO_TEST_RUNNING) return;
+
+    if (phase == PH_SETTLE && static_cast<int32_t>(app_time_us() - settle_until_us) >= 0) {
+        on_settled();
+    }
+}
+
+// =============================================================================
+// Public API
+// =============================================================================
+
+void servo_test_start(const ServoTestConfig& config) {
+    if (state.load() == SERVO_TEST_RUNNING) return;
+    if (config.servo >= NUM_SERVO_PINS || config.adc_input >= NUM_ADC_PINS) return;
+    if (config.low_us >= config.high_us) return;
+    requested_config = config;
+    error.store(SERVO_TEST_OK);
+    progress.store(0);
+    state.store(SERVO_TEST_RUNNING);
+    start_requested.store(true);
+}
+
+void servo_test_abort() {
+    if (state.load() == SERVO_TEST_RUNNING) abort_requested.store(true);
+}
+
+ServoTestState servo_test_state() {
+    return static_cast<ServoTestState>(state.load());
+}
+
+ServoTestError servo_test_error() {
+    return static_cast<ServoTestError>(error.load());
+}
+
+uint8_t servo_test_progress() {
+    return progress.load();
+}
+
+bool servo_test_result(ServoTestResult& out) {
+    if (state.load() != SERVO_TEST_DONE) return false;
+    out = result;
+    return true;
+}
+
+void servo_test_export() {
+    ServoTestResult r;
+    if (!servo_test_result(r)) return;
+
+    serial_printf("servo_test,servo=%u,adc=%u,runs=%u\n",
+                  r.config.servo + 1, r.config.adc_input + 1, r.runs_done);
+    log_println("run,from_us,to_us,dead_time_us,rise_us,slew_us_per_s,overshoot_permille");
+    for (uint8_t i = 0; i < r.runs_done; i++) {
+        const ServoTestRun& run = r.run[i];
+        if (!run.moved) {
+            serial_printf("%u,%u,%u,,,,\n", i + 1, run.from_us, run.to_us);
+            continue;
+        }
+        uint32_t span = run.to_us > run.from_us ? run.to_us - run.from_us : run.from_us - run.to_us;
+        uint32_t slew = run.rise_us ? static_cast<uint32_t>(800000ULL * span / run.rise_us) : 0;
+        serial_printf("%u,%u,%u,%lu,%lu,%lu,%u\n", i + 1, run.from_us, run.to_us,
+                      (unsigned long)run.dead_time_us, (unsigned long)run.rise_us,
+                      (unsigned long)slew, run.overshoot_permille);
+    }
+    serial_printf("deadband_us,%u,%u,%u\n", r.deadband_up_us, r.deadband_down_us, r.deadband_us);
+}
@@ -0,0 +1,51 @@
+// test/lipo_ir_bench.cpp - Run recorded LiPo traces through the IR estimator
+// Usage: lipo_ir_bench <trace file>...   (format: test/lipo_trace_file.h)
+// Prints the estimate per cell and, where the file has expect_ir_x10_mohm, the
+// reference value and the error in units of the reported uncertainty.
+
+#include <math.h>
+#include <stdio.h>
+#include <string>
+#include "lipo_analysis.h"
+#include "lipo_trace_file.h"
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <trace file>...\n", argv[0]);
+        return 2;
+    }
+
+    int failed = 0;
+    for (int a = 1; a < argc; a++) {
+        LipoTraceFile f;
+        std::string error;
+        if (!lipo_trace_read(argv[a], f, error)) {
+            fprintf(stderr, "%s\n", error.c_str());
+            failed++;
+            continue;
+        }
+
+        LipoIrResult r = lipo_estimate_ir(f.trace);
+        printf("%s: %zu samples", argv[a], f.trace.samples);
+        if (!r.valid) {
+            printf(", no estimate (%uS, %u mA)\n", r.cells, r.current_ma);
+            failed++;
+            continue;
+        }
+        printf(", %uS at %u mA, confidence %u%%, %u outliers\n",
+               r.cells, r.current_ma, r.confidence_permille / 10, r.rejected);
+
+        for (uint8_t c = 0; c < r.cells; c++) {
+            printf("  cell %u: %5.1f +- %4.1f mOhm", c + 1,
+                   r.ir_x10_mohm[c] / 10.0, r.uncertainty_x10_mohm[c] / 10.0);
+            if (c < f.expect_count) {
+                double err = (r.ir_x10_mohm[c] - f.expect_ir_x10_mohm[c]) / 10.0;
+                double sigma = r.uncertainty_x10_mohm[c] / 10.0;
+                printf("   reference %5.1f, error %+5.1f", f.expect_ir_x10_mohm[c] / 10.0, err);
+                if (sigma > 0.0) printf(" (%.1f sigma)", fabs(err) / sigma);
+            }
+            printf("\n");
+        }
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,116 @@
+// test/lipo_trace_file.h - Recorded LiPo IR traces on the host
+// Text format, one trace per file. '#' starts a comment; "key value" lines set
+// the LipoTrace fields, every other line is one sample (tap voltages in mV):
+//
+//   # 3S 1300 mAh, 25 C
+//   period_us 2000
+//   load_milliohm 2200
+//   load_on 100
+//   expect_ir_x10_mohm 52 49 55     (optional: reference meter, per cell)
+//   3811 7622 11430
+//   ...
+//
+// load_off defaults to the sample count.
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "lipo_analysis.h"
+
+struct LipoTraceFile {
+    std::vector<uint16_t> tap[LIPO_ANALYSIS_MAX_CELLS];
+    LipoTrace trace;                                    // Points into tap
+    uint16_t expect_ir_x10_mohm[LIPO_ANALYSIS_MAX_CELLS];
+    uint8_t expect_count;
+};
+
+// Numbers of a line into out (at most max); returns the count, -1 on a bad token
+inline int lipo_trace_numbers(char* s, long* out, int max) {
+    int n = 0;
+    for (char* tok = strtok(s, " \t,\r\n"); tok; tok = strtok(nullptr, " \t,\r\n")) {
+        char* end = nullptr;
+        long v = strtol(tok, &end, 10);
+        if (*end || n >= max) return -1;
+        out[n++] = v;
+    }
+    return n;
+}
+
+/**
+ * Read a trace file
+ * @param error Set to "<line>: <reason>" on failure
+ */
+inline bool lipo_trace_read(const char* path, LipoTraceFile& f, std::string& error) {
+    f = LipoTraceFile{};
+    FILE* fp = fopen(path, "r");
+    if (!fp) {
+        error = std::string(path) + ": cannot open";
+        return false;
+    }
+
+    bool load_off_set = false;
+    char line[256];
+    int line_no = 0;
+    auto fail = [&](const char* why) {
+        error = std::string(path) + ":" + std::to_string(line_no) + ": " + why;
+        fclose(fp);
+        return false;
+    };
+
+    while (fgets(line, sizeof(line), fp)) {
+        line_no++;
+        if (char* hash = strchr(line, '#')) *hash = '\0';
+        char* p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '\0' || *p == '\r' || *p == '\n') continue;
+
+        long v[LIPO_ANALYSIS_MAX_CELLS];
+        if (*p >= '0' && *p <= '9') {
+            int n = lipo_trace_numbers(p, v, LIPO_ANALYSIS_MAX_CELLS);
+            if (n <= 0) return fail("bad sample");
+            if (!f.trace.taps) f.trace.taps = static_cast<uint8_t>(n);
+            if (n != f.trace.taps) return fail("tap count differs from the first sample");
+            for (int i = 0; i < n; i++) {
+                if (v[i] < 0 || v[i] > 0xFFFF) return fail("tap voltage out of range");
+                f.tap[i].push_back(static_cast<uint16_t>(v[i]));
+            }
+            continue;
+        }
+
+        char* key = strtok(p, " \t");
+        char* rest = strtok(nullptr, "");
+        int n = rest ? lipo_trace_numbers(rest, v, LIPO_ANALYSIS_MAX_CELLS) : 0;
+        if (n <= 0) return fail("key without a value");
+        if (strcmp(key, "expect_ir_x10_mohm") == 0) {
+            for (int i = 0; i < n; i++) f.expect_ir_x10_mohm[i] = static_cast<uint16_t>(v[i]);
+            f.expect_count = static_cast<uint8_t>(n);
+            continue;
+        }
+        if (n != 1 || v[0] < 0) return fail("expected one value");
+        if (strcmp(key, "period_us") == 0) {
+            f.trace.period_us = static_cast<uint32_t>(v[0]);
+        } else if (strcmp(key, "load_milliohm") == 0) {
+            f.trace.load_milliohm = static_cast<uint32_t>(v[0]);
+        } else if (strcmp(key, "load_on") == 0) {
+            f.trace.load_on = static_cast<size_t>(v[0]);
+        } else if (strcmp(key, "load_off") == 0) {
+            f.trace.load_off = static_cast<size_t>(v[0]);
+            load_off_set = true;
+        } else {
+            return fail("unknown key");
+        }
+    }
+    fclose(fp);
+
+    if (!f.trace.taps) {
+        error = std::string(path) + ": no samples";
+        return false;
+    }
+    f.trace.samples = f.tap[0].size();
+    for (uint8_t i = 0; i < f.trace.taps; i++) f.trace.tap_mv[i] = f.tap[i].data();
+    if (!load_off_set) f.trace.load_off = f.trace.samples;
+    return true;
+}
@@ -0,0 +1,37 @@
+// test/stubs/lvgl.h - Just enough of the LVGL API for the host tests
+// Display calls record what the code under test asked for instead of drawing.
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+
+#define LV_UNUSED(x) ((void)(x))
+
+typedef int32_t lv_coord_t;
+
+struct lv_area_t {
+    int32_t x1, y1, x2, y2;
+};
+
+struct lv_display_t;
+typedef void (*lv_display_flush_cb_t)(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map);
+typedef void (*lv_display_flush_wait_cb_t)(lv_display_t* disp);
+
+struct lv_display_t {
+    lv_display_flush_cb_t flush_cb = nullptr;
+    lv_display_flush_wait_cb_t flush_wait_cb = nullptr;
+    uint32_t flush_ready_calls = 0;
+};
+
+inline int32_t lv_area_get_width(const lv_area_t* a) { return a->x2 - a->x1 + 1; }
+inline int32_t lv_area_get_height(const lv_area_t* a) { return a->y2 - a->y1 + 1; }
+
+inline void lv_display_set_flush_cb(lv_display_t* d, lv_display_flush_cb_t cb) { d->flush_cb = cb; }
+inline void lv_display_set_flush_wait_cb(lv_display_t* d, lv_display_flush_wait_cb_t cb) { d->flush_wait_cb = cb; }
+inline void lv_display_flush_ready(lv_display_t* d) { d->flush_ready_calls++; }
+
+inline uint32_t lv_tick_get() {
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+inline uint32_t lv_tick_elaps(uint32_t prev) { return lv_tick_get() - prev; }
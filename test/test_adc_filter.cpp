@@ -0,0 +1,124 @@
+// test/test_adc_filter.cpp - AdcFilter (oversampling + IIR) and AdcCalTable
+
+#include <stdlib.h>
+#include "adc_filter.h"
+#include "test_check.h"
+
+namespace {
+    typedef AdcFilter<6, 3> TapFilter;      // As used by the LiPo monitor
+
+    // Feed whole blocks of a constant raw value
+    template <typename F>
+    void feed_blocks(F& f, uint16_t raw, uint32_t blocks) {
+        for (uint32_t b = 0; b < blocks; b++) {
+            for (uint32_t i = 0; i < F::BLOCK; i++) f.push(raw);
+        }
+    }
+}
+
+static void test_blocks_and_first_value() {
+    TapFilter f;
+    CHECK(!f.valid());
+    for (uint32_t i = 0; i < TapFilter::BLOCK - 1; i++) CHECK(!f.push(1000));
+    CHECK(!f.valid());
+    CHECK(f.push(1000));
+    CHECK(f.valid());
+    CHECK(!f.settled());
+
+    // First block is taken as is, no ramp from zero
+    CHECK_EQ(f.value_q(), 1000u << TapFilter::FRAC_BITS);
+    CHECK_EQ(f.block_q(), 1000u << TapFilter::FRAC_BITS);
+}
+
+static void test_step_settles() {
+    TapFilter f;
+    feed_blocks(f, 1000, 1);
+    const uint32_t from = 1000u << TapFilter::FRAC_BITS;
+    const uint32_t to = 3000u << TapFilter::FRAC_BITS;
+
+    uint32_t prev = from;
+    for (uint32_t b = 1; b < TapFilter::SETTLE_BLOCKS; b++) {
+        CHECK(!f.settled());
+        feed_blocks(f, 3000, 1);
+        CHECK(f.value_q() >= prev);          // Monotonic, no overshoot
+        CHECK(f.value_q() <= to);
+        prev = f.value_q();
+    }
+    CHECK(f.settled());
+    CHECK_EQ(f.block_q(), to);
+    CHECK(f.value_q() - from >= (to - from) * 95 / 100);
+
+    // Fully converges: the scaled state leaves no truncation offset
+    feed_blocks(f, 3000, 200);
+    CHECK_EQ(f.value_q(), to);
+}
+
+static void test_noise_is_averaged() {
+    TapFilter f;
+    srand(1234);
+    // Uniform +/-40 count noise around 2000
+    for (uint32_t b = 0; b < 4 * TapFilter::SETTLE_BLOCKS; b++) {
+        for (uint32_t i = 0; i < TapFilter::BLOCK; i++) {
+            f.push(static_cast<uint16_t>(2000 + rand() % 81 - 40));
+        }
+    }
+    // Single sample sigma ~23 counts; oversampled + IIR: well under one count
+    const int32_t err_q = static_cast<int32_t>(f.value_q()) - (2000 << TapFilter::FRAC_BITS);
+    CHECK(abs(err_q) < (1 << TapFilter::FRAC_BITS));
+}
+
+static void test_full_scale_no_overflow() {
+    AdcFilter<8, 11> f;                      // Largest state the static_assert allows
+    feed_blocks(f, 4095, 1);
+    feed_blocks(f, 0, 1);
+    feed_blocks(f, 4095, 3 * decltype(f)::SETTLE_BLOCKS);
+    CHECK_EQ(f.value_q(), 4095u << 8);
+}
+
+static void test_reset() {
+    TapFilter f;
+    feed_blocks(f, 500, TapFilter::SETTLE_BLOCKS);
+    CHECK(f.settled());
+    f.push(4000);                            // Partial block is dropped too
+    f.reset();
+    CHECK(!f.valid());
+    CHECK_EQ(f.value_q(), 0);
+    feed_blocks(f, 2500, 1);
+    CHECK_EQ(f.value_q(), 2500u << TapFilter::FRAC_BITS);
+}
+
+static void test_cal_table() {
+    const AdcCalTable lin = AdcCalTable::linear(3300);
+    CHECK_EQ(lin.mv[0], 0);
+    CHECK_EQ(lin.mv[AdcCalTable::POINTS - 1], 3300);
+    CHECK_EQ(lin.to_uv(2048u << 6, 6), 1650000);
+    CHECK_EQ(lin.to_uv(0, 6), 0);
+    CHECK_EQ(lin.to_uv(4096u << 6, 6), 3300000);             // Last segment end
+    // Raw 1000 is in segment 3: one count = the segment slope, and the
+    // fractional bits interpolate below one count
+    const uint32_t step_uv = lin.to_uv((1000u << 6) + 64, 6) - lin.to_uv(1000u << 6, 6);
+    const uint32_t frac_uv = lin.to_uv((1000u << 6) + 1, 6) - lin.to_uv(1000u << 6, 6);
+    CHECK_NEAR(step_uv, (lin.mv[4] - lin.mv[3]) * 1000.0 / 256, 1.0);
+    CHECK_NEAR(frac_uv, step_uv / 64.0, 1.0);
+
+    // Chip calibration curve: 2 mV per count up to 1024, 1 mV per count above
+    AdcCalTable cal;
+    for (uint8_t i = 0; i < AdcCalTable::POINTS; i++) {
+        uint32_t raw = static_cast<uint32_t>(i) << AdcCalTable::SEGMENT_LOG2;
+        cal.mv[i] = static_cast<uint16_t>(raw <= 1024 ? 2 * raw : 2048 + (raw - 1024));
+    }
+    CHECK_EQ(cal.to_uv(512, 0), 1024000);
+    CHECK_EQ(cal.to_uv(1024, 0), 2048000);
+    CHECK_EQ(cal.to_uv(1536, 0), 2560000);
+    CHECK_EQ(cal.to_uv(1536u << 3, 3), 2560000);             // Same point, other scale
+}
+
+int main() {
+    RUN_TEST(test_blocks_and_first_value);
+    RUN_TEST(test_step_settles);
+    RUN_TEST(test_noise_is_averaged);
+    RUN_TEST(test_full_scale_no_overflow);
+    RUN_TEST(test_reset);
+    RUN_TEST(test_cal_table);
+    return TEST_RESULT();
+}
@@ -0,0 +1,159 @@
+// test/test_cg_solver.cpp - cg_solve and CgTracker on synthetic load traces
+
+#include <math.h>
+#include <stdlib.h>
+#include "cg_solver.h"
+#include "test_check.h"
+
+namespace {
+    typedef CgTracker<3> Tracker;       // Shift as used by the CG scale page
+
+    CgSolution solve2(int32_t load0, int32_t x0, int32_t load1, int32_t x1) {
+        const int32_t load[] = { load0, load1 };
+        const int32_t x[] = { x0, x1 };
+        return cg_solve(load, x, 2, 0x3);
+    }
+
+    // Uniform noise in [-amp, amp] from the seeded rand()
+    int32_t noise(int32_t amp) {
+        return static_cast<int32_t>(rand() % (2 * amp + 1)) - amp;
+    }
+}
+
+static void test_solve_basic() {
+    // 1.2 kg model on supports at 50 mm and 250 mm: 3:1 -> CG at 100 mm
+    const int32_t load[] = { 900000, 300000, 0 };
+    const int32_t x[] = { 50000, 250000, 400000 };
+    CgSolution s = cg_solve(load, x, 3, 0x3);
+    CHECK(s.valid);
+    CHECK_EQ(s.total_mg, 1200000);
+    CHECK_EQ(s.x_um, 100000);
+
+    // Unused support is left out of the span too
+    s = cg_solve(load, x, 3, 0x7);
+    CHECK(s.valid);
+    CHECK_EQ(s.x_um, 100000);
+}
+
+static void test_solve_rounding() {
+    // Round to nearest, halves away from zero
+    CHECK_EQ(solve2(40000, 0, 20000, 1).x_um, 0);           // 1/3
+    CHECK_EQ(solve2(20000, 0, 40000, 1).x_um, 1);           // 2/3
+    CHECK_EQ(solve2(30000, 0, 30000, 1).x_um, 1);           // 1/2
+    CHECK_EQ(solve2(30000, -1, 30000, 0).x_um, -1);         // -1/2
+    CHECK_EQ(solve2(40000, -1, 20000, 0).x_um, -1);         // -2/3
+    CHECK_EQ(solve2(20000, -1, 40000, 0).x_um, 0);          // -1/3
+}
+
+static void test_solve_negative_loads() {
+    // Tail-heavy model lifts the front support: CG behind the rear support
+    CgSolution s = solve2(-5000, 0, 105000, 500000);
+    CHECK(s.valid);
+    CHECK_EQ(s.total_mg, 100000);
+    CHECK_EQ(s.x_um, 525000);
+
+    // Negative loads cancel: the total decides whether anything is on the scale
+    s = solve2(-40000, 0, 55000, 500000);
+    CHECK(!s.valid);
+    CHECK_EQ(s.total_mg, 15000);
+}
+
+static void test_solve_rejects() {
+    // Out of the span +- 1 span: x = 2 spans (boundary) is kept, beyond is rejected
+    CgSolution s = solve2(-50000, 0, 100000, 100000);
+    CHECK(s.valid);
+    CHECK_EQ(s.x_um, 200000);
+    CHECK(!solve2(-60000, 0, 110000, 100000).valid);         // 220 mm
+    s = solve2(100000, 0, -50000, 100000);                   // -100 mm
+    CHECK(s.valid);
+    CHECK_EQ(s.x_um, -100000);
+    CHECK(!solve2(105000, 0, -55000, 100000).valid);         // -110 mm
+
+    // Too little mass, a single position, or a single support
+    CHECK(!solve2(10000, 0, 9999, 100000).valid);
+    CHECK(!solve2(50000, 100000, 50000, 100000).valid);
+    const int32_t load[] = { 50000, 50000 };
+    const int32_t x[] = { 0, 100000 };
+    CHECK(!cg_solve(load, x, 2, 0x1).valid);
+}
+
+static void test_tracker_mean_variance() {
+    Tracker t;
+    CHECK(!t.valid());
+
+    // Constant input: exact mean, no spread
+    CgSolution s = { true, 1000000, 123456 };
+    for (int i = 0; i < 10; i++) t.update(s);
+    CHECK(t.valid());
+    CHECK_EQ(t.x_um(), 123456);
+    CHECK_EQ(t.stddev_um(), 0);
+    CHECK_EQ(t.total_mg(), 1000000);
+
+    // Step: the mean follows with a = 1/8 per update
+    s.x_um = 133456;
+    for (int n = 1; n <= 32; n++) {
+        t.update(s);
+        const double expect = 133456 - 10000 * pow(7.0 / 8.0, n);
+        CHECK_NEAR(t.x_um(), expect, n);         // Truncation: at most ~1 um per update
+    }
+
+    // Alternating +-d around a mean: EWMA variance converges to d^2
+    t.reset();
+    for (int i = 0; i < 400; i++) {
+        s.x_um = 100000 + ((i & 1) ? 300 : -300);
+        t.update(s);
+    }
+    CHECK_NEAR(t.x_um(), 100000, 25);
+    CHECK_NEAR(t.stddev_um(), 300, 20);
+
+    // Invalid reading restarts the tracking
+    t.update(CgSolution{});
+    CHECK(!t.valid());
+    CHECK_EQ(t.stddev_um(), 0);
+}
+
+static void test_tracker_settles_on_noisy_loads() {
+    // 2 kg model, supports at 30 mm and 230 mm, CG at 90 mm, +-2 g noise per cell
+    const int32_t x[] = { 30000, 230000 };
+    const int32_t front = 1400000, rear = 600000;
+    const uint32_t LIMIT_UM = 300;
+
+    srand(42);
+    Tracker t;
+    double sum = 0, sum_sq = 0;
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < 4 * Tracker::WARMUP; i++) {
+        const int32_t load[] = { front + noise(2000), rear + noise(2000) };
+        CgSolution s = cg_solve(load, x, 2, 0x3);
+        CHECK(s.valid);
+        t.update(s);
+
+        if (i + 1 < Tracker::WARMUP) CHECK(!t.settled(LIMIT_UM));
+        if (i + 1 == Tracker::WARMUP) CHECK(t.settled(LIMIT_UM));
+        sum += s.x_um;
+        sum_sq += static_cast<double>(s.x_um) * s.x_um;
+        n++;
+    }
+    const double mean = sum / n;
+    const double sigma = sqrt(sum_sq / n - mean * mean);
+    CHECK(t.settled(LIMIT_UM));
+    CHECK_NEAR(t.x_um(), 90000, 100);
+    CHECK_NEAR(t.stddev_um(), sigma, sigma * 0.5);
+    CHECK(!t.settled(static_cast<uint32_t>(sigma / 4)));      // Limit below the noise
+
+    // Model moved on the scale: an invalid reading restarts the warm-up
+    t.update(CgSolution{});
+    const int32_t load[] = { front, rear };
+    t.update(cg_solve(load, x, 2, 0x3));
+    CHECK(!t.settled(LIMIT_UM));
+}
+
+int main() {
+    RUN_TEST(test_solve_basic);
+    RUN_TEST(test_solve_rounding);
+    RUN_TEST(test_solve_negative_loads);
+    RUN_TEST(test_solve_rejects);
+    RUN_TEST(test_tracker_mean_variance);
+    RUN_TEST(test_tracker_settles_on_noisy_loads);
+    return TEST_RESULT();
+}
@@ -0,0 +1,37 @@
+// test/test_check.h - Minimal check macros for the host tests
+#pragma once
+
+#include <math.h>
+#include <stdio.h>
+
+static int test_failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        test_failures++; \
+    } \
+} while (0)
+
+#define CHECK_EQ(a, b) do { \
+    long long va_ = (long long)(a), vb_ = (long long)(b); \
+    if (va_ != vb_) { \
+        printf("%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", \
+               __FILE__, __LINE__, #a, #b, va_, vb_); \
+        test_failures++; \
+    } \
+} while (0)
+
+#define CHECK_NEAR(a, b, tol) do { \
+    double va_ = (double)(a), vb_ = (double)(b); \
+    if (fabs(va_ - vb_) > (tol)) { \
+        printf("%s:%d: CHECK_NEAR(%s, %s) failed: %g != %g\n", \
+               __FILE__, __LINE__, #a, #b, va_, vb_); \
+        test_failures++; \
+    } \
+} while (0)
+
+#define RUN_TEST(fn) do { printf("%s\n", #fn); fn(); } while (0)
+
+#define TEST_RESULT() (printf(test_failures ? "FAILED (%d)\n" : "OK\n", test_failures), \
+                       test_failures ? 1 : 0)
@@ -0,0 +1,132 @@
+// test/test_display_flush.cpp - Flush handshake against a fake transport
+
+#include <atomic>
+#include <thread>
+#include "gui/display_flush.h"
+#include "gui/app_tasks.h"
+#include "test_check.h"
+
+namespace {
+    // Fake transport: records transfers, reports done after a number of polls
+    struct FakeTransport {
+        uint32_t starts = 0;
+        uint32_t last_px = 0;
+        uint32_t finishes = 0;
+        uint32_t polls = 0;
+        uint32_t done_after = 0;   // Polls until is_done() returns true
+    } fake;
+
+    void fake_start(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map, uint32_t px_count) {
+        LV_UNUSED(disp); LV_UNUSED(area); LV_UNUSED(px_map);
+        fake.starts++;
+        fake.last_px = px_count;
+        fake.polls = 0;
+    }
+
+    bool fake_is_done() {
+        return ++fake.polls > fake.done_after;
+    }
+
+    void fake_finish() {
+        fake.finishes++;
+    }
+
+    const DisplayTransport POLLED = { fake_start, fake_is_done, fake_finish };
+    const DisplayTransport CALLBACK = { fake_start, nullptr, fake_finish };
+
+    uint8_t px[16];
+    const lv_area_t AREA = { 0, 0, 319, 9 };   // 320 x 10 band
+}
+
+static void test_flush_starts_and_returns() {
+    lv_display_t disp;
+    fake = {};
+    fake.done_after = 1000;
+    display_flush_init(&disp, &POLLED);
+    CHECK(disp.flush_cb != nullptr);
+    CHECK(disp.flush_wait_cb != nullptr);
+
+    disp.flush_cb(&disp, &AREA, px);
+    CHECK_EQ(fake.starts, 1);
+    CHECK_EQ(fake.last_px, 320 * 10);
+    CHECK(display_flush_busy());
+    CHECK_EQ(disp.flush_ready_calls, 0);
+    CHECK_EQ(fake.finishes, 0);   // Bus stays held until the buffer is waited for
+}
+
+static void test_wait_polls_until_done() {
+    lv_display_t disp;
+    fake = {};
+    fake.done_after = 5;
+    display_flush_init(&disp, &POLLED);
+
+    disp.flush_cb(&disp, &AREA, px);
+    disp.flush_wait_cb(&disp);
+    CHECK(!display_flush_busy());
+    CHECK_EQ(fake.polls, 6);
+    CHECK_EQ(disp.flush_ready_calls, 1);
+    CHECK_EQ(fake.finishes, 1);
+
+    DisplayFlushStats s = display_flush_get_stats();
+    CHECK_EQ(s.flushes, 1);
+    CHECK_EQ(s.waits, 1);
+
+    // Nothing in flight: no wait counted, no second finish
+    display_flush_wait();
+    CHECK_EQ(display_flush_get_stats().waits, 1);
+    CHECK_EQ(fake.finishes, 1);
+}
+
+static void test_complete_is_idempotent() {
+    lv_display_t disp;
+    fake = {};
+    display_flush_init(&disp, &CALLBACK);
+
+    display_flush_complete();                 // Nothing in flight
+    CHECK_EQ(disp.flush_ready_calls, 0);
+
+    disp.flush_cb(&disp, &AREA, px);
+    display_flush_complete();
+    display_flush_complete();
+    CHECK_EQ(disp.flush_ready_calls, 1);
+    CHECK(!display_flush_busy());
+
+    // Completed without a wait: the next flush releases the bus first
+    CHECK_EQ(fake.finishes, 0);
+    disp.flush_cb(&disp, &AREA, px);
+    CHECK_EQ(fake.finishes, 1);
+    CHECK_EQ(fake.starts, 2);
+    CHECK_EQ(display_flush_get_stats().waits, 0);
+}
+
+static void test_wait_for_completion_callback() {
+    lv_display_t disp;
+    fake = {};
+    display_flush_init(&disp, &CALLBACK);
+
+    disp.flush_cb(&disp, &AREA, px);
+
+    // Completion arrives from another context (DMA done callback) while the task waits
+    std::atomic<bool> waiting(false);
+    std::thread dma([&waiting] {
+        while (!waiting) std::this_thread::yield();
+        app_task_delay_ms(5);
+        display_flush_complete();
+    });
+    waiting = true;
+    display_flush_wait();
+    dma.join();
+
+    CHECK(!display_flush_busy());
+    CHECK_EQ(disp.flush_ready_calls, 1);
+    CHECK_EQ(fake.finishes, 1);
+    CHECK(display_flush_get_stats().max_wait_ms >= 4);
+}
+
+int main() {
+    RUN_TEST(test_flush_starts_and_returns);
+    RUN_TEST(test_wait_polls_until_done);
+    RUN_TEST(test_complete_is_idempotent);
+    RUN_TEST(test_wait_for_completion_callback);
+    return TEST_RESULT();
+}
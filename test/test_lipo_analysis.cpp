@@ -0,0 +1,240 @@
+// test/test_lipo_analysis.cpp - Cell count and IR estimate on synthetic traces
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "lipo_analysis.h"
+#include "lipo_trace_file.h"
+#include "test_check.h"
+
+namespace {
+    constexpr uint32_t PERIOD_US = 2000;        // One oversampling block
+    constexpr size_t LOAD_ON = 100;
+    constexpr size_t SAMPLES = 300;
+    constexpr uint32_t LOAD_MILLIOHM = 2000;
+
+    // Pack under a switched load: per cell open-circuit voltage, ohmic drop and a
+    // slow linear polarization sag while loaded, +-noise mV on every tap
+    struct SynthPack {
+        uint8_t cells;
+        float cell_mv[LIPO_ANALYSIS_MAX_CELLS];
+        float ir_mohm[LIPO_ANALYSIS_MAX_CELLS];
+        uint32_t load_milliohm;
+        int noise;
+    };
+
+    struct SynthTrace {
+        std::vector<uint16_t> tap[LIPO_ANALYSIS_MAX_CELLS];
+        LipoTrace trace;
+        float current_a;
+    };
+
+    int32_t noise(int amp) {
+        return amp ? static_cast<int32_t>(rand() % (2 * amp + 1)) - amp : 0;
+    }
+
+    SynthTrace synth(const SynthPack& p) {
+        SynthTrace s = {};
+        float ocv = 0.0f, ir = 0.0f;
+        for (uint8_t c = 0; c < p.cells; c++) {
+            ocv += p.cell_mv[c];
+            ir += p.ir_mohm[c];
+        }
+        s.current_a = ocv / (p.load_milliohm + ir);    // mV / mOhm = A
+
+        for (size_t k = 0; k < SAMPLES; k++) {
+            // Sample LOAD_ON - 1 straddles the switching: half loaded
+            float on = (k >= LOAD_ON) ? 1.0f : (k == LOAD_ON - 1) ? 0.5f : 0.0f;
+            float sag_per_sample = (k >= LOAD_ON) ? 0.05f * (k - (LOAD_ON - 1)) : 0.0f;
+            float tap = 0.0f;
+            for (uint8_t c = 0; c < p.cells; c++) {
+                tap += p.cell_mv[c] - on * s.current_a * p.ir_mohm[c] - sag_per_sample;
+                s.tap[c].push_back(static_cast<uint16_t>(lroundf(tap) + noise(p.noise)));
+            }
+        }
+        s.trace.taps = p.cells;
+        for (uint8_t c = 0; c < p.cells; c++) s.trace.tap_mv[c] = s.tap[c].data();
+        s.trace.samples = SAMPLES;
+        s.trace.period_us = PERIOD_US;
+        s.trace.load_on = LOAD_ON;
+        s.trace.load_off = SAMPLES;
+        s.trace.load_milliohm = p.load_milliohm;
+        return s;
+    }
+
+    const SynthPack PACK_3S = { 3, { 3800, 3850, 3900 }, { 4.0f, 6.0f, 9.5f }, LOAD_MILLIOHM, 4 };
+}
+
+static void test_cells() {
+    const uint16_t s1[] = { 3800 };
+    LipoCells c = lipo_cells_from_taps(s1, 1);
+    CHECK_EQ(c.count, 1);
+    CHECK_EQ(c.total_mv, 3800);
+
+    const uint16_t s2[] = { 3800, 7650 };
+    c = lipo_cells_from_taps(s2, 2);
+    CHECK_EQ(c.count, 2);
+    CHECK_EQ(c.cell_mv[1], 3850);
+    CHECK(!c.implausible);
+
+    const uint16_t s3[] = { 3800, 7650, 11550 };
+    c = lipo_cells_from_taps(s3, 3);
+    CHECK_EQ(c.count, 3);
+    CHECK_EQ(c.cell_mv[2], 3900);
+    CHECK_EQ(c.total_mv, 11550);
+
+    // 2S on a 3-tap connector: the open tap floats close to the one below
+    const uint16_t open_high[] = { 3800, 7650, 7660 };
+    c = lipo_cells_from_taps(open_high, 3);
+    CHECK_EQ(c.count, 2);
+    CHECK(!c.implausible);
+
+    // Unconnected tap reads near 0
+    const uint16_t open_low[] = { 3800, 120, 90 };
+    c = lipo_cells_from_taps(open_low, 3);
+    CHECK_EQ(c.count, 1);
+    CHECK(!c.implausible);
+
+    // Tap above a cell count that does not look like a LiPo cell
+    const uint16_t odd[] = { 3800, 7650, 9000 };
+    c = lipo_cells_from_taps(odd, 3);
+    CHECK_EQ(c.count, 2);
+    CHECK(c.implausible);
+
+    const uint16_t none[] = { 0, 0, 0 };
+    c = lipo_cells_from_taps(none, 3);
+    CHECK_EQ(c.count, 0);
+    CHECK_EQ(c.total_mv, 0);
+}
+
+static void test_fit_line() {
+    std::vector<float> y;
+    for (int k = 0; k < 50; k++) y.push_back(100.0f + 2.0f * k);
+    auto at = [&y](size_t k) { return y[k]; };
+
+    LipoLineFit f = lipo_fit_line(at, 0, y.size(), 60.0f);
+    CHECK_NEAR(f.at_x0, 220.0f, 1e-3);
+    CHECK_EQ(f.rejected, 0);
+    CHECK_EQ(f.used, 50);
+
+    y[10] += 40.0f;
+    y[30] -= 40.0f;
+    f = lipo_fit_line(at, 0, y.size(), 60.0f);
+    CHECK_NEAR(f.at_x0, 220.0f, 1e-3);
+    CHECK_EQ(f.rejected, 2);
+
+    // Too few samples
+    f = lipo_fit_line(at, 0, 2, 0.0f);
+    CHECK_EQ(f.used, 0);
+}
+
+static void test_ir_recovered() {
+    srand(1);
+    SynthTrace s = synth(PACK_3S);
+    LipoIrResult r = lipo_estimate_ir(s.trace);
+    CHECK(r.valid);
+    CHECK_EQ(r.cells, 3);
+    CHECK_NEAR(r.current_ma, s.current_a * 1000.0f, 10.0);
+    for (uint8_t c = 0; c < 3; c++) {
+        // Within 3 sigma, plus the 0.1 mOhm result resolution
+        float got = r.ir_x10_mohm[c] / 10.0f;
+        float sigma = r.uncertainty_x10_mohm[c] / 10.0f;
+        CHECK(sigma > 0.0f);
+        CHECK_NEAR(got, PACK_3S.ir_mohm[c], 3.0f * sigma + 0.1f);
+    }
+    CHECK(r.confidence_permille > 500);
+}
+
+static void test_ir_outliers() {
+    srand(2);
+    SynthTrace s = synth(PACK_3S);
+    // Spikes on the middle tap, before and under load (each disturbs two cells)
+    const size_t spikes[] = { 20, 60, 150, 220, 280 };
+    for (size_t k : spikes) s.tap[1][k] += 150;
+
+    LipoIrResult r = lipo_estimate_ir(s.trace);
+    CHECK(r.valid);
+    CHECK(r.rejected >= 2 * (sizeof(spikes) / sizeof(spikes[0])));
+    for (uint8_t c = 0; c < 3; c++) {
+        float sigma = r.uncertainty_x10_mohm[c] / 10.0f;
+        CHECK_NEAR(r.ir_x10_mohm[c] / 10.0f, PACK_3S.ir_mohm[c], 3.0f * sigma + 0.1f);
+    }
+}
+
+static void test_ir_invalid() {
+    srand(3);
+    SynthTrace s = synth(PACK_3S);
+    LipoTrace t = s.trace;
+    t.load_on = 3;
+    CHECK(!lipo_estimate_ir(t).valid);
+
+    // Load window shorter than the settling time
+    t = s.trace;
+    t.load_off = LOAD_ON + 5;
+    CHECK(!lipo_estimate_ir(t).valid);
+
+    // 100 Ohm: ~115 mA, below LIPO_IR_MIN_CURRENT_MA (load not connected)
+    SynthPack weak = PACK_3S;
+    weak.load_milliohm = 100000;
+    SynthTrace w = synth(weak);
+    LipoIrResult r = lipo_estimate_ir(w.trace);
+    CHECK(!r.valid);
+    CHECK_EQ(r.cells, 3);
+    CHECK(r.current_ma < LIPO_IR_MIN_CURRENT_MA);
+
+    // No battery
+    const uint16_t zero[SAMPLES] = {};
+    t = s.trace;
+    for (uint8_t c = 0; c < t.taps; c++) t.tap_mv[c] = zero;
+    CHECK(!lipo_estimate_ir(t).valid);
+}
+
+static void test_trace_file() {
+    srand(4);
+    SynthTrace s = synth(PACK_3S);
+    std::string path = std::string(P_tmpdir) + "/test_lipo_analysis.trace";
+    FILE* fp = fopen(path.c_str(), "w");
+    CHECK(fp != nullptr);
+    if (!fp) return;
+    fprintf(fp, "# Synthetic 3S pack\nperiod_us %u\nload_milliohm %u\nload_on %zu\n",
+            static_cast<unsigned>(PERIOD_US), static_cast<unsigned>(LOAD_MILLIOHM), LOAD_ON);
+    fprintf(fp, "expect_ir_x10_mohm 40 60 95\n");
+    for (size_t k = 0; k < SAMPLES; k++) {
+        fprintf(fp, "%u %u %u\n", s.tap[0][k], s.tap[1][k], s.tap[2][k]);
+    }
+    fclose(fp);
+
+    LipoTraceFile f;
+    std::string error;
+    CHECK(lipo_trace_read(path.c_str(), f, error));
+    CHECK_EQ(f.trace.taps, 3);
+    CHECK_EQ(f.trace.samples, SAMPLES);
+    CHECK_EQ(f.trace.load_off, SAMPLES);
+    CHECK_EQ(f.expect_count, 3);
+    CHECK_EQ(f.expect_ir_x10_mohm[2], 95);
+
+    // Same result as the in-memory trace
+    LipoIrResult a = lipo_estimate_ir(s.trace);
+    LipoIrResult b = lipo_estimate_ir(f.trace);
+    CHECK(b.valid);
+    for (uint8_t c = 0; c < 3; c++) CHECK_EQ(a.ir_x10_mohm[c], b.ir_x10_mohm[c]);
+
+    // Malformed: sample with a different tap count
+    fp = fopen(path.c_str(), "a");
+    fprintf(fp, "3800 7650\n");
+    fclose(fp);
+    CHECK(!lipo_trace_read(path.c_str(), f, error));
+    CHECK(error.find(":306:") != std::string::npos);
+    remove(path.c_str());
+}
+
+int main() {
+    RUN_TEST(test_cells);
+    RUN_TEST(test_fit_line);
+    RUN_TEST(test_ir_recovered);
+    RUN_TEST(test_ir_outliers);
+    RUN_TEST(test_ir_invalid);
+    RUN_TEST(test_trace_file);
+    return TEST_RESULT();
+}
@@ -0,0 +1,141 @@
+// test/test_msg_queue.cpp - MsgQueue (host implementation) under concurrent load
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "msg_queue.h"
+#include "test_check.h"
+
+namespace {
+    struct Msg {
+        uint16_t producer;
+        uint32_t seq;
+    };
+
+    constexpr size_t QUEUE_LEN = 8;
+    constexpr uint16_t PRODUCERS = 4;
+    constexpr uint16_t CONSUMERS = 3;
+    constexpr uint32_t PER_PRODUCER = 20000;
+    constexpr uint16_t STOP = 0xFFFF;       // Producer id of the consumer stop message
+
+    uint32_t elapsed_ms(std::chrono::steady_clock::time_point start) {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+}
+
+static void test_fifo_and_capacity() {
+    MsgQueue<Msg, QUEUE_LEN> q;
+    for (uint32_t i = 0; i < QUEUE_LEN; i++) CHECK(q.send({ 0, i }));
+    CHECK_EQ(q.count(), QUEUE_LEN);
+    CHECK(!q.send({ 0, 99 }));              // Full, no wait
+    CHECK(!q.send_from_isr({ 0, 99 }));
+
+    // Wrap the ring a few times
+    Msg m;
+    for (uint32_t i = 0; i < 3 * QUEUE_LEN; i++) {
+        CHECK(q.receive(m, 0));
+        CHECK_EQ(m.seq, i);
+        CHECK(q.send({ 0, static_cast<uint32_t>(i + QUEUE_LEN) }));
+    }
+    CHECK_EQ(q.count(), QUEUE_LEN);
+}
+
+static void test_timeouts() {
+    MsgQueue<Msg, 2> q;
+    Msg m;
+
+    auto start = std::chrono::steady_clock::now();
+    CHECK(!q.receive(m, 20));
+    CHECK(elapsed_ms(start) >= 19);
+
+    q.send({ 0, 1 });
+    q.send({ 0, 2 });
+    start = std::chrono::steady_clock::now();
+    CHECK(!q.send({ 0, 3 }, 20));
+    CHECK(elapsed_ms(start) >= 19);
+    CHECK_EQ(q.count(), 2);
+}
+
+static void test_blocked_sender_wakes() {
+    MsgQueue<Msg, 1> q;
+    q.send({ 0, 1 });
+
+    std::thread consumer([&q] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        Msg m;
+        q.receive(m);
+    });
+    CHECK(q.send({ 0, 2 }, MSG_WAIT_FOREVER));
+    consumer.join();
+
+    Msg m;
+    CHECK(q.receive(m, 0));
+    CHECK_EQ(m.seq, 2);
+}
+
+// Several producers and consumers through a small queue: every message arrives
+// exactly once, and each producer's messages arrive in order
+static void test_stress_many_to_many() {
+    MsgQueue<Msg, QUEUE_LEN> q;
+    std::vector<std::vector<uint32_t>> received(CONSUMERS);
+
+    std::vector<std::thread> consumers;
+    for (uint16_t c = 0; c < CONSUMERS; c++) {
+        consumers.emplace_back([&q, &received, c] {
+            uint32_t last[PRODUCERS];
+            for (auto& l : last) l = UINT32_MAX;
+            bool in_order = true;
+            Msg m;
+            while (q.receive(m), m.producer != STOP) {
+                // Per producer, a consumer only ever sees increasing sequence numbers
+                if (last[m.producer] != UINT32_MAX && m.seq <= last[m.producer]) in_order = false;
+                last[m.producer] = m.seq;
+                received[c].push_back(m.producer * PER_PRODUCER + m.seq);
+            }
+            if (!in_order) received[c].push_back(UINT32_MAX);
+        });
+    }
+
+    std::vector<std::thread> producers;
+    for (uint16_t p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([&q, p] {
+            for (uint32_t i = 0; i < PER_PRODUCER; i++) {
+                // Mix blocking and retried non-blocking sends
+                if (i & 1) {
+                    q.send({ p, i }, MSG_WAIT_FOREVER);
+                } else {
+                    while (!q.send({ p, i }, 0)) std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : producers) t.join();
+    for (uint16_t c = 0; c < CONSUMERS; c++) q.send({ STOP, 0 }, MSG_WAIT_FOREVER);
+    for (auto& t : consumers) t.join();
+
+    std::vector<uint8_t> seen(PRODUCERS * PER_PRODUCER, 0);
+    size_t total = 0;
+    bool order_ok = true;
+    for (const auto& r : received) {
+        for (uint32_t id : r) {
+            if (id == UINT32_MAX) { order_ok = false; continue; }
+            seen[id]++;
+            total++;
+        }
+    }
+    CHECK(order_ok);
+    CHECK_EQ(total, PRODUCERS * PER_PRODUCER);
+    size_t dup_or_lost = 0;
+    for (uint8_t s : seen) if (s != 1) dup_or_lost++;
+    CHECK_EQ(dup_or_lost, 0);
+    CHECK_EQ(q.count(), 0);
+}
+
+int main() {
+    RUN_TEST(test_fifo_and_capacity);
+    RUN_TEST(test_timeouts);
+    RUN_TEST(test_blocked_sender_wakes);
+    RUN_TEST(test_stress_many_to_many);
+    return TEST_RESULT();
+}
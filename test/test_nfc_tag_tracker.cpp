@@ -0,0 +1,94 @@
+// test/test_nfc_tag_tracker.cpp - Tag presence state machine driven by a fake PN532
+
+#include <string.h>
+#include "src/nfc_tag_tracker.h"
+#include "test_check.h"
+
+namespace {
+    // Scripted reader: one entry per detection cycle, uid_len 0 = search timed out
+    struct ReaderResult {
+        uint8_t uid_len;
+        uint8_t uid[NFC_UID_MAX_LEN];
+    };
+
+    class FakePn532 {
+    public:
+        FakePn532(const ReaderResult* script, size_t count) : script_(script), count_(count) {}
+
+        bool has_next() const { return next_ < count_; }
+
+        // One detection cycle, as nfc_pn532_service() feeds the tracker
+        NfcTagEvent cycle(NfcTagTracker& tracker) {
+            const ReaderResult& r = script_[next_++];
+            return r.uid_len ? tracker.on_tag(r.uid, r.uid_len) : tracker.on_no_tag();
+        }
+
+    private:
+        const ReaderResult* script_;
+        size_t count_;
+        size_t next_ = 0;
+    };
+
+    const ReaderResult NONE = { 0, {} };
+    const ReaderResult TAG_A = { 4, { 0xDE, 0xAD, 0xBE, 0xEF } };
+    const ReaderResult TAG_B = { 7, { 0x04, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66 } };
+    const ReaderResult TAG_A_PREFIX = { 3, { 0xDE, 0xAD, 0xBE } };   // Same bytes, shorter UID
+}
+
+static void test_arrival_hold_removal() {
+    const ReaderResult script[] = { NONE, TAG_A, TAG_A, TAG_A, NONE, NONE };
+    const NfcTagEvent expect[] = {
+        NfcTagEvent::NONE, NfcTagEvent::ARRIVED, NfcTagEvent::NONE,
+        NfcTagEvent::NONE, NfcTagEvent::REMOVED, NfcTagEvent::NONE,
+    };
+    FakePn532 reader(script, sizeof(script) / sizeof(script[0]));
+    NfcTagTracker tracker;
+    for (size_t i = 0; reader.has_next(); i++) {
+        CHECK(reader.cycle(tracker) == expect[i]);
+    }
+    CHECK(!tracker.tag_present());
+}
+
+static void test_tag_swap_reports_arrival() {
+    const ReaderResult script[] = { TAG_A, TAG_B, TAG_B, TAG_A_PREFIX };
+    FakePn532 reader(script, 4);
+    NfcTagTracker tracker;
+
+    CHECK(reader.cycle(tracker) == NfcTagEvent::ARRIVED);
+    CHECK(reader.cycle(tracker) == NfcTagEvent::ARRIVED);
+    CHECK_EQ(tracker.uid_len(), 7);
+    CHECK(memcmp(tracker.uid(), TAG_B.uid, 7) == 0);
+    CHECK(reader.cycle(tracker) == NfcTagEvent::NONE);
+
+    // Length is part of the identity
+    CHECK(reader.cycle(tracker) == NfcTagEvent::ARRIVED);
+    CHECK_EQ(tracker.uid_len(), 3);
+    CHECK_EQ(tracker.uid()[3], 0);   // Tail of the longer UID cleared
+}
+
+static void test_oversized_uid_clamped() {
+    uint8_t uid[NFC_UID_MAX_LEN + 4];
+    for (uint8_t i = 0; i < sizeof(uid); i++) uid[i] = i + 1;
+    NfcTagTracker tracker;
+    CHECK(tracker.on_tag(uid, sizeof(uid)) == NfcTagEvent::ARRIVED);
+    CHECK_EQ(tracker.uid_len(), NFC_UID_MAX_LEN);
+    CHECK(tracker.on_tag(uid, sizeof(uid)) == NfcTagEvent::NONE);
+}
+
+static void test_reset_is_silent() {
+    NfcTagTracker tracker;
+    tracker.on_tag(TAG_A.uid, TAG_A.uid_len);
+    tracker.reset();
+    CHECK(!tracker.tag_present());
+    CHECK_EQ(tracker.uid_len(), 0);
+    CHECK(tracker.on_no_tag() == NfcTagEvent::NONE);
+    CHECK(tracker.on_tag(TAG_A.uid, TAG_A.uid_len) == NfcTagEvent::ARRIVED);
+}
+
+int main() {
+    RUN_TEST(test_arrival_hold_removal);
+    RUN_TEST(test_tag_swap_reports_arrival);
+    RUN_TEST(test_oversized_uid_clamped);
+    RUN_TEST(test_reset_is_silent);
+    return TEST_RESULT();
+}
@@ -0,0 +1,104 @@
+// test/test_pn532_frame.cpp - PN532 frames against recorded bytes
+
+#include <string.h>
+#include "src/pn532_frame.h"
+#include "test_check.h"
+
+namespace {
+    // Recorded on the Elechouse V3 (status byte stripped)
+    const uint8_t ACK[] = { 0x00, 0x00, 0xFF, 0x00, 0xFF, 0x00 };
+    const uint8_t FIRMWARE[] = { 0x00, 0x00, 0xFF, 0x06, 0xFA, 0xD5, 0x03, 0x32, 0x01, 0x06, 0x07, 0xE8, 0x00 };
+    const uint8_t SAM_OK[] = { 0x00, 0x00, 0xFF, 0x02, 0xFE, 0xD5, 0x15, 0x16, 0x00 };
+    const uint8_t TARGET_4B[] = {
+        0x00, 0x00, 0xFF, 0x0C, 0xF4, 0xD5, 0x4B,
+        0x01, 0x01, 0x00, 0x04, 0x08, 0x04, 0xDE, 0xAD, 0xBE, 0xEF,
+        0x96, 0x00 };
+    const uint8_t ERROR_FRAME[] = { 0x00, 0x00, 0xFF, 0x01, 0xFF, 0x7F, 0x81, 0x00 };
+}
+
+static void test_build_command() {
+    uint8_t out[32];
+    // GetFirmwareVersion, as sent by test_pn532_standalone
+    const uint8_t expect_fw[] = { 0x00, 0x00, 0xFF, 0x02, 0xFE, 0xD4, 0x02, 0x2A, 0x00 };
+    size_t n = pn532_build_command(out, PN532_CMD_GET_FIRMWARE_VERSION, nullptr, 0);
+    CHECK_EQ(n, sizeof(expect_fw));
+    CHECK(memcmp(out, expect_fw, n) == 0);
+
+    const uint8_t sam[] = { 0x01, 0x14, 0x01 };
+    const uint8_t expect_sam[] = { 0x00, 0x00, 0xFF, 0x05, 0xFB, 0xD4, 0x14, 0x01, 0x14, 0x01, 0x02, 0x00 };
+    n = pn532_build_command(out, PN532_CMD_SAM_CONFIGURATION, sam, sizeof(sam));
+    CHECK_EQ(n, sizeof(sam) + PN532_COMMAND_OVERHEAD);
+    CHECK(memcmp(out, expect_sam, n) == 0);
+}
+
+static void test_ack() {
+    CHECK(pn532_is_ack(ACK, sizeof(ACK)));
+    CHECK(!pn532_is_ack(ACK, 4));
+    CHECK(!pn532_is_ack(FIRMWARE, sizeof(FIRMWARE)));
+    const uint8_t nack[] = { 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00 };
+    CHECK(!pn532_is_ack(nack, sizeof(nack)));
+    const uint8_t not_ready[] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    CHECK(!pn532_is_ack(not_ready, sizeof(not_ready)));
+}
+
+static void test_parse_response() {
+    const uint8_t* d = nullptr;
+    CHECK_EQ(pn532_parse_response(FIRMWARE, sizeof(FIRMWARE), PN532_CMD_GET_FIRMWARE_VERSION, &d), 4);
+    CHECK_EQ(d[0], 0x32);                   // PN532
+    CHECK_EQ(d[1], 1);
+    CHECK_EQ(d[2], 6);
+
+    CHECK_EQ(pn532_parse_response(SAM_OK, sizeof(SAM_OK), PN532_CMD_SAM_CONFIGURATION, &d), 0);
+
+    // Longer preamble and padding after the frame (fixed-size I2C read)
+    uint8_t padded[40] = { 0x00 };
+    memcpy(padded + 1, FIRMWARE, sizeof(FIRMWARE));
+    memset(padded + 1 + sizeof(FIRMWARE), 0xA5, sizeof(padded) - 1 - sizeof(FIRMWARE));
+    CHECK_EQ(pn532_parse_response(padded, sizeof(padded), PN532_CMD_GET_FIRMWARE_VERSION, &d), 4);
+    CHECK_EQ(d[0], 0x32);
+}
+
+static void test_parse_rejects() {
+    const uint8_t* d = nullptr;
+    CHECK_EQ(pn532_parse_response(FIRMWARE, sizeof(FIRMWARE), PN532_CMD_SAM_CONFIGURATION, &d), -1);
+    CHECK_EQ(pn532_parse_response(FIRMWARE, 11, PN532_CMD_GET_FIRMWARE_VERSION, &d), -1);    // No DCS
+    CHECK_EQ(pn532_parse_response(ACK, sizeof(ACK), PN532_CMD_GET_FIRMWARE_VERSION, &d), -1);
+    CHECK_EQ(pn532_parse_response(ERROR_FRAME, sizeof(ERROR_FRAME), PN532_CMD_GET_FIRMWARE_VERSION, &d), -1);
+
+    uint8_t bad[sizeof(FIRMWARE)];
+    memcpy(bad, FIRMWARE, sizeof(bad));
+    bad[8] ^= 0x01;                         // Data checksum
+    CHECK_EQ(pn532_parse_response(bad, sizeof(bad), PN532_CMD_GET_FIRMWARE_VERSION, &d), -1);
+    memcpy(bad, FIRMWARE, sizeof(bad));
+    bad[4] = 0xFB;                          // Length checksum
+    CHECK_EQ(pn532_parse_response(bad, sizeof(bad), PN532_CMD_GET_FIRMWARE_VERSION, &d), -1);
+    memcpy(bad, FIRMWARE, sizeof(bad));
+    bad[0] = 0x01;                          // Garbage instead of the preamble
+    CHECK_EQ(pn532_parse_response(bad, sizeof(bad), PN532_CMD_GET_FIRMWARE_VERSION, &d), -1);
+}
+
+static void test_target_uid() {
+    const uint8_t* d = nullptr;
+    int n = pn532_parse_response(TARGET_4B, sizeof(TARGET_4B), PN532_CMD_IN_LIST_PASSIVE_TARGET, &d);
+    CHECK_EQ(n, 10);
+
+    uint8_t uid[10] = {};
+    CHECK_EQ(pn532_target_uid(d, n, uid, sizeof(uid)), 4);
+    const uint8_t expect[] = { 0xDE, 0xAD, 0xBE, 0xEF };
+    CHECK(memcmp(uid, expect, 4) == 0);
+
+    CHECK_EQ(pn532_target_uid(d, n, uid, 3), 0);    // Does not fit
+    CHECK_EQ(pn532_target_uid(d, n - 1, uid, 10), 0);   // UID cut off
+
+    const uint8_t none[] = { 0x00 };                // NbTg = 0
+    CHECK_EQ(pn532_target_uid(none, 1, uid, 10), 0);
+}
+
+int main() {
+    RUN_TEST(test_build_command);
+    RUN_TEST(test_ack);
+    RUN_TEST(test_parse_response);
+    RUN_TEST(test_parse_rejects);
+    RUN_TEST(test_target_uid);
+    return TEST_RESULT();
+}
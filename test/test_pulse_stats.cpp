@@ -0,0 +1,127 @@
+// test/test_pulse_stats.cpp - Capture statistics on synthetic edge streams
+
+#include "pulse_stats.h"
+#include "test_check.h"
+
+namespace {
+    constexpr uint32_t CLK_HZ = 80000000;           // MCPWM capture clock: 12.5 ns ticks
+    constexpr uint32_t PERIOD_50HZ = 1600000;       // 20 ms
+    constexpr uint32_t WIDTH_1500US = 120000;
+
+    // Feed frames [first, last) of a regular stream; width_delta alternates +/- per frame
+    void feed(PulseStats& s, uint32_t t0, uint32_t first, uint32_t last,
+              uint32_t period, uint32_t width, int32_t width_delta = 0) {
+        for (uint32_t k = first; k < last; k++) {
+            uint32_t rise = t0 + k * period;
+            int32_t delta = (k & 1) ? width_delta : -width_delta;
+            s.on_edge(true, rise);
+            s.on_edge(false, rise + width + delta);
+        }
+    }
+}
+
+static void test_steady_stream() {
+    PulseStats s(CLK_HZ);
+    feed(s, 1000, 0, 50, PERIOD_50HZ, WIDTH_1500US);
+    PulseReport r = s.take_report();
+    CHECK(r.signal);
+    CHECK_EQ(r.pulses, 50);
+    CHECK_EQ(r.width_ns, 1500000);
+    CHECK_EQ(r.width_mean_ns, 1500000);
+    CHECK_EQ(r.width_jitter_ns, 0);
+    CHECK_EQ(r.period_ns, 20000000);
+    CHECK_EQ(r.period_jitter_ns, 0);
+    CHECK_EQ(r.freq_mhz, 50000);
+    CHECK_EQ(r.lost_frames, 0);
+    CHECK_EQ(r.glitches, 0);
+}
+
+static void test_width_jitter_and_minmax() {
+    PulseStats s(CLK_HZ);
+    feed(s, 0, 0, 40, PERIOD_50HZ, WIDTH_1500US, 80);      // +/- 1 us
+    PulseReport r = s.take_report();
+    CHECK_EQ(r.width_mean_ns, 1500000);
+    CHECK_EQ(r.width_jitter_ns, 1000);
+    CHECK_EQ(r.width_min_ns, 1499000);
+    CHECK_EQ(r.width_max_ns, 1501000);
+
+    // New window: statistics restart, min/max are kept until reset()
+    feed(s, 0, 40, 50, PERIOD_50HZ, WIDTH_1500US);
+    r = s.take_report();
+    CHECK_EQ(r.pulses, 10);
+    CHECK_EQ(r.width_jitter_ns, 0);
+    CHECK_EQ(r.width_min_ns, 1499000);
+    CHECK_EQ(r.width_max_ns, 1501000);
+
+    s.reset();
+    feed(s, 0, 0, 5, PERIOD_50HZ, WIDTH_1500US);
+    r = s.take_report();
+    CHECK_EQ(r.width_min_ns, 1500000);
+    CHECK_EQ(r.width_max_ns, 1500000);
+}
+
+static void test_counter_wrap() {
+    PulseStats s(CLK_HZ);
+    // Counter wraps in the middle of the stream (and inside a pulse)
+    uint32_t t0 = UINT32_MAX - 3 * PERIOD_50HZ - WIDTH_1500US / 2;
+    feed(s, t0, 0, 10, PERIOD_50HZ, WIDTH_1500US);
+    PulseReport r = s.take_report();
+    CHECK_EQ(r.pulses, 10);
+    CHECK_EQ(r.width_max_ns, 1500000);
+    CHECK_EQ(r.period_ns, 20000000);
+    CHECK_EQ(r.period_jitter_ns, 0);
+}
+
+static void test_lost_frames() {
+    PulseStats s(CLK_HZ);
+    feed(s, 0, 0, 10, PERIOD_50HZ, WIDTH_1500US);
+    feed(s, 0, 12, 20, PERIOD_50HZ, WIDTH_1500US);     // Frames 10, 11 missing
+    feed(s, 0, 25, 30, PERIOD_50HZ, WIDTH_1500US);     // Frames 20..24 missing
+    PulseReport r = s.take_report();
+    CHECK_EQ(r.lost_frames, 7);
+    CHECK_EQ(r.period_ns, 20000000);                  // Gaps kept out of the period
+    CHECK_EQ(r.period_jitter_ns, 0);
+    CHECK_EQ(r.pulses, 23);
+}
+
+static void test_missing_edges() {
+    PulseStats s(CLK_HZ);
+    s.on_edge(false, 10);                   // Falling before any rise: ignored
+    s.on_edge(true, 0 * PERIOD_50HZ);
+    s.on_edge(false, 0 * PERIOD_50HZ + WIDTH_1500US);
+    s.on_edge(true, 1 * PERIOD_50HZ);       // Falling edge of this frame lost
+    s.on_edge(true, 2 * PERIOD_50HZ);
+    s.on_edge(false, 2 * PERIOD_50HZ + WIDTH_1500US);
+    s.on_edge(false, 3 * PERIOD_50HZ);      // Rising edge lost
+    s.on_edge(true, 4 * PERIOD_50HZ);
+    s.on_edge(false, 4 * PERIOD_50HZ + WIDTH_1500US);
+    PulseReport r = s.take_report();
+    CHECK_EQ(r.glitches, 2);
+    CHECK_EQ(r.pulses, 3);                  // No bogus widths from the broken frames
+    CHECK_EQ(r.width_max_ns, 1500000);
+    CHECK_EQ(r.width_min_ns, 1500000);
+}
+
+static void test_no_signal_and_fast_rate() {
+    PulseStats s(CLK_HZ);
+    PulseReport r = s.take_report();
+    CHECK(!r.signal);
+    CHECK_EQ(r.freq_mhz, 0);
+
+    // 333 Hz digital servo frame: 3 ms period
+    feed(s, 0, 0, 20, 240000, 80000);
+    r = s.take_report();
+    CHECK_EQ(r.period_ns, 3000000);
+    CHECK_EQ(r.freq_mhz, 333333);
+    CHECK_EQ(r.width_ns, 1000000);
+}
+
+int main() {
+    RUN_TEST(test_steady_stream);
+    RUN_TEST(test_width_jitter_and_minmax);
+    RUN_TEST(test_counter_wrap);
+    RUN_TEST(test_lost_frames);
+    RUN_TEST(test_missing_edges);
+    RUN_TEST(test_no_signal_and_fast_rate);
+    return TEST_RESULT();
+}
@@ -0,0 +1,299 @@
+// test/test_rc_decoders.cpp - SBUS / iBUS / PPM decoders on recorded streams
+
+#include <string.h>
+#include <vector>
+#include "rc_decoders.h"
+#include "test_check.h"
+
+namespace {
+    typedef std::vector<uint8_t> Bytes;
+
+    // --- Stream builders (the transmitter side of each protocol) ---
+
+    // SBUS frame: 16 x 11 bit channels packed LSB first
+    Bytes sbus_frame(const uint16_t raw[16], uint8_t flags, uint8_t footer = 0x00) {
+        Bytes f(SbusDecoder::FRAME_LEN, 0);
+        f[0] = SbusDecoder::HEADER;
+        uint32_t bits = 0;
+        uint8_t nbits = 0;
+        size_t pos = 1;
+        for (int i = 0; i < 16; i++) {
+            bits |= static_cast<uint32_t>(raw[i] & 0x7FF) << nbits;
+            nbits += 11;
+            while (nbits >= 8) {
+                f[pos++] = bits & 0xFF;
+                bits >>= 8;
+                nbits -= 8;
+            }
+        }
+        f[23] = flags;
+        f[24] = footer;
+        return f;
+    }
+
+    // iBUS frame: 14 little-endian words, checksum = 0xFFFF - sum of the other bytes
+    Bytes ibus_frame(const uint16_t words[14], bool corrupt_checksum = false) {
+        Bytes f;
+        f.push_back(IbusDecoder::HEADER_LEN);
+        f.push_back(IbusDecoder::HEADER_CMD);
+        for (int i = 0; i < 14; i++) {
+            f.push_back(words[i] & 0xFF);
+            f.push_back(words[i] >> 8);
+        }
+        uint16_t sum = 0;
+        for (uint8_t b : f) sum += b;
+        uint16_t checksum = 0xFFFF - sum;
+        if (corrupt_checksum) checksum ^= 0x0100;
+        f.push_back(checksum & 0xFF);
+        f.push_back(checksum >> 8);
+        return f;
+    }
+
+    void append(Bytes& stream, const Bytes& more) {
+        stream.insert(stream.end(), more.begin(), more.end());
+    }
+
+    template <typename Decoder>
+    int feed(Decoder& d, const Bytes& stream) {
+        int frames = 0;
+        for (uint8_t b : stream) frames += d.push(b);
+        return frames;
+    }
+
+    // PPM edge stream at the 80 MHz capture clock: a 300 us pulse starts each slot
+    constexpr uint32_t PPM_CLK_HZ = 80000000;
+    constexpr uint32_t TICKS_PER_US = PPM_CLK_HZ / 1000000;
+
+    struct PpmStream {
+        PpmDecoder& dec;
+        uint32_t t;
+        int frames = 0;
+        bool pulsed = false;    // Pulse at t already sent
+
+        void pulse() {
+            frames += dec.on_edge(true, t);
+            frames += dec.on_edge(false, t + 300 * TICKS_PER_US);
+            pulsed = true;
+        }
+        // One slot of us microseconds (pulse at its start)
+        void slot(uint32_t us) {
+            if (!pulsed) pulse();
+            pulsed = false;
+            t += us * TICKS_PER_US;
+        }
+        // Channels, sync gap, and the pulse that ends the gap (reports the frame)
+        void frame(const uint16_t* ch, int n, uint32_t sync_us = 10000) {
+            for (int i = 0; i < n; i++) slot(ch[i]);
+            slot(sync_us);
+            pulse();
+        }
+    };
+
+    const uint16_t RAW_CENTER = 992;
+}
+
+static void test_sbus_channels() {
+    uint16_t raw[16];
+    for (int i = 0; i < 16; i++) raw[i] = RAW_CENTER;
+    raw[0] = 192;       // 1000 us
+    raw[1] = 1792;      // 2000 us
+    raw[15] = 2047;     // Highest 11 bit value, last channel
+
+    SbusDecoder d;
+    CHECK_EQ(feed(d, sbus_frame(raw, 0)), 1);
+    const RcFrame& f = d.frame();
+    CHECK_EQ(f.num_channels, 16);
+    CHECK_EQ(f.ch_us[0], 1000);
+    CHECK_EQ(f.ch_us[1], 2000);
+    CHECK_EQ(f.ch_us[2], 1500);
+    CHECK_EQ(f.ch_us[15], SbusDecoder::to_us(2047));
+    CHECK(!f.frame_lost);
+    CHECK(!f.failsafe);
+}
+
+static void test_sbus_flags() {
+    uint16_t raw[16];
+    for (int i = 0; i < 16; i++) raw[i] = RAW_CENTER;
+
+    // Recorded link loss: lost frames, then failsafe, then recovery
+    Bytes stream;
+    append(stream, sbus_frame(raw, 0));
+    append(stream, sbus_frame(raw, SbusDecoder::FLAG_FRAME_LOST));
+    append(stream, sbus_frame(raw, SbusDecoder::FLAG_FRAME_LOST));
+    append(stream, sbus_frame(raw, SbusDecoder::FLAG_FRAME_LOST | SbusDecoder::FLAG_FAILSAFE));
+    append(stream, sbus_frame(raw, 0x03));         // Digital channels 17/18 only
+    SbusDecoder d;
+    CHECK_EQ(feed(d, stream), 5);
+    CHECK_EQ(d.stats().frames, 5);
+    CHECK_EQ(d.stats().lost_frames, 3);
+    CHECK_EQ(d.stats().failsafe_frames, 1);
+    CHECK(!d.frame().frame_lost);
+    CHECK(!d.frame().failsafe);
+
+    // Last flags stick to the published frame
+    CHECK_EQ(feed(d, sbus_frame(raw, SbusDecoder::FLAG_FAILSAFE)), 1);
+    CHECK(d.frame().failsafe);
+    CHECK(!d.frame().frame_lost);
+
+    d.reset_stats();
+    CHECK_EQ(d.stats().frames, 0);
+}
+
+static void test_sbus_footer_and_resync() {
+    uint16_t raw[16];
+    for (int i = 0; i < 16; i++) raw[i] = RAW_CENTER;
+
+    Bytes stream = { 0x00, 0xFF, 0x55 };            // Line noise before the first header
+    append(stream, sbus_frame(raw, 0, 0x14));       // SBUS2 telemetry slot footer
+    append(stream, sbus_frame(raw, 0, 0x5A));       // Bad footer
+    append(stream, sbus_frame(raw, 0));
+    SbusDecoder d;
+    CHECK_EQ(feed(d, stream), 2);
+    CHECK_EQ(d.stats().frames, 2);
+    CHECK_EQ(d.stats().bad_frames, 1);
+}
+
+// SBUS idles low: on the wire every byte is the complement of the data.
+// UART1 inverts RX in hardware (uart_set_line_inverse); without that the
+// decoder must not turn the raw line bytes into frames.
+static void test_sbus_inverted_polarity() {
+    uint16_t raw[16];
+    for (int i = 0; i < 16; i++) raw[i] = static_cast<uint16_t>(172 + i * 100);
+
+    Bytes data;
+    for (int k = 0; k < 4; k++) append(data, sbus_frame(raw, k == 3 ? SbusDecoder::FLAG_FAILSAFE : 0));
+    Bytes line(data.size());
+    for (size_t i = 0; i < data.size(); i++) line[i] = static_cast<uint8_t>(~data[i]);
+
+    SbusDecoder not_inverted;
+    CHECK_EQ(feed(not_inverted, line), 0);
+    CHECK_EQ(not_inverted.stats().frames, 0);
+
+    Bytes uart(line.size());
+    for (size_t i = 0; i < line.size(); i++) uart[i] = static_cast<uint8_t>(~line[i]);
+    SbusDecoder inverted;
+    CHECK_EQ(feed(inverted, uart), 4);
+    CHECK_EQ(inverted.stats().failsafe_frames, 1);
+    CHECK_EQ(inverted.frame().ch_us[0], SbusDecoder::to_us(172));
+    CHECK_EQ(inverted.frame().ch_us[15], SbusDecoder::to_us(1672));
+}
+
+static void test_ibus_frames_and_checksum() {
+    uint16_t words[14];
+    for (int i = 0; i < 14; i++) words[i] = static_cast<uint16_t>(1000 + i * 50);
+
+    Bytes stream;
+    append(stream, ibus_frame(words));
+    append(stream, ibus_frame(words, true));        // Bad checksum
+    words[0] = 2000;
+    append(stream, ibus_frame(words));
+
+    IbusDecoder d;
+    CHECK_EQ(feed(d, stream), 2);
+    CHECK_EQ(d.stats().frames, 2);
+    CHECK_EQ(d.stats().bad_frames, 1);
+    CHECK_EQ(d.frame().num_channels, 14);
+    CHECK_EQ(d.frame().ch_us[0], 2000);
+    CHECK_EQ(d.frame().ch_us[13], 1650);
+    CHECK_EQ(d.frame().ch_us[14], 0);
+    CHECK_EQ(d.stats().lost_frames, 0);             // iBUS has no flags
+    CHECK_EQ(d.stats().failsafe_frames, 0);
+}
+
+static void test_ibus_resync_and_extended() {
+    uint16_t words[14];
+    for (int i = 0; i < 14; i++) words[i] = 1500;
+
+    // A stray length byte right before the header
+    Bytes stream = { IbusDecoder::HEADER_LEN };
+    append(stream, ibus_frame(words));
+    IbusDecoder d;
+    CHECK_EQ(feed(d, stream), 1);
+
+    // Truncated frame (UART overrun): there are no gaps in the byte stream, so it
+    // swallows the start of the next frame and fails its checksum; the one after decodes
+    stream = ibus_frame(words);
+    stream.resize(10);
+    append(stream, ibus_frame(words));
+    CHECK_EQ(feed(d, stream), 0);
+    CHECK_EQ(d.stats().bad_frames, 1);
+
+    // 18 channel receiver: channel 15 = 0x5DC spread over the top nibbles of words 0..2,
+    // channel 16 = 0x3E8 over words 3..5
+    words[0] |= 0xC << 12; words[1] |= 0xD << 12; words[2] |= 0x5 << 12;
+    words[3] |= 0x8 << 12; words[4] |= 0xE << 12; words[5] |= 0x3 << 12;
+    CHECK_EQ(feed(d, ibus_frame(words)), 1);
+    CHECK_EQ(d.frame().num_channels, 16);
+    CHECK_EQ(d.frame().ch_us[0], 1500);
+    CHECK_EQ(d.frame().ch_us[5], 1500);
+    CHECK_EQ(d.frame().ch_us[14], 0x5DC);
+    CHECK_EQ(d.frame().ch_us[15], 0x3E8);
+    CHECK_EQ(d.stats().frames, 2);
+}
+
+static void test_ppm_sync_gap() {
+    const uint16_t ch[8] = { 1000, 1100, 1200, 1300, 1500, 1700, 1900, 2000 };
+    PpmDecoder d(PPM_CLK_HZ);
+    PpmStream s = { d, UINT32_MAX - 40000 * TICKS_PER_US };     // Counter wraps in frame 2
+
+    // Joined mid-frame: the partial frame before the first sync gap is not reported
+    s.slot(1500);
+    s.slot(1500);
+    s.slot(10000);
+    CHECK_EQ(s.frames, 0);
+
+    s.frame(ch, 8);
+    s.frame(ch, 8);
+    CHECK_EQ(s.frames, 2);
+    CHECK_EQ(d.frame().num_channels, 8);
+    for (int i = 0; i < 8; i++) CHECK_EQ(d.frame().ch_us[i], ch[i]);
+
+    // Shortest sync gap still counts, one microsecond less is a broken channel
+    s.frame(ch, 8, PpmDecoder::SYNC_MIN_US);
+    CHECK_EQ(s.frames, 3);
+    s.frame(ch, 8, PpmDecoder::SYNC_MIN_US - 1);    // Gap taken as a 9th, too long channel
+    CHECK_EQ(d.stats().bad_frames, 1);
+    s.frame(ch, 8);                                 // Dropped: resynchronizes on its gap
+    CHECK_EQ(s.frames, 3);
+    s.frame(ch, 8);
+    CHECK_EQ(s.frames, 4);
+    CHECK_EQ(d.stats().frames, 4);
+    CHECK_EQ(d.stats().bad_frames, 1);
+}
+
+static void test_ppm_bad_frames() {
+    const uint16_t ch[8] = { 1500, 1500, 1500, 1500, 1500, 1500, 1500, 1500 };
+    const uint16_t spike[8] = { 1500, 400, 1500, 1500, 1500, 1500, 1500, 1500 };
+    PpmDecoder d(PPM_CLK_HZ);
+    PpmStream s = { d, 0 };
+
+    s.slot(10000);
+    s.frame(ch, 3);             // Too few channels
+    s.frame(spike, 8);          // Channel below CH_MIN_US
+    s.frame(ch, 8);
+    CHECK_EQ(s.frames, 1);
+    CHECK_EQ(d.stats().bad_frames, 2);
+    CHECK_EQ(d.frame().num_channels, 8);
+
+    // More than RC_MAX_CHANNELS slots before a gap
+    uint16_t many[RC_MAX_CHANNELS + 1];
+    for (auto& c : many) c = 1500;
+    s.frame(many, RC_MAX_CHANNELS + 1);
+    CHECK_EQ(s.frames, 1);
+    CHECK_EQ(d.stats().bad_frames, 3);
+    s.frame(many, RC_MAX_CHANNELS);
+    CHECK_EQ(s.frames, 2);
+    CHECK_EQ(d.frame().num_channels, RC_MAX_CHANNELS);
+}
+
+int main() {
+    RUN_TEST(test_sbus_channels);
+    RUN_TEST(test_sbus_flags);
+    RUN_TEST(test_sbus_footer_and_resync);
+    RUN_TEST(test_sbus_inverted_polarity);
+    RUN_TEST(test_ibus_frames_and_checksum);
+    RUN_TEST(test_ibus_resync_and_extended);
+    RUN_TEST(test_ppm_sync_gap);
+    RUN_TEST(test_ppm_bad_frames);
+    return TEST_RESULT();
+}